@@ -0,0 +1,803 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI.h"
+#include "MyGUI_OverlappedLayer.h"
+#include "MyGUI_GlyphBatch.h"
+#include "MyGUI_DummyPlatform.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Counts every allocation made through global operator new.
+	// Allocations inside MyGUIEngine are counted too where the executable's operator new
+	// replaces the library one (shared libraries on ELF platforms, static builds).
+	std::atomic<size_t> allocationCount(0);
+}
+
+void* operator new(size_t _size)
+{
+	allocationCount++;
+	void* result = malloc(_size != 0 ? _size : 1);
+	if (result == nullptr)
+		throw std::bad_alloc();
+	return result;
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	free(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	free(_pointer);
+}
+
+namespace
+{
+
+	const int VIEW_WIDTH = 1024;
+	const int VIEW_HEIGHT = 768;
+
+	class Scenario
+	{
+	public:
+		Scenario(const std::string& _name) :
+			mName(_name)
+		{
+		}
+
+		virtual ~Scenario() { }
+
+		const std::string& getName() const
+		{
+			return mName;
+		}
+
+		virtual void setUp() { }
+		virtual void tearDown() { }
+
+		/** Run one iteration of scenario, returns number of measured operations */
+		virtual size_t run() = 0;
+
+	private:
+		std::string mName;
+	};
+
+	// Scenario owning top level widgets, they are destroyed after measurement.
+	class WidgetsScenario :
+		public Scenario
+	{
+	public:
+		WidgetsScenario(const std::string& _name) :
+			Scenario(_name)
+		{
+		}
+
+		void tearDown() override
+		{
+			MyGUI::Gui::getInstance().destroyWidgets(mWidgets);
+			mWidgets.clear();
+		}
+
+	protected:
+		MyGUI::VectorWidgetPtr mWidgets;
+	};
+
+	// Scenario measuring one multiline EditBox.
+	class EditScenario :
+		public Scenario
+	{
+	public:
+		EditScenario(const std::string& _name, const MyGUI::IntSize& _size) :
+			Scenario(_name),
+			mEdit(nullptr),
+			mSize(_size)
+		{
+		}
+
+		void setUp() override
+		{
+			mEdit = MyGUI::Gui::getInstance().createWidget<MyGUI::EditBox>("EditBoxStretch", MyGUI::IntCoord(MyGUI::IntPoint(), mSize), MyGUI::Align::Default, "Main");
+			mEdit->setEditMultiLine(true);
+			setUpEdit();
+		}
+
+		void tearDown() override
+		{
+			MyGUI::WidgetManager::getInstance().destroyWidget(mEdit);
+			mEdit = nullptr;
+		}
+
+	protected:
+		virtual void setUpEdit() { }
+
+	protected:
+		MyGUI::EditBox* mEdit;
+
+	private:
+		MyGUI::IntSize mSize;
+	};
+
+	// Buttons laid out in a grid over the whole view.
+	void createButtons(MyGUI::VectorWidgetPtr& _result, size_t _count, MyGUI::Widget* _parent)
+	{
+		const int columns = 50;
+		const int width = VIEW_WIDTH / columns;
+		const int height = VIEW_HEIGHT / (int)((_count + columns - 1) / columns);
+
+		for (size_t index = 0; index < _count; ++index)
+		{
+			MyGUI::IntCoord coord((int)(index % columns) * width, (int)(index / columns) * height, width - 1, height - 1);
+			MyGUI::Button* button = _parent != nullptr ?
+				_parent->createWidget<MyGUI::Button>("Button", coord, MyGUI::Align::Default) :
+				MyGUI::Gui::getInstance().createWidget<MyGUI::Button>("Button", coord, MyGUI::Align::Default, "Main");
+			button->setCaption("Button");
+			_result.push_back(button);
+		}
+	}
+
+	// About 1 Mb of log like text.
+	std::string createLogText()
+	{
+		std::string text;
+		for (size_t index = 0; index < 20000; ++index)
+			text += "[info] The quick brown fox jumps over the lazy dog.\n";
+		return text;
+	}
+
+	void renderFrame(bool _update = false)
+	{
+		MyGUI::DummyRenderManager& render = MyGUI::DummyRenderManager::getInstance();
+		render.begin();
+		MyGUI::LayerManager::getInstance().renderToTarget(&render, _update);
+		render.end();
+	}
+
+	MyGUI::OverlappedLayer* getOverlappedLayer()
+	{
+		return dynamic_cast<MyGUI::OverlappedLayer*>(MyGUI::LayerManager::getInstance().getByName("Overlapped"));
+	}
+
+	class WidgetCreateDestroy :
+		public Scenario
+	{
+	public:
+		WidgetCreateDestroy() :
+			Scenario("widget_create_destroy")
+		{
+		}
+
+		size_t run() override
+		{
+			MyGUI::VectorWidgetPtr widgets;
+			createButtons(widgets, 1000, nullptr);
+			MyGUI::Gui::getInstance().destroyWidgets(widgets);
+			// widgets are deleted on next frame, measure it too
+			MyGUI::WidgetManager::getInstance()._deleteDelayWidgets();
+			return 1000;
+		}
+	};
+
+	class LayoutLoad :
+		public Scenario
+	{
+	public:
+		LayoutLoad() :
+			Scenario("layout_load")
+		{
+		}
+
+		size_t run() override
+		{
+			MyGUI::VectorWidgetPtr widgets = MyGUI::LayoutManager::getInstance().loadLayout("Themes.layout");
+			MyGUI::LayoutManager::getInstance().unloadLayout(widgets);
+			MyGUI::WidgetManager::getInstance()._deleteDelayWidgets();
+			return 1;
+		}
+	};
+
+	class TextRelayout :
+		public EditScenario
+	{
+	public:
+		TextRelayout() :
+			EditScenario("text_relayout", MyGUI::IntSize(600, 400))
+		{
+		}
+
+		size_t run() override
+		{
+			for (size_t index = 0; index < 10; ++index)
+			{
+				mEdit->setCaption(mCaptions[index % 2]);
+				mEdit->getTextSize();
+			}
+			return 10;
+		}
+
+	protected:
+		void setUpEdit() override
+		{
+			mEdit->setEditWordWrap(true);
+
+			const std::string words = "The quick brown fox jumps over the lazy dog. ";
+			for (size_t index = 0; index < 100; ++index)
+			{
+				mCaptions[0] += words;
+				mCaptions[1] += index % 10 == 9 ? words + "\n" : words;
+			}
+		}
+
+	private:
+		std::string mCaptions[2];
+	};
+
+	class EditInsert :
+		public EditScenario
+	{
+	public:
+		EditInsert() :
+			EditScenario("edit_insert", MyGUI::IntSize(600, 400))
+		{
+		}
+
+		size_t run() override
+		{
+			// typing in the middle of text and erasing it back
+			size_t position = mEdit->getTextLength() / 2;
+			for (size_t index = 0; index < 5; ++index)
+			{
+				mEdit->insertText("a", position + index);
+				mEdit->getTextSize();
+			}
+			for (size_t index = 0; index < 5; ++index)
+			{
+				mEdit->eraseText(position + 4 - index, 1);
+				mEdit->getTextSize();
+			}
+			return 10;
+		}
+
+	protected:
+		void setUpEdit() override
+		{
+			mEdit->setEditWordWrap(true);
+			mEdit->setMaxTextLength(4 * 1024 * 1024);
+			mEdit->setCaption(createLogText());
+		}
+	};
+
+	class EditScroll :
+		public EditScenario
+	{
+	public:
+		EditScroll() :
+			EditScenario("edit_scroll", MyGUI::IntSize(600, 400)),
+			mPosition(0)
+		{
+		}
+
+		size_t run() override
+		{
+			// scrolling by a few lines and drawing the frame
+			mPosition = (mPosition + 50) % mEdit->getVScrollRange();
+			mEdit->setVScrollPosition(mPosition);
+			renderFrame();
+			return 1;
+		}
+
+	protected:
+		void setUpEdit() override
+		{
+			mEdit->setEditWordWrap(true);
+			mEdit->setMaxTextLength(4 * 1024 * 1024);
+			mEdit->setCaption(createLogText());
+			mPosition = 0;
+		}
+
+	private:
+		size_t mPosition;
+	};
+
+	class TextTessellate :
+		public EditScenario
+	{
+	public:
+		TextTessellate(const std::string& _name) :
+			EditScenario(_name, MyGUI::IntSize(VIEW_WIDTH, VIEW_HEIGHT)),
+			mSelect(false)
+		{
+		}
+
+		size_t run() override
+		{
+			// selection change makes only text to be tessellated again
+			mSelect = !mSelect;
+			mEdit->setTextSelection(0, mSelect ? 100 : 0);
+			renderFrame();
+			return 1;
+		}
+
+	protected:
+		void setUpEdit() override
+		{
+			mEdit->setTextShadow(true);
+
+			// screen full of text, partially clipped on the right
+			std::string text;
+			for (size_t index = 0; index < 60; ++index)
+				text += "[info] The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox.\n";
+			mEdit->setCaption(text);
+		}
+
+	private:
+		bool mSelect;
+	};
+
+	class GlyphQuads :
+		public Scenario
+	{
+	public:
+		GlyphQuads() :
+			Scenario("glyph_quads")
+		{
+		}
+
+		void setUp() override
+		{
+			// glyph sized quads over the view, last columns and rows are clipped
+			mBatch.clear();
+			for (int top = 0; top < VIEW_HEIGHT; top += 16)
+			{
+				for (int left = 0; left < VIEW_WIDTH; left += 9)
+				{
+					MyGUI::FloatRect vertex((float)left + 0.5f, (float)top + 2.0f, (float)left + 8.5f, (float)top + 14.0f);
+					mBatch.add(vertex, MyGUI::FloatRect(0.25f, 0.5f, 0.2578125f, 0.5234375f), 0xFFFFFFFF);
+				}
+			}
+			mVertices.resize(mBatch.size() * MyGUI::IndexedVertexQuad::VertexCount);
+
+			mInfo.setOffset(0, 0);
+			mInfo.pixScaleX = 1.0f / (float)VIEW_WIDTH;
+			mInfo.pixScaleY = 1.0f / (float)VIEW_HEIGHT;
+			mInfo.hOffset = 0.0f;
+			mInfo.vOffset = 0.0f;
+		}
+
+		void tearDown() override
+		{
+			mBatch.clear();
+			mVertices.clear();
+		}
+
+		size_t run() override
+		{
+			MyGUI::FloatRect clip(0.0f, 0.0f, (float)VIEW_WIDTH - 20.0f, (float)VIEW_HEIGHT - 10.0f);
+			mBatch.write(mVertices.data(), clip, 0.0f, 0.0f, 0.0f, mInfo);
+			return mBatch.size();
+		}
+
+	private:
+		MyGUI::GlyphBatch mBatch;
+		std::vector<MyGUI::Vertex> mVertices;
+		MyGUI::RenderTargetInfo mInfo;
+	};
+
+	class PickTest :
+		public WidgetsScenario
+	{
+	public:
+		PickTest(bool _pickGrid) :
+			WidgetsScenario(_pickGrid ? "pick_grid" : "pick"),
+			mPickGrid(_pickGrid),
+			mSeed(1)
+		{
+		}
+
+		void setUp() override
+		{
+			getOverlappedLayer()->setPickGrid(mPickGrid);
+
+			MyGUI::Widget* panel = MyGUI::Gui::getInstance().createWidget<MyGUI::Widget>("PanelEmpty", 0, 0, VIEW_WIDTH, VIEW_HEIGHT, MyGUI::Align::Default, "Overlapped");
+			mWidgets.push_back(panel);
+			MyGUI::VectorWidgetPtr widgets;
+			createButtons(widgets, 2000, panel);
+		}
+
+		void tearDown() override
+		{
+			WidgetsScenario::tearDown();
+			getOverlappedLayer()->setPickGrid(false);
+		}
+
+		size_t run() override
+		{
+			MyGUI::LayerManager& manager = MyGUI::LayerManager::getInstance();
+			for (size_t index = 0; index < 1000; ++index)
+			{
+				// same points on every run
+				mSeed = mSeed * 1103515245 + 12345;
+				int left = (int)((mSeed >> 16) % VIEW_WIDTH);
+				mSeed = mSeed * 1103515245 + 12345;
+				int top = (int)((mSeed >> 16) % VIEW_HEIGHT);
+				manager.getWidgetFromPoint(left, top);
+			}
+			return 1000;
+		}
+
+	private:
+		bool mPickGrid;
+		unsigned int mSeed;
+	};
+
+	class EventSubscribe :
+		public WidgetsScenario
+	{
+	public:
+		EventSubscribe() :
+			WidgetsScenario("event_subscribe"),
+			mCount(0)
+		{
+		}
+
+		void setUp() override
+		{
+			createButtons(mWidgets, 1000, nullptr);
+		}
+
+		size_t run() override
+		{
+			for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+			{
+				(*widget)->eventMouseButtonClick += MyGUI::newDelegate(MyGUI::delegates::byValue, this, &EventSubscribe::notifyWidget);
+				(*widget)->eventChangeCoord += MyGUI::newDelegate(MyGUI::delegates::byValue, this, &EventSubscribe::notifyWidget);
+			}
+
+			for (size_t index = 0; index < 10; ++index)
+			{
+				for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+				{
+					(*widget)->eventMouseButtonClick(*widget);
+					(*widget)->eventChangeCoord(*widget);
+				}
+			}
+
+			for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+			{
+				(*widget)->eventMouseButtonClick -= MyGUI::newDelegate(MyGUI::delegates::byValue, this, &EventSubscribe::notifyWidget);
+				(*widget)->eventChangeCoord -= MyGUI::newDelegate(MyGUI::delegates::byValue, this, &EventSubscribe::notifyWidget);
+			}
+
+			return mWidgets.size();
+		}
+
+	private:
+		void notifyWidget(MyGUI::Widget* _sender)
+		{
+			mCount ++;
+		}
+
+	private:
+		size_t mCount;
+	};
+
+	class FrameControllers :
+		public WidgetsScenario
+	{
+	public:
+		FrameControllers() :
+			WidgetsScenario("frame_controllers")
+		{
+		}
+
+		void setUp() override
+		{
+			createButtons(mWidgets, 1000, nullptr);
+
+			MyGUI::ControllerManager& manager = MyGUI::ControllerManager::getInstance();
+			for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+			{
+				// long enough to never finish while measured
+				MyGUI::ControllerPosition* controller = manager.createItem(MyGUI::ControllerPosition::getClassTypeName())->castType<MyGUI::ControllerPosition>();
+				controller->setPosition(MyGUI::IntPoint(VIEW_WIDTH, VIEW_HEIGHT));
+				controller->setTime(100000);
+				controller->setFunction("Inertional");
+				manager.addItem(*widget, controller);
+			}
+		}
+
+		size_t run() override
+		{
+			for (size_t index = 0; index < 10; ++index)
+				MyGUI::Gui::getInstance().frameEvent(1.0f / 60.0f);
+			return 10;
+		}
+	};
+
+	class FadeControllers :
+		public WidgetsScenario
+	{
+	public:
+		FadeControllers() :
+			WidgetsScenario("fade_controllers")
+		{
+		}
+
+		void setUp() override
+		{
+			createButtons(mWidgets, 2000, nullptr);
+		}
+
+		size_t run() override
+		{
+			MyGUI::ControllerManager& manager = MyGUI::ControllerManager::getInstance();
+
+			// rows start fading out and are stopped halfway, like list scrolled away and back
+			for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+			{
+				MyGUI::ControllerFadeAlpha* controller = manager.createItem(MyGUI::ControllerFadeAlpha::getClassTypeName())->castType<MyGUI::ControllerFadeAlpha>();
+				controller->setAlpha(0);
+				controller->setCoef(1);
+				manager.addItem(*widget, controller);
+			}
+
+			for (size_t index = 0; index < 10; ++index)
+				MyGUI::Gui::getInstance().frameEvent(1.0f / 60.0f);
+
+			for (MyGUI::VectorWidgetPtr::const_iterator widget = mWidgets.begin(); widget != mWidgets.end(); ++widget)
+			{
+				manager.removeItem(*widget);
+				(*widget)->setAlpha(1);
+			}
+			MyGUI::Gui::getInstance().frameEvent(1.0f / 60.0f);
+
+			return 11;
+		}
+	};
+
+	class Render :
+		public WidgetsScenario
+	{
+	public:
+		Render(bool _update) :
+			WidgetsScenario(_update ? "render_update" : "render"),
+			mUpdate(_update)
+		{
+		}
+
+		void setUp() override
+		{
+			mWidgets = MyGUI::LayoutManager::getInstance().loadLayout("Themes.layout");
+			createButtons(mWidgets, 500, nullptr);
+		}
+
+		size_t run() override
+		{
+			renderFrame(mUpdate);
+			return 1;
+		}
+
+	private:
+		bool mUpdate;
+	};
+
+	// Buttons and image boxes alternating inside one layer node, every texture change starts a new batch.
+	class TextureBatches :
+		public WidgetsScenario
+	{
+	public:
+		TextureBatches(const std::string& _name) :
+			WidgetsScenario(_name)
+		{
+		}
+
+		void setUp() override
+		{
+			MyGUI::Widget* root = MyGUI::Gui::getInstance().createWidget<MyGUI::Widget>("", MyGUI::IntCoord(0, 0, VIEW_WIDTH, VIEW_HEIGHT), MyGUI::Align::Default, "Main");
+			mWidgets.push_back(root);
+
+			const int columns = 20;
+			const int rows = 20;
+			const int width = VIEW_WIDTH / columns;
+			const int height = VIEW_HEIGHT / rows;
+			for (int index = 0; index < columns * rows; ++index)
+			{
+				MyGUI::IntCoord coord((index % columns) * width, (index / columns) * height, width - 1, height - 1);
+				if (index % 2 == 0)
+				{
+					root->createWidget<MyGUI::Button>("Button", coord, MyGUI::Align::Default);
+				}
+				else
+				{
+					MyGUI::ImageBox* image = root->createWidget<MyGUI::ImageBox>("ImageBox", coord, MyGUI::Align::Default);
+					image->setItemResource("ArrowPointerImage");
+				}
+			}
+		}
+
+		size_t run() override
+		{
+			renderFrame();
+			return 1;
+		}
+	};
+
+	// Window with many children dragged over the view and rendered after every move.
+	class WindowDrag :
+		public WidgetsScenario
+	{
+	public:
+		WindowDrag(bool _pixelSpace) :
+			WidgetsScenario(_pixelSpace ? "window_drag_pixel_space" : "window_drag"),
+			mPixelSpace(_pixelSpace),
+			mWindow(nullptr),
+			mStep(0)
+		{
+		}
+
+		void setUp() override
+		{
+			getOverlappedLayer()->setPixelSpace(mPixelSpace);
+
+			mWindow = MyGUI::Gui::getInstance().createWidget<MyGUI::Window>("WindowCS", 0, 0, VIEW_WIDTH / 2, VIEW_HEIGHT / 2, MyGUI::Align::Default, "Overlapped");
+			mWidgets.push_back(mWindow);
+			MyGUI::VectorWidgetPtr widgets;
+			createButtons(widgets, 500, mWindow);
+			mStep = 0;
+		}
+
+		void tearDown() override
+		{
+			WidgetsScenario::tearDown();
+			mWindow = nullptr;
+			getOverlappedLayer()->setPixelSpace(false);
+		}
+
+		size_t run() override
+		{
+			for (size_t index = 0; index < 10; ++index)
+			{
+				++mStep;
+				mWindow->setPosition((int)(mStep % 100), (int)(mStep % 50));
+				renderFrame();
+			}
+			return 10;
+		}
+
+	private:
+		bool mPixelSpace;
+		MyGUI::Window* mWindow;
+		size_t mStep;
+	};
+
+	void runScenario(Scenario& _scenario, double _minSeconds)
+	{
+		MyGUI::DummyRenderManager& render = MyGUI::DummyRenderManager::getInstance();
+
+		_scenario.setUp();
+		// warm up caches, lazy resources and vertex buffers
+		_scenario.run();
+
+		render.resetStatistic();
+		size_t allocations = allocationCount;
+		size_t operations = 0;
+
+		typedef std::chrono::steady_clock Clock;
+		Clock::time_point start = Clock::now();
+		double seconds = 0;
+
+		do
+		{
+			operations += _scenario.run();
+			seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+		while (seconds < _minSeconds);
+
+		allocations = allocationCount - allocations;
+		_scenario.tearDown();
+
+		double count = (double)operations;
+		std::cout << "{\"name\": \"" << _scenario.getName() << "\""
+			<< ", \"ops\": " << operations
+			<< ", \"seconds\": " << seconds
+			<< ", \"ns_per_op\": " << seconds * 1e9 / count
+			<< ", \"allocs_per_op\": " << allocations / count
+			<< ", \"batches_per_op\": " << render.getBatchCount() / count
+			<< ", \"vertices_per_op\": " << render.getVertexCount() / count
+			<< ", \"indices_per_op\": " << render.getIndexCount() / count
+			<< ", \"locks_per_op\": " << render.getLockCount() / count
+			<< ", \"locked_vertices_per_op\": " << render.getLockedVertexCount() / count
+			<< ", \"locked_bytes_per_op\": " << render.getLockedVertexSize() / count
+			<< "}" << std::endl;
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	std::string media = argc > 1 ? argv[1] : MYGUI_MEDIA_DIR;
+	double minSeconds = argc > 2 ? MyGUI::utility::parseDouble(argv[2]) : 1.0;
+
+	MyGUI::DummyPlatform* platform = new MyGUI::DummyPlatform();
+	// results go to stdout, keep it clean
+	MyGUI::LogManager::getInstance().setSTDOutputEnabled(false);
+	platform->initialise("Benchmark_Gui.log");
+
+	platform->getDataManagerPtr()->addResourceLocation(media + "/MyGUI_Media", false);
+	platform->getDataManagerPtr()->addResourceLocation(media + "/Demos/Demo_Themes", false);
+	platform->getRenderManagerPtr()->setViewSize(VIEW_WIDTH, VIEW_HEIGHT);
+
+	if (!platform->getDataManagerPtr()->isDataExist("MyGUI_Core.xml"))
+	{
+		std::cerr << "MyGUI media not found in '" << media << "'" << std::endl;
+		platform->shutdown();
+		delete platform;
+		return 1;
+	}
+
+	MyGUI::Gui* gui = new MyGUI::Gui();
+	gui->initialise();
+
+	std::vector<Scenario*> scenarios;
+	scenarios.push_back(new WidgetCreateDestroy());
+	scenarios.push_back(new LayoutLoad());
+	scenarios.push_back(new TextRelayout());
+	scenarios.push_back(new EditInsert());
+	scenarios.push_back(new EditScroll());
+	scenarios.push_back(new TextTessellate("text_tessellate"));
+	scenarios.push_back(new GlyphQuads());
+	scenarios.push_back(new PickTest(false));
+	scenarios.push_back(new PickTest(true));
+	scenarios.push_back(new EventSubscribe());
+	scenarios.push_back(new FrameControllers());
+	scenarios.push_back(new FadeControllers());
+	scenarios.push_back(new Render(false));
+	scenarios.push_back(new Render(true));
+	scenarios.push_back(new TextureBatches("texture_batches"));
+	scenarios.push_back(new WindowDrag(false));
+	scenarios.push_back(new WindowDrag(true));
+
+	for (std::vector<Scenario*>::iterator scenario = scenarios.begin(); scenario != scenarios.end(); ++scenario)
+	{
+		runScenario(**scenario, minSeconds);
+		delete *scenario;
+	}
+
+	gui->shutdown();
+
+	// the same scene again, with skin and image set textures packed into atlas pages
+	gui->initialise("");
+	MyGUI::TextureAtlasManager::getInstance().setEnabled(true);
+	MyGUI::ResourceManager::getInstance().load("MyGUI_Core.xml");
+
+	TextureBatches atlasBatches("texture_batches_atlas");
+	runScenario(atlasBatches, minSeconds);
+
+	gui->shutdown();
+
+	// the same scenes again, with compact vertices in vertex buffers
+	platform->getRenderManagerPtr()->setVertexLayout(MyGUI::VertexLayout::Compact);
+	gui->initialise();
+
+	TextTessellate compactText("text_tessellate_compact");
+	runScenario(compactText, minSeconds);
+	TextureBatches compactBatches("texture_batches_compact");
+	runScenario(compactBatches, minSeconds);
+
+	gui->shutdown();
+	delete gui;
+
+	platform->shutdown();
+	delete platform;
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_XmlDocument.h"
+#include "MyGUI_LogManager.h"
+#include "FileSystemInfo/FileSystemInfo.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+
+	// Data stream over a file that is already loaded into memory, so that only parsing is measured.
+	class MemoryDataStream :
+		public MyGUI::IDataStream
+	{
+	public:
+		MemoryDataStream(const std::string& _data) :
+			mData(_data),
+			mPosition(0)
+		{
+		}
+
+		bool eof() override
+		{
+			return mPosition >= mData.size();
+		}
+
+		size_t size() override
+		{
+			return mData.size();
+		}
+
+		void readline(std::string& _source, MyGUI::Char _delim) override
+		{
+			size_t end = mData.find((char)_delim, mPosition);
+			if (end == std::string::npos)
+				end = mData.size();
+			_source.assign(mData, mPosition, end - mPosition);
+			mPosition = end + 1;
+		}
+
+		size_t read(void* _buf, size_t _count) override
+		{
+			size_t count = std::min(_count, mData.size() - mPosition);
+			memcpy(_buf, mData.data() + mPosition, count);
+			mPosition += count;
+			return count;
+		}
+
+	private:
+		const std::string& mData;
+		size_t mPosition;
+	};
+
+	void loadFiles(const std::wstring& _folder, const std::wstring& _mask, std::vector<std::string>& _files)
+	{
+		common::VectorWString names;
+		common::scanFolder(names, _folder, true, _mask, true);
+
+		for (common::VectorWString::const_iterator name = names.begin(); name != names.end(); ++name)
+		{
+			std::ifstream stream(MyGUI::UString(*name).asUTF8_c_str(), std::ios_base::binary);
+			std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+			// skip files that are not MyGUI xml
+			MyGUI::xml::Document document;
+			MemoryDataStream check(data);
+			if (document.open(&check))
+				_files.push_back(data);
+		}
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	// errors from folder scanning go to the log
+	MyGUI::LogManager logManager;
+
+	std::wstring folder = MyGUI::UString(argc > 1 ? argv[1] : MYGUI_MEDIA_DIR).asWStr();
+	double minSeconds = argc > 2 ? MyGUI::utility::parseDouble(argv[2]) : 2.0;
+
+	std::vector<std::string> files;
+	loadFiles(folder, L"*.xml", files);
+	loadFiles(folder, L"*.layout", files);
+
+	size_t bytes = 0;
+	for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file)
+		bytes += file->size();
+
+	if (bytes == 0)
+	{
+		std::cerr << "No xml files found in '" << MyGUI::UString(folder).asUTF8() << "'" << std::endl;
+		return 1;
+	}
+
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+	double seconds = 0;
+	size_t passes = 0;
+
+	do
+	{
+		for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file)
+		{
+			MyGUI::xml::Document document;
+			MemoryDataStream stream(*file);
+			document.open(&stream);
+		}
+
+		++passes;
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	while (seconds < minSeconds);
+
+	double megabytes = (double)bytes * passes / (1024 * 1024);
+
+	std::cout << "{\"name\": \"xml_parse\", \"files\": " << files.size()
+		<< ", \"bytes\": " << bytes
+		<< ", \"passes\": " << passes
+		<< ", \"seconds\": " << seconds
+		<< ", \"mb_per_s\": " << megabytes / seconds
+		<< "}" << std::endl;
+
+	return 0;
+}
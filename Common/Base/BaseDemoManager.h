@@ -97,6 +97,15 @@ namespace base
 					MyGUI::MapString statistic = getStatistic();
 					for (MyGUI::MapString::const_iterator info = statistic.begin(); info != statistic.end(); info ++)
 						mInfo->change((*info).first, (*info).second);
+
+#ifdef MYGUI_ENABLE_PROFILER
+					const MyGUI::Profiler::FrameInfo& frame = MyGUI::Profiler::getInstance().getLastFrame();
+					for (size_t index = 0; index < MyGUI::ProfilerCounter::MAX; ++index)
+						mInfo->change(MyGUI::Profiler::getCounterName((MyGUI::ProfilerCounter::Enum)index), frame.counters[index]);
+					for (MyGUI::Profiler::VectorSectionInfo::const_iterator section = frame.sections.begin(); section != frame.sections.end(); ++section)
+						mInfo->change(std::string(section->name) + ", ms", section->time);
+#endif
+
 					mInfo->update();
 				}
 			}
@@ -96,6 +96,17 @@ namespace base
 		return result;
 	}
 
+	bool BaseManager::getImageSize(int& _width, int& _height, const std::string& _filename)
+	{
+		MyGUI::texture_utility::TextureInfo info;
+		if (!MyGUI::texture_utility::getTextureInfo(_filename, info))
+			return false;
+
+		_width = info.size.width;
+		_height = info.size.height;
+		return true;
+	}
+
 	void BaseManager::saveImage(int _width, int _height, MyGUI::PixelFormat _format, void* _texture, const std::string& _filename)
 	{
 		SDL_Surface* surface = SDL_CreateRGBSurface(0, _width, _height, _format.getBytesPerPixel() * 8, 0, 0, 0, 0);
@@ -24,6 +24,7 @@ namespace base
 //		/*internal:*/
 		void* loadImage(int& _width, int& _height, MyGUI::PixelFormat& _format, const std::string& _filename) override;
 		void saveImage(int _width, int _height, MyGUI::PixelFormat _format, void* _texture, const std::string& _filename) override;
+		bool getImageSize(int& _width, int& _height, const std::string& _filename) override;
 
 	private:
 		MyGUI::OpenGL3Platform* mPlatform = nullptr;
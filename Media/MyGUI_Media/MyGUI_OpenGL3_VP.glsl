@@ -4,12 +4,16 @@ out vec2 TexCoord;
 in vec3 VertexPosition;
 in vec4 VertexColor;
 in vec2 VertexTexCoord;
+// xy - position scale, zw - position offset, constant for whole batch
+in vec4 VertexTransform;
+// added to depth, constant for whole batch
+in float VertexDepth;
 uniform float YScale;
 void main()
 {
 	TexCoord = VertexTexCoord;
 	Color = VertexColor;
-	vec4 vpos = vec4(VertexPosition,1.0);
+	vec4 vpos = vec4(VertexPosition.xy * VertexTransform.xy + VertexTransform.zw, VertexPosition.z + VertexDepth, 1.0);
 	vpos.y *= YScale;
 	gl_Position = vpos;
-}
\ No newline at end of file
+}
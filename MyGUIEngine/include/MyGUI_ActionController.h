@@ -35,22 +35,34 @@ namespace MyGUI
 			if N > 10 speed will be increasing
 			if N < 10 speed will be decreasing
 		*/
+		template <int N>
+		inline float acceleratedMoveFactor(float _current_time)
+		{
+			return std::pow(_current_time, N / 10.f /*3 by default as Accelerated and 0.4 by default as Slowed*/);
+		}
+
 		template <int N>
 		inline void acceleratedMoveFunction(const IntCoord& _startRect, const IntCoord& _destRect, IntCoord& _result, float _current_time)
 		{
-			float k = std::pow(_current_time, N / 10.f /*3 by default as Accelerated and 0.4 by default as Slowed*/);
-			linearMoveFunction(_startRect, _destRect, _result, k);
+			linearMoveFunction(_startRect, _destRect, _result, acceleratedMoveFactor<N>(_current_time));
 		}
 
 		/** Function for ControllerPosition per frame action : Move with accelerated speed a bit farther than necessary and then return it back */
+		template <int N>
+		inline float jumpMoveFactor(float _current_time)
+		{
+			return std::pow(_current_time, 2.0f) * (-2 - N / 10.f) + _current_time * (3 + N / 10.f);
+		}
+
 		template <int N>
 		inline void jumpMoveFunction(const IntCoord& _startRect, const IntCoord& _destRect, IntCoord& _result, float _current_time)
 		{
-			float k = std::pow(_current_time, 2.0f) * (-2 - N / 10.f) + _current_time * (3 + N / 10.f);
-			linearMoveFunction(_startRect, _destRect, _result, k);
+			linearMoveFunction(_startRect, _destRect, _result, jumpMoveFactor<N>(_current_time));
 		}
 
 		/** Function for ControllerPosition per frame action : Start with zero speed increasing half time and then decreasing to zero */
+		float MYGUI_EXPORT inertionalMoveFactor(float _current_time);
+
 		void MYGUI_EXPORT inertionalMoveFunction(const IntCoord& _startRect, const IntCoord& _destRect, IntCoord& _result, float _current_time);
 
 	} // namespace action
@@ -40,6 +40,9 @@ namespace MyGUI
 		// меняет местами два индекса, индексы со сторонны данных
 		void swapItemsBackAt(size_t _index1, size_t _index2);
 
+		// reorder indexes from data side, index _order[N] becomes index N
+		void permuteItemsBack(const std::vector<size_t>& _order);
+
 #if MYGUI_DEBUG_MODE == 1
 		void checkIndexes();
 #endif
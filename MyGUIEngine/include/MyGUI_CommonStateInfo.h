@@ -12,6 +12,7 @@
 #include "MyGUI_CoordConverter.h"
 #include "MyGUI_LanguageManager.h"
 #include "MyGUI_TextureUtility.h"
+#include "MyGUI_TextureAtlasManager.h"
 
 namespace MyGUI
 {
@@ -38,8 +39,14 @@ namespace MyGUI
 				texture = LanguageManager::getInstance().replaceTags(texture);
 			}
 
-			const IntSize& size = texture_utility::getTextureSize(texture);
-			const IntCoord& coord = IntCoord::parse(_node->findAttribute("offset"));
+			IntCoord coord = IntCoord::parse(_node->findAttribute("offset"));
+
+			// texture could be packed into atlas page
+			IntPoint offset;
+			if (TextureAtlasManager::getInstance().mapTexture(texture, offset))
+				coord = coord + offset;
+
+			IntSize size = texture_utility::getTextureSize(texture);
 			mRect = CoordConverter::convertTextureCoord(coord, size);
 		}
 
@@ -90,8 +97,14 @@ namespace MyGUI
 				texture = LanguageManager::getInstance().replaceTags(texture);
 			}
 
-			const IntSize& size = texture_utility::getTextureSize(texture);
-			const IntCoord& coord = IntCoord::parse(_node->findAttribute("offset"));
+			IntCoord coord = IntCoord::parse(_node->findAttribute("offset"));
+
+			// texture could be packed into atlas page
+			IntPoint offset;
+			if (TextureAtlasManager::getInstance().mapTexture(texture, offset))
+				coord = coord + offset;
+
+			IntSize size = texture_utility::getTextureSize(texture);
 			mRect = CoordConverter::convertTextureCoord(coord, size);
 
 			xml::ElementEnumerator prop = _node->getElementEnumerator();
@@ -158,8 +171,14 @@ namespace MyGUI
 				texture = LanguageManager::getInstance().replaceTags(texture);
 			}
 
-			const IntSize& size = texture_utility::getTextureSize(texture);
-			const IntCoord& coord = IntCoord::parse(_node->findAttribute("offset"));
+			IntCoord coord = IntCoord::parse(_node->findAttribute("offset"));
+
+			// texture could be packed into atlas page
+			IntPoint offset;
+			if (TextureAtlasManager::getInstance().mapTexture(texture, offset))
+				coord = coord + offset;
+
+			IntSize size = texture_utility::getTextureSize(texture);
 			mRect = CoordConverter::convertTextureCoord(coord, size);
 		}
 
@@ -42,6 +42,10 @@ namespace MyGUI
 		void prepareItem(Widget* _widget) override;
 		void setProperty(const std::string& _key, const std::string& _value) override;
 
+	private:
+		friend class ControllerManager;
+		void updateItem();
+
 	private:
 		float mAlpha;
 		float mCoef;
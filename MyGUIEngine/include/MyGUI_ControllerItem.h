@@ -28,6 +28,11 @@ namespace MyGUI
 		MYGUI_RTTI_DERIVED( ControllerItem )
 
 	public:
+		ControllerItem() :
+			mTrack(0),
+			mTrackIndex(ITEM_NONE)
+		{
+		}
 		~ControllerItem() override = default;
 
 		virtual void prepareItem(Widget* _widget) = 0;
@@ -53,6 +58,11 @@ namespace MyGUI
 		*/
 		EventPairAddParameter<EventHandle_WidgetPtr, EventHandle_WidgetPtrControllerItemPtr> eventPostAction;
 
+	private:
+		friend class ControllerManager;
+		// place of working controller in ControllerManager, mTrackIndex is ITEM_NONE if controller is not added
+		size_t mTrack;
+		size_t mTrackIndex;
 	};
 
 } // namespace MyGUI
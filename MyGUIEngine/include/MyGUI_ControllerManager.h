@@ -9,10 +9,12 @@
 
 #include "MyGUI_Prerequest.h"
 #include "MyGUI_Singleton.h"
+#include "MyGUI_Types.h"
 #include "MyGUI_ControllerItem.h"
 #include "MyGUI_IUnlinkWidget.h"
 #include "MyGUI_WidgetDefines.h"
 #include "MyGUI_ActionController.h"
+#include <unordered_map>
 
 namespace MyGUI
 {
@@ -48,15 +50,96 @@ namespace MyGUI
 
 		const std::string& getCategoryName() const;
 
+		/** Internal method. Copy changed parameters of working controller. */
+		void _updateItem(ControllerItem* _item);
+
 	private:
+		// controllers of built-in types are kept by type in arrays of parameters and updated together,
+		// controllers of other types are updated one by one with ControllerItem::addTime
+		enum TrackType
+		{
+			TrackItem,
+			TrackFadeAlpha,
+			TrackPosition,
+			TrackCount
+		};
+
+		struct Track
+		{
+			virtual ~Track() = default;
+
+			void add(Widget* _widget, ControllerItem* _item);
+
+			// copy parameters of controller, and its starting state if _state is true
+			virtual void load(size_t /*_index*/, bool /*_state*/) { }
+			virtual void move(size_t _from, size_t _to);
+			virtual void resize(size_t _size);
+
+			// widget is nullptr for finished and removed controllers, they are deleted by compaction
+			VectorWidgetPtr widgets;
+			std::vector<ControllerItem*> items;
+		};
+
+		struct FadeAlphaTrack :
+			public Track
+		{
+			void load(size_t _index, bool _state) override;
+			void move(size_t _from, size_t _to) override;
+			void resize(size_t _size) override;
+
+			std::vector<float> alpha;
+			std::vector<float> coef;
+			// calculated every frame
+			std::vector<float> current;
+			std::vector<float> next;
+			std::vector<uint8> finished;
+		};
+
+		struct PositionTrack :
+			public Track
+		{
+			void load(size_t _index, bool _state) override;
+			void move(size_t _from, size_t _to) override;
+			void resize(size_t _size) override;
+
+			std::vector<IntCoord> start;
+			std::vector<IntCoord> dest;
+			std::vector<float> time;
+			std::vector<float> elapsed;
+			std::vector<uint8> function;
+			std::vector<uint8> calcPosition;
+			std::vector<uint8> calcSize;
+			// calculated every frame
+			std::vector<float> factor;
+			std::vector<IntCoord> result;
+			std::vector<uint8> finished;
+		};
+
 		void _unlinkWidget(Widget* _widget) override;
 		void frameEntered(float _time);
+		void updateItemTrack(float _time);
+		void updateFadeAlphaTrack(float _time);
+		void updatePositionTrack(float _time);
+		void finishItem(Track& _track, size_t _index, ControllerItem* _item);
+		void compactTracks();
 		void clear();
 
 	private:
-		typedef std::pair<Widget*, ControllerItem*> PairControllerItem;
-		typedef std::list<PairControllerItem> ListControllerItem;
-		ListControllerItem mListItem;
+		Track mItemTrack;
+		FadeAlphaTrack mFadeAlphaTrack;
+		PositionTrack mPositionTrack;
+		Track* mTracks[TrackCount];
+
+		typedef std::vector<ControllerItem*> VectorControllerItem;
+		typedef std::unordered_map<Widget*, VectorControllerItem> MapWidgetItem;
+		// working controllers of every widget, so they are found without search through all tracks
+		MapWidgetItem mWidgetItems;
+		// replaced controllers, they can be in their own event handler yet
+		VectorControllerItem mDeletedItems;
+
+		// all controllers in tracks, including finished ones that are not deleted yet
+		size_t mItemCount;
+		bool mNeedCompaction;
 
 		bool mIsInitialise;
 		std::string mCategoryName;
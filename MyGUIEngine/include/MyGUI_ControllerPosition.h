@@ -58,6 +58,23 @@ namespace MyGUI
 		void prepareItem(Widget* _widget) override;
 		void setProperty(const std::string& _key, const std::string& _value) override;
 
+	private:
+		friend class ControllerManager;
+
+		// built-in functions are calculated by manager for all controllers at once
+		enum Function
+		{
+			FunctionCustom,
+			FunctionLinear,
+			FunctionInertional,
+			FunctionAccelerated,
+			FunctionSlowed,
+			FunctionJump
+		};
+
+		void setAction(FrameAction::IDelegate* _value, Function _function);
+		void updateItem();
+
 	private:
 		IntCoord mStartCoord;
 		IntCoord mDestCoord;
@@ -69,6 +86,8 @@ namespace MyGUI
 		// controller changing size
 		bool mCalcSize;
 
+		Function mFunction;
+
 		/** Event : Every frame action while controller exist.\n
 			signature : void method(const IntRect& _startRect, const IntRect& _destRect, IntRect& _result, float _current_time)\n
 			@param _startRect start coordinate of widget
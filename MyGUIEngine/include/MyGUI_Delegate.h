@@ -9,9 +9,11 @@
 
 #include "MyGUI_Diagnostic.h"
 #include "MyGUI_Any.h"
-#include <list>
-
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <typeinfo>
+#include <vector>
 
 namespace MyGUI
 {
@@ -37,6 +39,13 @@ namespace delegates
 		IDelegateUnlink* m_baseDelegateUnlink;
 	};
 
+	// tag for newDelegate overloads that return delegate by value, multi delegate keeps it without allocation
+	struct ByValue { };
+	const ByValue byValue = ByValue();
+
+	template <typename ...Args>
+	class MultiDelegate;
+
 	template <typename ...Args>
 	class DelegateFunction
 	{
@@ -44,39 +53,89 @@ namespace delegates
 		using Function = std::function<void(Args...)>;
 
 		// function or static class method
-		DelegateFunction(Function _function, Any _functionPointer) :
-			mFunction(_function),
-			mFunctionPointer(_functionPointer)
+		DelegateFunction(void (*_function)(Args...)) :
+			mInvoke(&invokeFunction),
+			mType(&typeid(_function))
 		{
+			setStorage(_function);
 		}
 
 		// non-static class method
-		DelegateFunction(Function _function, Any _functionPointer, const IDelegateUnlink* _object) :
-			mFunction(_function),
-			mUnlink(_object),
-			mObject(_object),
-			mFunctionPointer(_functionPointer)
+		template <typename T, typename Method>
+		DelegateFunction(T* _object, Method _method) :
+			mInvoke(&invokeMethod<T, Method>),
+			mType(&typeid(Method)),
+			mUnlink(getUnlink(_object)),
+			mObject(_object)
 		{
+			setStorage(_method);
 		}
 
-		// non-static class method
-		DelegateFunction(Function _function, Any _functionPointer, const void* _object) :
-			mFunction(_function),
-			mUnlink(nullptr),
-			mObject(_object),
-			mFunctionPointer(_functionPointer)
+		// std::function, compared by id
+		DelegateFunction(const Function& _function, int64_t _delegateId) :
+			mInvoke(&invokeStdFunction),
+			mType(&typeid(Function)),
+			mFunction(new Function(_function))
 		{
+			setStorage(_delegateId);
+		}
+
+		DelegateFunction(const DelegateFunction& _other) :
+			mInvoke(_other.mInvoke),
+			mType(_other.mType),
+			mUnlink(_other.mUnlink),
+			mObject(_other.mObject),
+			mFunction(_other.mFunction != nullptr ? new Function(*_other.mFunction) : nullptr),
+			mStorage(_other.mStorage)
+		{
+		}
+
+		// moved delegate keeps std::function at the same address, so it could be moved while invoked
+		DelegateFunction(DelegateFunction&& _other) noexcept :
+			mInvoke(_other.mInvoke),
+			mType(_other.mType),
+			mUnlink(_other.mUnlink),
+			mObject(_other.mObject),
+			mFunction(_other.mFunction),
+			mStorage(_other.mStorage)
+		{
+			_other.mFunction = nullptr;
+		}
+
+		DelegateFunction& operator=(DelegateFunction _other) noexcept
+		{
+			std::swap(mInvoke, _other.mInvoke);
+			std::swap(mType, _other.mType);
+			std::swap(mUnlink, _other.mUnlink);
+			std::swap(mObject, _other.mObject);
+			std::swap(mFunction, _other.mFunction);
+			std::swap(mStorage, _other.mStorage);
+			return *this;
+		}
+
+		~DelegateFunction()
+		{
+			delete mFunction;
 		}
 
 		void invoke(Args... args)
 		{
-			mFunction(args...);
+			mInvoke(this, args...);
 		}
 
 		bool compare(DelegateFunction<Args...>* _delegate) const
 		{
 			if (nullptr == _delegate) return false;
-			return _delegate->mObject == mObject && _delegate->mFunctionPointer.compare(mFunctionPointer);
+			return compare(*_delegate);
+		}
+
+		bool compare(const DelegateFunction<Args...>& _delegate) const
+		{
+			// invoke thunk is instantiated in every module, so it is not compared,
+			// otherwise delegate created in plugin would never match one created in engine
+			return *_delegate.mType == *mType &&
+				_delegate.mObject == mObject &&
+				memcmp(_delegate.mStorage.data, mStorage.data, sizeof(mStorage.data)) == 0;
 		}
 
 		bool compare(IDelegateUnlink* _unlink) const
@@ -85,11 +144,81 @@ namespace delegates
 		}
 
 	private:
-		Function mFunction;
+		friend class MultiDelegate<Args...>;
+
+		// removed from multi delegate, but kept until it is not invoked anymore
+		bool isRemoved() const
+		{
+			return mInvoke == nullptr;
+		}
+
+		void remove()
+		{
+			mInvoke = nullptr;
+		}
 
-        const IDelegateUnlink* mUnlink = nullptr;
+		using Invoke = void (*)(DelegateFunction*, Args...);
+
+		// member function pointers are up to four pointers big, depending on compiler and class inheritance
+		// (MSVC uses 16 bytes in 32 bit builds for classes with unknown inheritance)
+		union Storage
+		{
+			void* pointer;
+			unsigned char data[sizeof(void*) * 4];
+		};
+
+		template <typename Value>
+		void setStorage(const Value& _value)
+		{
+			static_assert(sizeof(Value) <= sizeof(Storage), "Delegate function is too big");
+			// unused bytes are compared too
+			memset(mStorage.data, 0, sizeof(mStorage.data));
+			memcpy(mStorage.data, &_value, sizeof(Value));
+		}
+
+		template <typename Value>
+		Value getStorage() const
+		{
+			Value value;
+			memcpy(&value, mStorage.data, sizeof(Value));
+			return value;
+		}
+
+		static const IDelegateUnlink* getUnlink(const IDelegateUnlink* _object)
+		{
+			return _object;
+		}
+
+		static const IDelegateUnlink* getUnlink(const void* /*_object*/)
+		{
+			return nullptr;
+		}
+
+		static void invokeFunction(DelegateFunction* _delegate, Args... args)
+		{
+			_delegate->getStorage<void (*)(Args...)>()(std::forward<Args>(args)...);
+		}
+
+		template <typename T, typename Method>
+		static void invokeMethod(DelegateFunction* _delegate, Args... args)
+		{
+			T* object = static_cast<T*>(const_cast<void*>(_delegate->mObject));
+			(object->*_delegate->getStorage<Method>())(std::forward<Args>(args)...);
+		}
+
+		static void invokeStdFunction(DelegateFunction* _delegate, Args... args)
+		{
+			(*_delegate->mFunction)(std::forward<Args>(args)...);
+		}
+
+	private:
+		// function, method and object are kept inline, only std::function is allocated
+		Invoke mInvoke;
+		const std::type_info* mType;
+		const IDelegateUnlink* mUnlink = nullptr;
 		const void* mObject = nullptr;
-		Any mFunctionPointer;
+		Function* mFunction = nullptr;
+		Storage mStorage;
 	};
 
 } // namespace delegates
@@ -98,25 +227,19 @@ namespace delegates
 template <typename ...Args>
 inline delegates::DelegateFunction<Args...>* newDelegate(void(*_func)(Args... args))
 {
-	return new delegates::DelegateFunction<Args...>(_func, _func);
+	return new delegates::DelegateFunction<Args...>(_func);
 }
 
 // Creates delegate from a non-static class method
 template <typename T, typename ...Args>
 inline delegates::DelegateFunction<Args...>* newDelegate(T* _object, void (T::*_method)(Args... args))
 {
-	return new delegates::DelegateFunction<Args...>(
-		[=](Args&&... args) { return (_object->*_method)(std::forward<decltype(args)>(args)...); },
-		_method,
-		_object);
+	return new delegates::DelegateFunction<Args...>(_object, _method);
 }
 template <typename T, typename ...Args>
 inline delegates::DelegateFunction<Args...>* newDelegate(const T* _object, void (T::*_method)(Args... args) const)
 {
-    return new delegates::DelegateFunction<Args...>(
-        [=](Args&&... args) { return (_object->*_method)(std::forward<decltype(args)>(args)...); },
-        _method,
-        _object);
+	return new delegates::DelegateFunction<Args...>(_object, _method);
 }
 
 // Creates delegate from std::function
@@ -128,6 +251,28 @@ inline delegates::DelegateFunction<Args...>* newDelegate(const std::function<voi
 	return new delegates::DelegateFunction<Args...>(_function, delegateId);
 }
 
+// Same as above, but delegate is returned by value, for MultiDelegate operator+= and operator-=
+template <typename ...Args>
+inline delegates::DelegateFunction<Args...> newDelegate(delegates::ByValue, void(*_func)(Args... args))
+{
+	return delegates::DelegateFunction<Args...>(_func);
+}
+template <typename T, typename ...Args>
+inline delegates::DelegateFunction<Args...> newDelegate(delegates::ByValue, T* _object, void (T::*_method)(Args... args))
+{
+	return delegates::DelegateFunction<Args...>(_object, _method);
+}
+template <typename T, typename ...Args>
+inline delegates::DelegateFunction<Args...> newDelegate(delegates::ByValue, const T* _object, void (T::*_method)(Args... args) const)
+{
+	return delegates::DelegateFunction<Args...>(_object, _method);
+}
+template <typename ...Args>
+inline delegates::DelegateFunction<Args...> newDelegate(delegates::ByValue, const std::function<void(Args...)>& _function, int64_t delegateId)
+{
+	return delegates::DelegateFunction<Args...>(_function, delegateId);
+}
+
 namespace delegates
 {
 
@@ -200,9 +345,15 @@ namespace delegates
 	{
 	public:
 		using IDelegate = DelegateFunction<Args...>;
-		using ListDelegate = typename std::list<IDelegate*>;
+		// delegates are kept by value, removed ones stay in place until outermost call is finished
+		using VectorDelegate = typename std::vector<IDelegate>;
+
+		MultiDelegate() :
+			mInvokeDepth(0),
+			mNeedCompaction(false)
+		{
+		}
 
-		MultiDelegate() { }
 		~MultiDelegate()
 		{
 			clear();
@@ -210,100 +361,115 @@ namespace delegates
 
 		bool empty() const
 		{
-			for (const auto& delegate : mListDelegates)
+			for (const auto& delegate : mDelegates)
 			{
-				if (delegate) return false;
+				if (!delegate.isRemoved()) return false;
 			}
 			return true;
 		}
 
 		void clear()
 		{
-			for (auto iter = mListDelegates.begin(); iter != mListDelegates.end(); ++iter)
+			for (auto iter = mDelegates.begin(); iter != mDelegates.end(); ++iter)
 			{
-				if (*iter)
+				if (!iter->isRemoved())
 				{
-					delete (*iter);
-					(*iter) = nullptr;
+					iter->remove();
+					mNeedCompaction = true;
 				}
 			}
+			compact();
 		}
 
 		void clear(IDelegateUnlink* _unlink)
 		{
-			for (auto iter = mListDelegates.begin(); iter != mListDelegates.end(); ++iter)
+			for (auto iter = mDelegates.begin(); iter != mDelegates.end(); ++iter)
 			{
-				if ((*iter) && (*iter)->compare(_unlink))
+				if (!iter->isRemoved() && iter->compare(_unlink))
 				{
-					delete (*iter);
-					(*iter) = nullptr;
+					iter->remove();
+					mNeedCompaction = true;
 				}
 			}
+			compact();
 		}
 
+		// delegate is moved into multi delegate and deleted
 		void operator+=(IDelegate* _delegate)
 		{
-			for (auto iter = mListDelegates.begin(); iter != mListDelegates.end(); ++iter)
+			if (_delegate == nullptr) return;
+			IDelegate delegate(std::move(*_delegate));
+			delete _delegate;
+			*this += std::move(delegate);
+		}
+
+		void operator+=(IDelegate&& _delegate)
+		{
+			for (auto iter = mDelegates.begin(); iter != mDelegates.end(); ++iter)
 			{
-				if ((*iter) && (*iter)->compare(_delegate))
+				if (!iter->isRemoved() && iter->compare(_delegate))
 				{
 					MYGUI_EXCEPT("Trying to add same delegate twice.");
 				}
 			}
-			mListDelegates.push_back(_delegate);
+			mDelegates.push_back(std::move(_delegate));
 		}
 
 		void operator-=(IDelegate* _delegate)
 		{
-			for (auto iter = mListDelegates.begin(); iter != mListDelegates.end(); ++iter)
+			if (_delegate == nullptr) return;
+			*this -= *_delegate;
+			delete _delegate;
+		}
+
+		void operator-=(const IDelegate& _delegate)
+		{
+			for (auto iter = mDelegates.begin(); iter != mDelegates.end(); ++iter)
 			{
-				if ((*iter) && (*iter)->compare(_delegate))
+				if (!iter->isRemoved() && iter->compare(_delegate))
 				{
-					if ((*iter) != _delegate) delete (*iter);
-					(*iter) = nullptr;
+					iter->remove();
+					mNeedCompaction = true;
 					break;
 				}
 			}
-			delete _delegate;
+			compact();
 		}
 
 		void operator()(Args... args) const
 		{
-			auto iter = mListDelegates.begin();
-			while (iter != mListDelegates.end())
+			// delegates added by handlers are invoked in the same call,
+			// removed ones are only marked until outermost call is finished
+			InvokeScope scope(*this);
+			for (size_t index = 0; index < mDelegates.size(); ++index)
 			{
-				if (nullptr == (*iter))
-				{
-					iter = mListDelegates.erase(iter);
-				}
-				else
-				{
-					(*iter)->invoke(args...);
-					++iter;
-				}
+				IDelegate& delegate = mDelegates[index];
+				if (!delegate.isRemoved())
+					delegate.invoke(args...);
 			}
 		}
 
-		MultiDelegate(const MultiDelegate& _event)
+		MultiDelegate(const MultiDelegate& _event) :
+			mInvokeDepth(0),
+			mNeedCompaction(true)
 		{
 			// take ownership
-			ListDelegate del = _event.mListDelegates;
-			const_cast<MultiDelegate&>(_event).mListDelegates.clear();
-
-			safe_clear(del);
-
-			mListDelegates = del;
+			mDelegates.swap(const_cast<MultiDelegate&>(_event).mDelegates);
+			compact();
 		}
 
 		MultiDelegate& operator=(const MultiDelegate& _event)
 		{
-			// take ownership
-			ListDelegate del = _event.mListDelegates;
-			const_cast<MultiDelegate&>(_event).mListDelegates.clear();
+			if (this == &_event)
+				return *this;
 
-			safe_clear(del);
+			// take ownership
+			VectorDelegate del;
+			del.swap(const_cast<MultiDelegate&>(_event).mDelegates);
 
-			mListDelegates = del;
+			mDelegates.swap(del);
+			mNeedCompaction = true;
+			compact();
 
 			return *this;
 		}
@@ -317,34 +483,42 @@ namespace delegates
 		}
 
 	private:
-		void safe_clear(ListDelegate& _delegates)
+		struct InvokeScope
 		{
-			for (auto iter = mListDelegates.begin(); iter != mListDelegates.end(); ++iter)
+			InvokeScope(const MultiDelegate& _owner) :
+				owner(_owner)
 			{
-				if (*iter)
-				{
-					IDelegate* del = (*iter);
-					(*iter) = nullptr;
-					delete_is_not_found(del, _delegates);
-				}
+				owner.mInvokeDepth ++;
 			}
-		}
 
-		void delete_is_not_found(IDelegate* _del, ListDelegate& _delegates)
-		{
-			for (auto iter = _delegates.begin(); iter != _delegates.end(); ++iter)
+			~InvokeScope()
 			{
-				if ((*iter) && (*iter)->compare(_del))
-				{
-					return;
-				}
+				owner.mInvokeDepth --;
+				owner.compact();
 			}
 
-			delete _del;
+			const MultiDelegate& owner;
+		};
+
+		static bool isRemoved(const IDelegate& _delegate)
+		{
+			return _delegate.isRemoved();
+		}
+
+		// remove empty slots, unless they are being iterated
+		void compact() const
+		{
+			if (mInvokeDepth != 0 || !mNeedCompaction)
+				return;
+
+			mDelegates.erase(std::remove_if(mDelegates.begin(), mDelegates.end(), isRemoved), mDelegates.end());
+			mNeedCompaction = false;
 		}
 
 	private:
-		mutable ListDelegate mListDelegates;
+		mutable VectorDelegate mDelegates;
+		mutable unsigned int mInvokeDepth;
+		mutable bool mNeedCompaction;
 	};
 
 //#ifndef MYGUI_DONT_USE_OBSOLETE // TODO
@@ -323,6 +323,14 @@ namespace MyGUI
 
 		void setRealString(const UString& _caption);
 
+		// text with tags for editing in place, unlockRealString must be called after modification
+		TextBuffer& lockRealString();
+		// [_start, _start + _erased) of locked text was replaced by _inserted characters
+		void notifyRealStringChange(size_t _start, size_t _erased, size_t _inserted);
+		void unlockRealString();
+		// notifies range changed by _iterator over locked text and unlocks it
+		void unlockRealString(const TextIterator& _iterator);
+
 		void updateCursorPosition();
 
 		// размер данных
@@ -373,6 +381,8 @@ namespace MyGUI
 
 		// настоящий текст, закрытый за звездочками
 		UString mPasswordText;
+		// copy of text when it can't be edited in place
+		TextBuffer mRealStringBuffer;
 
 		// для поддержки режима статик, где курсор не нужен
 		std::string mOriginalPointer;
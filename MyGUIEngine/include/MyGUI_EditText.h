@@ -15,6 +15,7 @@
 #include "MyGUI_ResourceSkin.h"
 #include "MyGUI_RenderFormat.h"
 #include "MyGUI_TextView.h"
+#include "MyGUI_GlyphBatch.h"
 #include "MyGUI_VertexData.h"
 
 namespace MyGUI
@@ -41,6 +42,9 @@ namespace MyGUI
 		void setCaption(const UString& _value) override;
 		const UString& getCaption() const override;
 
+		TextBuffer* _getTextBuffer() override;
+		void _notifyCaptionChanged(size_t _start, size_t _erased, size_t _inserted) override;
+
 		void setTextColour(const Colour& _value)override;
 		const Colour& getTextColour() const override;
 
@@ -108,29 +112,23 @@ namespace MyGUI
 
 		void _setAlign(const IntSize& _oldsize) override;
 
+		void _prepareRender() override;
+
 		virtual const VectorLineInfo& getLineInfo() const;
 
+		/** Tessellate only lines that intersect the view, enabled by default.
+			When disabled every line is tessellated and clipped, rendered vertices are the same.
+		*/
+		void setVisibleLinesOnly(bool _value);
+		bool getVisibleLinesOnly() const;
+
 	private:
 		void _setTextColour(const Colour& _value);
 		void checkVertexSize();
+		// lines that intersect view, [_first, _last)
+		void getVisibleLines(size_t& _first, size_t& _last) const;
 		unsigned int getMixedNativeAlpha(float secondAlpha) const;
 
-		void drawQuad(
-			Vertex*& _vertex,
-			size_t& _vertexCount,
-			const FloatRect& _vertexRect,
-			float _vertexZ,
-			const FloatRect& _textureRect,
-			uint32 _colour) const;
-
-		void drawGlyph(
-			const RenderTargetInfo& renderTargetInfo,
-			Vertex*& _vertex,
-			size_t& _vertexCount,
-			FloatRect _vertexRect,
-			FloatRect _textureRect,
-			uint32 _colour) const;
-
 	protected:
 		bool mEmptyView;
 		uint32 mCurrentColourNative;
@@ -138,8 +136,10 @@ namespace MyGUI
 		uint32 mShadowColourNative;
 		IntCoord mCurrentCoord;
 
-		UString mCaption;
-		UString::utf32string mUtf32Caption;
+		// rebuilt from mTextBuffer on demand after editing in place
+		mutable UString mCaption;
+		mutable bool mCaptionOutDate;
+		TextBuffer mTextBuffer;
 		mutable bool mTextOutDate;
 		Align mTextAlign;
 
@@ -151,6 +151,7 @@ namespace MyGUI
 		IFont* mFont;
 		ITexture* mTexture;
 		int mFontHeight;
+		mutable size_t mFontTextureVersion;
 
 		bool mBackgroundNormal;
 		size_t mStartSelect;
@@ -159,6 +160,7 @@ namespace MyGUI
 		bool mVisibleCursor;
 		bool mInvertSelect;
 		bool mShadow;
+		bool mVisibleLinesOnly;
 
 		IntPoint mViewOffset; // смещение текста
 
@@ -173,6 +175,7 @@ namespace MyGUI
 		int mOldWidth;
 
 		mutable TextView mTextView;
+		GlyphBatch mGlyphBatch;
 	};
 
 } // namespace MyGUI
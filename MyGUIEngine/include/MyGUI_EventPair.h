@@ -46,6 +46,12 @@ namespace MyGUI
 			m_event += _delegate;
 		}
 
+		void operator += (typename Event::IDelegate&& _delegate)
+		{
+			m_eventObsolete.clear();
+			m_event += std::move(_delegate);
+		}
+
 		template <typename T>
 		MYGUI_OBSOLETE("use : signature : Event::IDelegate * _delegate")
 		void operator -= (T* _delegate)
@@ -60,6 +66,12 @@ namespace MyGUI
 			m_event -= _delegate;
 		}
 
+		void operator -= (const typename Event::IDelegate& _delegate)
+		{
+			m_eventObsolete.clear();
+			m_event -= _delegate;
+		}
+
 		template <typename TP1>
 		void operator()( TP1 p1 )
 		{
@@ -160,6 +172,12 @@ namespace MyGUI
 			m_event += _delegate;
 		}
 
+		void operator += (typename Event::IDelegate&& _delegate)
+		{
+			m_eventObsolete.clear();
+			m_event += std::move(_delegate);
+		}
+
 		template <typename T>
 		MYGUI_OBSOLETE("use : signature : Event::IDelegate * _delegate")
 		void operator -= (T* _delegate)
@@ -174,6 +192,12 @@ namespace MyGUI
 			m_event -= _delegate;
 		}
 
+		void operator -= (const typename Event::IDelegate& _delegate)
+		{
+			m_eventObsolete.clear();
+			m_event -= _delegate;
+		}
+
 		// 1 to 2
 		template <typename TP1, typename TP2>
 		void operator()( TP1 p1, TP2 p2 )
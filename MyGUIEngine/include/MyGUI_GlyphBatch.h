@@ -0,0 +1,54 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_GLYPH_BATCH_H_
+#define MYGUI_GLYPH_BATCH_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_Types.h"
+#include "MyGUI_VertexData.h"
+#include "MyGUI_RenderTargetInfo.h"
+
+namespace MyGUI
+{
+
+	/** Quads of text collected during one doRender, clipped and converted to vertices all at once.
+		Uses SSE2 when it is available, results are the same as with scalar code.
+	*/
+	class MYGUI_EXPORT GlyphBatch
+	{
+	public:
+		void clear();
+
+		// _vertexRect in pixels relative to cropped parent
+		void add(const FloatRect& _vertexRect, const FloatRect& _textureRect, uint32 _colour);
+
+		size_t size() const;
+
+		/** Clip quads by _clip, move them by _left and _top to render target pixels and write to _vertex as IndexedVertexQuad.
+			Quads that are clipped away are skipped.
+			@return Count of written vertices
+		*/
+		size_t write(Vertex* _vertex, const FloatRect& _clip, float _left, float _top, float _z, const RenderTargetInfo& _info) const;
+
+		/** Same as write, but always with scalar code. Reference for SIMD results. */
+		size_t writeScalar(Vertex* _vertex, const FloatRect& _clip, float _left, float _top, float _z, const RenderTargetInfo& _info) const;
+
+	private:
+		struct Quad
+		{
+			FloatRect vertex;
+			FloatRect texture;
+			uint32 colour;
+		};
+		typedef std::vector<Quad> VectorQuad;
+
+		VectorQuad mQuads;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_GLYPH_BATCH_H_
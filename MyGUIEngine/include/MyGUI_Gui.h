@@ -186,6 +186,7 @@ namespace MyGUI
 		ResourceManager* mResourceManager;
 		FactoryManager* mFactoryManager;
 		ToolTipManager* mToolTipManager;
+		TextureAtlasManager* mTextureAtlasManager;
 
 		bool mIsInitialise;
 	};
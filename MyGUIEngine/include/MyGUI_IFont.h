@@ -31,6 +31,14 @@ namespace MyGUI
 		virtual ITexture* getTextureFont() const = 0;
 
 		virtual int getDefaultHeight() const = 0;
+
+		/** Changes each time texture coordinates of already returned glyphs change,
+			text that keeps copies of glyph info has to be rebuilt after that.
+		*/
+		virtual size_t getTextureVersion() const
+		{
+			return 0;
+		}
 	};
 
 } // namespace MyGUI
@@ -21,6 +21,7 @@ namespace MyGUI
 	class ILayerNode;
 
 	class RenderItem;
+	class ISubWidget;
 
 	typedef std::vector<ILayerNode*> VectorILayerNode;
 	typedef Enumerator<VectorILayerNode> EnumeratorILayerNode;
@@ -61,6 +62,11 @@ namespace MyGUI
 		virtual RenderItem* addToRenderItem(ITexture* _texture, bool _firstQueue, bool _separate) = 0;
 		// необходимо обновление нода
 		virtual void outOfDate(RenderItem* _item) = 0;
+		// необходимо обновление только одного саб виджета из рендер айтема
+		virtual void outOfDate(RenderItem* _item, ISubWidget* /*_subItem*/)
+		{
+			outOfDate(_item);
+		}
 
 		// возвращает виджет по позиции
 		virtual ILayerItem* getLayerItemByPoint(int _left, int _top) const = 0;
@@ -0,0 +1,36 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_I_LIST_BOX_DATA_SOURCE_H_
+#define MYGUI_I_LIST_BOX_DATA_SOURCE_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_UString.h"
+
+namespace MyGUI
+{
+
+	/** Rows of ListBox or MultiListBox in virtual mode.
+		Widget doesn't keep rows itself, it asks for count of rows and for text of visible lines only.
+		Call updateDataSource of widget when rows are changed.
+	*/
+	class MYGUI_EXPORT IListBoxDataSource
+	{
+	public:
+		virtual ~IListBoxDataSource() = default;
+
+		virtual size_t getItemCount() const = 0;
+
+		/** Get text of cell, _column is 0 for ListBox. */
+		virtual UString getItemNameAt(size_t _index, size_t _column) const = 0;
+
+		/** Called by MultiListBox when user sorts rows by column, rows stay unchanged by default. */
+		virtual void sortItems(size_t /*_column*/, bool /*_ascending*/) { }
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_I_LIST_BOX_DATA_SOURCE_H_
@@ -14,6 +14,7 @@
 #include "MyGUI_IRenderTarget.h"
 #include "MyGUI_IStateInfo.h"
 #include "MyGUI_IObject.h"
+#include "MyGUI_WidgetAllocator.h"
 
 namespace MyGUI
 {
@@ -30,6 +31,16 @@ namespace MyGUI
 	public:
 		ISubWidget() : mVisible(true) { }
 
+		// sub widgets are allocated together with their widgets
+		static void* operator new(size_t _size)
+		{
+			return WidgetAllocator::allocate(_size);
+		}
+		static void operator delete(void* _pointer)
+		{
+			WidgetAllocator::deallocate(_pointer);
+		}
+
 		virtual void createDrawItem(ITexture* _texture, ILayerNode* _node) = 0;
 		virtual void destroyDrawItem() = 0;
 
@@ -38,6 +49,8 @@ namespace MyGUI
 		virtual void setStateData(IStateInfo* /*_data*/) { }
 
 		virtual void doRender() = 0;
+		// called before doRender, the only moment when item can ask render item for more vertices
+		virtual void _prepareRender() { }
 
 		virtual void setAlign(Align _value)
 		{
@@ -11,6 +11,7 @@
 #include "MyGUI_ISubWidget.h"
 #include "MyGUI_Colour.h"
 #include "MyGUI_Constants.h"
+#include "MyGUI_TextBuffer.h"
 
 namespace MyGUI
 {
@@ -124,6 +125,16 @@ namespace MyGUI
 			return Constants::getEmptyUString();
 		}
 
+		// caption with tags for editing in place, nullptr if not supported
+		// _notifyCaptionChanged must be called after caption was modified
+		virtual TextBuffer* _getTextBuffer()
+		{
+			return nullptr;
+		}
+		// [_start, _start + _erased) of caption was replaced by _inserted characters,
+		// might be called several times for one modification
+		virtual void _notifyCaptionChanged(size_t /*_start*/, size_t /*_erased*/, size_t /*_inserted*/) { }
+
 		virtual void setTextColour(const Colour& /*_value*/) { }
 		virtual const Colour& getTextColour() const
 		{
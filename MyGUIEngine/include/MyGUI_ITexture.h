@@ -10,6 +10,7 @@
 #include "MyGUI_Prerequest.h"
 #include "MyGUI_IRenderTarget.h"
 #include "MyGUI_RenderFormat.h"
+#include "MyGUI_Types.h"
 #include <string>
 
 namespace MyGUI
@@ -44,6 +45,17 @@ namespace MyGUI
 		virtual void unlock() = 0;
 		virtual bool isLocked() const = 0;
 
+		/** Write pixels to part of texture without touching the rest of it.
+			@param _coord Updated area of texture.
+			@param _data Pixels in texture format.
+			@param _rowPitch Size of one row of _data in bytes.
+			@return false if not supported, lock whole texture instead in this case.
+		*/
+		virtual bool updateRect(const IntCoord& /*_coord*/, const void* /*_data*/, size_t /*_rowPitch*/)
+		{
+			return false;
+		}
+
 		virtual int getWidth() const = 0;
 		virtual int getHeight() const = 0;
 
@@ -23,6 +23,53 @@ namespace MyGUI
 
 		virtual Vertex* lock() = 0;
 		virtual void unlock() = 0;
+
+		/** Lock vertices in range [_start, _start + _count) without discarding the rest of the buffer.
+			Must be followed by unlock().
+			@return nullptr if buffer doesn't support partial update, in this case whole buffer must be locked
+		*/
+		virtual Vertex* lockRange(size_t /*_start*/, size_t /*_count*/)
+		{
+			return nullptr;
+		}
+
+		/** Ask buffer to keep quads as IndexedVertexQuad, render target draws them with shared quad index buffer.
+			Buffer that doesn't support it ignores the call and keeps triangle list, check getIndexedQuads after.
+		*/
+		virtual void setIndexedQuads(bool /*_value*/) { }
+		/** @return true if vertices are IndexedVertexQuad, count passed to IRenderTarget::doRender is count of vertices either way */
+		virtual bool getIndexedQuads() const
+		{
+			return false;
+		}
+
+		/** Ask buffer to keep vertices in _value layout, lock and lockRange return CompactVertex memory for VertexLayout::Compact
+			and vertex counts are counts of CompactVertex. Buffer that doesn't support it ignores the call, check getVertexLayout after.
+			Buffer that supports VertexLayout::Compact must support setPositionTransform too, compact positions are mapped by it
+			after division by CompactVertex::PositionScale.
+		*/
+		virtual void setVertexLayout(VertexLayout /*_value*/) { }
+		virtual VertexLayout getVertexLayout() const
+		{
+			return VertexLayout::Float;
+		}
+
+		/** Ask buffer to map vertex positions when it is drawn, position * _scale + _offset is position in render target.
+			Render target that supports it applies it on GPU, so vertices don't have to be changed when only the mapping changes.
+			@return false if buffer doesn't support it, vertices must be in render target space then
+		*/
+		virtual bool setPositionTransform(const FloatPoint& /*_scale*/, const FloatPoint& /*_offset*/)
+		{
+			return false;
+		}
+		virtual FloatPoint getPositionScale() const
+		{
+			return FloatPoint(1, 1);
+		}
+		virtual FloatPoint getPositionOffset() const
+		{
+			return FloatPoint();
+		}
 	};
 
 } // namespace MyGUI
@@ -58,6 +58,7 @@ namespace MyGUI
 		RenderItem* addToRenderItem(ITexture* _texture, bool _firstQueue, bool _manualRender) override;
 		// необходимо обновление нода
 		void outOfDate(RenderItem* _item) override;
+		void outOfDate(RenderItem* _item, ISubWidget* _subItem) override;
 
 		// возвращает виджет по позиции
 		ILayerItem* getLayerItemByPoint(int _left, int _top) const override;
@@ -71,9 +72,14 @@ namespace MyGUI
 
 		bool isOutOfDate() const;
 
+		/** Keep vertices in pixels relative to root item of node, see RenderItem::setPixelSpace */
+		void setPixelSpace(bool _value);
+		bool getPixelSpace() const;
+
 	protected:
 		// push all empty buffers to the end of buffers list
 		void updateCompression();
+		RenderItem* createRenderItem(ITexture* _texture, bool _manualRender);
 		RenderItem* addToRenderItemFirstQueue(ITexture* _texture, bool _manualRender);
 		RenderItem* addToRenderItemSecondQueue(ITexture* _texture, bool _manualRender);
 	protected:
@@ -96,6 +102,7 @@ namespace MyGUI
 		bool mOutOfDate;
 		bool mOutOfDateCompression;
 		float mDepth;
+		bool mPixelSpace;
 	};
 
 } // namespace MyGUI
@@ -14,6 +14,7 @@
 #include "MyGUI_IItem.h"
 #include "MyGUI_IItemContainer.h"
 #include "MyGUI_IBItemInfo.h"
+#include "MyGUI_IListBoxDataSource.h"
 
 namespace MyGUI
 {
@@ -60,10 +61,31 @@ namespace MyGUI
 		void swapItemsAt(size_t _index1, size_t _index2);
 
 
-		//! Search item, returns the position of the first occurrence in array or ITEM_NONE if item not found
+		//! Search item, returns the position of the first occurrence in array or ITEM_NONE if item not found or list is in virtual mode
 		size_t findItemIndexWith(const UString& _name);
 		//@}
 
+		//------------------------------------------------------------------------------//
+		// virtual mode
+
+		/** @name Virtual Mode Methods
+			Methods used to show rows of data source instead of items.
+		*/
+		//@{
+		/** Show rows of _source instead of items, all items are removed. nullptr returns list to normal mode.
+			Items can't be inserted, changed or removed in virtual mode and they have no names or data,
+			only text of visible lines is requested from _source.
+		*/
+		void setDataSource(IListBoxDataSource* _source);
+		/** Get data source or nullptr if list is not in virtual mode */
+		IListBoxDataSource* getDataSource() const;
+
+		/** Read count of rows from data source again and redraw visible lines.
+			Selection is cleared if selected row doesn't exist any more.
+		*/
+		void updateDataSource();
+		//@}
+
 		//------------------------------------------------------------------------------//
 		// манипуляции выделениями
 
@@ -98,6 +120,7 @@ namespace MyGUI
 		template <typename ValueType>
 		ValueType* getItemDataAt(size_t _index, bool _throw = true) const
 		{
+			MYGUI_ASSERT(mDataSource == nullptr, "ListBox::getItemDataAt can't be used in virtual mode");
 			MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::getItemDataAt");
 			return mItemsInfo.at(_index).second.castType<ValueType>(_throw);
 		}
@@ -241,6 +264,10 @@ namespace MyGUI
 		// вспомогательные методы для составных списков
 		void _setItemFocus(size_t _position, bool _focus);
 		void _sendEventChangeScroll(size_t _position);
+		// reorder all items at once, item from position _order[N] is moved to position N
+		void _permuteItems(const std::vector<size_t>& _order);
+		// virtual mode for column of MultiListBox
+		void _setDataSource(IListBoxDataSource* _source, size_t _column);
 
 		// IItemContainer impl
 		size_t _getItemCount() const override;
@@ -297,6 +324,8 @@ namespace MyGUI
 
 		size_t getIndexByWidget(Widget* _widget) const;
 
+		void updateLineCaption(size_t _line, size_t _index);
+
 	private:
 		std::string mSkinLine;
 		ScrollBar* mWidgetScroll;
@@ -320,6 +349,11 @@ namespace MyGUI
 		typedef std::vector<PairItem> VectorItemInfo;
 		VectorItemInfo mItemsInfo;
 
+		// rows are taken from data source in virtual mode, mItemsInfo is empty then
+		IListBoxDataSource* mDataSource;
+		size_t mDataSourceColumn;
+		size_t mDataSourceCount;
+
 		// имеем ли мы фокус ввода
 		bool mNeedVisibleScroll;
 
@@ -183,6 +183,21 @@ namespace MyGUI
 		//! Swap items at a specified positions
 		void swapItemsAt(size_t _index1, size_t _index2);
 
+		//------------------------------------------------------------------------------//
+		// virtual mode
+
+		/** Show rows of _source instead of items, all items are removed. nullptr returns list to normal mode.
+			Items can't be inserted, changed or removed in virtual mode and they have no names or data,
+			only text of visible cells is requested from _source. Sorting by column is done by _source.
+		*/
+		void setDataSource(IListBoxDataSource* _source);
+		/** Get data source or nullptr if list is not in virtual mode */
+		IListBoxDataSource* getDataSource() const;
+
+		/** Read count of rows from data source again and redraw visible cells.
+			Selection is cleared if selected row doesn't exist any more.
+		*/
+		void updateDataSource();
 
 		//------------------------------------------------------------------------------//
 		// манипуляции отображением
@@ -255,6 +270,7 @@ namespace MyGUI
 		template <typename ValueType>
 		ValueType* getSubItemDataAt(size_t _column, size_t _index, bool _throw = true)
 		{
+			MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::getSubItemDataAt can't be used in virtual mode");
 			MYGUI_ASSERT_RANGE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::getSubItemDataAt");
 
 			size_t index = BiIndexBase::convertToBack(_index);
@@ -324,11 +340,17 @@ namespace MyGUI
 		bool compare(ListBox* _list, size_t _left, size_t _right);
 		void sortList();
 		void flipList();
+		void permuteItems(const std::vector<size_t>& _order);
+		void sortDataSource();
 
 		Widget* getOrCreateSeparator(size_t _index);
 
 		void updateBackSelected(size_t _index);
 
+		// rows are not reordered by list in virtual mode, so indexes are the same for user and columns
+		size_t convertToBackIndex(size_t _index) const;
+		size_t convertToFaceIndex(size_t _index) const;
+
 		struct ColumnInfo
 		{
 			MultiListItem* item;
@@ -380,6 +402,8 @@ namespace MyGUI
 
 		bool mFrameAdvise;
 		Widget* mHeaderPlace;
+
+		IListBoxDataSource* mDataSource;
 	};
 
 } // namespace MyGUI
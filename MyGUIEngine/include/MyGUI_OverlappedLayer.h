@@ -27,6 +27,14 @@ namespace MyGUI
 
 		void setPick(bool _pick);
 
+		/** Use spatial index to pick between children of widgets with many children */
+		void setPickGrid(bool _value);
+		bool getPickGrid() const;
+
+		/** Keep vertices of root widgets in their own pixel space, so moving of root widget doesn't render its vertices again */
+		void setPixelSpace(bool _value);
+		bool getPixelSpace() const;
+
 		ILayerNode* createChildItemNode() override;
 		void destroyChildItemNode(ILayerNode* _node) override;
 
@@ -58,6 +66,8 @@ namespace MyGUI
 
 	protected:
 		bool mIsPick;
+		bool mPickGrid;
+		bool mPixelSpace;
 		VectorILayerNode mChildItems;
 		bool mOutOfDate;
 		IntSize mViewSize;
@@ -0,0 +1,63 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_PICK_GRID_H_
+#define MYGUI_PICK_GRID_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_Types.h"
+#include "MyGUI_WidgetDefines.h"
+
+namespace MyGUI
+{
+
+	/** Uniform grid over coordinates of child widgets used to speed up picking.
+		Grid only filters out widgets that can't contain point, all other pick checks
+		and their order stay on the caller side, so picking result is the same as without grid.
+	*/
+	class MYGUI_EXPORT PickGrid
+	{
+	public:
+		PickGrid();
+
+		/** Rebuild grid, index of widget in _items is used as its id */
+		void build(const VectorWidgetPtr& _items);
+		void clear();
+
+		/** Grid need to be rebuilt before next use */
+		void outOfDate();
+		bool isOutOfDate() const;
+
+		/** Update grid after widget coordinates changed */
+		void updateItem(Widget* _item);
+
+		/** Indices of items which coordinates may contain point, sorted in ascending order */
+		const std::vector<size_t>& getItemsByPoint(int _left, int _top) const;
+
+	private:
+		IntRect getCellRect(const IntCoord& _coord) const;
+		void addToCells(size_t _index, const IntRect& _cells);
+		void removeFromCells(size_t _index, const IntRect& _cells);
+
+	private:
+		typedef std::vector<size_t> VectorIndex;
+
+		bool mOutOfDate;
+		IntRect mBounds;
+		int mCellWidth;
+		int mCellHeight;
+		int mColumns;
+		int mRows;
+		std::vector<VectorIndex> mCells;
+		// cells occupied by each item
+		std::vector<IntRect> mItemCells;
+		std::map<Widget*, size_t> mItemIndexes;
+		VectorIndex mEmpty;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_PICK_GRID_H_
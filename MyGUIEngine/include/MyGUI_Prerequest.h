@@ -32,6 +32,8 @@ namespace MyGUI
 	class RenderManager;
 	class FactoryManager;
 	class ToolTipManager;
+	class TextureAtlasManager;
+	class PickGrid;
 
 	class Widget;
 	class Button;
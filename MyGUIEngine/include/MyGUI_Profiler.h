@@ -0,0 +1,155 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_PROFILER_H_
+#define MYGUI_PROFILER_H_
+
+#include "MyGUI_Prerequest.h"
+#include <chrono>
+#include <ostream>
+
+namespace MyGUI
+{
+
+	struct MYGUI_EXPORT ProfilerCounter
+	{
+		enum Enum
+		{
+			Batches, // doRender calls
+			Vertices, // vertices passed to doRender
+			TessellatedItems, // draw items that regenerated their vertices
+			VertexBufferLocks, // lock and lockRange calls
+			TextureSwitches, // batches with another texture than previous batch
+			GlyphMisses, // glyphs that were not ready in font texture
+			LayoutPasses, // text layout updates
+			MAX
+		};
+	};
+
+	/** Collects per frame counters and time spent in instrumented parts of MyGUI.
+		Instrumentation is compiled in only with MYGUI_ENABLE_PROFILER, otherwise all statistic stays zero.
+		Profiler is not thread safe, it must be used from the thread that renders gui.
+	*/
+	class MYGUI_EXPORT Profiler
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		struct SectionInfo
+		{
+			const char* name;
+			// milliseconds
+			double time;
+			size_t calls;
+		};
+		typedef std::vector<SectionInfo> VectorSectionInfo;
+
+		struct FrameInfo
+		{
+			size_t index;
+			// milliseconds
+			double time;
+			size_t counters[ProfilerCounter::MAX];
+			VectorSectionInfo sections;
+		};
+
+	public:
+		static Profiler& getInstance();
+
+		/** Finish current frame and start next one. Called from Gui::frameEvent. */
+		void nextFrame();
+
+		/** Statistic of last finished frame */
+		const FrameInfo& getLastFrame() const;
+		size_t getCounter(ProfilerCounter::Enum _counter) const;
+		/** Time in milliseconds spent in section during last frame */
+		double getSectionTime(const std::string& _name) const;
+
+		static const char* getCounterName(ProfilerCounter::Enum _counter);
+
+		/** Record every section call and frame counters for export */
+		void setCaptureEnabled(bool _value);
+		bool getCaptureEnabled() const;
+		void clearCapture();
+
+		/** Write recorded data in Chrome trace event format (chrome://tracing, Perfetto) */
+		void writeChromeTrace(std::ostream& _stream) const;
+		bool saveChromeTrace(const std::string& _filename) const;
+
+	/*internal:*/
+		void addCounter(ProfilerCounter::Enum _counter, size_t _value);
+		void addBatch(const void* _texture, size_t _vertexCount);
+		void addSection(const char* _name, Clock::time_point _start, Clock::time_point _end);
+
+	private:
+		Profiler();
+
+		void resetFrame(FrameInfo& _frame);
+
+	private:
+		struct CaptureSection
+		{
+			const char* name;
+			Clock::time_point start;
+			Clock::time_point end;
+		};
+
+		struct CaptureFrame
+		{
+			Clock::time_point start;
+			Clock::time_point end;
+			size_t counters[ProfilerCounter::MAX];
+		};
+
+		FrameInfo mCurrentFrame;
+		FrameInfo mLastFrame;
+		Clock::time_point mFrameStart;
+		const void* mLastTexture;
+
+		bool mCaptureEnabled;
+		Clock::time_point mCaptureStart;
+		std::vector<CaptureSection> mCaptureSections;
+		std::vector<CaptureFrame> mCaptureFrames;
+	};
+
+	/** Adds time between construction and destruction to profiler section, use MYGUI_PROFILE_SCOPE */
+	class ProfilerScope
+	{
+	public:
+		ProfilerScope(const char* _name) :
+			mName(_name),
+			mStart(Profiler::Clock::now())
+		{
+		}
+
+		~ProfilerScope()
+		{
+			Profiler::getInstance().addSection(mName, mStart, Profiler::Clock::now());
+		}
+
+	private:
+		const char* mName;
+		Profiler::Clock::time_point mStart;
+	};
+
+} // namespace MyGUI
+
+#ifdef MYGUI_ENABLE_PROFILER
+	#define MYGUI_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define MYGUI_PROFILE_CONCAT(a, b) MYGUI_PROFILE_CONCAT_IMPL(a, b)
+	// _name must be string literal or any other string that outlives profiler
+	#define MYGUI_PROFILE_SCOPE(_name) MyGUI::ProfilerScope MYGUI_PROFILE_CONCAT(profilerScope, __LINE__)(_name)
+	#define MYGUI_PROFILE_COUNTER(_counter, _value) MyGUI::Profiler::getInstance().addCounter(MyGUI::ProfilerCounter::_counter, _value)
+	#define MYGUI_PROFILE_BATCH(_texture, _vertexCount) MyGUI::Profiler::getInstance().addBatch(_texture, _vertexCount)
+	#define MYGUI_PROFILE_FRAME() MyGUI::Profiler::getInstance().nextFrame()
+#else
+	#define MYGUI_PROFILE_SCOPE(_name) ((void)0)
+	#define MYGUI_PROFILE_COUNTER(_counter, _value) ((void)0)
+	#define MYGUI_PROFILE_BATCH(_texture, _vertexCount) ((void)0)
+	#define MYGUI_PROFILE_FRAME() ((void)0)
+#endif
+
+#endif // MYGUI_PROFILER_H_
@@ -46,6 +46,54 @@ namespace MyGUI
 		Enum mValue;
 	};
 
+	struct MYGUI_EXPORT VertexLayout
+	{
+	public:
+		enum Enum
+		{
+			Float, // Vertex, 24 bytes
+			Compact, // CompactVertex, 12 bytes
+			MAX
+		};
+
+		VertexLayout(Enum _value = MAX) :
+			mValue(_value)
+		{
+		}
+
+		friend bool operator == (VertexLayout const& a, VertexLayout const& b)
+		{
+			return a.mValue == b.mValue;
+		}
+
+		friend bool operator != (VertexLayout const& a, VertexLayout const& b)
+		{
+			return a.mValue != b.mValue;
+		}
+
+		int getValue() const
+		{
+			return mValue;
+		}
+
+		size_t getVertexSize() const
+		{
+			switch (mValue)
+			{
+				case Float:
+					return 24;
+				case Compact:
+					return 12;
+				case MAX:
+					return 0;
+			}
+			return 0;
+		}
+
+	private:
+		Enum mValue;
+	};
+
 	struct MYGUI_EXPORT PixelFormat
 	{
 		enum Enum
@@ -16,7 +16,33 @@
 namespace MyGUI
 {
 
-	typedef std::pair<ISubWidget*, size_t> DrawItemInfo;
+	struct DrawItemInfo
+	{
+		DrawItemInfo(ISubWidget* _item, size_t _count, bool _quads) :
+			item(_item),
+			count(_count),
+			quads(_quads),
+			cacheOffset(0),
+			bufferOffset(0),
+			vertexCount(0),
+			bufferCount(0)
+		{
+		}
+
+		ISubWidget* item;
+		// reserved vertex count
+		size_t count;
+		// item writes IndexedVertexQuad instead of triangle list
+		bool quads;
+		// start of item's slot in vertex cache
+		size_t cacheOffset;
+		// start of item's vertices in vertex buffer
+		size_t bufferOffset;
+		// vertex count written by last doRender
+		size_t vertexCount;
+		// vertex count in vertex buffer, differs from vertexCount when quads are converted
+		size_t bufferCount;
+	};
 	typedef std::vector<DrawItemInfo> VectorDrawItem;
 
 	class MYGUI_EXPORT RenderItem
@@ -33,14 +59,21 @@ namespace MyGUI
 		void setManualRender(bool _value);
 		bool getManualRender() const;
 
-		void addDrawItem(ISubWidget* _item, size_t _count);
+		/** Reserve _count vertices for _item.
+			@param _quads item writes IndexedVertexQuad, otherwise triangle list.
+		*/
+		void addDrawItem(ISubWidget* _item, size_t _count, bool _quads = false);
 		void removeDrawItem(ISubWidget* _item);
 		void reallockDrawItem(ISubWidget* _item, size_t _count);
 
 		void outOfDate();
+		/** Mark only one draw item as out of date, other draw items will reuse their cached vertices */
+		void outOfDate(ISubWidget* _item);
 		bool isOutOfDate() const;
 
 		size_t getNeedVertexCount() const;
+		/** Draw items with zero reserved vertices are counted too */
+		bool hasDrawItems() const;
 		size_t getVertexCount() const;
 
 		bool getCurrentUpdate() const;
@@ -53,6 +86,54 @@ namespace MyGUI
 		void setNeedCompression(bool _compression);
 		bool getNeedCompression() const;
 
+		/** Sub widgets write vertices in pixels relative to origin of layer node,
+			they are mapped to render target by position transform of vertex buffer, or when copied to vertex buffer
+			if it doesn't support transform. Moving of the whole node only changes origin then and vertices are not rendered again.
+		*/
+		void setPixelSpace(bool _value);
+		bool getPixelSpace() const;
+
+		/** Set position of layer node origin in layer, used in pixel space mode */
+		void setPixelSpaceOrigin(const IntPoint& _value);
+
+	private:
+		// render target given to sub widgets in pixel space mode, its info maps pixels to vertices 1:1
+		class PixelSpaceTarget :
+			public IRenderTarget
+		{
+		public:
+			PixelSpaceTarget();
+
+			void begin() override;
+			void end() override;
+
+			void doRender(IVertexBuffer* _buffer, ITexture* _texture, size_t _count) override;
+
+			const RenderTargetInfo& getInfo() const override;
+
+			void setTarget(IRenderTarget* _target, const IntPoint& _origin);
+
+		private:
+			IRenderTarget* mTarget;
+			RenderTargetInfo mInfo;
+		};
+
+	private:
+		void updateAllDrawItems();
+		// _all copies all draw items to buffer, even unchanged
+		void updateOutOfDateDrawItems(bool _all);
+		void renderDrawItem(DrawItemInfo& _info);
+		// _buffer is locked memory starting from vertex _start, returns false if compact vertices can't keep positions
+		bool copyLockedDrawItems(Vertex* _buffer, size_t _start, size_t _end) const;
+		template <typename VertexType, typename Copy>
+		void copyDrawItems(VertexType* _buffer, size_t _start, size_t _end, Copy& _copy) const;
+		// locks whole buffer, falls back to float layout if compact vertices can't keep positions
+		bool copyAllDrawItems(size_t _count);
+		// returns true when vertices in buffer have to be mapped again
+		bool updateVertexTransform(const RenderTargetInfo& _info);
+		void setVertexLayout(VertexLayout _value);
+		size_t getBufferVertexCount(bool _quads, size_t _count) const;
+
 	private:
 #if MYGUI_DEBUG_MODE == 1
 		std::string mTextureName;
@@ -61,10 +142,22 @@ namespace MyGUI
 		ITexture* mTexture;
 
 		size_t mNeedVertexCount;
+		size_t mNeedBufferVertexCount;
+		// vertices are IndexedVertexQuad in vertex buffer
+		bool mIndexedQuads;
+		// vertices are CompactVertex in vertex buffer
+		bool mCompactVertices;
+		// vertex buffer maps positions when drawn, see IVertexBuffer::setPositionTransform
+		bool mPositionTransform;
 
 		bool mOutOfDate;
 		VectorDrawItem mDrawItems;
 
+		// draw items that need to be rendered again when the whole item is not out of date
+		VectorSubWidget mOutOfDateItems;
+		// last rendered vertices of all draw items, each item has its own slot of reserved size
+		std::vector<Vertex> mVertexCache;
+
 		// колличество отрендренных реально вершин
 		size_t mCountVertex;
 
@@ -77,6 +170,13 @@ namespace MyGUI
 
 		bool mNeedCompression;
 		bool mManualRender;
+
+		bool mPixelSpace;
+		IntPoint mPixelSpaceOrigin;
+		PixelSpaceTarget mPixelSpaceTarget;
+		// part of mapping to render target applied when cached vertices are copied to buffer, the rest is done by buffer
+		FloatPoint mCopyScale;
+		FloatPoint mCopyOffset;
 	};
 
 } // namespace MyGUI
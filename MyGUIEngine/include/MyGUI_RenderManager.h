@@ -45,6 +45,11 @@ namespace MyGUI
 		/** Get current vertex colour type */
 		virtual VertexColourType getVertexFormat() const = 0;
 
+		/** Get preferred layout of vertices, RenderItem asks its vertex buffers for it with IVertexBuffer::setVertexLayout.
+			VertexLayout::Float by default.
+		*/
+		virtual VertexLayout getVertexLayout() const;
+
 		/** Check if texture format supported by hardware */
 		virtual bool isFormatSupported(PixelFormat _format, TextureUsage _usage);
 
@@ -59,6 +64,11 @@ namespace MyGUI
 			const std::string& _vertexProgramFile,
 			const std::string& _fragmentProgramFile) = 0;
 
+		/** Rebuild vertices of all render items on next render.
+			Used when texture coordinates used by many widgets change, for example after font texture was repacked.
+		*/
+		void _forceUpdate();
+
 #if MYGUI_DEBUG_MODE == 1
 		/** Check if texture is valid */
 		virtual bool checkTexture(ITexture* _texture);
@@ -68,6 +78,9 @@ namespace MyGUI
 		virtual void onResizeView(const IntSize& _viewSize);
 		virtual void onRenderToTarget(IRenderTarget* _target, bool _update);
 		virtual void onFrameEvent(float _time);
+
+	private:
+		bool mForceUpdate;
 	};
 
 } // namespace MyGUI
@@ -48,6 +48,16 @@ namespace MyGUI
 		/** Unregister delegate that parse XML node with specified tag (_key) */
 		void unregisterLoadXmlDelegate(const std::string& _key);
 
+		typedef delegates::CDelegate3<const xml::CompiledElement&, const std::string&, Version> LoadCompiledDelegate;
+
+		/** Register delegate that walks node of compiled file with specified tag (_key) in place.
+			Compiled files are loaded with LoadXmlDelegate when some of their tags have no such delegate.
+		*/
+		LoadCompiledDelegate& registerLoadCompiledDelegate(const std::string& _key);
+
+		/** Unregister delegate that walks node of compiled file with specified tag (_key) */
+		void unregisterLoadCompiledDelegate(const std::string& _key);
+
 		/** Check is resource exist */
 		bool isExist(const std::string& _name) const;
 
@@ -72,12 +82,16 @@ namespace MyGUI
 
 	private:
 		void _loadList(xml::ElementPtr _node, const std::string& _file, Version _version);
+		void _loadCompiledList(const xml::CompiledElement& _node, const std::string& _file, Version _version);
+		bool _loadCompiled(const xml::CompiledDocument& _document, const std::string& _file, bool _match, const std::string& _type);
 		bool _loadImplement(const std::string& _file, bool _match, const std::string& _type, const std::string& _instance);
 
 	private:
 		// карта с делегатами для парсинга хмл блоков
 		typedef std::map<std::string, LoadXmlDelegate> MapLoadXmlDelegate;
 		MapLoadXmlDelegate mMapLoadXmlDelegate;
+		typedef std::map<std::string, LoadCompiledDelegate> MapLoadCompiledDelegate;
+		MapLoadCompiledDelegate mMapLoadCompiledDelegate;
 
 		MapResource mResources;
 
@@ -51,6 +51,8 @@ namespace MyGUI
 		// получившаяся высота при генерации в пикселях
 		int getDefaultHeight() const override;
 
+		size_t getTextureVersion() const override;
+
 		// update texture after render device lost event
 		void textureInvalidate(ITexture* _texture) override;
 
@@ -77,6 +79,10 @@ namespace MyGUI
 		void setDistance(int _value);
 		void setMsdfMode(bool _value);
 		void setMsdfRange(int _value);
+		void setLazyMode(bool _value);
+		void setLazyMaxTextureSize(int _value);
+		void setCacheFile(const std::string& _value);
+		void setRenderThreadCount(int _value);
 
 		void addCodePointRange(Char _first, Char _second);
 		void removeCodePointRange(Char _first, Char _second);
@@ -110,17 +116,24 @@ namespace MyGUI
 		Char mSubstituteCodePoint; // The code point to use as a substitute for code points that don't exist in the font.
 		bool mMsdfMode; // Signed distance field texture, designed to be used with shader (see https://github.com/Chlumsky/msdfgen)
 		int mMsdfRange; // Gragient area range in pixels for msdf mode (higher range is required for thick outlines)
+		bool mLazyMode; // Whether glyphs are rendered into the texture on first use instead of all at once during initialisation.
+		int mLazyMaxTextureSize; // Texture size limit in lazy mode, least recently used glyphs are evicted when it is reached.
+		std::string mCacheFile; // Optional file that stores the rendered texture and glyph metrics between runs. Not used in lazy mode.
+		size_t mRenderThreadCount; // Maximum number of threads rendering glyphs during initialisation; zero to use all hardware threads.
 
 		// The following variables are calculated automatically.
 		int mDefaultHeight; // The nominal height of the font in pixels.
 		GlyphInfo* mSubstituteGlyphInfo; // The glyph info to use as a substitute for code points that don't exist in the font.
 		MyGUI::ITexture* mTexture; // The texture that contains all of the rendered glyphs in the font.
+		mutable size_t mTextureVersion; // Incremented each time texture coordinates of existing glyphs change.
+		uint64_t mCacheKey; // Hash of the font file and all of the parameters above, calculated on every initialisation.
 
 		// The following constants used to be mutable, but they no longer need to be. Do not modify their values!
 		static const int mDefaultGlyphSpacing; // How far apart the glyphs are placed from each other in the font texture, in pixels.
 		static const float mDefaultTabWidth; // Default "Tab" width, used only when tab width is no specified.
 		static const float mSelectedWidth; // The width of the "Selected" and "SelectedBack" special characters, in pixels.
 		static const float mCursorWidth; // The width of the "Cursor" special character, in pixels.
+		static const size_t mMinGlyphsPerThread; // Fewer glyphs than this are not worth starting another rendering thread for.
 
 	private:
 		// A map of code points to glyph indices.
@@ -135,12 +148,19 @@ namespace MyGUI
 		template<bool LAMode, bool Antialias>
 		void initialiseFreeType();
 
-		// Loads the font face as specified by mSource, mSize, and mResolution. Automatically adjusts code-point ranges according
-		// to the capabilities of the font face.
+		// Loads the font file specified by mSource into memory.
+		// Returns nullptr if the file could not be loaded. The caller is responsible for freeing the buffer by calling delete[] on
+		// it after calling FT_Done_Face() on all of the faces that use it.
+		uint8* loadFontBuffer(size_t& _fontBufferSize) const;
+
+		// Loads the font face from the specified font file buffer as specified by mSize and mResolution. Automatically adjusts
+		// code-point ranges according to the capabilities of the font face.
 		// Returns a handle to the FreeType face object for the face, or nullptr if the face could not be loaded.
-		// Keeps the font file loaded in memory and stores its location in _fontBuffer. The caller is responsible for freeing this
-		// buffer when it is done using the face by calling delete[] on the buffer after calling FT_Done_Face() on the face itself.
-		FT_Face loadFace(const FT_Library& _ftLibrary, uint8*& _fontBuffer);
+		FT_Face loadFace(const FT_Library& _ftLibrary, const uint8* _fontBuffer, size_t _fontBufferSize);
+
+		// Loads another instance of the face that was loaded by loadFace(), for use with a different FreeType library object.
+		// Returns nullptr if the face could not be loaded.
+		FT_Face copyFace(const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize) const;
 
 		// Wraps the current texture coordinates _texX and _texY to the beginning of the next line if the specified glyph width
 		// doesn't fit at the end of the current line. Automatically takes the glyph spacing into account.
@@ -157,25 +177,152 @@ namespace MyGUI
 		// Automatically updates _glyphHeightMap with data from the newly created glyph.
 		int createFaceGlyph(FT_UInt _glyphIndex, Char _codePoint, int _fontAscent, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, GlyphHeightMap& _glyphHeightMap);
 
+		// Position of a glyph in the texture.
+		struct GlyphPlace
+		{
+			FT_UInt glyphIndex;
+			GlyphInfo* info;
+			int texX;
+			int texY;
+		};
+
+		typedef std::vector<GlyphPlace> VectorGlyphPlace;
+
+		// Calculates the positions of all of the glyphs in _glyphHeightMap in a texture of the specified width.
+		void placeGlyphs(const GlyphHeightMap& _glyphHeightMap, int _texWidth, VectorGlyphPlace& _places) const;
+
+		// Calls _render(context, index) for each index in [0, _count) on several threads. Every thread uses its own copy of
+		// the face, the calling thread uses the specified one. The context is constructed once per thread as
+		// ThreadContext(library, face), so per-face objects are shared by all glyphs rendered on that thread.
+		template<typename ThreadContext, typename RenderFunction>
+		void renderInThreads(size_t _count, const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize, RenderFunction _render) const;
+
 		// Renders all of the glyphs in _glyphHeightMap into the specified texture buffer using data from the specified font face.
+		// The font buffer is used to load copies of the face for worker threads.
+		template<bool LAMode, bool Antialias>
+		void renderGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, const uint8* _fontBuffer, size_t _fontBufferSize, uint8* _texBuffer, int _texWidth, int _texHeight);
+
+		// Loads the glyph with the specified index from the specified font face and renders it at the specified position.
+		// Returns false if the glyph could not be loaded.
 		template<bool LAMode, bool Antialias>
-		void renderGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, uint8* _texBuffer, int _texWidth, int _texHeight);
+		bool renderFaceGlyph(GlyphInfo& _info, FT_UInt _glyphIndex, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY) const;
 
 		// Renders the glyph described by the specified glyph info according to the specified parameters.
 		// Supports two types of rendering, depending on the value of UseBuffer: Texture block transfer and rectangular color fill.
 		// The _luminance0 value is used for even-numbered columns (from zero), while _luminance1 is used for odd-numbered ones.
 		template<bool LAMode, bool UseBuffer, bool Antialias>
-		void renderGlyph(GlyphInfo& _info, uint8 _luminance0, uint8 _luminance1, uint8 _alpha, int _lineHeight, uint8* _texBuffer, int _texWidth, int _texHeight, int& _texX, int& _texY, uint8* _glyphBuffer = nullptr);
+		void renderGlyph(GlyphInfo& _info, uint8 _luminance0, uint8 _luminance1, uint8 _alpha, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY, uint8* _glyphBuffer = nullptr) const;
+
+		// Calculates mDefaultHeight from the metrics of the specified font face and returns the font's ascent.
+		int calculateFontMetrics(const FT_Face& _ftFace);
+
+		// Returns FreeType load flags for the specified type of hinting.
+		FT_Int32 getLoadFlags() const;
+
+		// Calculates mCacheKey from the contents of the font file and all of the parameters that affect the rendered glyphs.
+		void calculateCacheKey(const uint8* _fontBuffer, size_t _fontBufferSize, bool _laMode);
+
+		// Restores the glyphs and the texture from mCacheFile. Returns false if the cache doesn't exist or is out of date.
+		bool loadCache(bool _laMode);
+
+		// Writes the glyphs and the texture contents to mCacheFile.
+		void saveCache(const std::vector<uint8>& _texBuffer, int _texWidth, int _texHeight, size_t _numBytes) const;
+
+		// Destroys the current texture and creates a new one of the specified size and format.
+		void createTexture(int _texWidth, int _texHeight, PixelFormat _format);
+
+		// Add or remove a range of code points [_first, _second] in the specified map.
+		static void addCodePointRange(CharMap& _charMap, Char _first, Char _second);
+		static void removeCodePointRange(CharMap& _charMap, Char _first, Char _second);
 
 		CharMap mCharMap; // A map of code points to glyph indices.
 		GlyphMap mGlyphMap; // A map of code points to glyph info objects.
 
+		// Initialisation adjusts the code points, the "Tab" width and the substitute code point, so the values specified by the
+		// user are kept separately. They are restored before every initialisation and the cache key is calculated from them.
+		CharMap mSpecifiedCharMap;
+		float mSpecifiedTabWidth;
+		Char mSpecifiedSubstituteCodePoint;
+
+	private:
+		// A glyph that is rendered into the texture on first use in lazy mode.
+		struct LazyGlyph
+		{
+			GlyphInfo info;
+			FT_UInt glyphIndex;
+			IntCoord place; // Position of the rendered glyph in the texture, in pixels.
+			bool exist; // False if the glyph could not be loaded; the substitute glyph is used instead.
+			bool rendered;
+			bool pinned; // Special and substitute glyphs are never evicted.
+			size_t lastUse;
+		};
+
+		typedef std::unordered_map<Char, LazyGlyph> LazyGlyphMap;
+
+		// A row of glyphs in the texture in lazy mode. Glyphs are placed from left to right.
+		struct LazyShelf
+		{
+			int top;
+			int height;
+			int right;
+		};
+
+		typedef std::vector<LazyShelf> VectorLazyShelf;
+
+		// Everything needed to render new glyphs after initialisation in lazy mode. Kept behind a pointer because glyphs are
+		// created from the const getGlyphInfo().
+		struct LazyAtlas
+		{
+			FT_Library library;
+			FT_Face face;
+			uint8* fontBuffer;
+			FT_Int32 loadFlags;
+			int fontAscent;
+			bool laMode;
+			LazyGlyphMap glyphs;
+			VectorLazyShelf shelves;
+			std::vector<uint8> pixels; // Copy of the texture contents.
+			int texWidth;
+			int texHeight;
+			size_t useCounter;
+		};
+
+		void initialiseLazy(bool _laMode);
+		void destroyLazyAtlas();
+
+		const GlyphInfo* getLazyGlyphInfo(Char _id) const;
+
+		// Creates the glyph for the specified code point in the lazy glyph map without rendering it.
+		LazyGlyph& createLazyGlyph(Char _codePoint) const;
+		LazyGlyph& createLazySpecialGlyph(const GlyphInfo& _glyphInfo);
+
+		// Renders the glyph into the texture, growing the texture or evicting unused glyphs when there is no free space.
+		// Returns false if the glyph doesn't fit into the texture at all.
+		bool renderLazyGlyph(LazyGlyph& _glyph) const;
+		template<bool LAMode, bool Antialias>
+		void renderLazyGlyphPixels(LazyGlyph& _glyph) const;
+
+		// Finds free space for a glyph of the specified size in the texture.
+		bool allocateLazyPlace(int _width, int _height, IntCoord& _place) const;
+		bool growLazyTexture() const;
+		void evictLazyGlyphs() const;
+		void updateLazyGlyphUV(LazyGlyph& _glyph) const;
+
+		void uploadLazyTexture() const;
+		void uploadLazyGlyph(const LazyGlyph& _glyph) const;
+
+		// Texture coordinates of rendered glyphs changed, text that uses them has to be rebuilt.
+		void lazyTextureChanged() const;
+
+		LazyAtlas* mLazyAtlas; // Only created in lazy mode.
+
 #ifdef MYGUI_MSDF_FONTS
 		GlyphInfo createMsdfFaceGlyphInfo(Char _codePoint, const msdfgen::Shape& _shape, double _advance, int _fontAscent);
 		int createMsdfGlyph(const GlyphInfo& _glyphInfo, GlyphHeightMap& _glyphHeightMap);
 		int createMsdfFaceGlyph(Char _codePoint, int _fontAscent, msdfgen::FontHandle* _fontHandle, GlyphHeightMap& _glyphHeightMap);
 
-		void renderMsdfGlyphs(const GlyphHeightMap& _glyphHeightMap, msdfgen::FontHandle* _fontHandle, uint8* _texBuffer, int _texWidth, int _texHeight);
+		void renderMsdfGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize, uint8* _texBuffer, int _texWidth, int _texHeight);
+		bool renderMsdfGlyph(GlyphInfo& _info, msdfgen::FontHandle* _fontHandle, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY) const;
 #endif
 
 #endif // MYGUI_USE_FREETYPE
@@ -27,6 +27,11 @@ namespace MyGUI
 		void setViewOffset(const IntPoint& _point) override;
 
 		void doRender() override;
+
+		void _prepareRender() override;
+
+	private:
+		void updateViewOffset();
 	};
 
 } // namespace MyGUI
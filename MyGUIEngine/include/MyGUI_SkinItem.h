@@ -51,8 +51,8 @@ namespace MyGUI
 		ISubWidgetText* mText;
 		// указатель на первый не текстовой сабскин
 		ISubWidgetRect* mMainSkin;
-		// список всех стейтов
-		MapWidgetStateInfo mStateInfo;
+		// список всех стейтов, принадлежит скину
+		const MapWidgetStateInfo* mStateInfo;
 
 		std::string mTextureName;
 		ITexture* mTexture;
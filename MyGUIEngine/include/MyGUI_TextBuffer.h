@@ -0,0 +1,74 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_TEXT_BUFFER_H_
+#define MYGUI_TEXT_BUFFER_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_UString.h"
+#include <vector>
+
+namespace MyGUI
+{
+
+	/** UTF-32 text with a gap at the place of the last edit.
+		Edit moves only the text between the gap and edited place, so typing at one place costs the size
+		of typed text instead of the size of whole text. Characters are read by index across the gap,
+		contiguous copy of text is made only by str() and substr().
+	*/
+	class MYGUI_EXPORT TextBuffer
+	{
+	public:
+		typedef UString::unicode_char value_type;
+
+		TextBuffer();
+		explicit TextBuffer(const UString::utf32string& _text);
+
+		size_t size() const
+		{
+			return mData.size() - mGapSize;
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		value_type operator [] (size_t _index) const
+		{
+			return mData[_index < mGapStart ? _index : _index + mGapSize];
+		}
+
+		void insert(size_t _position, const UString::utf32string& _text);
+		void insert(size_t _position, const value_type* _text, size_t _count);
+
+		void erase(size_t _position, size_t _count);
+
+		void assign(const UString::utf32string& _text);
+
+		void clear();
+
+		UString::utf32string substr(size_t _position, size_t _count = UString::npos) const;
+
+		UString::utf32string str() const;
+
+		/** Number of '#' characters, text without them has no colour tags and no escaped '#' */
+		size_t getTagCharCount() const;
+
+	private:
+		void moveGap(size_t _position);
+		void reserveGap(size_t _size);
+
+	private:
+		std::vector<value_type> mData;
+		size_t mGapStart;
+		size_t mGapSize;
+		size_t mTagCharCount;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_TEXT_BUFFER_H_
@@ -10,6 +10,7 @@
 #include "MyGUI_Prerequest.h"
 #include "MyGUI_Colour.h"
 #include "MyGUI_TextChangeHistory.h"
+#include "MyGUI_TextBuffer.h"
 #include "MyGUI_IFont.h"
 
 namespace MyGUI
@@ -22,9 +23,20 @@ namespace MyGUI
 
 	public:
 		TextIterator(const UString& _text, VectorChangeInfo* _history = nullptr);
+		// edits _text in place, without copying it
+		TextIterator(TextBuffer& _text, VectorChangeInfo* _history = nullptr);
+
+		TextIterator(const TextIterator& _other);
+		TextIterator& operator = (const TextIterator& _other);
 
 		bool moveNext();
 
+		/** Moves to _position at once, as if moveNext was called until getPosition() reached it.
+			Works only for iterator that wasn't moved yet over text without tags.
+			@return false if iterator wasn't moved and moveNext must be used
+		*/
+		bool skipTo(size_t _position);
+
 		// возвращает цвет
 		bool getTagColour(UString& _colour) const;
 
@@ -65,6 +77,12 @@ namespace MyGUI
 
 		void cutMaxLengthFromBeginning(size_t _max);
 
+		/** Range of text with tags changed since iterator was created,
+			[_start, _start + _erased) of original text was replaced by _inserted characters.
+			@return false if text was not changed
+		*/
+		bool getChangedRange(size_t& _start, size_t& _erased, size_t& _inserted) const;
+
 		// возвращает текст без тегов
 		static UString getOnlyText(const UString& _text);
 
@@ -78,21 +96,29 @@ namespace MyGUI
 		static UString toTagsString(const UString& _text);
 
 	private:
-		bool getTagColour(UString& _colour, UString::utf32string::iterator& _iter) const;
+		bool getTagColour(UString& _colour, size_t& _index) const;
 
 		bool setTagColour(const UString::utf32string& _colour);
 
-		void insert(UString::utf32string::iterator& _start, const UString::utf32string& _insert);
+		void insert(size_t _start, const UString::utf32string& _insert);
 
-		UString::utf32string::iterator erase(UString::utf32string::iterator _start, UString::utf32string::iterator _end);
+		size_t erase(size_t _start, size_t _end);
 
 		void clear();
 
+		// [_start, _end) of current text is going to be replaced
+		void notifyChange(size_t _start, size_t _end);
+
 		void normaliseNewLine(UString& _text);
 
+		void assign(const TextIterator& _other);
+
 	private:
-		UString::utf32string mText;
-		UString::utf32string::iterator mCurrent, mEnd, mSave;
+		TextBuffer mOwnText;
+		// either mOwnText or external text edited in place
+		TextBuffer* mText;
+		// index of current character and of saved start point, ITEM_NONE if start point isn't saved
+		size_t mCurrent, mSave;
 
 		// позиция и размер
 		size_t mPosition;
@@ -100,6 +126,12 @@ namespace MyGUI
 		bool mFirst;
 
 		VectorChangeInfo* mHistory;
+
+		// changed range, ITEM_NONE if text wasn't changed
+		size_t mChangeStart;
+		// count of unchanged characters at the end
+		size_t mChangeSuffix;
+		size_t mOriginalSize;
 	};
 
 } // namespace MyGUI
@@ -11,6 +11,7 @@
 #include "MyGUI_TextureUtility.h"
 #include "MyGUI_TextViewData.h"
 #include "MyGUI_IFont.h"
+#include "MyGUI_TextBuffer.h"
 
 namespace MyGUI
 {
@@ -20,7 +21,13 @@ namespace MyGUI
 	public:
 		TextView();
 
-		void update(const UString::utf32string& _text, IFont* _font, int _height, Align _align, VertexColourType _format, int _maxWidth = -1);
+		/** [_start, _start + _erased) of text was replaced by _inserted characters since last update, lines outside of changed
+			range are reused by next update. Might be called several times before update, any text size change that was not
+			notified makes whole text to be laid out again.
+		*/
+		void notifyTextChange(size_t _start, size_t _erased, size_t _inserted);
+
+		void update(const TextBuffer& _text, IFont* _font, int _height, Align _align, VertexColourType _format, int _maxWidth = -1);
 
 		size_t getCursorPosition(const IntPoint& _value) const;
 
@@ -32,11 +39,58 @@ namespace MyGUI
 
 		const VectorLineInfo& getData() const;
 
+		// cursor position of first character in line
+		size_t getLineStart(size_t _line) const;
+		// colour from last colour tag before line, false if there was no such tag
+		bool getLineColour(size_t _line, uint32& _colour) const;
+
+	private:
+		// where line came from, lines that don't depend on changed text are reused on next update
+		struct LineLayout
+		{
+			// first character of line
+			size_t start;
+			// first character of next line, past the text size for last line
+			size_t next;
+			// end of text that affected line breaking
+			size_t examined;
+			// widest point where line could wrap but didn't
+			float fitWidth;
+			// width that made line wrap, or FLT_MAX
+			float wrapWidth;
+			// last colour tag in line
+			bool hasColour;
+			uint32 colour;
+
+			// recalculated on every update, depend on previous lines
+			size_t position;
+			bool hasStartColour;
+			uint32 startColour;
+		};
+		typedef std::vector<LineLayout> VectorLineLayout;
+
+		void layoutLine(const TextBuffer& _text, size_t _start, int _height, VertexColourType _format, int _maxWidth, LineInfo& _line, LineLayout& _layout) const;
+		bool isLineFit(const LineLayout& _layout, int _maxWidth) const;
+
 	private:
 		IntSize mViewSize;
 		size_t mLength;
 		VectorLineInfo mLineInfo;
 		int mFontHeight;
+
+		// state of last update
+		size_t mTextSize;
+		VectorLineLayout mLineLayout;
+		IFont* mFont;
+		VertexColourType mVertexFormat;
+		size_t mFontTextureVersion;
+
+		// changes notified since last update, text size includes them
+		bool mTextChanged;
+		size_t mChangeStart;
+		// count of unchanged characters at the end
+		size_t mChangeSuffix;
+		size_t mChangedTextSize;
 	};
 
 } // namespace MyGUI
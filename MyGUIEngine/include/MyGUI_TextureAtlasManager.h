@@ -0,0 +1,108 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_TEXTURE_ATLAS_MANAGER_H_
+#define MYGUI_TEXTURE_ATLAS_MANAGER_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_Singleton.h"
+#include "MyGUI_Types.h"
+#include "MyGUI_ITexture.h"
+#include "MyGUI_XmlDocument.h"
+#include "MyGUI_Version.h"
+#include <map>
+
+namespace MyGUI
+{
+
+	/** Packs textures of skins and image sets into few big atlas pages, so widgets with different
+		textures can be rendered in one batch. Disabled by default, must be enabled before skins are loaded,
+		either with setEnabled or with <MyGUI type="TextureAtlas"> section in xml.
+	*/
+	class MYGUI_EXPORT TextureAtlasManager :
+		public ITextureInvalidateListener
+	{
+		MYGUI_SINGLETON_DECLARATION(TextureAtlasManager);
+	public:
+		TextureAtlasManager();
+
+		void initialise();
+		void shutdown();
+
+		/** Enable packing of textures used by resources loaded after this call. */
+		void setEnabled(bool _value);
+		bool getEnabled() const;
+
+		/** Set size of new atlas pages. */
+		void setPageSize(int _value);
+		int getPageSize() const;
+
+		/** Set maximum width and height of texture that is packed, bigger textures are used as is. */
+		void setMaxTextureSize(int _value);
+		int getMaxTextureSize() const;
+
+		/** Get texture that should be used instead of _texture, texture is packed on first request.
+			@param _texture Texture name, replaced with atlas page name.
+			@param _offset Position of texture inside of atlas page in pixels.
+			@return false if atlas is disabled or texture can't be packed, _texture and _offset are not changed in this case.
+		*/
+		bool mapTexture(std::string& _texture, IntPoint& _offset);
+
+		/** Get count of textures packed into atlas pages. */
+		size_t getTextureCount() const;
+		/** Get count of atlas pages. */
+		size_t getPageCount() const;
+
+	private:
+		struct Page
+		{
+			ITexture* texture;
+			int size;
+			std::vector<uint8> pixels;
+			// shelf packing, textures are placed in rows from left to right
+			int shelfLeft;
+			int shelfTop;
+			int shelfHeight;
+		};
+		typedef std::vector<Page> VectorPage;
+
+		struct Placement
+		{
+			// ITEM_NONE if texture can't be packed
+			size_t page;
+			IntPoint offset;
+		};
+		typedef std::map<std::string, Placement> MapPlacement;
+
+		void _load(xml::ElementPtr _node, const std::string& _file, Version _version);
+
+		void textureInvalidate(ITexture* _texture) override;
+
+		Placement packTexture(const std::string& _texture);
+		bool fitTexture(int _width, int _height) const;
+		bool readPixels(ITexture* _texture, std::vector<uint8>& _pixels) const;
+		size_t findPlace(int _width, int _height, IntPoint& _point);
+		void uploadPage(const Page& _page, const IntCoord& _coord) const;
+
+		void destroyAllPages();
+
+	private:
+		VectorPage mPages;
+		MapPlacement mPlacements;
+		size_t mTextureCount;
+
+		bool mEnabled;
+		int mPageSize;
+		int mMaxTextureSize;
+
+		bool mIsInitialise;
+		std::string mXmlAtlasTagName;
+		std::string mXmlPropertyTagName;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_TEXTURE_ATLAS_MANAGER_H_
@@ -10,6 +10,7 @@
 #include "MyGUI_Prerequest.h"
 #include "MyGUI_Colour.h"
 #include "MyGUI_RenderFormat.h"
+#include "MyGUI_ITexture.h"
 
 namespace MyGUI
 {
@@ -17,7 +18,36 @@ namespace MyGUI
 	namespace texture_utility
 	{
 
-		MYGUI_EXPORT const IntSize& getTextureSize(const std::string& _texture, bool _cache = true);
+		/// Information about texture file read from its header
+		struct MYGUI_EXPORT TextureInfo
+		{
+			TextureInfo() :
+				mipCount(0)
+			{
+			}
+
+			IntSize size;
+			/// Unknow for compressed and other formats that have no PixelFormat equivalent
+			PixelFormat format;
+			/// Count of mip levels stored in file, 1 if file have no mips
+			size_t mipCount;
+		};
+
+		/** Get size of texture. Size of created texture is used if there is one, otherwise size is read
+			from file header (PNG, JPEG and DDS) without creating texture. Texture is created and loaded
+			only when file format is not recognised.
+			@param _cache If false cached information about _texture is read from file again (about all textures if _texture is empty).
+		*/
+		MYGUI_EXPORT IntSize getTextureSize(const std::string& _texture, bool _cache = true);
+		/** Get information about texture file, read from file header without decoding image.
+			Results are cached by file name, function can be called from any thread.
+			@return false if file not found or its format is not recognised.
+		*/
+		MYGUI_EXPORT bool getTextureInfo(const std::string& _texture, TextureInfo& _info);
+		/// Forget cached information about all texture files
+		MYGUI_EXPORT void clearTextureInfo();
+		/// Get texture, texture is created and loaded from file if it was not created yet
+		MYGUI_EXPORT ITexture* loadTexture(const std::string& _texture);
 		/// Convert Colour to 32-bit representation
 		MYGUI_EXPORT uint32 toNativeColour(const Colour& _colour, VertexColourType _format);
 		/// Convert from 32-bit ARGB to native colour (ABGR or ARGB)
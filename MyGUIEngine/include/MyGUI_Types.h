@@ -43,6 +43,7 @@ namespace MyGUI
 
 	// TODO: remove this types
 	using uint8 = uint8_t;
+	using int16 = int16_t;
 	using uint16 = uint16_t;
 	using uint32 = uint32_t;
 
@@ -9,6 +9,8 @@
 
 #include "MyGUI_Prerequest.h"
 #include "MyGUI_Types.h"
+#include "MyGUI_RenderFormat.h"
+#include <algorithm>
 
 namespace MyGUI
 {
@@ -30,6 +32,57 @@ namespace MyGUI
 		float u, v;
 	};
 
+	/** Vertex of VertexLayout::Compact.
+		Position is fixed point in pixels with 1/8 pixel step, in range [-4096, 4096) from origin chosen by RenderItem.
+		Vertex buffer maps it to render target with its position transform (see IVertexBuffer::setPositionTransform).
+		It has no depth, render target uses its RenderTargetInfo::maximumDepth for whole batch.
+		Texture coordinates are normalized to [0, 1] with 1/65535 step.
+	*/
+	struct CompactVertex
+	{
+		enum Enum
+		{
+			PositionScale = 8,
+			PositionRange = 32768 / PositionScale,
+			TexCoordScale = 65535
+		};
+
+		// _x and _y are in pixels
+		void set(float _x, float _y, uint32 _colour, float _u, float _v)
+		{
+			x = packPosition(_x);
+			y = packPosition(_y);
+			colour = _colour;
+			u = packTexCoord(_u);
+			v = packTexCoord(_v);
+		}
+
+		static bool isPositionInRange(float _value)
+		{
+			return _value >= -(float)PositionRange && _value < (float)PositionRange;
+		}
+
+		static int16 packPosition(float _value)
+		{
+			float value = (std::min)((std::max)(_value * PositionScale, -32768.0f), 32767.0f);
+			// rounding of shifted positive value is truncation
+			return (int16)((int)(value + 32768.5f) - 32768);
+		}
+
+		static uint16 packTexCoord(float _value)
+		{
+			float value = (std::min)((std::max)(_value, 0.0f), 1.0f);
+			return (uint16)(value * TexCoordScale + 0.5f);
+		}
+
+		int16 x, y;
+		uint32 colour;
+		uint16 u, v;
+	};
+
+	static_assert(sizeof(Vertex) == 24, "VertexLayout::getVertexSize doesn't match Vertex");
+	static_assert(sizeof(CompactVertex) == 12, "VertexLayout::getVertexSize doesn't match CompactVertex");
+
 	struct VertexQuad
 	{
 		enum Enum
@@ -66,6 +119,57 @@ namespace MyGUI
 		Vertex vertex[6];
 	};
 
+	/** Quad without duplicated vertices, drawn as triangles LT-RT-LB and LB-RT-RB.
+		Triangles are the same as in VertexQuad, index buffer or RenderItem restores the missing vertices.
+	*/
+	struct IndexedVertexQuad
+	{
+		enum Enum
+		{
+			CornerLT = 0,
+			CornerRT = 1,
+			CornerLB = 2,
+			CornerRB = 3,
+			VertexCount = 4,
+			IndexCount = 6
+		};
+
+		void set(float _l, float _t, float _r, float _b, float _z, float _u1, float _v1, float _u2, float _v2, uint32 _colour)
+		{
+			vertex[CornerLT].set(_l, _t, _z, _u1, _v1, _colour);
+			vertex[CornerRT].set(_r, _t, _z, _u2, _v1, _colour);
+			vertex[CornerLB].set(_l, _b, _z, _u1, _v2, _colour);
+			vertex[CornerRB].set(_r, _b, _z, _u2, _v2, _colour);
+		}
+
+		void set(float _x1, float _y1, float _x2, float _y2, float _x3, float _y3, float _x4, float _y4, float _z, float _u1, float _v1, float _u2, float _v2, uint32 _colour)
+		{
+			vertex[CornerLT].set(_x1, _y1, _z, _u1, _v1, _colour);
+			vertex[CornerRT].set(_x2, _y2, _z, _u2, _v1, _colour);
+			vertex[CornerLB].set(_x4, _y4, _z, _u1, _v2, _colour);
+			vertex[CornerRB].set(_x3, _y3, _z, _u2, _v2, _colour);
+		}
+
+		/** Write indices of _count quads, first quad starts from vertex _first. */
+		template <typename IndexType>
+		static void fillIndices(IndexType* _indices, size_t _first, size_t _count)
+		{
+			for (size_t quad = 0; quad < _count; ++quad)
+			{
+				IndexType base = (IndexType)((_first + quad) * VertexCount);
+				_indices[0] = base + CornerLT;
+				_indices[1] = base + CornerRT;
+				_indices[2] = base + CornerLB;
+				_indices[3] = base + CornerLB;
+				_indices[4] = base + CornerRT;
+				_indices[5] = base + CornerRB;
+				_indices += IndexCount;
+			}
+		}
+
+		Vertex vertex[4];
+	};
+
 } // namespace MyGUI
 
 #endif // MYGUI_VERTEX_DATA_H_
@@ -17,6 +17,7 @@
 #include "MyGUI_IObject.h"
 #include "MyGUI_SkinItem.h"
 #include "MyGUI_BackwardCompatibility.h"
+#include "MyGUI_WidgetAllocator.h"
 
 namespace MyGUI
 {
@@ -43,6 +44,10 @@ namespace MyGUI
 	public:
 		Widget();
 
+		/** Widgets are allocated with WidgetAllocator */
+		static void* operator new(size_t _size);
+		static void operator delete(void* _pointer);
+
 		/** Create child widget
 			@param _type widget type
 			@param _skin widget skin
@@ -365,6 +370,8 @@ namespace MyGUI
 
 		void _updateAlpha();
 		void _updateAbsolutePoint();
+		// same as _updateAbsolutePoint, but vertices of sub skins are still valid
+		void _translateAbsolutePoint();
 
 		// для внутреннего использования
 		void _updateVisible();
@@ -388,6 +395,11 @@ namespace MyGUI
 
 		void addWidget(Widget* _widget);
 
+		bool _isPickGridEnabled() const;
+		void _pickGridOutOfDate();
+		void _pickGridUpdateItem(Widget* _widget);
+		bool _isPixelSpaceRoot() const;
+
 	private:
 		// клиентская зона окна
 		// если виджет имеет пользовательские окна не в себе
@@ -400,6 +412,10 @@ namespace MyGUI
 		// вектор детей скина
 		VectorWidgetPtr mWidgetChildSkin;
 
+		// spatial index over mWidgetChild, used for picking when layer allows it
+		// created on first pick when there are enough children
+		mutable PickGrid* mPickGrid;
+
 		// availability for mouse/keyboard
 		bool mEnabled;
 		bool mInheritedEnabled;
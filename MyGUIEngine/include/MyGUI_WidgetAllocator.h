@@ -0,0 +1,59 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_WIDGET_ALLOCATOR_H_
+#define MYGUI_WIDGET_ALLOCATOR_H_
+
+#include "MyGUI_Prerequest.h"
+#include <cstddef>
+
+namespace MyGUI
+{
+
+	struct MYGUI_EXPORT WidgetAllocatorStats
+	{
+		WidgetAllocatorStats() :
+			poolCount(0),
+			poolPages(0),
+			poolBlocks(0),
+			poolFreeBlocks(0),
+			liveObjects(0),
+			allocations(0)
+		{
+		}
+
+		// count of size classes that have own free list
+		size_t poolCount;
+		size_t poolPages;
+		size_t poolBlocks;
+		size_t poolFreeBlocks;
+		size_t liveObjects;
+		// total count of allocations since start
+		size_t allocations;
+	};
+
+	/** Allocator for widgets and sub widgets.
+		Objects are taken from free lists, one free list per object size, so every widget type reuses
+		memory of destroyed widgets of the same type. Main thread only, like widgets themselves.
+		With MYGUI_USE_WIDGET_POOL turned off in CMake every object is allocated with ::operator new.
+		Arenas per loaded layout are not used: strings and containers of widgets still allocate one by
+		one, so they didn't make loading faster, and pages were kept while any widget of layout lived.
+	*/
+	class MYGUI_EXPORT WidgetAllocator
+	{
+	public:
+		static void* allocate(size_t _size);
+		static void deallocate(void* _pointer);
+
+		/** Release free list pages if there are no objects allocated from them. */
+		static void trim();
+
+		static WidgetAllocatorStats getStats();
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_WIDGET_ALLOCATOR_H_
@@ -12,6 +12,7 @@
 #include "MyGUI_IUnlinkWidget.h"
 #include "MyGUI_ICroppedRectangle.h"
 #include "MyGUI_Widget.h"
+#include "MyGUI_WidgetAllocator.h"
 #include <set>
 #include "MyGUI_BackwardCompatibility.h"
 
@@ -46,6 +47,9 @@ namespace MyGUI
 		/** Check if factory with specified widget type exist */
 		bool isFactoryExist(const std::string& _type);
 
+		/** Get memory statistics of widgets and sub widgets */
+		WidgetAllocatorStats getAllocatorStats() const;
+
 		/*internal:*/
 		void _deleteWidget(Widget* _widget);
 		void _deleteDelayWidgets();
@@ -11,6 +11,8 @@
 #include "MyGUI_UString.h"
 #include "MyGUI_Diagnostic.h"
 #include "MyGUI_DataStream.h"
+#include "MyGUI_Types.h"
+#include "MyGUI_Colour.h"
 
 #include <vector>
 #include <string>
@@ -67,6 +69,7 @@ namespace MyGUI
 				MoreThanOneXMLDeclaration,
 				MoreThanOneRootElement,
 				IncorrectAttribute,
+				TooDeepNesting,
 				MAX
 			};
 
@@ -92,6 +95,7 @@ namespace MyGUI
 					"XML file contain more than one declaration",
 					"XML file contain more than one root element",
 					"XML file contain incorrect attribute",
+					"XML file contain too deeply nested elements",
 					""
 				};
 				return values[(_index < MAX && _index >= 0) ? _index : MAX];
@@ -102,6 +106,7 @@ namespace MyGUI
 
 		class Element;
 		class Document;
+		class CompiledDocument;
 
 		using ElementPtr = Element*;
 		typedef std::pair<std::string, std::string> PairAttribute;
@@ -166,6 +171,9 @@ namespace MyGUI
 			Element(const std::string& _name, ElementPtr _parent, ElementType _type = ElementType::Normal, const std::string& _content = "");
 			void save(std::ostream& _stream, size_t _level);
 
+			// deletes element, or only destroys it if memory belongs to arena of Document
+			static void destroy(ElementPtr _element);
+
 		public:
 			ElementPtr createChild(const std::string& _name, const std::string& _content = "", ElementType _type = ElementType::Normal);
 			void removeChild(ElementPtr _child);
@@ -275,6 +283,7 @@ namespace MyGUI
 			VectorElement mChilds;
 			ElementPtr mParent;
 			ElementType mType;
+			bool mInArena;
 		};
 
 		//----------------------------------------------------------------------//
@@ -299,6 +308,9 @@ namespace MyGUI
 
 			bool open(IDataStream* _data);
 
+			/** Create Element tree from compiled document */
+			bool open(const CompiledDocument& _document);
+
 			// сохраняет файл
 			bool save(const std::string& _filename);
 
@@ -309,6 +321,13 @@ namespace MyGUI
 
 			bool save(const UString& _filename);
 
+			/** Save document in compiled binary format.
+				Strings are stored once in a shared table, numbers and colours are parsed when saving.
+				Compiled data can be walked in place with CompiledDocument,
+				all open() methods detect this format too and create the same Element tree.
+			*/
+			bool saveBinary(std::ostream& _stream);
+
 			void clear();
 
 			std::string getLastError() const;
@@ -335,14 +354,15 @@ namespace MyGUI
 			void setLastFileError(const std::string& _filename);
 			void setLastFileError(const std::wstring& _filename);
 
-			bool parseTag(ElementPtr& _currentNode, std::string _content);
+			bool parseText(std::string& _data);
 
-			bool checkPair(std::string& _key, std::string& _value);
+			bool parseTag(ElementPtr& _currentNode, const char* _begin, const char* _end);
 
-			bool parseLine(std::string& _line, ElementPtr& _element);
+			bool parseAttributes(ElementPtr _element, const char* _begin, const char* _end);
 
-			// ищет символ без учета ковычек
-			size_t find(const std::string& _text, char _char, size_t _start = 0);
+			// parsed elements are allocated in blocks, that are freed together in clear
+			ElementPtr createElement(ElementPtr _parent, ElementType _type);
+			void clearElements();
 
 			void clearDeclaration();
 			void clearRoot();
@@ -350,6 +370,9 @@ namespace MyGUI
 		private:
 			ElementPtr mRoot;
 			ElementPtr mDeclaration;
+			std::vector<Element*> mElementBlocks;
+			size_t mElementBlockSize;
+			size_t mElementBlockUsed;
 			ErrorType mLastError;
 			std::string mLastErrorFile;
 			size_t mLine;
@@ -357,6 +380,170 @@ namespace MyGUI
 
 		}; // class Document
 
+		//----------------------------------------------------------------------//
+		// class CompiledAttribute
+		//----------------------------------------------------------------------//
+		/** Attribute of element in CompiledDocument.
+			Values that are lists of up to four numbers or colours written as #RRGGBB are parsed
+			when document is compiled, every value is available as string too.
+		*/
+		class MYGUI_EXPORT CompiledAttribute
+		{
+			friend class CompiledElement;
+
+		public:
+			CompiledAttribute();
+
+			/** False for attribute that was not found */
+			bool isValid() const;
+
+			const char* getName() const;
+			const char* getValue() const;
+
+			/** Get value that is list of exactly _count integer numbers, returns false for other values */
+			bool getInts(int* _values, size_t _count) const;
+			/** Get value that is list of exactly _count numbers, returns false for other values */
+			bool getFloats(float* _values, size_t _count) const;
+
+			bool getValue(int& _value) const;
+			bool getValue(float& _value) const;
+			bool getValue(IntPoint& _value) const;
+			bool getValue(IntSize& _value) const;
+			bool getValue(IntCoord& _value) const;
+			bool getValue(FloatCoord& _value) const;
+			/** Get colour written the same way as for Colour::parse */
+			bool getValue(Colour& _value) const;
+
+		private:
+			CompiledAttribute(const CompiledDocument* _document, uint32 _index);
+
+			uint32 getNumber(size_t _index) const;
+
+		private:
+			const CompiledDocument* mDocument;
+			uint32 mIndex;
+		};
+
+		//----------------------------------------------------------------------//
+		// class CompiledElement
+		//----------------------------------------------------------------------//
+		/** Element of CompiledDocument, small value that refers to data of document */
+		class MYGUI_EXPORT CompiledElement
+		{
+			friend class CompiledDocument;
+
+		public:
+			CompiledElement();
+
+			/** False for element that doesn't exist */
+			bool isValid() const;
+
+			const char* getName() const;
+			/** Compare name without creating string */
+			bool isName(const char* _name) const;
+			const char* getContent() const;
+			ElementType getType() const;
+
+			size_t getAttributeCount() const;
+			CompiledAttribute getAttributeAt(size_t _index) const;
+			/** Find attribute by name, returns not valid attribute if there is no such attribute */
+			CompiledAttribute findAttribute(const char* _name) const;
+
+			size_t getChildCount() const;
+			CompiledElement getChildAt(size_t _index) const;
+
+		private:
+			CompiledElement(const CompiledDocument* _document, uint32 _index);
+
+			uint32 getField(size_t _field) const;
+
+		private:
+			const CompiledDocument* mDocument;
+			uint32 mIndex;
+		};
+
+		//----------------------------------------------------------------------//
+		// class CompiledDocument
+		//----------------------------------------------------------------------//
+		/** Read-only view of document saved with Document::saveBinary.
+			View works in place over the buffer it was opened with, for example memory mapped file,
+			nothing is copied and walking elements and attributes doesn't allocate memory.
+		*/
+		class MYGUI_EXPORT CompiledDocument
+		{
+			friend class CompiledElement;
+			friend class CompiledAttribute;
+
+		public:
+			CompiledDocument();
+
+			/** Check whether data starts as compiled document */
+			static bool isCompiled(const void* _data, size_t _size);
+
+			/** Open view over data, data must be kept unchanged while view is used.
+				Whole document is validated here, so walking it needs no checks later.
+			*/
+			bool open(const void* _data, size_t _size);
+
+			void close();
+
+			CompiledElement getDeclaration() const;
+			CompiledElement getRoot() const;
+
+			/** Number of nesting levels, declaration and root are on first level */
+			size_t getDepth() const;
+
+			std::string getLastError() const;
+
+		private:
+			bool fail();
+
+			// records are arrays of little endian numbers, all of them are checked in open
+			static uint32 getField(const char* _records, uint32 _index, size_t _fieldCount, size_t _field)
+			{
+				const uint8* data = reinterpret_cast<const uint8*>(_records) + ((size_t)_index * _fieldCount + _field) * 4;
+				return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24);
+			}
+
+			uint32 getStringField(uint32 _index, size_t _field) const
+			{
+				return getField(mStrings, _index, 2, _field);
+			}
+
+			uint32 getElementField(uint32 _index, size_t _field) const
+			{
+				return getField(mElements, _index, 7, _field);
+			}
+
+			uint32 getAttributeField(uint32 _index, size_t _field) const
+			{
+				return getField(mAttributes, _index, 8, _field);
+			}
+
+			const char* getString(uint32 _index) const
+			{
+				return mStringData + getStringField(_index, 0);
+			}
+
+			size_t getStringSize(uint32 _index) const
+			{
+				return getStringField(_index, 1);
+			}
+
+		private:
+			const char* mStrings;
+			const char* mElements;
+			const char* mAttributes;
+			const char* mStringData;
+			uint32 mStringCount;
+			uint32 mElementCount;
+			uint32 mAttributeCount;
+			uint32 mDeclaration;
+			uint32 mRoot;
+			size_t mDepth;
+			ErrorType mLastError;
+		};
+
 		MYGUI_OBSOLETE("use : class MyGUI::xml::ElementEnumerator")
 		typedef ElementEnumerator xmlNodeIterator;
 		MYGUI_OBSOLETE("use : class MyGUI::xml::ElementPtr")
@@ -39,7 +39,7 @@ namespace MyGUI
 				_startRect.height - int( float(_startRect.height - _destRect.height) * _k ));
 		}
 
-		void inertionalMoveFunction(const IntCoord& _startRect, const IntCoord& _destRect, IntCoord& _result, float _current_time)
+		float inertionalMoveFactor(float _current_time)
 		{
 #ifdef M_PI
 #undef M_PI
@@ -48,7 +48,12 @@ namespace MyGUI
 			float k = std::sin(M_PI * _current_time - M_PI / 2.0f);
 			if (k < 0) k = (-std::pow(-k, 0.7f) + 1) / 2;
 			else k = (std::pow(k, 0.7f) + 1) / 2;
-			linearMoveFunction(_startRect, _destRect, _result, k);
+			return k;
+		}
+
+		void inertionalMoveFunction(const IntCoord& _startRect, const IntCoord& _destRect, IntCoord& _result, float _current_time)
+		{
+			linearMoveFunction(_startRect, _destRect, _result, inertionalMoveFactor(_current_time));
 		}
 
 	} // namespace action
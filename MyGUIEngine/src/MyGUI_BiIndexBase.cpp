@@ -139,6 +139,23 @@ namespace MyGUI
 		std::swap(mIndexFace[mIndexBack[_index1]], mIndexFace[mIndexBack[_index2]]);
 	}
 
+	void BiIndexBase::permuteItemsBack(const std::vector<size_t>& _order)
+	{
+		MYGUI_ASSERT(_order.size() == mIndexBack.size(), "BiIndexBase::permuteItemsBack");
+
+		VectorSizeT indexBack(_order.size());
+		for (size_t pos = 0; pos < _order.size(); ++pos)
+		{
+			indexBack[pos] = mIndexBack[_order[pos]];
+			mIndexFace[indexBack[pos]] = pos;
+		}
+		mIndexBack.swap(indexBack);
+
+#if MYGUI_DEBUG_MODE == 1
+		checkIndexes();
+#endif
+	}
+
 #if MYGUI_DEBUG_MODE == 1
 
 	void BiIndexBase::checkIndexes()
@@ -9,6 +9,7 @@
 #include "MyGUI_Gui.h"
 #include "MyGUI_InputManager.h"
 #include "MyGUI_WidgetManager.h"
+#include "MyGUI_ControllerManager.h"
 #include "MyGUI_Widget.h"
 
 namespace MyGUI
@@ -92,11 +93,13 @@ namespace MyGUI
 	void ControllerFadeAlpha::setAlpha(float _value)
 	{
 		mAlpha = _value;
+		updateItem();
 	}
 
 	void ControllerFadeAlpha::setCoef(float _value)
 	{
 		mCoef = _value;
+		updateItem();
 	}
 
 	void ControllerFadeAlpha::setEnabled(bool _value)
@@ -104,4 +107,12 @@ namespace MyGUI
 		mEnabled = _value;
 	}
 
+	void ControllerFadeAlpha::updateItem()
+	{
+		// working controller is updated by manager with its own copy of parameters
+		ControllerManager* manager = ControllerManager::getInstancePtr();
+		if (manager != nullptr)
+			manager->_updateItem(this);
+	}
+
 } // namespace MyGUI
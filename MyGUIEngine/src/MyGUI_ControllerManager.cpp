@@ -9,22 +9,30 @@
 #include "MyGUI_ControllerManager.h"
 #include "MyGUI_WidgetManager.h"
 #include "MyGUI_FactoryManager.h"
+#include "MyGUI_Profiler.h"
 
 #include "MyGUI_ControllerEdgeHide.h"
 #include "MyGUI_ControllerFadeAlpha.h"
 #include "MyGUI_ControllerPosition.h"
 #include "MyGUI_ControllerRepeatClick.h"
 
+#include <algorithm>
+
 namespace MyGUI
 {
 
 	MYGUI_SINGLETON_DEFINITION(ControllerManager);
 
 	ControllerManager::ControllerManager() :
+		mItemCount(0),
+		mNeedCompaction(false),
 		mIsInitialise(false),
 		mCategoryName("Controller"),
 		mSingletonHolder(this)
 	{
+		mTracks[TrackItem] = &mItemTrack;
+		mTracks[TrackFadeAlpha] = &mFadeAlphaTrack;
+		mTracks[TrackPosition] = &mPositionTrack;
 	}
 
 	void ControllerManager::initialise()
@@ -62,11 +70,21 @@ namespace MyGUI
 
 	void ControllerManager::clear()
 	{
-		for (ListControllerItem::iterator iter = mListItem.begin(); iter != mListItem.end(); ++iter)
+		for (size_t index = 0; index < TrackCount; ++index)
 		{
-			delete (*iter).second;
+			Track& track = *mTracks[index];
+			for (VectorControllerItem::iterator iter = track.items.begin(); iter != track.items.end(); ++iter)
+				delete (*iter);
+			track.resize(0);
 		}
-		mListItem.clear();
+
+		for (VectorControllerItem::iterator iter = mDeletedItems.begin(); iter != mDeletedItems.end(); ++iter)
+			delete (*iter);
+		mDeletedItems.clear();
+
+		mWidgetItems.clear();
+		mItemCount = 0;
+		mNeedCompaction = false;
 	}
 
 	ControllerItem* ControllerManager::createItem(const std::string& _type)
@@ -80,35 +98,64 @@ namespace MyGUI
 		// подготавливаем
 		_item->prepareItem(_widget);
 
-		for (ListControllerItem::iterator iter = mListItem.begin(); iter != mListItem.end(); ++iter)
+		VectorControllerItem& widgetItems = mWidgetItems[_widget];
+		for (VectorControllerItem::iterator iter = widgetItems.begin(); iter != widgetItems.end(); ++iter)
 		{
 			// такой уже в списке есть
-			if ((*iter).first == _widget)
+			if ((*iter)->getTypeName() == _item->getTypeName())
 			{
-				if ((*iter).second->getTypeName() == _item->getTypeName())
-				{
-					delete (*iter).second;
-					(*iter).second = _item;
-					return;
-				}
+				ControllerItem* previous = *iter;
+				_item->mTrack = previous->mTrack;
+				_item->mTrackIndex = previous->mTrackIndex;
+				previous->mTrackIndex = ITEM_NONE;
+
+				Track& track = *mTracks[_item->mTrack];
+				track.items[_item->mTrackIndex] = _item;
+				track.load(_item->mTrackIndex, true);
+
+				(*iter) = _item;
+				mDeletedItems.push_back(previous);
+				mNeedCompaction = true;
+				return;
 			}
 		}
 
 		// если виджет первый, то подписываемся на кадры
-		if (mListItem.empty())
+		if (mItemCount == 0)
 			Gui::getInstance().eventFrameStart += newDelegate(this, &ControllerManager::frameEntered);
 
-		// вставляем в самый конец
-		mListItem.push_back(PairControllerItem(_widget, _item));
+		size_t track = TrackItem;
+		if (_item->getTypeName() == ControllerFadeAlpha::getClassTypeName())
+			track = TrackFadeAlpha;
+		else if (_item->getTypeName() == ControllerPosition::getClassTypeName())
+			track = TrackPosition;
+
+		_item->mTrack = track;
+		_item->mTrackIndex = mTracks[track]->widgets.size();
+		mTracks[track]->add(_widget, _item);
+
+		widgetItems.push_back(_item);
+		mItemCount ++;
 	}
 
 	void ControllerManager::removeItem(Widget* _widget)
 	{
+		MapWidgetItem::iterator widgetItems = mWidgetItems.find(_widget);
+		if (widgetItems == mWidgetItems.end())
+			return;
+
 		// не удаляем из списка, а обнуляем, в цикле он будет удален
-		for (ListControllerItem::iterator iter = mListItem.begin(); iter != mListItem.end(); ++iter)
-		{
-			if ((*iter).first == _widget) (*iter).first = nullptr;
-		}
+		for (VectorControllerItem::iterator iter = widgetItems->second.begin(); iter != widgetItems->second.end(); ++iter)
+			mTracks[(*iter)->mTrack]->widgets[(*iter)->mTrackIndex] = nullptr;
+
+		mWidgetItems.erase(widgetItems);
+		mNeedCompaction = true;
+	}
+
+	void ControllerManager::_updateItem(ControllerItem* _item)
+	{
+		if (_item->mTrackIndex != ITEM_NONE)
+			mTracks[_item->mTrack]->load(_item->mTrackIndex, false);
 	}
 
 	void ControllerManager::_unlinkWidget(Widget* _widget)
@@ -118,28 +165,324 @@ namespace MyGUI
 
 	void ControllerManager::frameEntered(float _time)
 	{
-		for (ListControllerItem::iterator iter = mListItem.begin(); iter != mListItem.end(); /*added in body*/)
+		MYGUI_PROFILE_SCOPE("ControllerManager::frameEntered");
+
+		updateItemTrack(_time);
+		updateFadeAlphaTrack(_time);
+		updatePositionTrack(_time);
+
+		if (mNeedCompaction)
+			compactTracks();
+
+		if (mItemCount == 0)
+			Gui::getInstance().eventFrameStart -= newDelegate(this, &ControllerManager::frameEntered);
+	}
+
+	void ControllerManager::updateItemTrack(float _time)
+	{
+		Track& track = mItemTrack;
+
+		// controllers added by event handlers are updated in the same frame
+		for (size_t index = 0; index < track.widgets.size(); ++index)
 		{
-			if (nullptr == (*iter).first)
-			{
-				delete (*iter).second;
-				// удаляем из списка, итератор не увеличиваем и на новый круг
-				iter = mListItem.erase(iter);
+			Widget* widget = track.widgets[index];
+			if (widget == nullptr)
 				continue;
+
+			ControllerItem* item = track.items[index];
+			if (!item->addTime(widget, _time))
+				finishItem(track, index, item);
+		}
+	}
+
+	void ControllerManager::updateFadeAlphaTrack(float _time)
+	{
+		FadeAlphaTrack& track = mFadeAlphaTrack;
+
+		// controllers added by event handlers are updated in the next frame
+		size_t count = track.widgets.size();
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			Widget* widget = track.widgets[index];
+			track.current[index] = widget != nullptr ? widget->getAlpha() : ALPHA_MIN;
+		}
+
+		// same steps as in ControllerFadeAlpha::addTime, without branches so loop can be vectorised
+		for (size_t index = 0; index < count; ++index)
+		{
+			float current = track.current[index];
+			float alpha = track.alpha[index];
+			float step = _time * track.coef[index];
+			float increased = current + step;
+			float decreased = current - step;
+			bool increase = alpha > current;
+			bool moving = increase ? alpha > increased : alpha < decreased;
+			track.next[index] = moving ? (increase ? increased : decreased) : alpha;
+			track.finished[index] = moving ? 0 : 1;
+		}
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			Widget* widget = track.widgets[index];
+			if (widget == nullptr)
+				continue;
+
+			ControllerItem* item = track.items[index];
+			widget->setAlpha(track.next[index]);
+
+			if (track.finished[index] == 0)
+			{
+				item->eventUpdateAction(widget, item);
+			}
+			else
+			{
+				// вызываем пользовательский делегат пост обработки
+				item->eventPostAction(widget, item);
+				finishItem(track, index, item);
 			}
+		}
+	}
 
-			if ((*iter).second->addTime((*iter).first, _time))
+	void ControllerManager::updatePositionTrack(float _time)
+	{
+		PositionTrack& track = mPositionTrack;
+
+		// controllers added by event handlers are updated in the next frame
+		size_t count = track.widgets.size();
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			float elapsed = track.elapsed[index] + _time;
+			bool finished = !(elapsed < track.time[index]);
+			track.elapsed[index] = elapsed;
+			track.factor[index] = finished ? 1.0f : elapsed / track.time[index];
+			track.finished[index] = finished ? 1 : 0;
+		}
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			float& factor = track.factor[index];
+			switch (track.function[index])
 			{
-				++iter;
+			case ControllerPosition::FunctionInertional:
+				factor = action::inertionalMoveFactor(factor);
+				break;
+			case ControllerPosition::FunctionAccelerated:
+				factor = action::acceleratedMoveFactor<30>(factor);
+				break;
+			case ControllerPosition::FunctionSlowed:
+				factor = action::acceleratedMoveFactor<4>(factor);
+				break;
+			case ControllerPosition::FunctionJump:
+				factor = action::jumpMoveFactor<5>(factor);
+				break;
+			default:
+				break;
+			}
+		}
+
+		// same as action::linearMoveFunction
+		for (size_t index = 0; index < count; ++index)
+		{
+			const IntCoord& start = track.start[index];
+			const IntCoord& dest = track.dest[index];
+			float factor = track.factor[index];
+			track.result[index].set(
+				start.left - int(float(start.left - dest.left) * factor),
+				start.top - int(float(start.top - dest.top) * factor),
+				start.width - int(float(start.width - dest.width) * factor),
+				start.height - int(float(start.height - dest.height) * factor));
+		}
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			if (track.function[index] != ControllerPosition::FunctionCustom || track.widgets[index] == nullptr)
+				continue;
+
+			// user function can add controllers, so nothing is passed by reference into tracks
+			IntCoord start = track.start[index];
+			IntCoord dest = track.dest[index];
+			IntCoord coord;
+			ControllerPosition* item = static_cast<ControllerPosition*>(track.items[index]);
+			item->eventFrameAction(start, dest, coord, track.factor[index]);
+			track.result[index] = coord;
+		}
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			Widget* widget = track.widgets[index];
+			if (widget == nullptr)
 				continue;
+
+			// slow movement changes coordinate not in every frame, widget is not updated then
+			ControllerItem* item = track.items[index];
+			IntCoord coord = track.result[index];
+			if (track.calcPosition[index] != 0)
+			{
+				if (track.calcSize[index] != 0)
+				{
+					if (widget->getCoord() != coord)
+						widget->setCoord(coord);
+				}
+				else if (widget->getPosition() != coord.point())
+				{
+					widget->setPosition(coord.point());
+				}
+			}
+			else if (track.calcSize[index] != 0 && widget->getSize() != coord.size())
+			{
+				widget->setSize(coord.size());
 			}
 
-			// на следующей итерации виджет вылетит из списка
-			(*iter).first = nullptr;
+			// вызываем пользовательский делегат обновления
+			item->eventUpdateAction(widget, item);
+
+			if (track.finished[index] != 0)
+			{
+				// вызываем пользовательский делегат пост обработки
+				item->eventPostAction(widget, item);
+				finishItem(track, index, item);
+			}
 		}
+	}
 
-		if (mListItem.empty())
-			Gui::getInstance().eventFrameStart -= newDelegate(this, &ControllerManager::frameEntered);
+	void ControllerManager::finishItem(Track& _track, size_t _index, ControllerItem* _item)
+	{
+		// event handler could already remove or replace controller
+		Widget* widget = _track.widgets[_index];
+		if (widget == nullptr || _track.items[_index] != _item)
+			return;
+
+		MapWidgetItem::iterator widgetItems = mWidgetItems.find(widget);
+		VectorControllerItem& items = widgetItems->second;
+		items.erase(std::find(items.begin(), items.end(), _item));
+		if (items.empty())
+			mWidgetItems.erase(widgetItems);
+
+		// на следующей итерации виджет вылетит из списка
+		_track.widgets[_index] = nullptr;
+		mNeedCompaction = true;
+	}
+
+	void ControllerManager::compactTracks()
+	{
+		for (size_t trackIndex = 0; trackIndex < TrackCount; ++trackIndex)
+		{
+			Track& track = *mTracks[trackIndex];
+
+			size_t count = 0;
+			for (size_t index = 0; index < track.widgets.size(); ++index)
+			{
+				if (track.widgets[index] == nullptr)
+				{
+					delete track.items[index];
+					mItemCount --;
+				}
+				else
+				{
+					if (index != count)
+						track.move(index, count);
+					count ++;
+				}
+			}
+			track.resize(count);
+		}
+
+		for (VectorControllerItem::iterator iter = mDeletedItems.begin(); iter != mDeletedItems.end(); ++iter)
+			delete (*iter);
+		mDeletedItems.clear();
+
+		mNeedCompaction = false;
+	}
+
+	void ControllerManager::Track::add(Widget* _widget, ControllerItem* _item)
+	{
+		size_t index = widgets.size();
+		resize(index + 1);
+		widgets[index] = _widget;
+		items[index] = _item;
+		load(index, true);
+	}
+
+	void ControllerManager::Track::move(size_t _from, size_t _to)
+	{
+		widgets[_to] = widgets[_from];
+		items[_to] = items[_from];
+		items[_to]->mTrackIndex = _to;
+	}
+
+	void ControllerManager::Track::resize(size_t _size)
+	{
+		widgets.resize(_size);
+		items.resize(_size);
+	}
+
+	void ControllerManager::FadeAlphaTrack::load(size_t _index, bool _state)
+	{
+		ControllerFadeAlpha* item = static_cast<ControllerFadeAlpha*>(items[_index]);
+		alpha[_index] = item->mAlpha;
+		coef[_index] = item->mCoef;
+	}
+
+	void ControllerManager::FadeAlphaTrack::move(size_t _from, size_t _to)
+	{
+		Track::move(_from, _to);
+		alpha[_to] = alpha[_from];
+		coef[_to] = coef[_from];
+	}
+
+	void ControllerManager::FadeAlphaTrack::resize(size_t _size)
+	{
+		Track::resize(_size);
+		alpha.resize(_size);
+		coef.resize(_size);
+		current.resize(_size);
+		next.resize(_size);
+		finished.resize(_size);
+	}
+
+	void ControllerManager::PositionTrack::load(size_t _index, bool _state)
+	{
+		ControllerPosition* item = static_cast<ControllerPosition*>(items[_index]);
+		dest[_index] = item->mDestCoord;
+		time[_index] = item->mTime;
+		function[_index] = (uint8)item->mFunction;
+		calcPosition[_index] = item->mCalcPosition ? 1 : 0;
+		calcSize[_index] = item->mCalcSize ? 1 : 0;
+
+		if (_state)
+		{
+			start[_index] = item->mStartCoord;
+			elapsed[_index] = item->mElapsedTime;
+		}
+	}
+
+	void ControllerManager::PositionTrack::move(size_t _from, size_t _to)
+	{
+		Track::move(_from, _to);
+		start[_to] = start[_from];
+		dest[_to] = dest[_from];
+		time[_to] = time[_from];
+		elapsed[_to] = elapsed[_from];
+		function[_to] = function[_from];
+		calcPosition[_to] = calcPosition[_from];
+		calcSize[_to] = calcSize[_from];
+	}
+
+	void ControllerManager::PositionTrack::resize(size_t _size)
+	{
+		Track::resize(_size);
+		start.resize(_size);
+		dest.resize(_size);
+		time.resize(_size);
+		elapsed.resize(_size);
+		function.resize(_size);
+		calcPosition.resize(_size);
+		calcSize.resize(_size);
+		factor.resize(_size);
+		result.resize(_size);
+		finished.resize(_size);
 	}
 
 	const std::string& ControllerManager::getCategoryName() const
@@ -11,6 +11,7 @@
 #include "MyGUI_WidgetManager.h"
 #include "MyGUI_Widget.h"
 #include "MyGUI_ActionController.h"
+#include "MyGUI_ControllerManager.h"
 
 namespace MyGUI
 {
@@ -19,7 +20,8 @@ namespace MyGUI
 		mTime(1),
 		mElapsedTime(0),
 		mCalcPosition(false),
-		mCalcSize(false)
+		mCalcSize(false),
+		mFunction(FunctionCustom)
 	{
         setFunction("Linear");
 	}
@@ -29,6 +31,7 @@ namespace MyGUI
 		mDestCoord = _destCoord;
 		mCalcPosition = true;
 		mCalcSize = true;
+		updateItem();
 	}
 
 	void ControllerPosition::setSize(const IntSize& _destSize)
@@ -37,6 +40,7 @@ namespace MyGUI
 		mDestCoord.height = _destSize.height;
 		mCalcPosition = false;
 		mCalcSize = true;
+		updateItem();
 	}
 
 	void ControllerPosition::setPosition(const IntPoint& _destPoint)
@@ -45,6 +49,7 @@ namespace MyGUI
 		mDestCoord.top = _destPoint.top;
 		mCalcPosition = true;
 		mCalcSize = false;
+		updateItem();
 	}
 
 	void ControllerPosition::prepareItem(Widget* _widget)
@@ -114,25 +119,41 @@ namespace MyGUI
 	void ControllerPosition::setFunction(const std::string& _value)
 	{
 		if (_value == "Linear")
-			setAction(MyGUI::newDelegate(action::linearMoveFunction));
+			setAction(MyGUI::newDelegate(action::linearMoveFunction), FunctionLinear);
 		else if (_value == "Inertional")
-			setAction(MyGUI::newDelegate(action::inertionalMoveFunction));
+			setAction(MyGUI::newDelegate(action::inertionalMoveFunction), FunctionInertional);
 		else if (_value == "Accelerated")
-			setAction(MyGUI::newDelegate(action::acceleratedMoveFunction<30>));
+			setAction(MyGUI::newDelegate(action::acceleratedMoveFunction<30>), FunctionAccelerated);
 		else if (_value == "Slowed")
-			setAction(MyGUI::newDelegate(action::acceleratedMoveFunction<4>));
+			setAction(MyGUI::newDelegate(action::acceleratedMoveFunction<4>), FunctionSlowed);
 		else if (_value == "Jump")
-			setAction(MyGUI::newDelegate(action::jumpMoveFunction<5>));
+			setAction(MyGUI::newDelegate(action::jumpMoveFunction<5>), FunctionJump);
 	}
 
 	void ControllerPosition::setTime(float _value)
 	{
 		mTime = _value;
+		updateItem();
 	}
 
 	void ControllerPosition::setAction(FrameAction::IDelegate* _value)
+	{
+		setAction(_value, FunctionCustom);
+	}
+
+	void ControllerPosition::setAction(FrameAction::IDelegate* _value, Function _function)
 	{
 		eventFrameAction = _value;
+		mFunction = _function;
+		updateItem();
+	}
+
+	void ControllerPosition::updateItem()
+	{
+		// working controller is updated by manager with its own copy of parameters
+		ControllerManager* manager = ControllerManager::getInstancePtr();
+		if (manager != nullptr)
+			manager->_updateItem(this);
 	}
 
 } // namespace MyGUI
@@ -48,9 +48,9 @@ namespace MyGUI
 	size_t DataStream::read(void* _buf, size_t _count)
 	{
 		if (mStream == nullptr) return 0;
-		size_t count = std::min(size(), _count);
-		mStream->read((char*)_buf, count);
-		return count;
+		// count of bytes actually read, it is less at the end of stream
+		mStream->read((char*)_buf, _count);
+		return (size_t)mStream->gcount();
 	}
 
 } // namespace MyGUI
@@ -962,7 +962,7 @@ namespace MyGUI
 		mVectorUndoChangeInfo.pop_back();
 		mVectorRedoChangeInfo.push_back(info);
 
-		UString::utf32string text = getRealString().asUTF32();
+		TextBuffer& text = lockRealString();
 
 		// apply undo
 		for (VectorChangeInfo::const_reverse_iterator iter = info.rbegin(); iter != info.rend(); ++iter)
@@ -972,9 +972,11 @@ namespace MyGUI
 			{
 			case TextCommandInfo::COMMAND_INSERT:
 				text.erase(change.start, change.text.size());
+				notifyRealStringChange(change.start, change.text.size(), 0);
 				break;
 			case TextCommandInfo::COMMAND_ERASE:
 				text.insert(change.start, change.text);
+				notifyRealStringChange(change.start, 0, change.text.size());
 				break;
 			case TextCommandInfo::COMMAND_POSITION:
 				mCursorPosition = change.undo;
@@ -983,7 +985,7 @@ namespace MyGUI
 			}
 		}
 
-		setRealString(UString(text));
+		unlockRealString();
 
 		// restore cursor position
 		if (mClientText != nullptr)
@@ -1009,7 +1011,7 @@ namespace MyGUI
 		mVectorRedoChangeInfo.pop_back();
 		mVectorUndoChangeInfo.push_back(info);
 
-		UString::utf32string text = getRealString().asUTF32();
+		TextBuffer& text = lockRealString();
 
 		// apply redo
 		for (const auto& change : info)
@@ -1018,9 +1020,11 @@ namespace MyGUI
 			{
 			case TextCommandInfo::COMMAND_INSERT:
 				text.insert(change.start, change.text);
+				notifyRealStringChange(change.start, 0, change.text.size());
 				break;
 			case TextCommandInfo::COMMAND_ERASE:
 				text.erase(change.start, change.text.size());
+				notifyRealStringChange(change.start, change.text.size(), 0);
 				break;
 			case TextCommandInfo::COMMAND_POSITION:
 				mCursorPosition = change.redo;
@@ -1030,7 +1034,7 @@ namespace MyGUI
 
 		}
 
-		setRealString(UString(text));
+		unlockRealString();
 
 		// restore cursor position
 		if (mClientText != nullptr)
@@ -1075,6 +1079,9 @@ namespace MyGUI
 		// нужно ли вставлять цвет
 		bool need_colour = true;
 
+		// text without tags isn't walked up to start of range
+		iterator.skipTo(_start);
+
 		// цикл прохода по строке
 		while (iterator.moveNext())
 		{
@@ -1123,11 +1130,14 @@ namespace MyGUI
 		size_t end = _start + _count;
 
 		// итератор нашей строки
-		TextIterator iterator(getRealString(), history);
+		TextIterator iterator(lockRealString(), history);
 
 		// дефолтный цвет
 		UString colour = mClientText == nullptr ? "" : TextIterator::convertTagColour(mClientText->getTextColour());
 
+		// text without tags isn't walked up to start of range
+		iterator.skipTo(_start);
+
 		// цикл прохода по строке
 		while (iterator.moveNext())
 		{
@@ -1173,7 +1183,7 @@ namespace MyGUI
 			commandResetHistory();
 
 		// и возвращаем строку на место
-		setRealString(iterator.getText());
+		unlockRealString(iterator);
 	}
 
 	void EditBox::setTextSelectColour(const Colour& _colour, bool _history)
@@ -1235,7 +1245,7 @@ namespace MyGUI
 			history = new VectorChangeInfo();
 
 		// итератор нашей строки
-		TextIterator iterator(getRealString(), history);
+		TextIterator iterator(lockRealString(), history);
 
 		// вставляем текст
 		iterator.setText(_caption, mModeMultiline || mModeWordWrap);
@@ -1269,7 +1279,7 @@ namespace MyGUI
 			commandResetHistory();
 
 		// и возвращаем строку на место
-		setRealString(iterator.getText());
+		unlockRealString(iterator);
 
 		// обновляем по позиции
 		if (mClientText != nullptr)
@@ -1295,7 +1305,7 @@ namespace MyGUI
 			history = new VectorChangeInfo();
 
 		// итератор нашей строки
-		TextIterator iterator(getRealString(), history);
+		TextIterator iterator(lockRealString(), history);
 
 		// дефолтный цвет
 		UString colour = mClientText == nullptr ? "" : TextIterator::convertTagColour(mClientText->getTextColour());
@@ -1303,6 +1313,9 @@ namespace MyGUI
 		// потом переделать через TextIterator чтобы отвязать понятие тег от эдита
 		bool need_colour = ( (_text.size() > 6) && (_text[0] == L'#') && (_text[1] != L'#') );
 
+		// text without tags isn't walked up to start of range
+		iterator.skipTo(_start);
+
 		// цикл прохода по строке
 		while (iterator.moveNext())
 		{
@@ -1355,7 +1368,7 @@ namespace MyGUI
 			commandResetHistory();
 
 		// и возвращаем строку на место
-		setRealString(iterator.getText());
+		unlockRealString(iterator);
 
 		// обновляем по позиции
 		if (mClientText != nullptr)
@@ -1378,7 +1391,7 @@ namespace MyGUI
 			history = new VectorChangeInfo();
 
 		// итератор нашей строки
-		TextIterator iterator(getRealString(), history);
+		TextIterator iterator(lockRealString(), history);
 
 		// дефолтный цвет
 		UString colour;
@@ -1386,6 +1399,9 @@ namespace MyGUI
 		size_t end = _start + _count;
 		bool need_colour = false;
 
+		// text without tags isn't walked up to start of range
+		iterator.skipTo(_start);
+
 		// цикл прохода по строке
 		while (iterator.moveNext())
 		{
@@ -1459,7 +1475,7 @@ namespace MyGUI
 			commandResetHistory();
 
 		// и возвращаем строку на место
-		setRealString(iterator.getText());
+		unlockRealString(iterator);
 
 		// обновляем по позиции
 		if (mClientText != nullptr)
@@ -1537,6 +1553,44 @@ namespace MyGUI
 		}
 	}
 
+	TextBuffer& EditBox::lockRealString()
+	{
+		TextBuffer* text = (mModePassword || mClientText == nullptr) ? nullptr : mClientText->_getTextBuffer();
+		if (text != nullptr)
+			return *text;
+
+		mRealStringBuffer.assign(getRealString().asUTF32());
+		return mRealStringBuffer;
+	}
+
+	void EditBox::notifyRealStringChange(size_t _start, size_t _erased, size_t _inserted)
+	{
+		// text that is not edited in place is set again on unlock
+		TextBuffer* text = (mModePassword || mClientText == nullptr) ? nullptr : mClientText->_getTextBuffer();
+		if (text != nullptr)
+			mClientText->_notifyCaptionChanged(_start, _erased, _inserted);
+	}
+
+	void EditBox::unlockRealString()
+	{
+		TextBuffer* text = (mModePassword || mClientText == nullptr) ? nullptr : mClientText->_getTextBuffer();
+		if (text != nullptr)
+			return;
+
+		setRealString(UString(mRealStringBuffer.str()));
+		mRealStringBuffer.clear();
+	}
+
+	void EditBox::unlockRealString(const TextIterator& _iterator)
+	{
+		size_t start = 0;
+		size_t erased = 0;
+		size_t inserted = 0;
+		if (_iterator.getChangedRange(start, erased, inserted))
+			notifyRealStringChange(start, erased, inserted);
+		unlockRealString();
+	}
+
 	void EditBox::setPasswordChar(Char _char)
 	{
 		mCharPassword = _char;
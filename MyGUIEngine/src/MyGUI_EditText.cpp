@@ -18,7 +18,7 @@
 namespace MyGUI
 {
 
-	const size_t SIMPLETEXT_COUNT_VERTEX = 32 * VertexQuad::VertexCount;
+	const size_t SIMPLETEXT_COUNT_VERTEX = 32 * IndexedVertexQuad::VertexCount;
 
 	EditText::EditText() :
 		ISubWidgetText(),
@@ -26,6 +26,7 @@ namespace MyGUI
 		mCurrentColourNative(0xFFFFFFFF),
 		mInverseColourNative(0xFF000000),
 		mShadowColourNative(0x00000000),
+		mCaptionOutDate(false),
 		mTextOutDate(false),
 		mTextAlign(Align::Default),
 		mColour(Colour::White),
@@ -34,6 +35,7 @@ namespace MyGUI
 		mFont(nullptr),
 		mTexture(nullptr),
 		mFontHeight(0),
+		mFontTextureVersion(0),
 		mBackgroundNormal(true),
 		mStartSelect(0),
 		mEndSelect(0),
@@ -41,6 +43,7 @@ namespace MyGUI
 		mVisibleCursor(false),
 		mInvertSelect(true),
 		mShadow(false),
+		mVisibleLinesOnly(true),
 		mNode(nullptr),
 		mRenderItem(nullptr),
 		mCountVertex(SIMPLETEXT_COUNT_VERTEX),
@@ -60,13 +63,13 @@ namespace MyGUI
 		mVisible = _visible;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::_correctView()
 	{
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::_setAlign(const IntSize& _oldsize)
@@ -141,7 +144,7 @@ namespace MyGUI
 
 				// обновить перед выходом
 				if (nullptr != mNode)
-					mNode->outOfDate(mRenderItem);
+					mNode->outOfDate(mRenderItem, this);
 				return;
 			}
 		}
@@ -157,25 +160,47 @@ namespace MyGUI
 		mIsMargin = margin;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::setCaption(const UString& _value)
 	{
+		size_t oldSize = mTextBuffer.size();
 		mCaption = _value;
-		mUtf32Caption = mCaption.asUTF32();
+		mCaptionOutDate = false;
+		mTextBuffer.assign(mCaption.asUTF32());
 		mTextOutDate = true;
-
-		checkVertexSize();
+		mTextView.notifyTextChange(0, oldSize, mTextBuffer.size());
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
+	}
+
+	void EditText::_prepareRender()
+	{
+		checkVertexSize();
 	}
 
 	void EditText::checkVertexSize()
 	{
+		if (nullptr == mFont || !mVisible || mEmptyView)
+			return;
+
+		if (mTextOutDate || mFontTextureVersion != mFont->getTextureVersion())
+			updateRawData();
+
+		// only visible lines are tessellated
+		size_t firstLine = 0;
+		size_t lastLine = 0;
+		getVisibleLines(firstLine, lastLine);
+
+		const VectorLineInfo& textViewData = mTextView.getData();
+		size_t count = 0;
+		for (size_t line = firstLine; line < lastLine; ++line)
+			count += textViewData[line].count;
+
 		// reallocate if we need more vertices (extra vertices for selection * 2 and cursor)
-		size_t need = (mUtf32Caption.size() * (mShadow ? 3 : 2) + 2) * VertexQuad::VertexCount;
+		size_t need = (count * (mShadow ? 3 : 2) + 2) * IndexedVertexQuad::VertexCount;
 		if (mCountVertex < need)
 		{
 			mCountVertex = need + SIMPLETEXT_COUNT_VERTEX;
@@ -191,9 +216,29 @@ namespace MyGUI
 
 	const UString& EditText::getCaption() const
 	{
+		if (mCaptionOutDate)
+		{
+			mCaption = UString(mTextBuffer.str());
+			mCaptionOutDate = false;
+		}
 		return mCaption;
 	}
 
+	TextBuffer* EditText::_getTextBuffer()
+	{
+		return &mTextBuffer;
+	}
+
+	void EditText::_notifyCaptionChanged(size_t _start, size_t _erased, size_t _inserted)
+	{
+		mCaptionOutDate = true;
+		mTextOutDate = true;
+		mTextView.notifyTextChange(_start, _erased, _inserted);
+
+		if (nullptr != mNode)
+			mNode->outOfDate(mRenderItem, this);
+	}
+
 	void EditText::setTextColour(const Colour& _value)
 	{
 		mManualColour = true;
@@ -212,7 +257,7 @@ namespace MyGUI
 		mInverseColourNative = mCurrentColourNative ^ 0x00FFFFFF;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	const Colour& EditText::getTextColour() const
@@ -231,7 +276,7 @@ namespace MyGUI
 		mInverseColourNative = mCurrentColourNative ^ 0x00FFFFFF;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::setFontName(const std::string& _value)
@@ -262,11 +307,11 @@ namespace MyGUI
 		if (nullptr != mTexture && nullptr != mNode)
 		{
 			mRenderItem = mNode->addToRenderItem(mTexture, false, false);
-			mRenderItem->addDrawItem(this, mCountVertex);
+			mRenderItem->addDrawItem(this, mCountVertex, true);
 		}
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	const std::string& EditText::getFontName() const
@@ -280,7 +325,7 @@ namespace MyGUI
 		mTextOutDate = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	int EditText::getFontHeight() const
@@ -297,7 +342,7 @@ namespace MyGUI
 			MYGUI_ASSERT(!mRenderItem, "mRenderItem must be nullptr");
 
 			mRenderItem = mNode->addToRenderItem(mTexture, false, false);
-			mRenderItem->addDrawItem(this, mCountVertex);
+			mRenderItem->addDrawItem(this, mCountVertex, true);
 		}
 	}
 
@@ -327,7 +372,7 @@ namespace MyGUI
 		mEndSelect = _end;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	bool EditText::getSelectBackground() const
@@ -342,7 +387,7 @@ namespace MyGUI
 		mBackgroundNormal = _normal;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	bool EditText::isVisibleCursor() const
@@ -357,7 +402,7 @@ namespace MyGUI
 		mVisibleCursor = _value;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	size_t EditText::getCursorPosition() const
@@ -372,15 +417,17 @@ namespace MyGUI
 		mCursorPosition = _index;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::setTextAlign(Align _value)
 	{
 		mTextAlign = _value;
+		// line offsets depend on align
+		mTextOutDate = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	Align EditText::getTextAlign() const
@@ -419,7 +466,7 @@ namespace MyGUI
 		mViewOffset = _point;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	IntPoint EditText::getViewOffset() const
@@ -466,7 +513,7 @@ namespace MyGUI
 		mShiftText = _value;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::setWordWrap(bool _value)
@@ -475,7 +522,7 @@ namespace MyGUI
 		mTextOutDate = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::updateRawData() const
@@ -484,6 +531,7 @@ namespace MyGUI
 			return;
 		// сбрасывам флаги
 		mTextOutDate = false;
+		mFontTextureVersion = mFont->getTextureVersion();
 
 		int width = -1;
 		if (mWordWrap)
@@ -494,7 +542,7 @@ namespace MyGUI
 				width -= 2;
 		}
 
-		mTextView.update(mUtf32Caption, mFont, mFontHeight, mTextAlign, mVertexFormat, width);
+		mTextView.update(mTextBuffer, mFont, mFontHeight, mTextAlign, mVertexFormat, width);
 	}
 
 	void EditText::setStateData(IStateInfo* _data)
@@ -510,15 +558,14 @@ namespace MyGUI
 		if (nullptr == mFont || !mVisible || mEmptyView)
 			return;
 
-		if (mRenderItem->getCurrentUpdate() || mTextOutDate)
+		// glyph texture coordinates copied to text view are out of date after font texture was repacked
+		if (mRenderItem->getCurrentUpdate() || mTextOutDate || mFontTextureVersion != mFont->getTextureVersion())
 			updateRawData();
 
-		Vertex* vertex = mRenderItem->getCurrentVertexBuffer();
-
 		const RenderTargetInfo& renderTargetInfo = mRenderItem->getRenderTarget()->getInfo();
 
-		// колличество отрисованных вершин
-		size_t vertexCount = 0;
+		// quads are collected first and converted to vertices together
+		mGlyphBatch.clear();
 
 		// текущие цвета
 		uint32 colour = mCurrentColourNative;
@@ -527,15 +574,28 @@ namespace MyGUI
 
 		const VectorLineInfo& textViewData = mTextView.getData();
 
-		float top = (float)(-mViewOffset.top + mCoord.top);
+		size_t firstLine = 0;
+		size_t lastLine = 0;
+		getVisibleLines(firstLine, lastLine);
+
+		// state left by colour tags and characters of lines above
+		uint32 lineColour = 0;
+		if (firstLine < lastLine && mTextView.getLineColour(firstLine, lineColour))
+		{
+			colour = lineColour | (colour & 0xFF000000);
+			inverseColour = colour ^ 0x00FFFFFF;
+			selectedColour = mInvertSelect ? inverseColour : colour | 0x00FFFFFF;
+		}
+
+		size_t index = firstLine < lastLine ? mTextView.getLineStart(firstLine) : 0;
+
+		float top = (float)(-mViewOffset.top + mCoord.top + (int)firstLine * mFontHeight);
 
 		FloatRect vertexRect;
 
 		const FloatRect& selectedUVRect = mFont->getGlyphInfo(mBackgroundNormal ? FontCodeType::Selected : FontCodeType::SelectedBack)->uvRect;
 
-		size_t index = 0;
-
-		for (VectorLineInfo::const_iterator line = textViewData.begin(); line != textViewData.end(); ++line)
+		for (VectorLineInfo::const_iterator line = textViewData.begin() + firstLine; line != textViewData.begin() + lastLine; ++line)
 		{
 			float left = (float)(line->offset - mViewOffset.left + mCoord.left);
 
@@ -559,7 +619,7 @@ namespace MyGUI
 				{
 					vertexRect.set(left, top, left + fullAdvance, top + (float)mFontHeight);
 
-					drawGlyph(renderTargetInfo, vertex, vertexCount, vertexRect, selectedUVRect, selectedColour);
+					mGlyphBatch.add(vertexRect, selectedUVRect, selectedColour);
 				}
 
 				// Render the glyph shadow, if any.
@@ -570,7 +630,7 @@ namespace MyGUI
 					vertexRect.right = vertexRect.left + sim->getWidth();
 					vertexRect.bottom = vertexRect.top + sim->getHeight();
 
-					drawGlyph(renderTargetInfo, vertex, vertexCount, vertexRect, sim->getUVRect(), mShadowColourNative);
+					mGlyphBatch.add(vertexRect, sim->getUVRect(), mShadowColourNative);
 				}
 
 				// Render the glyph itself.
@@ -579,7 +639,7 @@ namespace MyGUI
 				vertexRect.right = vertexRect.left + sim->getWidth();
 				vertexRect.bottom = vertexRect.top + sim->getHeight();
 
-				drawGlyph(renderTargetInfo, vertex, vertexCount, vertexRect, sim->getUVRect(), (!select || !mInvertSelect) ? colour : inverseColour);
+				mGlyphBatch.add(vertexRect, sim->getUVRect(), (!select || !mInvertSelect) ? colour : inverseColour);
 
 				left += fullAdvance;
 				++index;
@@ -596,13 +656,51 @@ namespace MyGUI
 			const GlyphInfo* cursorGlyph = mFont->getGlyphInfo(static_cast<Char>(FontCodeType::Cursor));
 			vertexRect.set((float)point.left, (float)point.top, (float)point.left + cursorGlyph->width, (float)(point.top + mFontHeight));
 
-			drawGlyph(renderTargetInfo, vertex, vertexCount, vertexRect, cursorGlyph->uvRect, mCurrentColourNative | 0x00FFFFFF);
+			mGlyphBatch.add(vertexRect, cursorGlyph->uvRect, mCurrentColourNative | 0x00FFFFFF);
 		}
 
+		FloatRect clip((float)mCurrentCoord.left, (float)mCurrentCoord.top, (float)mCurrentCoord.right(), (float)mCurrentCoord.bottom());
+		float offsetLeft = (float)(mCroppedParent->getAbsoluteLeft() - renderTargetInfo.leftOffset);
+		float offsetTop = (float)(mCroppedParent->getAbsoluteTop() - renderTargetInfo.topOffset) + (mShiftText ? 1.0f : 0.0f);
+		size_t vertexCount = mGlyphBatch.write(mRenderItem->getCurrentVertexBuffer(), clip, offsetLeft, offsetTop, mNode->getNodeDepth(), renderTargetInfo);
+
 		// колличество реально отрисованных вершин
 		mRenderItem->setLastVertexCount(vertexCount);
 	}
 
+	void EditText::getVisibleLines(size_t& _first, size_t& _last) const
+	{
+		size_t count = mTextView.getData().size();
+		_first = 0;
+		_last = count;
+		if (mFontHeight <= 0 || !mVisibleLinesOnly)
+			return;
+
+		// glyphs and their shadow can stick out of line a little, so one more line on each side
+		int top = mCoord.top - mViewOffset.top;
+		int first = (mCurrentCoord.top - top) / mFontHeight - 1;
+		int last = (mCurrentCoord.bottom() - top) / mFontHeight + 2;
+		_first = first > 0 ? (std::min)((size_t)first, count) : 0;
+		_last = last > 0 ? (std::min)((size_t)last, count) : 0;
+		if (_last < _first)
+			_last = _first;
+	}
+
+	void EditText::setVisibleLinesOnly(bool _value)
+	{
+		if (mVisibleLinesOnly == _value)
+			return;
+		mVisibleLinesOnly = _value;
+
+		if (nullptr != mNode)
+			mNode->outOfDate(mRenderItem, this);
+	}
+
+	bool EditText::getVisibleLinesOnly() const
+	{
+		return mVisibleLinesOnly;
+	}
+
 	void EditText::setInvertSelected(bool _value)
 	{
 		if (mInvertSelect == _value)
@@ -610,7 +708,7 @@ namespace MyGUI
 		mInvertSelect = _value;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	bool EditText::getInvertSelected() const
@@ -628,10 +726,8 @@ namespace MyGUI
 		mShadow = _value;
 		mTextOutDate = true;
 
-		checkVertexSize();
-
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void EditText::setShadowColour(const Colour& _value)
@@ -642,7 +738,7 @@ namespace MyGUI
 		mShadowColourNative = (mShadowColourNative & 0x00FFFFFF) | getMixedNativeAlpha(mShadowColour.alpha);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	const Colour& EditText::getShadowColour() const
@@ -650,138 +746,4 @@ namespace MyGUI
 		return mShadowColour;
 	}
 
-	void EditText::drawQuad(
-		Vertex*& _vertex,
-		size_t& _vertexCount,
-		const FloatRect& _vertexRect,
-		float _vertexZ,
-		const FloatRect& _textureRect,
-		uint32 _colour) const
-	{
-		_vertex[0].x = _vertexRect.left;
-		_vertex[0].y = _vertexRect.top;
-		_vertex[0].z = _vertexZ;
-		_vertex[0].colour = _colour;
-		_vertex[0].u = _textureRect.left;
-		_vertex[0].v = _textureRect.top;
-
-		_vertex[2].x = _vertexRect.left;
-		_vertex[2].y = _vertexRect.bottom;
-		_vertex[2].z = _vertexZ;
-		_vertex[2].colour = _colour;
-		_vertex[2].u = _textureRect.left;
-		_vertex[2].v = _textureRect.bottom;
-
-		_vertex[1].x = _vertexRect.right;
-		_vertex[1].y = _vertexRect.top;
-		_vertex[1].z = _vertexZ;
-		_vertex[1].colour = _colour;
-		_vertex[1].u = _textureRect.right;
-		_vertex[1].v = _textureRect.top;
-
-		_vertex[3].x = _vertexRect.right;
-		_vertex[3].y = _vertexRect.top;
-		_vertex[3].z = _vertexZ;
-		_vertex[3].colour = _colour;
-		_vertex[3].u = _textureRect.right;
-		_vertex[3].v = _textureRect.top;
-
-		_vertex[5].x = _vertexRect.left;
-		_vertex[5].y = _vertexRect.bottom;
-		_vertex[5].z = _vertexZ;
-		_vertex[5].colour = _colour;
-		_vertex[5].u = _textureRect.left;
-		_vertex[5].v = _textureRect.bottom;
-
-		_vertex[4].x = _vertexRect.right;
-		_vertex[4].y = _vertexRect.bottom;
-		_vertex[4].z = _vertexZ;
-		_vertex[4].colour = _colour;
-		_vertex[4].u = _textureRect.right;
-		_vertex[4].v = _textureRect.bottom;
-
-		_vertex += VertexQuad::VertexCount;
-		_vertexCount += VertexQuad::VertexCount;
-	}
-
-	void EditText::drawGlyph(
-		const RenderTargetInfo& _renderTargetInfo,
-		Vertex*& _vertex,
-		size_t& _vertexCount,
-		FloatRect _vertexRect,
-		FloatRect _textureRect,
-		uint32 _colour) const
-	{
-		// символ залазиет влево
-		float leftClip = (float)mCurrentCoord.left - _vertexRect.left;
-		if (leftClip > 0.0f)
-		{
-			if ((float)mCurrentCoord.left < _vertexRect.right)
-			{
-				_textureRect.left += _textureRect.width() * leftClip / _vertexRect.width();
-				_vertexRect.left += leftClip;
-			}
-			else
-			{
-				return;
-			}
-		}
-
-		// символ залазиет вправо
-		float rightClip = _vertexRect.right - (float)mCurrentCoord.right();
-		if (rightClip > 0.0f)
-		{
-			if (_vertexRect.left < (float)mCurrentCoord.right())
-			{
-				_textureRect.right -= _textureRect.width() * rightClip / _vertexRect.width();
-				_vertexRect.right -= rightClip;
-			}
-			else
-			{
-				return;
-			}
-		}
-
-		// символ залазиет вверх
-		float topClip = (float)mCurrentCoord.top - _vertexRect.top;
-		if (topClip > 0.0f)
-		{
-			if ((float)mCurrentCoord.top < _vertexRect.bottom)
-			{
-				_textureRect.top += _textureRect.height() * topClip / _vertexRect.height();
-				_vertexRect.top += topClip;
-			}
-			else
-			{
-				return;
-			}
-		}
-
-		// символ залазиет вниз
-		float bottomClip = _vertexRect.bottom - (float)mCurrentCoord.bottom();
-		if (bottomClip > 0.0f)
-		{
-			if (_vertexRect.top < (float)mCurrentCoord.bottom())
-			{
-				_textureRect.bottom -= _textureRect.height() * bottomClip / _vertexRect.height();
-				_vertexRect.bottom -= bottomClip;
-			}
-			else
-			{
-				return;
-			}
-		}
-
-		float pix_left = mCroppedParent->getAbsoluteLeft() - _renderTargetInfo.leftOffset + _vertexRect.left;
-		float pix_top = mCroppedParent->getAbsoluteTop() - _renderTargetInfo.topOffset + (mShiftText ? 1.0f : 0.0f) + _vertexRect.top;
-
-		FloatRect vertexRect(
-			((_renderTargetInfo.pixScaleX * pix_left + _renderTargetInfo.hOffset) * 2.0f) - 1.0f,
-			-(((_renderTargetInfo.pixScaleY * pix_top + _renderTargetInfo.vOffset) * 2.0f) - 1.0f),
-			((_renderTargetInfo.pixScaleX * (pix_left + _vertexRect.width()) + _renderTargetInfo.hOffset) * 2.0f) - 1.0f,
-			-(((_renderTargetInfo.pixScaleY * (pix_top + _vertexRect.height()) + _renderTargetInfo.vOffset) * 2.0f) - 1.0f));
-
-		drawQuad(_vertex, _vertexCount, vertexRect, mNode->getNodeDepth(), _textureRect, _colour);
-	}
-
 } // namespace MyGUI
@@ -0,0 +1,294 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_GlyphBatch.h"
+
+#if !defined(MYGUI_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MYGUI_GLYPH_BATCH_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace MyGUI
+{
+
+	namespace
+	{
+
+		// vertices are written as floats, colour included
+		static_assert(sizeof(Vertex) == 6 * sizeof(float), "Vertex layout changed");
+		static_assert(sizeof(FloatRect) == 4 * sizeof(float), "FloatRect layout changed");
+
+		Vertex* writeQuad(
+			Vertex* _vertex,
+			FloatRect _vertexRect,
+			FloatRect _textureRect,
+			uint32 _colour,
+			const FloatRect& _clip,
+			float _left,
+			float _top,
+			float _z,
+			const RenderTargetInfo& _info)
+		{
+			// символ залазиет влево
+			float leftClip = _clip.left - _vertexRect.left;
+			if (leftClip > 0.0f)
+			{
+				if (_clip.left < _vertexRect.right)
+				{
+					_textureRect.left += _textureRect.width() * leftClip / _vertexRect.width();
+					_vertexRect.left += leftClip;
+				}
+				else
+				{
+					return _vertex;
+				}
+			}
+
+			// символ залазиет вправо
+			float rightClip = _vertexRect.right - _clip.right;
+			if (rightClip > 0.0f)
+			{
+				if (_vertexRect.left < _clip.right)
+				{
+					_textureRect.right -= _textureRect.width() * rightClip / _vertexRect.width();
+					_vertexRect.right -= rightClip;
+				}
+				else
+				{
+					return _vertex;
+				}
+			}
+
+			// символ залазиет вверх
+			float topClip = _clip.top - _vertexRect.top;
+			if (topClip > 0.0f)
+			{
+				if (_clip.top < _vertexRect.bottom)
+				{
+					_textureRect.top += _textureRect.height() * topClip / _vertexRect.height();
+					_vertexRect.top += topClip;
+				}
+				else
+				{
+					return _vertex;
+				}
+			}
+
+			// символ залазиет вниз
+			float bottomClip = _vertexRect.bottom - _clip.bottom;
+			if (bottomClip > 0.0f)
+			{
+				if (_vertexRect.top < _clip.bottom)
+				{
+					_textureRect.bottom -= _textureRect.height() * bottomClip / _vertexRect.height();
+					_vertexRect.bottom -= bottomClip;
+				}
+				else
+				{
+					return _vertex;
+				}
+			}
+
+			float pix_left = _left + _vertexRect.left;
+			float pix_top = _top + _vertexRect.top;
+
+			float left = ((_info.pixScaleX * pix_left + _info.hOffset) * 2.0f) - 1.0f;
+			float top = -(((_info.pixScaleY * pix_top + _info.vOffset) * 2.0f) - 1.0f);
+			float right = ((_info.pixScaleX * (pix_left + _vertexRect.width()) + _info.hOffset) * 2.0f) - 1.0f;
+			float bottom = -(((_info.pixScaleY * (pix_top + _vertexRect.height()) + _info.vOffset) * 2.0f) - 1.0f);
+
+			reinterpret_cast<IndexedVertexQuad*>(_vertex)->set(left, top, right, bottom, _z, _textureRect.left, _textureRect.top, _textureRect.right, _textureRect.bottom, _colour);
+
+			return _vertex + IndexedVertexQuad::VertexCount;
+		}
+
+#ifdef MYGUI_GLYPH_BATCH_SSE2
+		inline __m128 select(__m128 _mask, __m128 _value, __m128 _default)
+		{
+			return _mm_or_ps(_mm_and_ps(_mask, _value), _mm_andnot_ps(_mask, _default));
+		}
+
+		// same clipping as in scalar writeQuad, quads that are clipped completely are removed from _visible
+		inline void clipQuads(
+			__m128& _left, __m128& _top, __m128& _right, __m128& _bottom,
+			__m128& _u1, __m128& _v1, __m128& _u2, __m128& _v2,
+			__m128& _visible,
+			__m128 _clipLeft, __m128 _clipTop, __m128 _clipRight, __m128 _clipBottom)
+		{
+			const __m128 zero = _mm_setzero_ps();
+
+			__m128 clip = _mm_sub_ps(_clipLeft, _left);
+			__m128 mask = _mm_cmpgt_ps(clip, zero);
+			__m128 inside = _mm_cmplt_ps(_clipLeft, _right);
+			_visible = _mm_andnot_ps(_mm_andnot_ps(inside, mask), _visible);
+			mask = _mm_and_ps(mask, inside);
+			_u1 = select(mask, _mm_add_ps(_u1, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(_u2, _u1), clip), _mm_sub_ps(_right, _left))), _u1);
+			_left = select(mask, _mm_add_ps(_left, clip), _left);
+
+			clip = _mm_sub_ps(_right, _clipRight);
+			mask = _mm_cmpgt_ps(clip, zero);
+			inside = _mm_cmplt_ps(_left, _clipRight);
+			_visible = _mm_andnot_ps(_mm_andnot_ps(inside, mask), _visible);
+			mask = _mm_and_ps(mask, inside);
+			_u2 = select(mask, _mm_sub_ps(_u2, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(_u2, _u1), clip), _mm_sub_ps(_right, _left))), _u2);
+			_right = select(mask, _mm_sub_ps(_right, clip), _right);
+
+			clip = _mm_sub_ps(_clipTop, _top);
+			mask = _mm_cmpgt_ps(clip, zero);
+			inside = _mm_cmplt_ps(_clipTop, _bottom);
+			_visible = _mm_andnot_ps(_mm_andnot_ps(inside, mask), _visible);
+			mask = _mm_and_ps(mask, inside);
+			_v1 = select(mask, _mm_add_ps(_v1, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(_v2, _v1), clip), _mm_sub_ps(_bottom, _top))), _v1);
+			_top = select(mask, _mm_add_ps(_top, clip), _top);
+
+			clip = _mm_sub_ps(_bottom, _clipBottom);
+			mask = _mm_cmpgt_ps(clip, zero);
+			inside = _mm_cmplt_ps(_top, _clipBottom);
+			_visible = _mm_andnot_ps(_mm_andnot_ps(inside, mask), _visible);
+			mask = _mm_and_ps(mask, inside);
+			_v2 = select(mask, _mm_sub_ps(_v2, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(_v2, _v1), clip), _mm_sub_ps(_bottom, _top))), _v2);
+			_bottom = select(mask, _mm_sub_ps(_bottom, clip), _bottom);
+		}
+
+		// _rect is (left, top, right, bottom), _uv is the same for texture, _zc is (z, colour, z, colour)
+		inline Vertex* writeQuad(Vertex* _vertex, __m128 _rect, __m128 _uv, __m128 _zc)
+		{
+			float* data = reinterpret_cast<float*>(_vertex);
+			// four vertices LT RT LB RB are six vectors: (x y z c) (u v x y) (z c u v) ...
+			_mm_storeu_ps(data, _mm_movelh_ps(_rect, _zc));
+			_mm_storeu_ps(data + 4, _mm_shuffle_ps(_uv, _rect, _MM_SHUFFLE(1, 2, 1, 0)));
+			_mm_storeu_ps(data + 8, _mm_shuffle_ps(_zc, _uv, _MM_SHUFFLE(1, 2, 1, 0)));
+			_mm_storeu_ps(data + 12, _mm_shuffle_ps(_rect, _zc, _MM_SHUFFLE(1, 0, 3, 0)));
+			_mm_storeu_ps(data + 16, _mm_shuffle_ps(_uv, _rect, _MM_SHUFFLE(3, 2, 3, 0)));
+			_mm_storeu_ps(data + 20, _mm_shuffle_ps(_zc, _uv, _MM_SHUFFLE(3, 2, 1, 0)));
+			return _vertex + IndexedVertexQuad::VertexCount;
+		}
+#endif
+
+	}
+
+	void GlyphBatch::clear()
+	{
+		mQuads.clear();
+	}
+
+	void GlyphBatch::add(const FloatRect& _vertexRect, const FloatRect& _textureRect, uint32 _colour)
+	{
+		mQuads.push_back(Quad());
+		Quad& quad = mQuads.back();
+		quad.vertex = _vertexRect;
+		quad.texture = _textureRect;
+		quad.colour = _colour;
+	}
+
+	size_t GlyphBatch::size() const
+	{
+		return mQuads.size();
+	}
+
+	size_t GlyphBatch::write(Vertex* _vertex, const FloatRect& _clip, float _left, float _top, float _z, const RenderTargetInfo& _info) const
+	{
+		Vertex* vertex = _vertex;
+		size_t index = 0;
+
+#ifdef MYGUI_GLYPH_BATCH_SSE2
+		// four quads at once, operations are the same as in scalar writeQuad to get the same results
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 sign = _mm_set1_ps(-0.0f);
+		const __m128 clipLeft = _mm_set1_ps(_clip.left);
+		const __m128 clipTop = _mm_set1_ps(_clip.top);
+		const __m128 clipRight = _mm_set1_ps(_clip.right);
+		const __m128 clipBottom = _mm_set1_ps(_clip.bottom);
+		const __m128 offsetLeft = _mm_set1_ps(_left);
+		const __m128 offsetTop = _mm_set1_ps(_top);
+		const __m128 scaleX = _mm_set1_ps(_info.pixScaleX);
+		const __m128 scaleY = _mm_set1_ps(_info.pixScaleY);
+		const __m128 hOffset = _mm_set1_ps(_info.hOffset);
+		const __m128 vOffset = _mm_set1_ps(_info.vOffset);
+		const __m128 z = _mm_set1_ps(_z);
+
+		for (; index + 4 <= mQuads.size(); index += 4)
+		{
+			const Quad* quad = &mQuads[index];
+
+			__m128 left = _mm_loadu_ps(&quad[0].vertex.left);
+			__m128 top = _mm_loadu_ps(&quad[1].vertex.left);
+			__m128 right = _mm_loadu_ps(&quad[2].vertex.left);
+			__m128 bottom = _mm_loadu_ps(&quad[3].vertex.left);
+			_MM_TRANSPOSE4_PS(left, top, right, bottom);
+
+			__m128 u1 = _mm_loadu_ps(&quad[0].texture.left);
+			__m128 v1 = _mm_loadu_ps(&quad[1].texture.left);
+			__m128 u2 = _mm_loadu_ps(&quad[2].texture.left);
+			__m128 v2 = _mm_loadu_ps(&quad[3].texture.left);
+			_MM_TRANSPOSE4_PS(u1, v1, u2, v2);
+
+			__m128 colour = _mm_castsi128_ps(_mm_set_epi32((int)quad[3].colour, (int)quad[2].colour, (int)quad[1].colour, (int)quad[0].colour));
+
+			// quad is dropped when it is clipped from any side completely
+			__m128 visible = _mm_cmpeq_ps(zero, zero);
+
+			// most of text is not clipped at all
+			__m128 outside = _mm_or_ps(
+				_mm_or_ps(_mm_cmpgt_ps(_mm_sub_ps(clipLeft, left), zero), _mm_cmpgt_ps(_mm_sub_ps(right, clipRight), zero)),
+				_mm_or_ps(_mm_cmpgt_ps(_mm_sub_ps(clipTop, top), zero), _mm_cmpgt_ps(_mm_sub_ps(bottom, clipBottom), zero)));
+			if (_mm_movemask_ps(outside) != 0)
+			{
+				clipQuads(left, top, right, bottom, u1, v1, u2, v2, visible, clipLeft, clipTop, clipRight, clipBottom);
+				if (_mm_movemask_ps(visible) == 0)
+					continue;
+			}
+
+			int visibleMask = _mm_movemask_ps(visible);
+
+			__m128 pixLeft = _mm_add_ps(offsetLeft, left);
+			__m128 pixTop = _mm_add_ps(offsetTop, top);
+			__m128 pixRight = _mm_add_ps(pixLeft, _mm_sub_ps(right, left));
+			__m128 pixBottom = _mm_add_ps(pixTop, _mm_sub_ps(bottom, top));
+
+			left = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(scaleX, pixLeft), hOffset), two), one);
+			top = _mm_xor_ps(_mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(scaleY, pixTop), vOffset), two), one), sign);
+			right = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(scaleX, pixRight), hOffset), two), one);
+			bottom = _mm_xor_ps(_mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(scaleY, pixBottom), vOffset), two), one), sign);
+
+			// back to one vector per quad
+			_MM_TRANSPOSE4_PS(left, top, right, bottom);
+			_MM_TRANSPOSE4_PS(u1, v1, u2, v2);
+			__m128 zcLow = _mm_unpacklo_ps(z, colour);
+			__m128 zcHigh = _mm_unpackhi_ps(z, colour);
+
+			if (visibleMask & 1)
+				vertex = writeQuad(vertex, left, u1, _mm_movelh_ps(zcLow, zcLow));
+			if (visibleMask & 2)
+				vertex = writeQuad(vertex, top, v1, _mm_movehl_ps(zcLow, zcLow));
+			if (visibleMask & 4)
+				vertex = writeQuad(vertex, right, u2, _mm_movelh_ps(zcHigh, zcHigh));
+			if (visibleMask & 8)
+				vertex = writeQuad(vertex, bottom, v2, _mm_movehl_ps(zcHigh, zcHigh));
+		}
+#endif
+
+		for (; index < mQuads.size(); ++index)
+		{
+			const Quad& quad = mQuads[index];
+			vertex = writeQuad(vertex, quad.vertex, quad.texture, quad.colour, _clip, _left, _top, _z, _info);
+		}
+
+		return vertex - _vertex;
+	}
+
+	size_t GlyphBatch::writeScalar(Vertex* _vertex, const FloatRect& _clip, float _left, float _top, float _z, const RenderTargetInfo& _info) const
+	{
+		Vertex* vertex = _vertex;
+		for (VectorQuad::const_iterator quad = mQuads.begin(); quad != mQuads.end(); ++quad)
+			vertex = writeQuad(vertex, quad->vertex, quad->texture, quad->colour, _clip, _left, _top, _z, _info);
+		return vertex - _vertex;
+	}
+
+} // namespace MyGUI
@@ -26,7 +26,9 @@
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_ToolTipManager.h"
+#include "MyGUI_TextureAtlasManager.h"
 #include "MyGUI_TextureUtility.h"
+#include "MyGUI_Profiler.h"
 
 namespace MyGUI
 {
@@ -50,6 +52,7 @@ namespace MyGUI
 		mResourceManager(nullptr),
 		mFactoryManager(nullptr),
 		mToolTipManager(nullptr),
+		mTextureAtlasManager(nullptr),
 		mIsInitialise(false),
 		mSingletonHolder(this)
 	{
@@ -82,6 +85,7 @@ namespace MyGUI
 		mLanguageManager = new LanguageManager();
 		mFactoryManager = new FactoryManager();
 		mToolTipManager = new ToolTipManager();
+		mTextureAtlasManager = new TextureAtlasManager();
 
 		mResourceManager->initialise();
 		mLayerManager->initialise();
@@ -99,6 +103,7 @@ namespace MyGUI
 		mLanguageManager->initialise();
 		mFactoryManager->initialise();
 		mToolTipManager->initialise();
+		mTextureAtlasManager->initialise();
 
 		WidgetManager::getInstance().registerUnlinker(this);
 
@@ -144,6 +149,7 @@ namespace MyGUI
 		mResourceManager->shutdown();
 		mFactoryManager->shutdown();
 		mToolTipManager->shutdown();
+		mTextureAtlasManager->shutdown();
 
 		WidgetManager::getInstance().unregisterUnlinker(this);
 		mWidgetManager->shutdown();
@@ -164,9 +170,10 @@ namespace MyGUI
 		delete mResourceManager;
 		delete mFactoryManager;
 		delete mToolTipManager;
+		delete mTextureAtlasManager;
 
 		// сбрасываем кеш
-		texture_utility::getTextureSize("", false);
+		texture_utility::clearTextureInfo();
 
 		MYGUI_LOG(Info, getClassTypeName() << " successfully shutdown");
 		mIsInitialise = false;
@@ -325,6 +332,9 @@ namespace MyGUI
 
 	void Gui::frameEvent(float _time)
 	{
+		MYGUI_PROFILE_FRAME();
+		MYGUI_PROFILE_SCOPE("Gui::frameEvent");
+
 		eventFrameStart(_time);
 	}
 
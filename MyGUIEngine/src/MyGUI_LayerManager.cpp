@@ -14,6 +14,7 @@
 
 #include "MyGUI_SharedLayer.h"
 #include "MyGUI_OverlappedLayer.h"
+#include "MyGUI_Profiler.h"
 
 namespace MyGUI
 {
@@ -211,6 +212,8 @@ namespace MyGUI
 
 	Widget* LayerManager::getWidgetFromPoint(int _left, int _top) const
 	{
+		MYGUI_PROFILE_SCOPE("LayerManager::getWidgetFromPoint");
+
 		VectorLayer::const_reverse_iterator iter = mLayerNodes.rbegin();
 		while (iter != mLayerNodes.rend())
 		{
@@ -223,6 +226,8 @@ namespace MyGUI
 
 	void LayerManager::renderToTarget(IRenderTarget* _target, bool _update)
 	{
+		MYGUI_PROFILE_SCOPE("LayerManager::renderToTarget");
+
 		for (VectorLayer::iterator iter = mLayerNodes.begin(); iter != mLayerNodes.end(); ++iter)
 		{
 			(*iter)->renderToTarget(_target, _update);
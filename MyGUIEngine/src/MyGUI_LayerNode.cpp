@@ -10,6 +10,7 @@
 #include "MyGUI_ITexture.h"
 #include "MyGUI_ISubWidget.h"
 #include "MyGUI_ISubWidgetText.h"
+#include "MyGUI_TextureAtlasManager.h"
 
 namespace MyGUI
 {
@@ -20,7 +21,8 @@ namespace MyGUI
 		mLayer(_layer),
 		mOutOfDate(false),
 		mOutOfDateCompression(false),
-		mDepth(0.0f)
+		mDepth(0.0f),
+		mPixelSpace(false)
 	{
 	}
 
@@ -93,6 +95,16 @@ namespace MyGUI
 			mOutOfDateCompression = false;
 		}
 
+		if (mPixelSpace)
+		{
+			// root item of overlapped layer node has coordinates in layer
+			IntPoint origin = mLayerItems.size() == 1 ? mLayerItems.front()->getLayerItemCoord().point() : IntPoint();
+			for (VectorRenderItem::iterator iter = mFirstRenderItems.begin(); iter != mFirstRenderItems.end(); ++iter)
+				(*iter)->setPixelSpaceOrigin(origin);
+			for (VectorRenderItem::iterator iter = mSecondRenderItems.begin(); iter != mSecondRenderItems.end(); ++iter)
+				(*iter)->setPixelSpaceOrigin(origin);
+		}
+
 		// сначала отрисовываем свое
 		for (VectorRenderItem::iterator iter = mFirstRenderItems.begin(); iter != mFirstRenderItems.end(); ++iter)
 			(*iter)->renderToTarget(_target, _update);
@@ -151,9 +163,7 @@ namespace MyGUI
 	{
 		if (mFirstRenderItems.empty() || _manualRender)
 		{
-			RenderItem* item = new RenderItem();
-			item->setTexture(_texture);
-			item->setManualRender(_manualRender);
+			RenderItem* item = createRenderItem(_texture, _manualRender);
 			mLastNotEmptyItem = mFirstRenderItems.size();
 			mFirstRenderItems.push_back(item);
 
@@ -165,6 +175,17 @@ namespace MyGUI
 
 		// first queue keep order
 
+		// skip buffers emptied since last compression, they draw nothing, so item can join buffer before them
+		// (widget that changes texture to atlas right after creation would break batch otherwise)
+		if (TextureAtlasManager::getInstance().getEnabled())
+		{
+			while (mLastNotEmptyItem > 0 && mLastNotEmptyItem < mFirstRenderItems.size() &&
+				!mFirstRenderItems[mLastNotEmptyItem]->hasDrawItems() && !mFirstRenderItems[mLastNotEmptyItem]->getManualRender())
+			{
+				--mLastNotEmptyItem;
+			}
+		}
+
 		// use either last non-empty buffer if it have same texture
 		// or empty buffer (if found in the end)
 		if (mLastNotEmptyItem < mFirstRenderItems.size())
@@ -184,15 +205,22 @@ namespace MyGUI
 		}
 
 		// not found, create new
-		RenderItem* item = new RenderItem();
-		item->setTexture(_texture);
-		item->setManualRender(_manualRender);
+		RenderItem* item = createRenderItem(_texture, _manualRender);
 		mLastNotEmptyItem = mFirstRenderItems.size();
 		mFirstRenderItems.push_back(item);
 
 		return item;
 	}
 
+	RenderItem* LayerNode::createRenderItem(ITexture* _texture, bool _manualRender)
+	{
+		RenderItem* item = new RenderItem();
+		item->setTexture(_texture);
+		item->setManualRender(_manualRender);
+		item->setPixelSpace(mPixelSpace);
+		return item;
+	}
+
 	RenderItem* LayerNode::addToRenderItemSecondQueue(ITexture* _texture, bool _manualRender)
 	{
 		// order is not important in second queue
@@ -212,9 +240,7 @@ namespace MyGUI
 		}
 
 		// not found, create new
-		RenderItem* item = new RenderItem();
-		item->setTexture(_texture);
-		item->setManualRender(_manualRender);
+		RenderItem* item = createRenderItem(_texture, _manualRender);
 		mSecondRenderItems.push_back(item);
 
 		return item;
@@ -251,6 +277,13 @@ namespace MyGUI
 			_item->outOfDate();
 	}
 
+	void LayerNode::outOfDate(RenderItem* _item, ISubWidget* _subItem)
+	{
+		mOutOfDate = true;
+		if (_item)
+			_item->outOfDate(_subItem);
+	}
+
 	EnumeratorILayerNode LayerNode::getEnumerator() const
 	{
 		return EnumeratorILayerNode(mChildItems);
@@ -347,4 +380,23 @@ namespace MyGUI
 		return mDepth;
 	}
 
+	void LayerNode::setPixelSpace(bool _value)
+	{
+		if (mPixelSpace == _value)
+			return;
+
+		mPixelSpace = _value;
+		mOutOfDate = true;
+
+		for (VectorRenderItem::iterator iter = mFirstRenderItems.begin(); iter != mFirstRenderItems.end(); ++iter)
+			(*iter)->setPixelSpace(mPixelSpace);
+		for (VectorRenderItem::iterator iter = mSecondRenderItems.begin(); iter != mSecondRenderItems.end(); ++iter)
+			(*iter)->setPixelSpace(mPixelSpace);
+	}
+
+	bool LayerNode::getPixelSpace() const
+	{
+		return mPixelSpace;
+	}
+
 } // namespace MyGUI
@@ -26,6 +26,9 @@ namespace MyGUI
 		mLastRedrawLine(0),
 		mIndexSelect(ITEM_NONE),
 		mLineActive(ITEM_NONE),
+		mDataSource(nullptr),
+		mDataSourceColumn(0),
+		mDataSourceCount(0),
 		mNeedVisibleScroll(true)
 	{
 	}
@@ -272,7 +275,7 @@ namespace MyGUI
 
 	void ListBox::updateScroll()
 	{
-		mRangeIndex = (mHeightLine * (int)mItemsInfo.size()) - _getClientWidget()->getHeight();
+		mRangeIndex = (mHeightLine * (int)getItemCount()) - _getClientWidget()->getHeight();
 
 		if (mWidgetScroll == nullptr)
 			return;
@@ -296,8 +299,8 @@ namespace MyGUI
 
 		mWidgetScroll->setScrollRange(mRangeIndex + 1);
 		mWidgetScroll->setScrollViewPage(_getClientWidget()->getHeight());
-		if (!mItemsInfo.empty())
-			mWidgetScroll->setTrackSize(mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)mItemsInfo.size());
+		if (getItemCount() != 0)
+			mWidgetScroll->setTrackSize(mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)getItemCount());
 	}
 
 	void ListBox::updateLine(bool _reset)
@@ -319,7 +322,7 @@ namespace MyGUI
 			int height = (int)mWidgetLines.size() * mHeightLine - mOffsetTop;
 
 			// до тех пор, пока не достигнем максимального колличества, и всегда на одну больше
-			while ( (height <= (_getClientWidget()->getHeight() + mHeightLine)) && (mWidgetLines.size() < mItemsInfo.size()) )
+			while ( (height <= (_getClientWidget()->getHeight() + mHeightLine)) && (mWidgetLines.size() < getItemCount()) )
 			{
 				// создаем линию
 				Widget* widget = _getClientWidget()->createWidgetT("Button", mSkinLine, 0, height, _getClientWidget()->getWidth(), mHeightLine, Align::Top | Align::HStretch);
@@ -377,7 +380,7 @@ namespace MyGUI
 						count --;
 					}
 
-					int top = (int)mItemsInfo.size() - count - 1;
+					int top = (int)getItemCount() - count - 1;
 
 					// выравниваем
 					int offset = 0 - mOffsetTop;
@@ -426,7 +429,7 @@ namespace MyGUI
 			size_t index = pos + (size_t)mTopIndex;
 
 			// не будем заходить слишком далеко
-			if (index >= mItemsInfo.size())
+			if (index >= getItemCount())
 			{
 				// запоминаем последнюю перерисованную линию
 				mLastRedrawLine = pos;
@@ -442,7 +445,7 @@ namespace MyGUI
 			// если был скрыт, то покажем
 			mWidgetLines[pos]->setVisible(true);
 			// обновляем текст
-			mWidgetLines[pos]->setCaption(mItemsInfo[index].first);
+			updateLineCaption(pos, index);
 
 			// если нужно выделить ,то выделим
 			static_cast<Button*>(mWidgetLines[pos])->setStateSelected(index == mIndexSelect);
@@ -480,9 +483,9 @@ namespace MyGUI
 		if (_index >= mLastRedrawLine)
 			return;
 
-		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::_redrawItem");
+		MYGUI_ASSERT_RANGE(_index, getItemCount(), "ListBox::_redrawItem");
 		// перерисовываем
-		mWidgetLines[_index]->setCaption(mItemsInfo[_index + mTopIndex].first);
+		updateLineCaption(_index, _index + mTopIndex);
 
 #if MYGUI_DEBUG_MODE == 1
 		_checkMapping("ListBox::_redrawItem");
@@ -491,6 +494,7 @@ namespace MyGUI
 
 	void ListBox::insertItemAt(size_t _index, const UString& _name, Any _data)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::insertItemAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE_INSERT(_index, mItemsInfo.size(), "ListBox::insertItemAt");
 		if (_index == ITEM_NONE)
 			_index = mItemsInfo.size();
@@ -510,8 +514,8 @@ namespace MyGUI
 			if (mWidgetScroll != nullptr)
 			{
 				mWidgetScroll->setScrollRange(mWidgetScroll->getScrollRange() + mHeightLine);
-				if (!mItemsInfo.empty())
-					mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)mItemsInfo.size() );
+				if (getItemCount() != 0)
+					mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)getItemCount() );
 				mWidgetScroll->setScrollPosition(mTopIndex * mHeightLine + mOffsetTop);
 			}
 			mRangeIndex += mHeightLine;
@@ -528,8 +532,8 @@ namespace MyGUI
 				if (mWidgetScroll != nullptr)
 				{
 					mWidgetScroll->setScrollRange(mWidgetScroll->getScrollRange() + mHeightLine);
-					if (!mItemsInfo.empty())
-						mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)mItemsInfo.size() );
+					if (getItemCount() != 0)
+						mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)getItemCount() );
 					mWidgetScroll->setScrollPosition(mTopIndex * mHeightLine + mOffsetTop);
 				}
 				mRangeIndex += mHeightLine;
@@ -553,6 +557,7 @@ namespace MyGUI
 
 	void ListBox::removeItemAt(size_t _index)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::removeItemAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::removeItemAt");
 
 		// удяляем физически строку
@@ -582,8 +587,8 @@ namespace MyGUI
 			if (mWidgetScroll != nullptr)
 			{
 				mWidgetScroll->setScrollRange(mWidgetScroll->getScrollRange() - mHeightLine);
-				if (!mItemsInfo.empty())
-					mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)mItemsInfo.size() );
+				if (getItemCount() != 0)
+					mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)getItemCount() );
 				mWidgetScroll->setScrollPosition(mTopIndex * mHeightLine + mOffsetTop);
 			}
 			mRangeIndex -= mHeightLine;
@@ -600,8 +605,8 @@ namespace MyGUI
 				if (mWidgetScroll != nullptr)
 				{
 					mWidgetScroll->setScrollRange(mWidgetScroll->getScrollRange() - mHeightLine);
-					if (!mItemsInfo.empty())
-						mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)mItemsInfo.size() );
+					if (getItemCount() != 0)
+						mWidgetScroll->setTrackSize( mWidgetScroll->getLineSize() * _getClientWidget()->getHeight() / mHeightLine / (int)getItemCount() );
 					mWidgetScroll->setScrollPosition(mTopIndex * mHeightLine + mOffsetTop);
 				}
 				mRangeIndex -= mHeightLine;
@@ -625,7 +630,7 @@ namespace MyGUI
 
 	void ListBox::setIndexSelected(size_t _index)
 	{
-		MYGUI_ASSERT_RANGE_AND_NONE(_index, mItemsInfo.size(), "ListBox::setIndexSelected");
+		MYGUI_ASSERT_RANGE_AND_NONE(_index, getItemCount(), "ListBox::setIndexSelected");
 		if (mIndexSelect != _index)
 		{
 			_selectIndex(mIndexSelect, false);
@@ -658,7 +663,7 @@ namespace MyGUI
 
 	void ListBox::beginToItemAt(size_t _index)
 	{
-		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::beginToItemAt");
+		MYGUI_ASSERT_RANGE(_index, getItemCount(), "ListBox::beginToItemAt");
 		if (mRangeIndex <= 0)
 			return;
 
@@ -682,7 +687,7 @@ namespace MyGUI
 	bool ListBox::isItemVisibleAt(size_t _index, bool _fill)
 	{
 		// если элемента нет, то мы его не видим (в том числе когда их вообще нет)
-		if (_index >= mItemsInfo.size())
+		if (_index >= getItemCount())
 			return false;
 		// если скрола нет, то мы палюбак видим
 		if (mRangeIndex <= 0)
@@ -741,6 +746,7 @@ namespace MyGUI
 
 	void ListBox::setItemNameAt(size_t _index, const UString& _name)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::setItemNameAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::setItemNameAt");
 		mItemsInfo[_index].first = _name;
 		_redrawItem(_index);
@@ -748,6 +754,7 @@ namespace MyGUI
 
 	void ListBox::setItemDataAt(size_t _index, Any _data)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::setItemDataAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::setItemDataAt");
 		mItemsInfo[_index].second = _data;
 		_redrawItem(_index);
@@ -755,6 +762,7 @@ namespace MyGUI
 
 	const UString& ListBox::getItemNameAt(size_t _index) const
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::getItemNameAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mItemsInfo.size(), "ListBox::getItemNameAt");
 		return mItemsInfo[_index].first;
 	}
@@ -839,6 +847,7 @@ namespace MyGUI
 
 	void ListBox::swapItemsAt(size_t _index1, size_t _index2)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "ListBox::swapItemsAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index1, mItemsInfo.size(), "ListBox::swapItemsAt");
 		MYGUI_ASSERT_RANGE(_index2, mItemsInfo.size(), "ListBox::swapItemsAt");
 
@@ -851,6 +860,27 @@ namespace MyGUI
 		_redrawItem(_index2);
 	}
 
+	void ListBox::_permuteItems(const std::vector<size_t>& _order)
+	{
+		MYGUI_ASSERT(_order.size() == mItemsInfo.size(), "ListBox::_permuteItems");
+
+		size_t selected = ITEM_NONE;
+		VectorItemInfo items(mItemsInfo.size());
+		for (size_t index = 0; index < _order.size(); ++index)
+		{
+			PairItem& item = mItemsInfo[_order[index]];
+			items[index].first.swap(item.first);
+			items[index].second.swap(item.second);
+
+			if (_order[index] == mIndexSelect)
+				selected = index;
+		}
+		mItemsInfo.swap(items);
+		mIndexSelect = selected;
+
+		_redrawItemRange();
+	}
+
 	void ListBox::_checkMapping(const std::string& _owner)
 	{
 		size_t count_pressed = 0;
@@ -871,7 +901,7 @@ namespace MyGUI
 	void ListBox::_checkAlign()
 	{
 		// максимальная высота всех строк
-		int max_height = mItemsInfo.size() * mHeightLine;
+		int max_height = getItemCount() * mHeightLine;
 		// видимая высота
 		int visible_height = _getClientWidget()->getHeight();
 
@@ -883,7 +913,7 @@ namespace MyGUI
 			int height = 0;
 			for (size_t pos = 0; pos < mWidgetLines.size(); pos++)
 			{
-				if (pos >= mItemsInfo.size())
+				if (pos >= getItemCount())
 					break;
 				MYGUI_ASSERT(mWidgetLines[pos]->getTop() == height, "mWidgetLines[pos]->getTop() == height");
 				height += mWidgetLines[pos]->getHeight();
@@ -893,6 +923,10 @@ namespace MyGUI
 
 	size_t ListBox::findItemIndexWith(const UString& _name)
 	{
+		// items have no names in virtual mode
+		if (mDataSource != nullptr)
+			return ITEM_NONE;
+
 		for (size_t pos = 0; pos < mItemsInfo.size(); pos++)
 		{
 			if (mItemsInfo[pos].first == _name)
@@ -903,12 +937,66 @@ namespace MyGUI
 
 	int ListBox::getOptimalHeight() const
 	{
-		return (int)((mCoord.height - _getClientWidget()->getHeight()) + (mItemsInfo.size() * mHeightLine));
+		return (int)((mCoord.height - _getClientWidget()->getHeight()) + (getItemCount() * mHeightLine));
 	}
 
 	size_t ListBox::getItemCount() const
 	{
-		return mItemsInfo.size();
+		return mDataSource != nullptr ? mDataSourceCount : mItemsInfo.size();
+	}
+
+	void ListBox::setDataSource(IListBoxDataSource* _source)
+	{
+		_setDataSource(_source, 0);
+	}
+
+	IListBoxDataSource* ListBox::getDataSource() const
+	{
+		return mDataSource;
+	}
+
+	void ListBox::_setDataSource(IListBoxDataSource* _source, size_t _column)
+	{
+		if (mDataSource == _source && mDataSourceColumn == _column)
+			return;
+
+		// rows of previous source or items are gone, only column of the same source can change
+		if (mDataSource != _source)
+		{
+			mDataSource = nullptr;
+			removeAllItems();
+		}
+
+		mDataSource = _source;
+		mDataSourceColumn = _column;
+		mDataSourceCount = mDataSource != nullptr ? mDataSource->getItemCount() : 0;
+
+		updateScroll();
+		updateLine(true);
+		_redrawItemRange();
+	}
+
+	void ListBox::updateDataSource()
+	{
+		if (mDataSource == nullptr)
+			return;
+
+		mDataSourceCount = mDataSource->getItemCount();
+		if (mIndexSelect != ITEM_NONE && mIndexSelect >= mDataSourceCount)
+			mIndexSelect = ITEM_NONE;
+
+		// only lines in view are redrawn, position is kept if rows are still there
+		updateScroll();
+		updateLine(true);
+		_redrawItemRange();
+	}
+
+	void ListBox::updateLineCaption(size_t _line, size_t _index)
+	{
+		if (mDataSource != nullptr)
+			mWidgetLines[_line]->setCaption(mDataSource->getItemNameAt(_index, mDataSourceColumn));
+		else
+			mWidgetLines[_line]->setCaption(mItemsInfo[_index].first);
 	}
 
 	void ListBox::addItem(const UString& _name, Any _data)
@@ -1015,7 +1103,7 @@ namespace MyGUI
 #if MYGUI_DEBUG_MODE == 1
 			_checkMapping("ListBox::notifyMousePressed");
 			MYGUI_ASSERT_RANGE(*_sender->_getInternalData<size_t>(), mWidgetLines.size(), "ListBox::notifyMousePressed");
-			MYGUI_ASSERT_RANGE(*_sender->_getInternalData<size_t>() + mTopIndex, mItemsInfo.size(), "ListBox::notifyMousePressed");
+			MYGUI_ASSERT_RANGE(*_sender->_getInternalData<size_t>() + mTopIndex, getItemCount(), "ListBox::notifyMousePressed");
 #endif
 
 			size_t index = *_sender->_getInternalData<size_t>() + mTopIndex;
@@ -27,7 +27,8 @@ namespace MyGUI
 		mWidthSeparator(0),
 		mItemSelected(ITEM_NONE),
 		mFrameAdvise(false),
-		mHeaderPlace(nullptr)
+		mHeaderPlace(nullptr),
+		mDataSource(nullptr)
 	{
 	}
 
@@ -152,6 +153,51 @@ namespace MyGUI
 		mItemSelected = ITEM_NONE;
 	}
 
+	void MultiListBox::setDataSource(IListBoxDataSource* _source)
+	{
+		if (mDataSource == _source)
+			return;
+
+		removeAllItems();
+		frameAdvise(false);
+
+		mDataSource = _source;
+		for (size_t index = 0; index < mVectorColumnInfo.size(); ++index)
+			mVectorColumnInfo[index].list->_setDataSource(mDataSource, index);
+
+		if (mDataSource != nullptr && mSortColumnIndex != ITEM_NONE)
+			sortDataSource();
+	}
+
+	IListBoxDataSource* MultiListBox::getDataSource() const
+	{
+		return mDataSource;
+	}
+
+	void MultiListBox::updateDataSource()
+	{
+		if (mDataSource == nullptr)
+			return;
+
+		for (VectorColumnInfo::iterator iter = mVectorColumnInfo.begin(); iter != mVectorColumnInfo.end(); ++iter)
+		{
+			(*iter).list->updateDataSource();
+		}
+
+		if (mItemSelected != ITEM_NONE && mItemSelected >= getItemCount())
+			mItemSelected = ITEM_NONE;
+	}
+
+	size_t MultiListBox::convertToBackIndex(size_t _index) const
+	{
+		return mDataSource != nullptr ? _index : BiIndexBase::convertToBack(_index);
+	}
+
+	size_t MultiListBox::convertToFaceIndex(size_t _index) const
+	{
+		return mDataSource != nullptr ? _index : BiIndexBase::convertToFace(_index);
+	}
+
 	void MultiListBox::updateBackSelected(size_t _index)
 	{
 		if (_index == ITEM_NONE)
@@ -179,11 +225,12 @@ namespace MyGUI
 		MYGUI_ASSERT_RANGE_AND_NONE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::setIndexSelected");
 
 		mItemSelected = _index;
-		updateBackSelected(BiIndexBase::convertToBack(mItemSelected));
+		updateBackSelected(convertToBackIndex(mItemSelected));
 	}
 
 	void MultiListBox::setSubItemNameAt(size_t _column, size_t _index, const UString& _name)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::setSubItemNameAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::setSubItemAt");
 
 		size_t index = BiIndexBase::convertToBack(_index);
@@ -196,6 +243,7 @@ namespace MyGUI
 
 	const UString& MultiListBox::getSubItemNameAt(size_t _column, size_t _index) const
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::getSubItemNameAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::getSubItemNameAt");
 
 		size_t index = BiIndexBase::convertToBack(_index);
@@ -204,6 +252,9 @@ namespace MyGUI
 
 	size_t MultiListBox::findSubItemWith(size_t _column, const UString& _name)
 	{
+		if (mDataSource != nullptr)
+			return ITEM_NONE;
+
 		size_t index = getSubItemAt(_column)->findItemIndexWith(_name);
 		return BiIndexBase::convertToFace(index);
 	}
@@ -240,7 +291,7 @@ namespace MyGUI
 
 		updateBackSelected(_position);
 
-		mItemSelected = BiIndexBase::convertToFace(_position);
+		mItemSelected = convertToFaceIndex(_position);
 
 		// наш евент
 		eventListChangePosition(this, mItemSelected);
@@ -249,13 +300,13 @@ namespace MyGUI
 	void MultiListBox::notifyListSelectAccept(ListBox* _sender, size_t _position)
 	{
 		// наш евент
-		eventListSelectAccept(this, BiIndexBase::convertToFace(_position));
+		eventListSelectAccept(this, convertToFaceIndex(_position));
 	}
 
 	void MultiListBox::notifyListNotifyItem(ListBox * _sender, const MyGUI::IBNotifyItemData & _info)
 	{
 		IBNotifyItemData infoConvertedIndex(_info);
-		infoConvertedIndex.index = BiIndexBase::convertToFace(_info.index);
+		infoConvertedIndex.index = convertToFaceIndex(_info.index);
 		eventNotifyItem(this, infoConvertedIndex);
 	}
 
@@ -356,22 +407,36 @@ namespace MyGUI
 		if (ITEM_NONE == mSortColumnIndex)
 			return;
 
-		size_t last = mVectorColumnInfo.front().list->getItemCount();
-		if (0 == last)
+		if (mDataSource != nullptr)
+		{
+			// direction is already changed, source sorts rows again
+			sortDataSource();
 			return;
-		last --;
-		size_t first = 0;
+		}
 
-		while (first < last)
-		{
-			BiIndexBase::swapItemsBackAt(first, last);
-			for (VectorColumnInfo::iterator iter = mVectorColumnInfo.begin(); iter != mVectorColumnInfo.end(); ++iter)
-			{
-				(*iter).list->swapItemsAt(first, last);
-			}
+		size_t count = mVectorColumnInfo.front().list->getItemCount();
+		if (0 == count)
+			return;
 
-			first++;
-			last--;
+		std::vector<size_t> order(count);
+		for (size_t index = 0; index < count; ++index)
+			order[index] = count - index - 1;
+
+		permuteItems(order);
+	}
+
+	void MultiListBox::sortDataSource()
+	{
+		mDataSource->sortItems(mSortColumnIndex, mSortUp);
+		updateDataSource();
+	}
+
+	void MultiListBox::permuteItems(const std::vector<size_t>& _order)
+	{
+		BiIndexBase::permuteItemsBack(_order);
+		for (VectorColumnInfo::iterator iter = mVectorColumnInfo.begin(); iter != mVectorColumnInfo.end(); ++iter)
+		{
+			(*iter).list->_permuteItems(_order);
 		}
 
 		updateBackSelected(BiIndexBase::convertToBack(mItemSelected));
@@ -379,8 +444,9 @@ namespace MyGUI
 
 	bool MultiListBox::compare(ListBox* _list, size_t _left, size_t _right)
 	{
+		// true if row _left goes before row _right
 		bool result = false;
-		if (mSortUp)
+		if (!mSortUp)
 			std::swap(_left, _right);
 		if (requestOperatorLess.empty())
 		{
@@ -399,44 +465,54 @@ namespace MyGUI
 		if (ITEM_NONE == mSortColumnIndex)
 			return;
 
+		if (mDataSource != nullptr)
+		{
+			frameAdvise(false);
+			sortDataSource();
+			return;
+		}
+
 		ListBox* list = mVectorColumnInfo[mSortColumnIndex].list;
 
 		size_t count = list->getItemCount();
 		if (0 == count)
 			return;
 
-		// shell sort
-		int first;
-		size_t last;
-		for (size_t step = count >> 1; step > 0 ; step >>= 1)
+		// rows are sorted as indexes, then all columns are reordered at once
+		std::vector<size_t> order(count);
+		for (size_t index = 0; index < count; ++index)
+			order[index] = index;
+
+		if (requestOperatorLess.empty())
 		{
-			for (size_t i = 0; i < (count - step); i++)
+			// names are taken from list once, not for every comparison
+			std::vector<const UString*> names(count);
+			for (size_t index = 0; index < count; ++index)
+				names[index] = &list->getItemNameAt(index);
+
+			bool sortUp = mSortUp;
+			std::stable_sort(order.begin(), order.end(), [&](size_t _left, size_t _right)
 			{
-				first = (int)i;
-				while (first >= 0)
-				{
-					last = first + step;
-					if (compare(list, first, last))
-					{
-						BiIndexBase::swapItemsBackAt(first, last);
-						for (VectorColumnInfo::iterator iter = mVectorColumnInfo.begin(); iter != mVectorColumnInfo.end(); ++iter)
-						{
-							(*iter).list->swapItemsAt(first, last);
-						}
-					}
-					first--;
-				}
-			}
+				return sortUp ? *names[_left] < *names[_right] : *names[_right] < *names[_left];
+			});
+		}
+		else
+		{
+			std::stable_sort(order.begin(), order.end(), [&](size_t _left, size_t _right)
+			{
+				return compare(list, _left, _right);
+			});
 		}
 
 		frameAdvise(false);
 
-		updateBackSelected(BiIndexBase::convertToBack(mItemSelected));
+		permuteItems(order);
 	}
 
 	void MultiListBox::insertItemAt(size_t _index, const UString& _name, Any _data)
 	{
 		MYGUI_ASSERT(!mVectorColumnInfo.empty(), "MultiListBox::insertItemAt");
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::insertItemAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE_INSERT(_index, mVectorColumnInfo.front().list->getItemCount(), "MultiListBox::insertItemAt");
 		if (ITEM_NONE == _index)
 			_index = mVectorColumnInfo.front().list->getItemCount();
@@ -462,6 +538,7 @@ namespace MyGUI
 	void MultiListBox::removeItemAt(size_t _index)
 	{
 		MYGUI_ASSERT(!mVectorColumnInfo.empty(), "MultiListBox::removeItemAt");
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::removeItemAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::removeItemAt");
 
 		size_t index = BiIndexBase::removeItemAt(_index);
@@ -488,6 +565,7 @@ namespace MyGUI
 	void MultiListBox::swapItemsAt(size_t _index1, size_t _index2)
 	{
 		MYGUI_ASSERT(!mVectorColumnInfo.empty(), "MultiListBox::removeItemAt");
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::swapItemsAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index1, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::swapItemsAt");
 		MYGUI_ASSERT_RANGE(_index2, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::swapItemsAt");
 
@@ -506,6 +584,7 @@ namespace MyGUI
 
 	void MultiListBox::setSubItemDataAt(size_t _column, size_t _index, Any _data)
 	{
+		MYGUI_ASSERT(mDataSource == nullptr, "MultiListBox::setSubItemDataAt can't be used in virtual mode");
 		MYGUI_ASSERT_RANGE(_index, mVectorColumnInfo.begin()->list->getItemCount(), "MultiListBox::setSubItemDataAt");
 
 		size_t index = BiIndexBase::convertToBack(_index);
@@ -716,7 +795,7 @@ namespace MyGUI
 		column.button->eventMouseButtonClick += newDelegate(this, &MultiListBox::notifyButtonClick);
 
 		// если уже были столбики, то делаем то же колличество полей
-		if (!mVectorColumnInfo.empty())
+		if (!mVectorColumnInfo.empty() && mDataSource == nullptr)
 		{
 			size_t count = mVectorColumnInfo.front().list->getItemCount();
 			for (size_t pos = 0; pos < count; ++pos)
@@ -933,6 +1012,10 @@ namespace MyGUI
 			info.button->setCoord(mWidthBar, 0, columnWidth, getButtonHeight());
 			info.button->_setInternalData(index);
 
+			// cells of data source are taken by current position of column
+			if (mDataSource != nullptr)
+				info.list->_setDataSource(mDataSource, index);
+
 			mWidthBar += columnWidth;
 
 			// промежуток между листами
@@ -15,6 +15,8 @@ namespace MyGUI
 
 	OverlappedLayer::OverlappedLayer() :
 		mIsPick(false),
+		mPickGrid(false),
+		mPixelSpace(false),
 		mOutOfDate(false)
 	{
 		mViewSize = RenderManager::getInstance().getViewSize();
@@ -38,6 +40,10 @@ namespace MyGUI
 				const std::string& value = propert->findAttribute("value");
 				if (key == "Pick")
 					setPick(utility::parseValue<bool>(value));
+				else if (key == "PickGrid")
+					setPickGrid(utility::parseValue<bool>(value));
+				else if (key == "PixelSpace")
+					setPixelSpace(utility::parseValue<bool>(value));
 			}
 		}
 		else if (_version >= Version(1, 0))
@@ -55,10 +61,38 @@ namespace MyGUI
 		mIsPick = _pick;
 	}
 
+	void OverlappedLayer::setPickGrid(bool _value)
+	{
+		mPickGrid = _value;
+	}
+
+	bool OverlappedLayer::getPickGrid() const
+	{
+		return mPickGrid;
+	}
+
+	void OverlappedLayer::setPixelSpace(bool _value)
+	{
+		mPixelSpace = _value;
+
+		for (VectorILayerNode::iterator iter = mChildItems.begin(); iter != mChildItems.end(); ++iter)
+		{
+			LayerNode* node = (*iter)->castType<LayerNode>(false);
+			if (node != nullptr)
+				node->setPixelSpace(mPixelSpace);
+		}
+	}
+
+	bool OverlappedLayer::getPixelSpace() const
+	{
+		return mPixelSpace;
+	}
+
 	ILayerNode* OverlappedLayer::createChildItemNode()
 	{
 		// создаем рутовый айтем
-		ILayerNode* node = new LayerNode(this);
+		LayerNode* node = new LayerNode(this);
+		node->setPixelSpace(mPixelSpace);
 		mChildItems.push_back(node);
 
 		mOutOfDate = true;
@@ -0,0 +1,163 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_PickGrid.h"
+#include "MyGUI_Widget.h"
+
+namespace MyGUI
+{
+
+	const int PICK_GRID_MAX_CELLS = 64;
+
+	PickGrid::PickGrid() :
+		mOutOfDate(true),
+		mCellWidth(1),
+		mCellHeight(1),
+		mColumns(0),
+		mRows(0)
+	{
+	}
+
+	void PickGrid::build(const VectorWidgetPtr& _items)
+	{
+		clear();
+		mOutOfDate = false;
+
+		if (_items.empty())
+			return;
+
+		// bounds are inclusive, same as Widget::_checkPoint
+		const IntCoord& first = _items.front()->getCoord();
+		mBounds.set(first.left, first.top, first.right(), first.bottom());
+		long long totalWidth = 0;
+		long long totalHeight = 0;
+		for (VectorWidgetPtr::const_iterator iter = _items.begin(); iter != _items.end(); ++iter)
+		{
+			const IntCoord& coord = (*iter)->getCoord();
+			mBounds.left = (std::min)(mBounds.left, coord.left);
+			mBounds.top = (std::min)(mBounds.top, coord.top);
+			mBounds.right = (std::max)(mBounds.right, coord.right());
+			mBounds.bottom = (std::max)(mBounds.bottom, coord.bottom());
+			totalWidth += coord.width;
+			totalHeight += coord.height;
+		}
+
+		// cell size close to average item size
+		int width = mBounds.width() + 1;
+		int height = mBounds.height() + 1;
+		int averageWidth = (std::max)(1, (int)(totalWidth / (long long)_items.size()));
+		int averageHeight = (std::max)(1, (int)(totalHeight / (long long)_items.size()));
+		mColumns = (std::max)(1, (std::min)(PICK_GRID_MAX_CELLS, width / averageWidth));
+		mRows = (std::max)(1, (std::min)(PICK_GRID_MAX_CELLS, height / averageHeight));
+		mCellWidth = (width + mColumns - 1) / mColumns;
+		mCellHeight = (height + mRows - 1) / mRows;
+
+		mCells.resize(mColumns * mRows);
+		mItemCells.resize(_items.size());
+		for (size_t index = 0; index < _items.size(); ++index)
+		{
+			mItemIndexes[_items[index]] = index;
+			mItemCells[index] = getCellRect(_items[index]->getCoord());
+			addToCells(index, mItemCells[index]);
+		}
+	}
+
+	void PickGrid::clear()
+	{
+		mOutOfDate = true;
+		mBounds.clear();
+		mColumns = 0;
+		mRows = 0;
+		mCells.clear();
+		mItemCells.clear();
+		mItemIndexes.clear();
+	}
+
+	void PickGrid::outOfDate()
+	{
+		mOutOfDate = true;
+	}
+
+	bool PickGrid::isOutOfDate() const
+	{
+		return mOutOfDate;
+	}
+
+	void PickGrid::updateItem(Widget* _item)
+	{
+		if (mOutOfDate)
+			return;
+
+		std::map<Widget*, size_t>::const_iterator item = mItemIndexes.find(_item);
+		// not picked through grid, for example skin child
+		if (item == mItemIndexes.end())
+			return;
+
+		const IntCoord& coord = _item->getCoord();
+		if (coord.left < mBounds.left || coord.top < mBounds.top || coord.right() > mBounds.right || coord.bottom() > mBounds.bottom)
+		{
+			// item left grid bounds
+			mOutOfDate = true;
+			return;
+		}
+
+		IntRect cells = getCellRect(coord);
+		IntRect& oldCells = mItemCells[item->second];
+		if (cells == oldCells)
+			return;
+
+		removeFromCells(item->second, oldCells);
+		addToCells(item->second, cells);
+		oldCells = cells;
+	}
+
+	const std::vector<size_t>& PickGrid::getItemsByPoint(int _left, int _top) const
+	{
+		if (mCells.empty() || !mBounds.inside(IntPoint(_left, _top)))
+			return mEmpty;
+
+		int column = (_left - mBounds.left) / mCellWidth;
+		int row = (_top - mBounds.top) / mCellHeight;
+		return mCells[row * mColumns + column];
+	}
+
+	IntRect PickGrid::getCellRect(const IntCoord& _coord) const
+	{
+		return IntRect(
+			(_coord.left - mBounds.left) / mCellWidth,
+			(_coord.top - mBounds.top) / mCellHeight,
+			(_coord.right() - mBounds.left) / mCellWidth,
+			(_coord.bottom() - mBounds.top) / mCellHeight);
+	}
+
+	void PickGrid::addToCells(size_t _index, const IntRect& _cells)
+	{
+		for (int row = _cells.top; row <= _cells.bottom; ++row)
+		{
+			for (int column = _cells.left; column <= _cells.right; ++column)
+			{
+				VectorIndex& cell = mCells[row * mColumns + column];
+				cell.insert(std::lower_bound(cell.begin(), cell.end(), _index), _index);
+			}
+		}
+	}
+
+	void PickGrid::removeFromCells(size_t _index, const IntRect& _cells)
+	{
+		for (int row = _cells.top; row <= _cells.bottom; ++row)
+		{
+			for (int column = _cells.left; column <= _cells.right; ++column)
+			{
+				VectorIndex& cell = mCells[row * mColumns + column];
+				VectorIndex::iterator iter = std::lower_bound(cell.begin(), cell.end(), _index);
+				if (iter != cell.end() && *iter == _index)
+					cell.erase(iter);
+			}
+		}
+	}
+
+} // namespace MyGUI
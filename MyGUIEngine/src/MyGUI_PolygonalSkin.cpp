@@ -101,7 +101,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::setAlpha(float _alpha)
@@ -110,7 +110,7 @@ namespace MyGUI
 		mCurrentColour = (mCurrentColour & 0x00FFFFFF) | (alpha & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::_correctView()
@@ -118,7 +118,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::_setAlign(const IntSize& _oldsize)
@@ -184,7 +184,7 @@ namespace MyGUI
 
 				// обновить перед выходом
 				if (nullptr != mNode)
-					mNode->outOfDate(mRenderItem);
+					mNode->outOfDate(mRenderItem, this);
 				return;
 			}
 		}
@@ -200,7 +200,7 @@ namespace MyGUI
 		mIsMargin = margin;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::createDrawItem(ITexture* _texture, ILayerNode* _node)
@@ -255,7 +255,7 @@ namespace MyGUI
 		mCurrentColour = (colour & 0x00FFFFFF) | (mCurrentColour & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::setStateData(IStateInfo* _data)
@@ -270,7 +270,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void PolygonalSkin::_rebuildGeometry()
@@ -484,8 +484,8 @@ namespace MyGUI
 
 		// now calculate widget base offset and then resulting position in screen coordinates
 		const RenderTargetInfo& info = mRenderItem->getRenderTarget()->getInfo();
-		float vertex_left_base = ((info.pixScaleX * (float)(mCroppedParent->getAbsoluteLeft()) + info.hOffset) * 2) - 1;
-		float vertex_top_base = -(((info.pixScaleY * (float)(mCroppedParent->getAbsoluteTop()) + info.vOffset) * 2) - 1);
+		float vertex_left_base = ((info.pixScaleX * (float)(mCroppedParent->getAbsoluteLeft() - info.leftOffset) + info.hOffset) * 2) - 1;
+		float vertex_top_base = -(((info.pixScaleY * (float)(mCroppedParent->getAbsoluteTop() - info.topOffset) + info.vOffset) * 2) - 1);
 
 		for (size_t i = 0; i < mResultVerticiesPos.size(); ++i)
 		{
@@ -0,0 +1,245 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_Profiler.h"
+#include <cstring>
+#include <fstream>
+
+namespace MyGUI
+{
+
+	// capture stops growing after that, about 24 Mb of sections
+	const size_t PROFILER_MAX_CAPTURE_SECTIONS = 1000000;
+
+	namespace
+	{
+		const char* const counterNames[ProfilerCounter::MAX] =
+		{
+			"Batches",
+			"Vertices",
+			"TessellatedItems",
+			"VertexBufferLocks",
+			"TextureSwitches",
+			"GlyphMisses",
+			"LayoutPasses"
+		};
+
+		double getMicroseconds(Profiler::Clock::time_point _start, Profiler::Clock::time_point _end)
+		{
+			return std::chrono::duration<double, std::micro>(_end - _start).count();
+		}
+
+		void writeString(std::ostream& _stream, const char* _value)
+		{
+			_stream << '"';
+			for (; *_value != 0; ++_value)
+			{
+				if (*_value == '"' || *_value == '\\')
+					_stream << '\\';
+				_stream << *_value;
+			}
+			_stream << '"';
+		}
+	}
+
+	Profiler::Profiler() :
+		mFrameStart(Clock::now()),
+		mLastTexture(nullptr),
+		mCaptureEnabled(false)
+	{
+		resetFrame(mCurrentFrame);
+		resetFrame(mLastFrame);
+	}
+
+	Profiler& Profiler::getInstance()
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	void Profiler::nextFrame()
+	{
+		Clock::time_point now = Clock::now();
+		mCurrentFrame.time = std::chrono::duration<double, std::milli>(now - mFrameStart).count();
+
+		if (mCaptureEnabled)
+		{
+			CaptureFrame frame;
+			// frame could start before capture was enabled
+			frame.start = (std::max)(mFrameStart, mCaptureStart);
+			frame.end = now;
+			memcpy(frame.counters, mCurrentFrame.counters, sizeof(frame.counters));
+			mCaptureFrames.push_back(frame);
+		}
+
+		size_t index = mCurrentFrame.index;
+		std::swap(mLastFrame, mCurrentFrame);
+		resetFrame(mCurrentFrame);
+		mCurrentFrame.index = index + 1;
+
+		mFrameStart = now;
+		mLastTexture = nullptr;
+	}
+
+	const Profiler::FrameInfo& Profiler::getLastFrame() const
+	{
+		return mLastFrame;
+	}
+
+	size_t Profiler::getCounter(ProfilerCounter::Enum _counter) const
+	{
+		MYGUI_ASSERT_RANGE(_counter, ProfilerCounter::MAX, "Profiler::getCounter");
+		return mLastFrame.counters[_counter];
+	}
+
+	double Profiler::getSectionTime(const std::string& _name) const
+	{
+		for (VectorSectionInfo::const_iterator section = mLastFrame.sections.begin(); section != mLastFrame.sections.end(); ++section)
+		{
+			if (_name == section->name)
+				return section->time;
+		}
+		return 0;
+	}
+
+	const char* Profiler::getCounterName(ProfilerCounter::Enum _counter)
+	{
+		MYGUI_ASSERT_RANGE(_counter, ProfilerCounter::MAX, "Profiler::getCounterName");
+		return counterNames[_counter];
+	}
+
+	void Profiler::setCaptureEnabled(bool _value)
+	{
+		if (_value && !mCaptureEnabled && mCaptureSections.empty() && mCaptureFrames.empty())
+			mCaptureStart = Clock::now();
+		mCaptureEnabled = _value;
+	}
+
+	bool Profiler::getCaptureEnabled() const
+	{
+		return mCaptureEnabled;
+	}
+
+	void Profiler::clearCapture()
+	{
+		mCaptureSections.clear();
+		mCaptureFrames.clear();
+		mCaptureStart = Clock::now();
+	}
+
+	void Profiler::writeChromeTrace(std::ostream& _stream) const
+	{
+		_stream << "{\"traceEvents\": [";
+
+		bool first = true;
+		for (std::vector<CaptureFrame>::const_iterator frame = mCaptureFrames.begin(); frame != mCaptureFrames.end(); ++frame)
+		{
+			double start = getMicroseconds(mCaptureStart, frame->start);
+			_stream << (first ? "\n" : ",\n");
+			_stream << "{\"name\": \"Frame\", \"cat\": \"MyGUI\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+				<< ", \"ts\": " << start << ", \"dur\": " << getMicroseconds(frame->start, frame->end) << "}";
+
+			// counters are shown from the beginning of the frame they were collected in
+			_stream << ",\n{\"name\": \"Counters\", \"cat\": \"MyGUI\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << start << ", \"args\": {";
+			for (size_t index = 0; index < ProfilerCounter::MAX; ++index)
+				_stream << (index != 0 ? ", " : "") << "\"" << counterNames[index] << "\": " << frame->counters[index];
+			_stream << "}}";
+
+			first = false;
+		}
+
+		for (std::vector<CaptureSection>::const_iterator section = mCaptureSections.begin(); section != mCaptureSections.end(); ++section)
+		{
+			_stream << (first ? "\n" : ",\n");
+			_stream << "{\"name\": ";
+			writeString(_stream, section->name);
+			_stream << ", \"cat\": \"MyGUI\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+				<< ", \"ts\": " << getMicroseconds(mCaptureStart, section->start)
+				<< ", \"dur\": " << getMicroseconds(section->start, section->end) << "}";
+
+			first = false;
+		}
+
+		_stream << "\n], \"displayTimeUnit\": \"ms\"}\n";
+	}
+
+	bool Profiler::saveChromeTrace(const std::string& _filename) const
+	{
+		std::ofstream stream;
+		stream.open(_filename.c_str(), std::ios_base::out | std::ios_base::binary);
+
+		if (!stream.is_open())
+		{
+			MYGUI_LOG(Error, "Profiler: can't open file '" << _filename << "' for writing");
+			return false;
+		}
+
+		writeChromeTrace(stream);
+
+		stream.close();
+		return true;
+	}
+
+	void Profiler::addCounter(ProfilerCounter::Enum _counter, size_t _value)
+	{
+		mCurrentFrame.counters[_counter] += _value;
+	}
+
+	void Profiler::addBatch(const void* _texture, size_t _vertexCount)
+	{
+		mCurrentFrame.counters[ProfilerCounter::Batches] ++;
+		mCurrentFrame.counters[ProfilerCounter::Vertices] += _vertexCount;
+
+		if (_texture != mLastTexture)
+		{
+			mCurrentFrame.counters[ProfilerCounter::TextureSwitches] ++;
+			mLastTexture = _texture;
+		}
+	}
+
+	void Profiler::addSection(const char* _name, Clock::time_point _start, Clock::time_point _end)
+	{
+		double time = std::chrono::duration<double, std::milli>(_end - _start).count();
+
+		VectorSectionInfo::iterator section = mCurrentFrame.sections.begin();
+		while (section != mCurrentFrame.sections.end() && section->name != _name && strcmp(section->name, _name) != 0)
+			++section;
+
+		if (section == mCurrentFrame.sections.end())
+		{
+			SectionInfo info;
+			info.name = _name;
+			info.time = time;
+			info.calls = 1;
+			mCurrentFrame.sections.push_back(info);
+		}
+		else
+		{
+			section->time += time;
+			section->calls ++;
+		}
+
+		if (mCaptureEnabled && mCaptureSections.size() < PROFILER_MAX_CAPTURE_SECTIONS)
+		{
+			CaptureSection capture;
+			capture.name = _name;
+			capture.start = _start;
+			capture.end = _end;
+			mCaptureSections.push_back(capture);
+		}
+	}
+
+	void Profiler::resetFrame(FrameInfo& _frame)
+	{
+		_frame.index = 0;
+		_frame.time = 0;
+		for (size_t index = 0; index < ProfilerCounter::MAX; ++index)
+			_frame.counters[index] = 0;
+		_frame.sections.clear();
+	}
+
+} // namespace MyGUI
@@ -11,7 +11,14 @@
 #include "MyGUI_Gui.h"
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_DataManager.h"
-#include "MyGUI_RenderManager.h"
+#include "MyGUI_Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+#if !defined(MYGUI_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MYGUI_RENDER_ITEM_SSE2
+	#include <emmintrin.h>
+#endif
 
 namespace MyGUI
 {
@@ -19,6 +26,10 @@ namespace MyGUI
 	RenderItem::RenderItem() :
 		mTexture(nullptr),
 		mNeedVertexCount(0),
+		mNeedBufferVertexCount(0),
+		mIndexedQuads(false),
+		mCompactVertices(false),
+		mPositionTransform(false),
 		mOutOfDate(false),
 		mCountVertex(0),
 		mCurrentUpdate(true),
@@ -27,9 +38,15 @@ namespace MyGUI
 		mVertexBuffer(nullptr),
 		mRenderTarget(nullptr),
 		mNeedCompression(false),
-		mManualRender(false)
+		mManualRender(false),
+		mPixelSpace(false),
+		mCopyScale(1, 1)
 	{
 		mVertexBuffer = RenderManager::getInstance().createVertexBuffer();
+		mVertexBuffer->setIndexedQuads(true);
+		mIndexedQuads = mVertexBuffer->getIndexedQuads();
+
+		setVertexLayout(RenderManager::getInstance().getVertexLayout());
 	}
 
 	RenderItem::~RenderItem()
@@ -43,35 +60,37 @@ namespace MyGUI
 		if (mTexture == nullptr)
 			return;
 
+		MYGUI_PROFILE_SCOPE("RenderItem::renderToTarget");
+
 		mRenderTarget = _target;
 
 		mCurrentUpdate = _update;
 
+		if (mPixelSpace)
+			mPixelSpaceTarget.setTarget(_target, mPixelSpaceOrigin);
+		bool remap = updateVertexTransform(_target->getInfo());
+
+		// reallocation moves items in cache, so it is done for all items before rendering any of them
 		if (mOutOfDate || _update)
 		{
-			mCountVertex = 0;
-			Vertex* buffer = mVertexBuffer->lock();
-			if (buffer != nullptr)
-			{
-				for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
-				{
-					// перед вызовом запоминаем позицию в буфере
-					mCurrentVertex = buffer;
-					mLastVertexCount = 0;
-
-					(*iter).first->doRender();
-
-					// колличество отрисованных вершин
-					MYGUI_DEBUG_ASSERT(mLastVertexCount <= (*iter).second, "It is too much vertexes");
-					buffer += mLastVertexCount;
-					mCountVertex += mLastVertexCount;
-				}
-
-				mVertexBuffer->unlock();
-			}
+			for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
+				(*iter).item->_prepareRender();
+		}
+		else
+		{
+			for (VectorSubWidget::iterator iter = mOutOfDateItems.begin(); iter != mOutOfDateItems.end(); ++iter)
+				(*iter)->_prepareRender();
+		}
 
+		if (mOutOfDate || _update)
+		{
+			updateAllDrawItems();
 			mOutOfDate = false;
 		}
+		else if (!mOutOfDateItems.empty() || remap)
+		{
+			updateOutOfDateDrawItems(remap);
+		}
 
 		// хоть с 0 не выводиться батч, но все равно не будем дергать стейт и операцию
 		if (0 != mCountVertex)
@@ -85,29 +104,451 @@ namespace MyGUI
 			}
 #endif
 			// непосредственный рендринг
+			MYGUI_PROFILE_SCOPE("IRenderTarget::doRender");
+
 			if (mManualRender)
 			{
 				for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
-					(*iter).first->doManualRender(mVertexBuffer, mTexture, mCountVertex);
+				{
+					MYGUI_PROFILE_BATCH(mTexture, mCountVertex);
+					(*iter).item->doManualRender(mVertexBuffer, mTexture, mCountVertex);
+				}
 			}
 			else
 			{
+				MYGUI_PROFILE_BATCH(mTexture, mCountVertex);
 				_target->doRender(mVertexBuffer, mTexture, mCountVertex);
 			}
 		}
 	}
 
+	void RenderItem::updateAllDrawItems()
+	{
+		mOutOfDateItems.clear();
+
+		if (mVertexCache.size() < mNeedVertexCount)
+			mVertexCache.resize(mNeedVertexCount);
+
+		size_t cacheOffset = 0;
+		size_t bufferOffset = 0;
+		for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
+		{
+			(*iter).cacheOffset = cacheOffset;
+			(*iter).bufferOffset = bufferOffset;
+			renderDrawItem(*iter);
+
+			cacheOffset += (*iter).count;
+			bufferOffset += (*iter).bufferCount;
+		}
+
+		mCountVertex = copyAllDrawItems(bufferOffset) ? bufferOffset : 0;
+	}
+
+	void RenderItem::updateOutOfDateDrawItems(bool _all)
+	{
+		std::sort(mOutOfDateItems.begin(), mOutOfDateItems.end());
+
+		// range of vertex buffer that differs from its current content
+		size_t rangeStart = ITEM_NONE;
+		size_t rangeEnd = 0;
+
+		size_t bufferOffset = 0;
+		for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
+		{
+			bool changed = (*iter).bufferOffset != bufferOffset;
+			if (std::binary_search(mOutOfDateItems.begin(), mOutOfDateItems.end(), (*iter).item))
+			{
+				renderDrawItem(*iter);
+				changed = true;
+			}
+
+			(*iter).bufferOffset = bufferOffset;
+			bufferOffset += (*iter).bufferCount;
+
+			if (changed && (*iter).bufferCount != 0)
+			{
+				if (rangeStart == ITEM_NONE)
+					rangeStart = (*iter).bufferOffset;
+				rangeEnd = bufferOffset;
+			}
+		}
+
+		mOutOfDateItems.clear();
+
+		if (_all && bufferOffset != 0)
+		{
+			rangeStart = 0;
+			rangeEnd = bufferOffset;
+		}
+
+		if (rangeStart != ITEM_NONE)
+		{
+			MYGUI_PROFILE_COUNTER(VertexBufferLocks, 1);
+			Vertex* buffer = mVertexBuffer->lockRange(rangeStart, rangeEnd - rangeStart);
+			bool copied = false;
+			if (buffer != nullptr)
+			{
+				copied = copyLockedDrawItems(buffer, rangeStart, rangeEnd);
+				mVertexBuffer->unlock();
+			}
+
+			// buffer can't be updated partially or compact vertices didn't fit, upload all cached vertices
+			if (!copied && !copyAllDrawItems(bufferOffset))
+			{
+				mCountVertex = 0;
+				return;
+			}
+		}
+
+		mCountVertex = bufferOffset;
+	}
+
+	void RenderItem::renderDrawItem(DrawItemInfo& _info)
+	{
+		// перед вызовом запоминаем позицию в буфере
+		mCurrentVertex = mVertexCache.data() + _info.cacheOffset;
+		mLastVertexCount = 0;
+
+		MYGUI_PROFILE_COUNTER(TessellatedItems, 1);
+		_info.item->doRender();
+
+		// колличество отрисованных вершин
+		MYGUI_DEBUG_ASSERT(mLastVertexCount <= _info.count, "It is too much vertexes");
+		_info.vertexCount = mLastVertexCount;
+		_info.bufferCount = getBufferVertexCount(_info.quads, mLastVertexCount);
+	}
+
+	namespace
+	{
+
+		// copies vertices as they are
+		struct VertexCopy
+		{
+			void operator()(Vertex& _destination, const Vertex& _source) const
+			{
+				_destination = _source;
+			}
+
+			void operator()(Vertex* _destination, const Vertex* _source, size_t _count) const
+			{
+				memcpy(_destination, _source, _count * sizeof(Vertex));
+			}
+		};
+
+		// maps positions while copying, for vertex buffers without position transform
+		struct TransformVertexCopy
+		{
+			TransformVertexCopy(const FloatPoint& _scale, const FloatPoint& _offset) :
+				scale(_scale),
+				offset(_offset)
+			{
+			}
+
+			void operator()(Vertex& _destination, const Vertex& _source) const
+			{
+				_destination = _source;
+				_destination.x = _source.x * scale.left + offset.left;
+				_destination.y = _source.y * scale.top + offset.top;
+			}
+
+			void operator()(Vertex* _destination, const Vertex* _source, size_t _count) const
+			{
+				for (size_t index = 0; index < _count; ++index)
+					operator()(_destination[index], _source[index]);
+			}
+
+			FloatPoint scale;
+			FloatPoint offset;
+		};
+
+		// maps positions to pixels while copying and packs vertices, remembers if any position didn't fit
+		class CompactVertexCopy
+		{
+		public:
+			CompactVertexCopy(const FloatPoint& _scale, const FloatPoint& _offset) :
+				mScale(_scale),
+				mOffset(_offset),
+				mInRange(true)
+			{
+#ifdef MYGUI_RENDER_ITEM_SSE2
+				// two vertices per register, fixed point scale is applied together with mapping
+				mPositionScale = _mm_setr_ps(_scale.left, _scale.top, _scale.left, _scale.top);
+				mPositionScale = _mm_mul_ps(mPositionScale, _mm_set1_ps((float)CompactVertex::PositionScale));
+				mPositionOffset = _mm_setr_ps(_offset.left, _offset.top, _offset.left, _offset.top);
+				mPositionOffset = _mm_mul_ps(mPositionOffset, _mm_set1_ps((float)CompactVertex::PositionScale));
+				mOutOfRange = _mm_setzero_ps();
+#endif
+			}
+
+			void operator()(CompactVertex& _destination, const Vertex& _source)
+			{
+				float x = _source.x * mScale.left + mOffset.left;
+				float y = _source.y * mScale.top + mOffset.top;
+				if (!CompactVertex::isPositionInRange(x) || !CompactVertex::isPositionInRange(y))
+					mInRange = false;
+				_destination.set(x, y, _source.colour, _source.u, _source.v);
+			}
+
+			void operator()(CompactVertex* _destination, const Vertex* _source, size_t _count)
+			{
+				size_t index = 0;
+#ifdef MYGUI_RENDER_ITEM_SSE2
+				const __m128 texCoordScale = _mm_set1_ps((float)CompactVertex::TexCoordScale);
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 minimum = _mm_set1_ps(-32768.0f);
+				const __m128 maximum = _mm_set1_ps(32767.0f);
+				// texture coordinates are packed as signed and restored by flipping of sign bit
+				const __m128i unsignedBias = _mm_set1_epi32(32768);
+				const __m128i signFlip = _mm_set1_epi16(-32768);
+
+				for (; index + 4 <= _count; index += 4)
+				{
+					const Vertex* source = _source + index;
+
+					__m128 position01 = _mm_add_ps(_mm_mul_ps(loadPair(&source[0].x, &source[1].x), mPositionScale), mPositionOffset);
+					__m128 position23 = _mm_add_ps(_mm_mul_ps(loadPair(&source[2].x, &source[3].x), mPositionScale), mPositionOffset);
+					mOutOfRange = _mm_or_ps(mOutOfRange, _mm_or_ps(_mm_cmplt_ps(position01, minimum), _mm_cmpgt_ps(position01, maximum)));
+					mOutOfRange = _mm_or_ps(mOutOfRange, _mm_or_ps(_mm_cmplt_ps(position23, minimum), _mm_cmpgt_ps(position23, maximum)));
+					__m128i positions = _mm_packs_epi32(_mm_cvtps_epi32(position01), _mm_cvtps_epi32(position23));
+
+					__m128 texCoord01 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(loadPair(&source[0].u, &source[1].u), texCoordScale), zero), texCoordScale);
+					__m128 texCoord23 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(loadPair(&source[2].u, &source[3].u), texCoordScale), zero), texCoordScale);
+					__m128i texCoords = _mm_packs_epi32(
+						_mm_sub_epi32(_mm_cvtps_epi32(texCoord01), unsignedBias),
+						_mm_sub_epi32(_mm_cvtps_epi32(texCoord23), unsignedBias));
+					texCoords = _mm_xor_si128(texCoords, signFlip);
+
+					// one 32 bit word of x and y, and of u and v per vertex
+					uint32 packedPositions[4];
+					uint32 packedTexCoords[4];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(packedPositions), positions);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(packedTexCoords), texCoords);
+
+					CompactVertex* destination = _destination + index;
+					for (size_t vertex = 0; vertex < 4; ++vertex)
+					{
+						memcpy(&destination[vertex].x, &packedPositions[vertex], sizeof(uint32));
+						destination[vertex].colour = source[vertex].colour;
+						memcpy(&destination[vertex].u, &packedTexCoords[vertex], sizeof(uint32));
+					}
+				}
+#endif
+				for (; index < _count; ++index)
+					operator()(_destination[index], _source[index]);
+			}
+
+			bool isInRange() const
+			{
+#ifdef MYGUI_RENDER_ITEM_SSE2
+				if (_mm_movemask_ps(mOutOfRange) != 0)
+					return false;
+#endif
+				return mInRange;
+			}
+
+		private:
+#ifdef MYGUI_RENDER_ITEM_SSE2
+			static __m128 loadPair(const float* _first, const float* _second)
+			{
+				return _mm_castsi128_ps(_mm_unpacklo_epi64(
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(_first)),
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(_second))));
+			}
+#endif
+
+		private:
+			FloatPoint mScale;
+			FloatPoint mOffset;
+			bool mInRange;
+#ifdef MYGUI_RENDER_ITEM_SSE2
+			__m128 mPositionScale;
+			__m128 mPositionOffset;
+			__m128 mOutOfRange;
+#endif
+		};
+
+	} // namespace
+
+	bool RenderItem::copyLockedDrawItems(Vertex* _buffer, size_t _start, size_t _end) const
+	{
+		if (mCompactVertices)
+		{
+			CompactVertexCopy copy(mCopyScale, mCopyOffset);
+			copyDrawItems(reinterpret_cast<CompactVertex*>(_buffer) - _start, _start, _end, copy);
+			return copy.isInRange();
+		}
+
+		if (mCopyScale != FloatPoint(1, 1) || mCopyOffset != FloatPoint())
+		{
+			TransformVertexCopy copy(mCopyScale, mCopyOffset);
+			copyDrawItems(_buffer - _start, _start, _end, copy);
+		}
+		else
+		{
+			VertexCopy copy;
+			copyDrawItems(_buffer - _start, _start, _end, copy);
+		}
+		return true;
+	}
+
+	template <typename VertexType, typename Copy>
+	void RenderItem::copyDrawItems(VertexType* _buffer, size_t _start, size_t _end, Copy& _copy) const
+	{
+		for (VectorDrawItem::const_iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
+		{
+			const DrawItemInfo& info = *iter;
+			if (info.bufferCount == 0 || info.bufferOffset + info.bufferCount <= _start)
+				continue;
+			if (info.bufferOffset >= _end)
+				break;
+
+			const Vertex* source = mVertexCache.data() + info.cacheOffset;
+			VertexType* destination = _buffer + info.bufferOffset;
+			if (info.quads == mIndexedQuads)
+			{
+				_copy(destination, source, info.vertexCount);
+			}
+			else if (info.quads)
+			{
+				// restore duplicated corners for triangle list
+				for (size_t index = 0; index + IndexedVertexQuad::VertexCount <= info.vertexCount; index += IndexedVertexQuad::VertexCount)
+				{
+					_copy(destination[VertexQuad::CornerLT], source[IndexedVertexQuad::CornerLT]);
+					_copy(destination[VertexQuad::CornerRT], source[IndexedVertexQuad::CornerRT]);
+					_copy(destination[VertexQuad::CornerLB], source[IndexedVertexQuad::CornerLB]);
+					_copy(destination[VertexQuad::CornerLB2], source[IndexedVertexQuad::CornerLB]);
+					_copy(destination[VertexQuad::CornerRT2], source[IndexedVertexQuad::CornerRT]);
+					_copy(destination[VertexQuad::CornerRB], source[IndexedVertexQuad::CornerRB]);
+					source += IndexedVertexQuad::VertexCount;
+					destination += VertexQuad::VertexCount;
+				}
+			}
+			else
+			{
+				// every triangle becomes quad with degenerate second triangle
+				for (size_t index = 0; index + 3 <= info.vertexCount; index += 3)
+				{
+					_copy(destination[IndexedVertexQuad::CornerLT], source[0]);
+					_copy(destination[IndexedVertexQuad::CornerRT], source[1]);
+					_copy(destination[IndexedVertexQuad::CornerLB], source[2]);
+					_copy(destination[IndexedVertexQuad::CornerRB], source[2]);
+					source += 3;
+					destination += IndexedVertexQuad::VertexCount;
+				}
+			}
+		}
+	}
+
+	bool RenderItem::updateVertexTransform(const RenderTargetInfo& _info)
+	{
+		// mapping of cached vertices to render target
+		FloatPoint scale(1, 1);
+		FloatPoint offset;
+		if (mPixelSpace)
+		{
+			// same mapping as sub widgets use for vertices in render target space:
+			// x = ((pixScaleX * (left - leftOffset) + hOffset) * 2) - 1, y = -(((pixScaleY * (top - topOffset) + vOffset) * 2) - 1)
+			// while pixel space vertices are x = left - originX, y = originY - top
+			scale.set(_info.pixScaleX * 2, _info.pixScaleY * 2);
+			offset.set(
+				scale.left * (float)(mPixelSpaceOrigin.left - _info.leftOffset) + _info.hOffset * 2 - 1,
+				1 - _info.vOffset * 2 - scale.top * (float)(mPixelSpaceOrigin.top - _info.topOffset));
+		}
+
+		// part of mapping applied when vertices are copied to buffer, the rest is done by buffer
+		FloatPoint copyScale(1, 1);
+		FloatPoint copyOffset;
+		FloatPoint bufferScale(1, 1);
+		FloatPoint bufferOffset;
+		if (mCompactVertices)
+		{
+			// compact positions are pixels from node origin, or from center of render target
+			if (!mPixelSpace)
+				copyScale.set(1 / (_info.pixScaleX * 2), 1 / (_info.pixScaleY * 2));
+			bufferScale.set(scale.left / copyScale.left, scale.top / copyScale.top);
+			bufferOffset = offset;
+		}
+		else if (mPositionTransform)
+		{
+			bufferScale = scale;
+			bufferOffset = offset;
+		}
+		else
+		{
+			copyScale = scale;
+			copyOffset = offset;
+		}
+
+		if (bufferScale != mVertexBuffer->getPositionScale() || bufferOffset != mVertexBuffer->getPositionOffset())
+			mVertexBuffer->setPositionTransform(bufferScale, bufferOffset);
+
+		if (copyScale == mCopyScale && copyOffset == mCopyOffset)
+			return false;
+
+		mCopyScale = copyScale;
+		mCopyOffset = copyOffset;
+		return true;
+	}
+
+	bool RenderItem::copyAllDrawItems(size_t _count)
+	{
+		MYGUI_PROFILE_COUNTER(VertexBufferLocks, 1);
+		Vertex* buffer = mVertexBuffer->lock();
+		if (buffer == nullptr)
+			return false;
+
+		bool packed = copyLockedDrawItems(buffer, 0, _count);
+		mVertexBuffer->unlock();
+
+		if (!packed)
+		{
+			// compact positions would be clamped, this item keeps float vertices from now on
+			setVertexLayout(VertexLayout::Float);
+			updateVertexTransform(mRenderTarget->getInfo());
+			return copyAllDrawItems(_count);
+		}
+
+		return true;
+	}
+
+	void RenderItem::setVertexLayout(VertexLayout _value)
+	{
+		// compact vertices are mapped to render target by vertex buffer, so they need its position transform
+		mPositionTransform = mVertexBuffer->setPositionTransform(FloatPoint(1, 1), FloatPoint());
+		if (!mPositionTransform)
+			_value = VertexLayout::Float;
+
+		if (mVertexBuffer->getVertexLayout() != _value)
+			mVertexBuffer->setVertexLayout(_value);
+
+		mCompactVertices = mVertexBuffer->getVertexLayout() == VertexLayout::Compact;
+
+		// buffer transform was reset
+		mCopyScale.clear();
+		mCopyOffset.clear();
+	}
+
+	size_t RenderItem::getBufferVertexCount(bool _quads, size_t _count) const
+	{
+		if (_quads == mIndexedQuads)
+			return _count;
+		if (_quads)
+			return _count / IndexedVertexQuad::VertexCount * VertexQuad::VertexCount;
+		return _count / 3 * IndexedVertexQuad::VertexCount;
+	}
+
 	void RenderItem::removeDrawItem(ISubWidget* _item)
 	{
 		for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
 		{
-			if ((*iter).first == _item)
+			if ((*iter).item == _item)
 			{
-				mNeedVertexCount -= (*iter).second;
+				mNeedVertexCount -= (*iter).count;
+				mNeedBufferVertexCount -= getBufferVertexCount((*iter).quads, (*iter).count);
 				mDrawItems.erase(iter);
 				mOutOfDate = true;
 
-				mVertexBuffer->setVertexCount(mNeedVertexCount);
+				mVertexBuffer->setVertexCount(mNeedBufferVertexCount);
 
 				// если все отдетачились, расскажем отцу
 				if (mDrawItems.empty())
@@ -122,39 +563,42 @@ namespace MyGUI
 		MYGUI_EXCEPT("DrawItem not found");
 	}
 
-	void RenderItem::addDrawItem(ISubWidget* _item, size_t _count)
+	void RenderItem::addDrawItem(ISubWidget* _item, size_t _count, bool _quads)
 	{
 
 // проверяем только в дебаге
 #if MYGUI_DEBUG_MODE == 1
 		for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
 		{
-			MYGUI_ASSERT((*iter).first != _item, "DrawItem exist");
+			MYGUI_ASSERT((*iter).item != _item, "DrawItem exist");
 		}
 #endif
 
-		mDrawItems.push_back(DrawItemInfo(_item, _count));
+		mDrawItems.push_back(DrawItemInfo(_item, _count, _quads));
 		mNeedVertexCount += _count;
+		mNeedBufferVertexCount += getBufferVertexCount(_quads, _count);
 		mOutOfDate = true;
 
-		mVertexBuffer->setVertexCount(mNeedVertexCount);
+		mVertexBuffer->setVertexCount(mNeedBufferVertexCount);
 	}
 
 	void RenderItem::reallockDrawItem(ISubWidget* _item, size_t _count)
 	{
 		for (VectorDrawItem::iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
 		{
-			if ((*iter).first == _item)
+			if ((*iter).item == _item)
 			{
 				// если нужно меньше, то ниче не делаем
-				if ((*iter).second < _count)
+				if ((*iter).count < _count)
 				{
-					mNeedVertexCount -= (*iter).second;
+					mNeedVertexCount -= (*iter).count;
 					mNeedVertexCount += _count;
-					(*iter).second = _count;
+					mNeedBufferVertexCount -= getBufferVertexCount((*iter).quads, (*iter).count);
+					mNeedBufferVertexCount += getBufferVertexCount((*iter).quads, _count);
+					(*iter).count = _count;
 					mOutOfDate = true;
 
-					mVertexBuffer->setVertexCount(mNeedVertexCount);
+					mVertexBuffer->setVertexCount(mNeedBufferVertexCount);
 				}
 				return;
 			}
@@ -195,6 +639,28 @@ namespace MyGUI
 	void RenderItem::setManualRender(bool _value)
 	{
 		mManualRender = _value;
+
+		// manually rendered items draw vertex buffer themselves and expect render target space
+		if (mManualRender)
+			setPixelSpace(false);
+
+		// manually rendered items get vertex buffer and draw it themselves, so it stays triangle list of Vertex
+		mVertexBuffer->setIndexedQuads(!mManualRender);
+		bool indexedQuads = mVertexBuffer->getIndexedQuads();
+		bool compactVertices = mCompactVertices;
+		setVertexLayout(mManualRender ? VertexLayout::Float : RenderManager::getInstance().getVertexLayout());
+		if (mCompactVertices != compactVertices)
+			mOutOfDate = true;
+		if (mIndexedQuads != indexedQuads)
+		{
+			mIndexedQuads = indexedQuads;
+			mOutOfDate = true;
+
+			mNeedBufferVertexCount = 0;
+			for (VectorDrawItem::const_iterator iter = mDrawItems.begin(); iter != mDrawItems.end(); ++iter)
+				mNeedBufferVertexCount += getBufferVertexCount((*iter).quads, (*iter).count);
+			mVertexBuffer->setVertexCount(mNeedBufferVertexCount);
+		}
 	}
 
 	bool RenderItem::getManualRender() const
@@ -207,6 +673,22 @@ namespace MyGUI
 		mOutOfDate = true;
 	}
 
+	void RenderItem::outOfDate(ISubWidget* _item)
+	{
+		if (mOutOfDate)
+			return;
+
+		// same item may be reported several times per frame, don't let the list grow unbounded
+		if (mOutOfDateItems.size() >= mDrawItems.size())
+		{
+			mOutOfDate = true;
+			mOutOfDateItems.clear();
+			return;
+		}
+
+		mOutOfDateItems.push_back(_item);
+	}
+
 	bool RenderItem::isOutOfDate() const
 	{
 		return mOutOfDate;
@@ -217,6 +699,11 @@ namespace MyGUI
 		return mNeedVertexCount;
 	}
 
+	bool RenderItem::hasDrawItems() const
+	{
+		return !mDrawItems.empty();
+	}
+
 	size_t RenderItem::getVertexCount() const
 	{
 		return mCountVertex;
@@ -239,7 +726,68 @@ namespace MyGUI
 
 	IRenderTarget* RenderItem::getRenderTarget()
 	{
+		if (mPixelSpace && mRenderTarget != nullptr)
+			return &mPixelSpaceTarget;
 		return mRenderTarget;
 	}
 
+	void RenderItem::setPixelSpace(bool _value)
+	{
+		_value = _value && !mManualRender;
+		if (mPixelSpace == _value)
+			return;
+
+		mPixelSpace = _value;
+		mOutOfDate = true;
+	}
+
+	bool RenderItem::getPixelSpace() const
+	{
+		return mPixelSpace;
+	}
+
+	void RenderItem::setPixelSpaceOrigin(const IntPoint& _value)
+	{
+		mPixelSpaceOrigin = _value;
+	}
+
+	RenderItem::PixelSpaceTarget::PixelSpaceTarget() :
+		mTarget(nullptr)
+	{
+		mInfo.pixScaleX = 0.5f;
+		mInfo.pixScaleY = 0.5f;
+		mInfo.hOffset = 0.5f;
+		mInfo.vOffset = 0.5f;
+	}
+
+	void RenderItem::PixelSpaceTarget::begin()
+	{
+		mTarget->begin();
+	}
+
+	void RenderItem::PixelSpaceTarget::end()
+	{
+		mTarget->end();
+	}
+
+	void RenderItem::PixelSpaceTarget::doRender(IVertexBuffer* _buffer, ITexture* _texture, size_t _count)
+	{
+		mTarget->doRender(_buffer, _texture, _count);
+	}
+
+	const RenderTargetInfo& RenderItem::PixelSpaceTarget::getInfo() const
+	{
+		return mInfo;
+	}
+
+	void RenderItem::PixelSpaceTarget::setTarget(IRenderTarget* _target, const IntPoint& _origin)
+	{
+		mTarget = _target;
+
+		const RenderTargetInfo& info = _target->getInfo();
+		mInfo.maximumDepth = info.maximumDepth;
+		mInfo.aspectCoef = info.aspectCoef;
+		mInfo.setOffset(_origin.left, _origin.top);
+	}
+
 } // namespace MyGUI
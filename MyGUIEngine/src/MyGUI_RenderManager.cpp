@@ -15,15 +15,26 @@ namespace MyGUI
 	MYGUI_SINGLETON_DEFINITION(RenderManager);
 
 	RenderManager::RenderManager() :
-		mSingletonHolder(this)
+		mSingletonHolder(this),
+		mForceUpdate(false)
 	{
 	}
 
+	VertexLayout RenderManager::getVertexLayout() const
+	{
+		return VertexLayout::Float;
+	}
+
 	bool RenderManager::isFormatSupported(PixelFormat _format, TextureUsage _usage)
 	{
 		return true;
 	}
 
+	void RenderManager::_forceUpdate()
+	{
+		mForceUpdate = true;
+	}
+
 #if MYGUI_DEBUG_MODE == 1
 	bool RenderManager::checkTexture(ITexture* _texture)
 	{
@@ -40,9 +51,13 @@ namespace MyGUI
 
 	void RenderManager::onRenderToTarget(IRenderTarget* _target, bool _update)
 	{
+		// flag is reset before rendering, so requests made during this render are applied on next one
+		bool update = _update || mForceUpdate;
+		mForceUpdate = false;
+
 		LayerManager* layers = LayerManager::getInstancePtr();
 		if (layers != nullptr)
-			layers->renderToTarget(_target, _update);
+			layers->renderToTarget(_target, update);
 	}
 
 	void RenderManager::onFrameEvent(float _time)
@@ -8,6 +8,7 @@
 #include "MyGUI_ResourceImageSet.h"
 #include "MyGUI_ResourceManager.h"
 #include "MyGUI_LanguageManager.h"
+#include "MyGUI_TextureAtlasManager.h"
 #include "MyGUI_Constants.h"
 
 namespace MyGUI
@@ -35,6 +36,10 @@ namespace MyGUI
 
 			group.size = IntSize::parse(group_node->findAttribute("size"));
 
+			// texture could be packed into atlas page, frames are moved with it
+			IntPoint offset;
+			TextureAtlasManager::getInstance().mapTexture(group.texture, offset);
+
 			xml::ElementEnumerator index_node = group_node->getElementEnumerator();
 			while (index_node.next("Index"))
 			{
@@ -46,7 +51,7 @@ namespace MyGUI
 				while (frame_node.next("Frame"))
 				{
 					size_t count = utility::parseSizeT(frame_node->findAttribute("count"));
-					const IntPoint& point = IntPoint::parse(frame_node->findAttribute("point"));
+					const IntPoint& point = IntPoint::parse(frame_node->findAttribute("point")) + offset;
 					if ((count < 1) || (count > 256)) count = 1;
 					while (count > 0)
 					{
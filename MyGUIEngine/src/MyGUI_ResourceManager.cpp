@@ -11,6 +11,7 @@
 #include "MyGUI_DataManager.h"
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_DataStreamHolder.h"
+#include "MyGUI_DataMemoryStream.h"
 #include "MyGUI_ResourceImageSet.h"
 
 namespace MyGUI
@@ -33,6 +34,7 @@ namespace MyGUI
 
 		registerLoadXmlDelegate(mCategoryName) = newDelegate(this, &ResourceManager::loadFromXmlNode);
 		registerLoadXmlDelegate(mXmlListTagName) = newDelegate(this, &ResourceManager::_loadList);
+		registerLoadCompiledDelegate(mXmlListTagName) = newDelegate(this, &ResourceManager::_loadCompiledList);
 
 		// регестрируем дефолтные ресурсы
 		FactoryManager::getInstance().registerFactory<ResourceImageSet>(mCategoryName);
@@ -51,8 +53,10 @@ namespace MyGUI
 		clear();
 		unregisterLoadXmlDelegate(mCategoryName);
 		unregisterLoadXmlDelegate(mXmlListTagName);
+		unregisterLoadCompiledDelegate(mXmlListTagName);
 
 		mMapLoadXmlDelegate.clear();
+		mMapLoadCompiledDelegate.clear();
 
 		MYGUI_LOG(Info, getClassTypeName() << " successfully shutdown");
 		mIsInitialise = false;
@@ -116,6 +120,19 @@ namespace MyGUI
 		}
 	}
 
+	void ResourceManager::_loadCompiledList(const xml::CompiledElement& _node, const std::string& _file, Version _version)
+	{
+		for (size_t index = 0; index < _node.getChildCount(); ++index)
+		{
+			xml::CompiledElement node = _node.getChildAt(index);
+			if (!node.isName(mXmlListTagName.c_str())) continue;
+			xml::CompiledAttribute source = node.findAttribute("file");
+			if (!source.isValid()) continue;
+			MYGUI_LOG(Info, "Load ini file '" << source.getValue() << "'");
+			_loadImplement(source.getValue(), false, "", getClassTypeName());
+		}
+	}
+
 	ResourceManager::LoadXmlDelegate& ResourceManager::registerLoadXmlDelegate(const std::string& _key)
 	{
 		MapLoadXmlDelegate::iterator iter = mMapLoadXmlDelegate.find(_key);
@@ -129,6 +146,61 @@ namespace MyGUI
 		if (iter != mMapLoadXmlDelegate.end()) mMapLoadXmlDelegate.erase(iter);
 	}
 
+	ResourceManager::LoadCompiledDelegate& ResourceManager::registerLoadCompiledDelegate(const std::string& _key)
+	{
+		MapLoadCompiledDelegate::iterator iter = mMapLoadCompiledDelegate.find(_key);
+		MYGUI_ASSERT(iter == mMapLoadCompiledDelegate.end(), "name delegate is exist");
+		return (mMapLoadCompiledDelegate[_key] = LoadCompiledDelegate());
+	}
+
+	void ResourceManager::unregisterLoadCompiledDelegate(const std::string& _key)
+	{
+		MapLoadCompiledDelegate::iterator iter = mMapLoadCompiledDelegate.find(_key);
+		if (iter != mMapLoadCompiledDelegate.end()) mMapLoadCompiledDelegate.erase(iter);
+	}
+
+	bool ResourceManager::_loadCompiled(const xml::CompiledDocument& _document, const std::string& _file, bool _match, const std::string& _type)
+	{
+		// errors are reported when the same file is loaded as Element tree
+		xml::CompiledElement root = _document.getRoot();
+		if (!root.isName("MyGUI"))
+			return false;
+
+		xml::CompiledAttribute type = root.findAttribute("type");
+		if (type.isValid())
+		{
+			if (_match && _type != type.getValue())
+				return false;
+
+			MapLoadCompiledDelegate::iterator iter = mMapLoadCompiledDelegate.find(type.getValue());
+			if (iter == mMapLoadCompiledDelegate.end())
+				return false;
+
+			(*iter).second(root, _file, Version::parse(root.findAttribute("version").getValue()));
+			return true;
+		}
+
+		if (_match)
+			return false;
+
+		// nested blocks are walked in place only if all of them can be
+		for (size_t index = 0; index < root.getChildCount(); ++index)
+		{
+			xml::CompiledElement node = root.getChildAt(index);
+			if (node.isName("MyGUI") && mMapLoadCompiledDelegate.find(node.findAttribute("type").getValue()) == mMapLoadCompiledDelegate.end())
+				return false;
+		}
+
+		for (size_t index = 0; index < root.getChildCount(); ++index)
+		{
+			xml::CompiledElement node = root.getChildAt(index);
+			if (node.isName("MyGUI"))
+				mMapLoadCompiledDelegate[node.findAttribute("type").getValue()](node, _file, Version::parse(root.findAttribute("version").getValue()));
+		}
+
+		return true;
+	}
+
 	bool ResourceManager::_loadImplement(const std::string& _file, bool _match, const std::string& _type, const std::string& _instance)
 	{
 		DataStreamHolder data = DataManager::getInstance().getData(_file);
@@ -138,8 +210,34 @@ namespace MyGUI
 			return false;
 		}
 
+		std::string buffer(data.getData()->size(), '\0');
+		if (!buffer.empty())
+			buffer.resize(data.getData()->read(&buffer[0], buffer.size()));
+
+		// compiled file is walked in place when there are delegates for it
 		xml::Document doc;
-		if (!doc.open(data.getData()))
+		bool result = false;
+		if (xml::CompiledDocument::isCompiled(buffer.data(), buffer.size()))
+		{
+			xml::CompiledDocument compiled;
+			if (!compiled.open(buffer.data(), buffer.size()))
+			{
+				MYGUI_LOG(Error, _instance << " : '" << _file << "', " << compiled.getLastError());
+				return false;
+			}
+
+			if (_loadCompiled(compiled, _file, _match, _type))
+				return true;
+
+			result = doc.open(compiled);
+		}
+		else
+		{
+			DataMemoryStream stream(reinterpret_cast<unsigned char*>(&buffer[0]), buffer.size());
+			result = doc.open(&stream);
+		}
+
+		if (!result)
 		{
 			MYGUI_LOG(Error, _instance << " : '" << _file << "', " << doc.getLastError());
 			return false;
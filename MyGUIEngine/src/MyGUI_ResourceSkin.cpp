@@ -9,6 +9,7 @@
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_LanguageManager.h"
 #include "MyGUI_SubWidgetManager.h"
+#include "MyGUI_TextureAtlasManager.h"
 
 namespace MyGUI
 {
@@ -51,6 +52,10 @@ namespace MyGUI
 			texture = localizator.replaceTags(texture);
 		}
 
+		// texture could be packed into atlas page, states convert their coords the same way
+		IntPoint atlasOffset;
+		TextureAtlasManager::getInstance().mapTexture(texture, atlasOffset);
+
 		setInfo(size, texture);
 
 		// проверяем маску
@@ -10,6 +10,7 @@
 #include "MyGUI_DataStreamHolder.h"
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_Bitwise.h"
+#include "MyGUI_Profiler.h"
 
 #ifdef MYGUI_USE_FREETYPE
 
@@ -18,6 +19,10 @@
 #	include FT_BITMAP_H
 #	include FT_WINFONTS_H
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 #ifdef MYGUI_MSDF_FONTS
 #include "msdfgen/msdfgen.h"
 #include "msdfgen/msdfgen-ext.h"
@@ -58,6 +63,11 @@ namespace MyGUI
 		return 0;
 	}
 
+	size_t ResourceTrueTypeFont::getTextureVersion() const
+	{
+		return 0;
+	}
+
 	void ResourceTrueTypeFont::textureInvalidate(ITexture* _texture)
 	{
 	}
@@ -124,6 +134,22 @@ namespace MyGUI
 	{
 	}
 
+	void ResourceTrueTypeFont::setLazyMode(bool _value)
+	{
+	}
+
+	void ResourceTrueTypeFont::setLazyMaxTextureSize(int _value)
+	{
+	}
+
+	void ResourceTrueTypeFont::setCacheFile(const std::string& _value)
+	{
+	}
+
+	void ResourceTrueTypeFont::setRenderThreadCount(int _value)
+	{
+	}
+
 	void ResourceTrueTypeFont::addCodePointRange(Char _first, Char _second)
 	{
 	}
@@ -257,12 +283,130 @@ namespace MyGUI
 			}
 		};
 
+		// Fills the texture buffer with transparent white pixels.
+		template<bool LAMode>
+		void clearPixels(uint8* _dest, size_t _count)
+		{
+			for (uint8* endDest = _dest + _count * Pixel<LAMode>::getNumBytes(); _dest != endDest; )
+				Pixel<LAMode, false, false>::set(_dest, charMaskWhite, charMaskBlack);
+		}
+
+		// Copies a rectangle of _width x _height pixels between texture buffers with the specified widths.
+		void copyPixels(const uint8* _source, int _sourceWidth, int _sourceX, int _sourceY, uint8* _dest, int _destWidth, int _destX, int _destY, int _width, int _height, size_t _numBytes)
+		{
+			for (int y = 0; y < _height; ++y)
+				memcpy(
+					_dest + ((_destY + y) * _destWidth + _destX) * _numBytes,
+					_source + ((_sourceY + y) * _sourceWidth + _sourceX) * _numBytes,
+					_width * _numBytes);
+		}
+
+		// Identifies font cache files; the version has to be incremented whenever the format of the file changes.
+		const uint32 cacheMagic = 0x4346474D; // "MGFC"
+		const uint32 cacheVersion = 1;
+
+		// Adds the specified bytes to a 64-bit FNV-1a hash.
+		void hashBytes(uint64_t& _hash, const void* _data, size_t _size)
+		{
+			const uint8* data = static_cast<const uint8*>(_data);
+			for (size_t i = 0; i < _size; ++i)
+			{
+				_hash ^= data[i];
+				_hash *= 1099511628211ULL;
+			}
+		}
+
+		template<typename T>
+		void hashValue(uint64_t& _hash, const T& _value)
+		{
+			hashBytes(_hash, &_value, sizeof(T));
+		}
+
+		template<typename T>
+		void writeValue(std::ofstream& _stream, const T& _value)
+		{
+			_stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+		}
+
+		template<typename T>
+		bool readValue(IDataStream* _stream, T& _value)
+		{
+			return _stream->read(&_value, sizeof(T)) == sizeof(T);
+		}
+
+		void writeGlyphInfo(std::ofstream& _stream, const GlyphInfo& _info)
+		{
+			writeValue(_stream, (uint32)_info.codePoint);
+			writeValue(_stream, _info.width);
+			writeValue(_stream, _info.height);
+			writeValue(_stream, _info.advance);
+			writeValue(_stream, _info.bearingX);
+			writeValue(_stream, _info.bearingY);
+			writeValue(_stream, _info.uvRect.left);
+			writeValue(_stream, _info.uvRect.top);
+			writeValue(_stream, _info.uvRect.right);
+			writeValue(_stream, _info.uvRect.bottom);
+		}
+
+		bool readGlyphInfo(IDataStream* _stream, GlyphInfo& _info)
+		{
+			uint32 codePoint = 0;
+			bool result = readValue(_stream, codePoint) &&
+				readValue(_stream, _info.width) &&
+				readValue(_stream, _info.height) &&
+				readValue(_stream, _info.advance) &&
+				readValue(_stream, _info.bearingX) &&
+				readValue(_stream, _info.bearingY) &&
+				readValue(_stream, _info.uvRect.left) &&
+				readValue(_stream, _info.uvRect.top) &&
+				readValue(_stream, _info.uvRect.right) &&
+				readValue(_stream, _info.uvRect.bottom);
+			_info.codePoint = codePoint;
+			return result;
+		}
+
+		// Per-thread state of renderInThreads() for glyphs rendered with FreeType.
+		struct FaceRenderContext
+		{
+			FaceRenderContext(const FT_Library& _ftLibrary, const FT_Face& _ftFace) :
+				library(_ftLibrary),
+				face(_ftFace)
+			{
+			}
+
+			const FT_Library& library;
+			const FT_Face& face;
+		};
+
+#ifdef MYGUI_MSDF_FONTS
+		// Per-thread state of renderInThreads() for msdf glyphs, the face is adopted by msdfgen once for all glyphs of the thread.
+		struct MsdfRenderContext
+		{
+			MsdfRenderContext(const FT_Library& /*_ftLibrary*/, const FT_Face& _ftFace) :
+				font(msdfgen::adoptFreetypeFont(_ftFace))
+			{
+			}
+
+			~MsdfRenderContext()
+			{
+				msdfgen::destroyFont(font);
+			}
+
+			msdfgen::FontHandle* font;
+
+		private:
+			MsdfRenderContext(const MsdfRenderContext&);
+			MsdfRenderContext& operator=(const MsdfRenderContext&);
+		};
+#endif
+
 	}
 
 	const int ResourceTrueTypeFont::mDefaultGlyphSpacing = 1;
 	const float ResourceTrueTypeFont::mDefaultTabWidth = 8.0f;
 	const float ResourceTrueTypeFont::mSelectedWidth = 1.0f;
 	const float ResourceTrueTypeFont::mCursorWidth = 2.0f;
+	const size_t ResourceTrueTypeFont::mMinGlyphsPerThread = 64;
 
 	ResourceTrueTypeFont::ResourceTrueTypeFont() :
 		mSize(0),
@@ -276,14 +420,24 @@ namespace MyGUI
 		mSubstituteCodePoint(static_cast<Char>(FontCodeType::NotDefined)),
 		mMsdfMode(false),
 		mMsdfRange(2),
+		mLazyMode(false),
+		mLazyMaxTextureSize(2048),
+		mRenderThreadCount(0),
 		mDefaultHeight(0),
 		mSubstituteGlyphInfo(nullptr),
-		mTexture(nullptr)
+		mTexture(nullptr),
+		mTextureVersion(0),
+		mCacheKey(0),
+		mSpecifiedTabWidth(0.0f),
+		mSpecifiedSubstituteCodePoint(static_cast<Char>(FontCodeType::NotDefined)),
+		mLazyAtlas(nullptr)
 	{
 	}
 
 	ResourceTrueTypeFont::~ResourceTrueTypeFont()
 	{
+		destroyLazyAtlas();
+
 		if (mTexture != nullptr)
 		{
 			RenderManager::getInstance().destroyTexture(mTexture);
@@ -339,6 +493,22 @@ namespace MyGUI
 				{
 					setMsdfRange(utility::parseInt(value));
 				}
+				else if (key == "LazyMode")
+				{
+					setLazyMode(utility::parseBool(value));
+				}
+				else if (key == "LazyMaxTextureSize")
+				{
+					setLazyMaxTextureSize(utility::parseInt(value));
+				}
+				else if (key == "CacheFile")
+				{
+					setCacheFile(value);
+				}
+				else if (key == "RenderThreadCount")
+				{
+					setRenderThreadCount(utility::parseInt(value));
+				}
 			}
 			else if (node->getName() == "Codes")
 			{
@@ -361,7 +531,7 @@ namespace MyGUI
 
 				// If no code points have been included, include the Unicode Basic Multilingual Plane by default before processing
 				//	any exclusions.
-				if (mCharMap.empty())
+				if (mSpecifiedCharMap.empty())
 					addCodePointRange(0, 0xFFFF);
 
 				// Range of exclusions.
@@ -388,6 +558,9 @@ namespace MyGUI
 
 	const GlyphInfo* ResourceTrueTypeFont::getGlyphInfo(Char _id) const
 	{
+		if (mLazyAtlas != nullptr)
+			return getLazyGlyphInfo(_id);
+
 		GlyphMap::const_iterator glyphIter = mGlyphMap.find(_id);
 
 		if (glyphIter != mGlyphMap.end())
@@ -395,6 +568,7 @@ namespace MyGUI
 			return &glyphIter->second;
 		}
 
+		MYGUI_PROFILE_COUNTER(GlyphMisses, 1);
 		return mSubstituteGlyphInfo;
 	}
 
@@ -408,9 +582,20 @@ namespace MyGUI
 		return mDefaultHeight;
 	}
 
+	size_t ResourceTrueTypeFont::getTextureVersion() const
+	{
+		return mTextureVersion;
+	}
+
 	void ResourceTrueTypeFont::textureInvalidate(ITexture* _texture)
 	{
-		mGlyphMap.clear();
+		// In lazy mode glyphs are kept in memory, so only the texture contents have to be restored.
+		if (mLazyAtlas != nullptr)
+		{
+			uploadLazyTexture();
+			return;
+		}
+
 		initialise();
 	}
 
@@ -467,18 +652,30 @@ namespace MyGUI
 
 	void ResourceTrueTypeFont::addCodePointRange(Char _first, Char _second)
 	{
-		CharMap::iterator positionHint = mCharMap.lower_bound(_first);
+		addCodePointRange(mSpecifiedCharMap, _first, _second);
+		addCodePointRange(mCharMap, _first, _second);
+	}
+
+	void ResourceTrueTypeFont::removeCodePointRange(Char _first, Char _second)
+	{
+		removeCodePointRange(mSpecifiedCharMap, _first, _second);
+		removeCodePointRange(mCharMap, _first, _second);
+	}
+
+	void ResourceTrueTypeFont::addCodePointRange(CharMap& _charMap, Char _first, Char _second)
+	{
+		CharMap::iterator positionHint = _charMap.lower_bound(_first);
 
-		if (positionHint != mCharMap.begin())
+		if (positionHint != _charMap.begin())
 			--positionHint;
 
 		for (Char i = _first; i <= _second; ++i)
-			positionHint = mCharMap.insert(positionHint, CharMap::value_type(i, 0));
+			positionHint = _charMap.insert(positionHint, CharMap::value_type(i, 0));
 	}
 
-	void ResourceTrueTypeFont::removeCodePointRange(Char _first, Char _second)
+	void ResourceTrueTypeFont::removeCodePointRange(CharMap& _charMap, Char _first, Char _second)
 	{
-		mCharMap.erase(mCharMap.lower_bound(_first), mCharMap.upper_bound(_second));
+		_charMap.erase(_charMap.lower_bound(_first), _charMap.upper_bound(_second));
 	}
 
 	void ResourceTrueTypeFont::clearCodePoints()
@@ -491,11 +688,31 @@ namespace MyGUI
 		if (mGlyphSpacing == -1)
 			mGlyphSpacing = mDefaultGlyphSpacing;
 
+		// Start from the values specified by the user; a previous initialisation could have adjusted them.
+		mCharMap = mSpecifiedCharMap;
+		mTabWidth = mSpecifiedTabWidth;
+		mSubstituteCodePoint = mSpecifiedSubstituteCodePoint;
+		mGlyphMap.clear();
+		mSubstituteGlyphInfo = nullptr;
+
 		// If L8A8 (2 bytes per pixel) is supported, use it; otherwise, use R8G8B8A8 (4 bytes per pixel) as L8L8L8A8.
 		bool laMode = MyGUI::RenderManager::getInstance().isFormatSupported(Pixel<true>::getFormat(), TextureUsage::Static | TextureUsage::Write);
 		if (mMsdfMode)
 			laMode = false;
 
+		destroyLazyAtlas();
+
+		if (mLazyMode)
+		{
+			if (!mMsdfMode)
+			{
+				initialiseLazy(laMode);
+				return;
+			}
+
+			MYGUI_LOG(Warning, "ResourceTrueTypeFont: Lazy mode is not supported in msdf mode; all glyphs of font '" << getResourceName() << "' are rendered at once.");
+		}
+
 		// Select and call an appropriate initialisation method. By making this decision up front, we avoid having to branch on
 		// these variables many thousands of times inside tight nested loops later. From this point on, the various function
 		// templates ensure that all of the necessary branching is done purely at compile time for all combinations.
@@ -522,7 +739,32 @@ namespace MyGUI
 	void ResourceTrueTypeFont::initialiseFreeType()
 	{
 		//-------------------------------------------------------------------//
-		// Initialise FreeType and load the font.
+		// Load the font file and try to restore the glyphs from the cache.
+		//-------------------------------------------------------------------//
+
+		size_t fontBufferSize = 0;
+		uint8* fontBuffer = loadFontBuffer(fontBufferSize);
+
+		if (fontBuffer == nullptr)
+		{
+			MYGUI_LOG(Error, "ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
+			return;
+		}
+
+		if (!mCacheFile.empty())
+		{
+			// The key is calculated on every initialisation, so a change of any parameter since the last one is noticed.
+			calculateCacheKey(fontBuffer, fontBufferSize, LAMode);
+
+			if (loadCache(LAMode))
+			{
+				delete [] fontBuffer;
+				return;
+			}
+		}
+
+		//-------------------------------------------------------------------//
+		// Initialise FreeType and load the font face.
 		//-------------------------------------------------------------------//
 
 		FT_Library ftLibrary;
@@ -530,14 +772,13 @@ namespace MyGUI
 		if (FT_Init_FreeType(&ftLibrary) != 0)
 			MYGUI_EXCEPT("ResourceTrueTypeFont: Could not init the FreeType library!");
 
-		uint8* fontBuffer = nullptr;
-
-		FT_Face ftFace = loadFace(ftLibrary, fontBuffer);
+		FT_Face ftFace = loadFace(ftLibrary, fontBuffer, fontBufferSize);
 
 		if (ftFace == nullptr)
 		{
 			MYGUI_LOG(Error, "ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
 			FT_Done_FreeType(ftLibrary);
+			delete [] fontBuffer;
 			return;
 		}
 
@@ -554,50 +795,10 @@ namespace MyGUI
 		// Calculate the font metrics.
 		//-------------------------------------------------------------------//
 
-		// The font's overall ascent and descent are defined in three different places in a TrueType font, and with different
-		// values in each place. The most reliable source for these metrics is usually the "usWinAscent" and "usWinDescent" pair of
-		// values in the OS/2 header; however, some fonts contain inaccurate data there. To be safe, we use the highest of the set
-		// of values contained in the face metrics and the two sets of values contained in the OS/2 header.
-		int fontAscent = ftFace->size->metrics.ascender >> 6;
-		int fontDescent = -ftFace->size->metrics.descender >> 6;
-
-		TT_OS2* os2 = (TT_OS2*)FT_Get_Sfnt_Table(ftFace, ft_sfnt_os2);
-
-		if (os2 != nullptr)
-		{
-			setMax(fontAscent, os2->usWinAscent * ftFace->size->metrics.y_ppem / ftFace->units_per_EM);
-			setMax(fontDescent, os2->usWinDescent * ftFace->size->metrics.y_ppem / ftFace->units_per_EM);
-
-			setMax(fontAscent, os2->sTypoAscender * ftFace->size->metrics.y_ppem / ftFace->units_per_EM);
-			setMax(fontDescent, -os2->sTypoDescender * ftFace->size->metrics.y_ppem / ftFace->units_per_EM);
-		}
-
-		// The nominal font height is calculated as the sum of its ascent and descent as specified by the font designer. Previously
-		// it was defined by MyGUI in terms of the maximum ascent and descent of the glyphs currently in use, but this caused the
-		// font's line spacing to change whenever glyphs were added to or removed from the font definition. Doing it this way
-		// instead prevents a lot of layout problems, and it is also more typographically correct and more aesthetically pleasing.
-		mDefaultHeight = fontAscent + fontDescent;
+		int fontAscent = calculateFontMetrics(ftFace);
 
 		// Set the load flags based on the specified type of hinting.
-		FT_Int32 ftLoadFlags = FT_LOAD_DEFAULT;
-
-		switch (mHinting)
-		{
-		case HintingForceAuto:
-			ftLoadFlags = FT_LOAD_FORCE_AUTOHINT;
-			break;
-		case HintingDisableAuto:
-			ftLoadFlags = FT_LOAD_NO_AUTOHINT;
-			break;
-		case HintingDisableAll:
-			// When hinting is completely disabled, glyphs must always be rendered -- even during layout calculations -- due to
-			// discrepancies between the glyph metrics and the actual rendered bitmap metrics.
-			ftLoadFlags = FT_LOAD_NO_HINTING | FT_LOAD_RENDER;
-			break;
-		case HintingUseNative:
-			ftLoadFlags = FT_LOAD_DEFAULT;
-			break;
-		}
+		FT_Int32 ftLoadFlags = getLoadFlags();
 
 		//-------------------------------------------------------------------//
 		// Create the glyphs and calculate their metrics.
@@ -744,39 +945,45 @@ namespace MyGUI
 		// Create the texture and render the glyphs onto it.
 		//-------------------------------------------------------------------//
 
-		if (mTexture)
-		{
-			RenderManager::getInstance().destroyTexture( mTexture );
-			mTexture = nullptr;
-		}
-
-		mTexture = RenderManager::getInstance().createTexture(MyGUI::utility::toString((size_t)this, "_TrueTypeFont"));
-
-		mTexture->createManual(texWidth, texHeight, TextureUsage::Static | TextureUsage::Write, Pixel<LAMode>::getFormat());
-		mTexture->setInvalidateListener(this);
-
-		if (!mShader.empty())
-			mTexture->setShader(mShader);
+		createTexture(texWidth, texHeight, Pixel<LAMode>::getFormat());
 
 		uint8* texBuffer = static_cast<uint8*>(mTexture->lock(TextureUsage::Write));
 
 		if (texBuffer != nullptr)
 		{
+			size_t texBufferSize = texWidth * texHeight * Pixel<LAMode>::getNumBytes();
+
+			// The locked texture may be write-only, so glyphs that are going to be cached are rendered into memory first.
+			std::vector<uint8> cacheBuffer;
+			uint8* renderBuffer = texBuffer;
+
+			if (!mCacheFile.empty())
+			{
+				cacheBuffer.resize(texBufferSize);
+				renderBuffer = cacheBuffer.data();
+			}
+
 			// Make the texture background transparent white (or black for msdf mode).
-			for (uint8* dest = texBuffer, * endDest = dest + texWidth * texHeight * Pixel<LAMode>::getNumBytes(); dest != endDest; )
+			for (uint8* dest = renderBuffer, * endDest = dest + texBufferSize; dest != endDest; )
 				Pixel<LAMode, false, false>::set(dest, mMsdfMode ? charMaskBlack : charMaskWhite, charMaskBlack);
 
 			if (!mMsdfMode)
-				renderGlyphs<LAMode, Antialias>(glyphHeightMap, ftLibrary, ftFace, ftLoadFlags, texBuffer, texWidth, texHeight);
+				renderGlyphs<LAMode, Antialias>(glyphHeightMap, ftLibrary, ftFace, ftLoadFlags, fontBuffer, fontBufferSize, renderBuffer, texWidth, texHeight);
 #ifdef MYGUI_MSDF_FONTS
 			else
-				renderMsdfGlyphs(glyphHeightMap, msdfFont, texBuffer, texWidth, texHeight);
+				renderMsdfGlyphs(glyphHeightMap, ftLibrary, ftFace, fontBuffer, fontBufferSize, renderBuffer, texWidth, texHeight);
 #endif
 
+			if (!cacheBuffer.empty())
+				memcpy(texBuffer, cacheBuffer.data(), texBufferSize);
+
 			mTexture->unlock();
 
 			MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' using texture size " << texWidth << " x " << texHeight << ".");
 			MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' using real height " << mDefaultHeight << " pixels.");
+
+			if (!cacheBuffer.empty())
+				saveCache(cacheBuffer, texWidth, texHeight, Pixel<LAMode>::getNumBytes());
 		}
 		else
 		{
@@ -796,32 +1003,35 @@ namespace MyGUI
 		delete [] fontBuffer;
 	}
 
-	FT_Face ResourceTrueTypeFont::loadFace(const FT_Library& _ftLibrary, uint8*& _fontBuffer)
+	uint8* ResourceTrueTypeFont::loadFontBuffer(size_t& _fontBufferSize) const
 	{
-		FT_Face result = nullptr;
-
-		// Load the font file.
 		IDataStream* datastream = DataManager::getInstance().getData(mSource);
 
 		if (datastream == nullptr)
-			return result;
+			return nullptr;
 
-		size_t fontBufferSize = datastream->size();
-		_fontBuffer = new uint8[fontBufferSize];
-		datastream->read(_fontBuffer, fontBufferSize);
+		_fontBufferSize = datastream->size();
+		uint8* result = new uint8[_fontBufferSize];
+		datastream->read(result, _fontBufferSize);
 
 		DataManager::getInstance().freeData(datastream);
-		datastream = nullptr;
+
+		return result;
+	}
+
+	FT_Face ResourceTrueTypeFont::loadFace(const FT_Library& _ftLibrary, const uint8* _fontBuffer, size_t _fontBufferSize)
+	{
+		FT_Face result = nullptr;
 
 		// Determine how many faces the font contains.
-		if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)fontBufferSize, -1, &result) != 0)
+		if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)_fontBufferSize, -1, &result) != 0)
 			MYGUI_EXCEPT("ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
 
 		FT_Long numFaces = result->num_faces;
 		FT_Long faceIndex = 0;
 
 		// Load the first face.
-		if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)fontBufferSize, faceIndex, &result) != 0)
+		if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)_fontBufferSize, faceIndex, &result) != 0)
 			MYGUI_EXCEPT("ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
 
 		if (result->face_flags & FT_FACE_FLAG_SCALABLE)
@@ -835,7 +1045,7 @@ namespace MyGUI
 
 			// If no code points have been specified, use the Unicode Basic Multilingual Plane by default.
 			if (mCharMap.empty())
-				addCodePointRange(0, 0xFFFF);
+				addCodePointRange(mCharMap, 0, 0xFFFF);
 		}
 		else
 		{
@@ -856,7 +1066,7 @@ namespace MyGUI
 				FT_Done_Face(result);
 
 				if (++faceIndex < numFaces)
-					if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)fontBufferSize, faceIndex, &result) != 0)
+					if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)_fontBufferSize, faceIndex, &result) != 0)
 						MYGUI_EXCEPT("ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
 			}
 			while (faceIndex < numFaces);
@@ -865,7 +1075,7 @@ namespace MyGUI
 
 			faceIndex = (iter != faceSizes.end()) ? iter->second : faceSizes.rbegin()->second;
 
-			if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)fontBufferSize, faceIndex, &result) != 0)
+			if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)_fontBufferSize, faceIndex, &result) != 0)
 				MYGUI_EXCEPT("ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
 
 			// Select the first bitmap strike available in the selected face. This needs to be done explicitly even though Windows
@@ -878,222 +1088,1059 @@ namespace MyGUI
 			if (mCharMap.empty())
 			{
 				// No code points have been specified, so add the printable ASCII range by default.
-				addCodePointRange(0x20, 0x7E);
+				addCodePointRange(mCharMap, 0x20, 0x7E);
 
 				// Additionally, if the font's character set is CP-1252, add the range of non-ASCII 8-bit code points that are
 				// common between CP-1252 and ISO-8859-1; i.e., everything but 0x80 through 0x9F.
 				if (fnt.charset == FT_WinFNT_ID_CP1252)
-					addCodePointRange(0xA0, 0xFF);
+					addCodePointRange(mCharMap, 0xA0, 0xFF);
 			}
 			else
 			{
 				// Some code points have been specified, so remove anything in the non-printable ASCII range as well as anything
 				// over 8 bits.
-				removeCodePointRange(0, 0x1F);
-				removeCodePointRange(0x100, std::numeric_limits<Char>::max());
+				removeCodePointRange(mCharMap, 0, 0x1F);
+				removeCodePointRange(mCharMap, 0x100, std::numeric_limits<Char>::max());
 
 				// Additionally, remove non-ASCII 8-bit code points (plus ASCII DEL, 0x7F). If the font's character set is CP-1252,
 				// remove only the code points that differ between CP-1252 and ISO-8859-1; otherwise, remove all of them.
 				if (fnt.charset == FT_WinFNT_ID_CP1252)
-					removeCodePointRange(0x7F, 0x9F);
+					removeCodePointRange(mCharMap, 0x7F, 0x9F);
 				else
-					removeCodePointRange(0x7F, 0xFF);
+					removeCodePointRange(mCharMap, 0x7F, 0xFF);
 			}
 		}
 
 		return result;
 	}
 
-	void ResourceTrueTypeFont::autoWrapGlyphPos(int _glyphWidth, int _texWidth, int _lineHeight, int& _texX, int& _texY) const
+	void ResourceTrueTypeFont::calculateCacheKey(const uint8* _fontBuffer, size_t _fontBufferSize, bool _laMode)
 	{
-		if (_glyphWidth > 0 && _texX + mGlyphSpacing + _glyphWidth > _texWidth)
-		{
-			_texX = mGlyphSpacing;
-			_texY += mGlyphSpacing + _lineHeight;
-		}
-	}
+		uint64_t hash = 14695981039346656037ULL;
 
-	GlyphInfo ResourceTrueTypeFont::createFaceGlyphInfo(Char _codePoint, int _fontAscent, FT_GlyphSlot _glyph) const
-	{
-		float bearingX = _glyph->metrics.horiBearingX / 64.0f;
+		hashValue(hash, cacheVersion);
+		hashBytes(hash, _fontBuffer, _fontBufferSize);
+		hashValue(hash, mSize);
+		hashValue(hash, mResolution);
+		hashValue(hash, mHinting);
+		hashValue(hash, mAntialias);
+		hashValue(hash, mSpaceWidth);
+		hashValue(hash, mGlyphSpacing);
+		hashValue(hash, mSpecifiedTabWidth);
+		hashValue(hash, mOffsetHeight);
+		hashValue(hash, mSpecifiedSubstituteCodePoint);
+		hashValue(hash, mMsdfMode);
+		hashValue(hash, mMsdfRange);
+		hashValue(hash, _laMode);
 
-		// The following calculations aren't currently needed but are kept here for future use.
-		// float ascent = _glyph->metrics.horiBearingY / 64.0f;
-		// float descent = (_glyph->metrics.height / 64.0f) - ascent;
+		for (CharMap::const_iterator iter = mSpecifiedCharMap.begin(); iter != mSpecifiedCharMap.end(); ++iter)
+			hashValue(hash, iter->first);
 
-		return GlyphInfo(
-			_codePoint,
-			std::max((float)_glyph->bitmap.width, _glyph->metrics.width / 64.0f),
-			std::max((float)_glyph->bitmap.rows, _glyph->metrics.height / 64.0f),
-			(_glyph->advance.x / 64.0f) - bearingX,
-			bearingX,
-			std::floor(_fontAscent - (_glyph->metrics.horiBearingY / 64.0f) - mOffsetHeight));
+		// Zero means that the key is not calculated yet.
+		mCacheKey = hash != 0 ? hash : 1;
 	}
 
-	int ResourceTrueTypeFont::createGlyph(FT_UInt _glyphIndex, const GlyphInfo& _glyphInfo, GlyphHeightMap& _glyphHeightMap)
+	bool ResourceTrueTypeFont::loadCache(bool _laMode)
 	{
-		int width = (int)std::ceil(_glyphInfo.width);
-		int height = (int)std::ceil(_glyphInfo.height);
+		if (!DataManager::getInstance().isDataExist(mCacheFile))
+			return false;
 
-		mCharMap[_glyphInfo.codePoint] = _glyphIndex;
-		GlyphInfo& info = mGlyphMap.insert(GlyphMap::value_type(_glyphInfo.codePoint, _glyphInfo)).first->second;
-		_glyphHeightMap[height].insert(std::make_pair(_glyphIndex, &info));
+		DataStreamHolder data(DataManager::getInstance().getData(mCacheFile));
+		IDataStream* stream = data.getData();
 
-		return (width > 0) ? mGlyphSpacing + width : 0;
-	}
+		if (stream == nullptr)
+			return false;
 
-	int ResourceTrueTypeFont::createFaceGlyph(FT_UInt _glyphIndex, Char _codePoint, int _fontAscent, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, GlyphHeightMap& _glyphHeightMap)
-	{
-		if (mGlyphMap.find(_codePoint) == mGlyphMap.end())
+		uint32 magic = 0;
+		uint32 version = 0;
+		uint64_t key = 0;
+
+		if (!readValue(stream, magic) || !readValue(stream, version) || !readValue(stream, key) ||
+			magic != cacheMagic || version != cacheVersion || key != mCacheKey)
 		{
-			if (FT_Load_Glyph(_ftFace, _glyphIndex, _ftLoadFlags) == 0)
-				return createGlyph(_glyphIndex, createFaceGlyphInfo(_codePoint, _fontAscent, _ftFace->glyph), _glyphHeightMap);
-			else
-				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot load glyph " << _glyphIndex << " for character " << _codePoint << " in font '" << getResourceName() << "'.");
+			MYGUI_LOG(Info, "ResourceTrueTypeFont: Cache '" << mCacheFile << "' of font '" << getResourceName() << "' is out of date.");
+			return false;
 		}
-		else
+
+		int32_t defaultHeight = 0;
+		float tabWidth = 0.0f;
+		uint32 substituteCodePoint = 0;
+		uint32 charCount = 0;
+
+		if (!readValue(stream, defaultHeight) || !readValue(stream, tabWidth) || !readValue(stream, substituteCodePoint) || !readValue(stream, charCount))
+			return false;
+
+		CharMap charMap;
+
+		for (uint32 index = 0; index < charCount; ++index)
 		{
-			mCharMap[_codePoint] = _glyphIndex;
+			uint32 codePoint = 0;
+			uint32 glyphIndex = 0;
+
+			if (!readValue(stream, codePoint) || !readValue(stream, glyphIndex))
+				return false;
+
+			charMap.insert(charMap.end(), CharMap::value_type(codePoint, glyphIndex));
 		}
 
-		return 0;
-	}
+		uint32 glyphCount = 0;
 
-	template<bool LAMode, bool Antialias>
-	void ResourceTrueTypeFont::renderGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, uint8* _texBuffer, int _texWidth, int _texHeight)
-	{
-		FT_Bitmap ftBitmap;
-		FT_Bitmap_New(&ftBitmap);
+		if (!readValue(stream, glyphCount))
+			return false;
 
-		int texX = mGlyphSpacing, texY = mGlyphSpacing;
+		GlyphMap glyphMap;
 
-		for (const auto& sameHeightGlyphs : _glyphHeightMap)
+		for (uint32 index = 0; index < glyphCount; ++index)
 		{
-			int glyphHeight = sameHeightGlyphs.first;
-			for (const auto& glyph : sameHeightGlyphs.second)
-			{
-				GlyphInfo& info = *glyph.second;
+			GlyphInfo info;
 
-				switch (info.codePoint)
-				{
-				case FontCodeType::Selected:
-				case FontCodeType::SelectedBack:
-				{
-					renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY);
+			if (!readGlyphInfo(stream, info))
+				return false;
 
-					// Manually adjust the glyph's width to zero. This prevents artifacts from appearing at the seams when
-					// rendering multi-character selections.
-					GlyphMap::iterator glyphIter = mGlyphMap.find(info.codePoint);
-					if (glyphIter != mGlyphMap.end())
-					{
-						glyphIter->second.width = 0.0f;
-						glyphIter->second.uvRect.right = glyphIter->second.uvRect.left;
-					}
-				}
-				break;
+			glyphMap.insert(GlyphMap::value_type(info.codePoint, info));
+		}
 
-				case FontCodeType::Cursor:
-				case FontCodeType::Tab:
-					renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY);
-					break;
+		int32_t texWidth = 0;
+		int32_t texHeight = 0;
+		uint32 numBytes = 0;
 
-				default:
-					if (FT_Load_Glyph(_ftFace, glyph.first, _ftLoadFlags | FT_LOAD_RENDER) == 0)
-					{
-						if (_ftFace->glyph->bitmap.buffer != nullptr)
-						{
-							uint8* glyphBuffer = nullptr;
-
-							switch (_ftFace->glyph->bitmap.pixel_mode)
-							{
-							case FT_PIXEL_MODE_GRAY:
-								glyphBuffer = _ftFace->glyph->bitmap.buffer;
-								break;
-
-							case FT_PIXEL_MODE_MONO:
-								// Convert the monochrome bitmap to 8-bit before rendering it.
-								if (FT_Bitmap_Convert(_ftLibrary, &_ftFace->glyph->bitmap, &ftBitmap, 1) == 0)
-								{
-									// Go through the bitmap and convert all of the nonzero values to 0xFF (white).
-									for (uint8* p = ftBitmap.buffer, * endP = p + ftBitmap.width * ftBitmap.rows; p != endP; ++p)
-										*p = *p ? 0xFF : 0;
-
-									glyphBuffer = ftBitmap.buffer;
-								}
-								break;
-							}
-
-							if (glyphBuffer != nullptr)
-								renderGlyph<LAMode, true, Antialias>(info, charMaskWhite, charMaskWhite, charMaskWhite, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY, glyphBuffer);
-						}
-					}
-					else
-					{
-						MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot render glyph " << glyph.first << " for character " << info.codePoint << " in font '" << getResourceName() << "'.");
-					}
-					break;
-				}
-			}
-		}
+		if (!readValue(stream, texWidth) || !readValue(stream, texHeight) || !readValue(stream, numBytes) ||
+			texWidth <= 0 || texHeight <= 0 || numBytes != (_laMode ? Pixel<true>::getNumBytes() : Pixel<false>::getNumBytes()) ||
+			glyphMap.find(substituteCodePoint) == glyphMap.end())
+			return false;
 
-		FT_Bitmap_Done(_ftLibrary, &ftBitmap);
-	}
+		size_t texBufferSize = (size_t)texWidth * texHeight * numBytes;
+		std::vector<uint8> texBuffer(texBufferSize);
+
+		if (stream->read(texBuffer.data(), texBufferSize) != texBufferSize)
+			return false;
+
+		// The cache is valid, so nothing below can fail anymore.
+		mDefaultHeight = defaultHeight;
+		mTabWidth = tabWidth;
+		mSubstituteCodePoint = substituteCodePoint;
+		mCharMap.swap(charMap);
+		mGlyphMap.swap(glyphMap);
+		mSubstituteGlyphInfo = &mGlyphMap.find(mSubstituteCodePoint)->second;
+
+		createTexture(texWidth, texHeight, _laMode ? Pixel<true>::getFormat() : Pixel<false>::getFormat());
+
+		void* dest = mTexture->lock(TextureUsage::Write);
+
+		if (dest != nullptr)
+		{
+			memcpy(dest, texBuffer.data(), texBufferSize);
+			mTexture->unlock();
+		}
+		else
+		{
+			MYGUI_LOG(Error, "ResourceTrueTypeFont: Error locking texture; pointer is nullptr.");
+		}
+
+		MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' loaded from cache '" << mCacheFile << "'.");
+
+		return true;
+	}
+
+	void ResourceTrueTypeFont::saveCache(const std::vector<uint8>& _texBuffer, int _texWidth, int _texHeight, size_t _numBytes) const
+	{
+		std::string fileName = DataManager::getInstance().getDataPath(mCacheFile);
+
+		if (fileName.empty())
+		{
+			// There is no cache yet, so create it next to the font file.
+			const std::string& source = DataManager::getInstance().getDataPath(mSource);
+
+			if (source.empty())
+			{
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Could not find a location for cache '" << mCacheFile << "' of font '" << getResourceName() << "'.");
+				return;
+			}
+
+			size_t pos = source.find_last_of("\\/");
+			fileName = (pos == std::string::npos ? std::string() : source.substr(0, pos + 1)) + mCacheFile;
+		}
+
+		std::ofstream stream(fileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!stream.is_open())
+		{
+			MYGUI_LOG(Warning, "ResourceTrueTypeFont: Could not write cache '" << fileName << "' of font '" << getResourceName() << "'.");
+			return;
+		}
+
+		writeValue(stream, cacheMagic);
+		writeValue(stream, cacheVersion);
+		writeValue(stream, mCacheKey);
+
+		writeValue(stream, (int32_t)mDefaultHeight);
+		writeValue(stream, mTabWidth);
+		writeValue(stream, (uint32)mSubstituteCodePoint);
+
+		writeValue(stream, (uint32)mCharMap.size());
+		for (CharMap::const_iterator iter = mCharMap.begin(); iter != mCharMap.end(); ++iter)
+		{
+			writeValue(stream, (uint32)iter->first);
+			writeValue(stream, (uint32)iter->second);
+		}
+
+		writeValue(stream, (uint32)mGlyphMap.size());
+		for (GlyphMap::const_iterator iter = mGlyphMap.begin(); iter != mGlyphMap.end(); ++iter)
+			writeGlyphInfo(stream, iter->second);
+
+		writeValue(stream, (int32_t)_texWidth);
+		writeValue(stream, (int32_t)_texHeight);
+		writeValue(stream, (uint32)_numBytes);
+		stream.write(reinterpret_cast<const char*>(_texBuffer.data()), _texBuffer.size());
+
+		if (!stream)
+			MYGUI_LOG(Warning, "ResourceTrueTypeFont: Could not write cache '" << fileName << "' of font '" << getResourceName() << "'.");
+	}
+
+	void ResourceTrueTypeFont::createTexture(int _texWidth, int _texHeight, PixelFormat _format)
+	{
+		if (mTexture)
+		{
+			RenderManager::getInstance().destroyTexture( mTexture );
+			mTexture = nullptr;
+		}
+
+		mTexture = RenderManager::getInstance().createTexture(MyGUI::utility::toString((size_t)this, "_TrueTypeFont"));
+
+		mTexture->createManual(_texWidth, _texHeight, TextureUsage::Static | TextureUsage::Write, _format);
+		mTexture->setInvalidateListener(this);
+
+		if (!mShader.empty())
+			mTexture->setShader(mShader);
+	}
+
+	int ResourceTrueTypeFont::calculateFontMetrics(const FT_Face& _ftFace)
+	{
+		// The font's overall ascent and descent are defined in three different places in a TrueType font, and with different
+		// values in each place. The most reliable source for these metrics is usually the "usWinAscent" and "usWinDescent" pair of
+		// values in the OS/2 header; however, some fonts contain inaccurate data there. To be safe, we use the highest of the set
+		// of values contained in the face metrics and the two sets of values contained in the OS/2 header.
+		int fontAscent = _ftFace->size->metrics.ascender >> 6;
+		int fontDescent = -_ftFace->size->metrics.descender >> 6;
+
+		TT_OS2* os2 = (TT_OS2*)FT_Get_Sfnt_Table(_ftFace, ft_sfnt_os2);
+
+		if (os2 != nullptr)
+		{
+			setMax(fontAscent, os2->usWinAscent * _ftFace->size->metrics.y_ppem / _ftFace->units_per_EM);
+			setMax(fontDescent, os2->usWinDescent * _ftFace->size->metrics.y_ppem / _ftFace->units_per_EM);
+
+			setMax(fontAscent, os2->sTypoAscender * _ftFace->size->metrics.y_ppem / _ftFace->units_per_EM);
+			setMax(fontDescent, -os2->sTypoDescender * _ftFace->size->metrics.y_ppem / _ftFace->units_per_EM);
+		}
+
+		// The nominal font height is calculated as the sum of its ascent and descent as specified by the font designer. Previously
+		// it was defined by MyGUI in terms of the maximum ascent and descent of the glyphs currently in use, but this caused the
+		// font's line spacing to change whenever glyphs were added to or removed from the font definition. Doing it this way
+		// instead prevents a lot of layout problems, and it is also more typographically correct and more aesthetically pleasing.
+		mDefaultHeight = fontAscent + fontDescent;
+
+		return fontAscent;
+	}
+
+	FT_Int32 ResourceTrueTypeFont::getLoadFlags() const
+	{
+		switch (mHinting)
+		{
+		case HintingForceAuto:
+			return FT_LOAD_FORCE_AUTOHINT;
+		case HintingDisableAuto:
+			return FT_LOAD_NO_AUTOHINT;
+		case HintingDisableAll:
+			// When hinting is completely disabled, glyphs must always be rendered -- even during layout calculations -- due to
+			// discrepancies between the glyph metrics and the actual rendered bitmap metrics.
+			return FT_LOAD_NO_HINTING | FT_LOAD_RENDER;
+		case HintingUseNative:
+			break;
+		}
+
+		return FT_LOAD_DEFAULT;
+	}
+
+	void ResourceTrueTypeFont::autoWrapGlyphPos(int _glyphWidth, int _texWidth, int _lineHeight, int& _texX, int& _texY) const
+	{
+		if (_glyphWidth > 0 && _texX + mGlyphSpacing + _glyphWidth > _texWidth)
+		{
+			_texX = mGlyphSpacing;
+			_texY += mGlyphSpacing + _lineHeight;
+		}
+	}
+
+	GlyphInfo ResourceTrueTypeFont::createFaceGlyphInfo(Char _codePoint, int _fontAscent, FT_GlyphSlot _glyph) const
+	{
+		float bearingX = _glyph->metrics.horiBearingX / 64.0f;
+
+		// The following calculations aren't currently needed but are kept here for future use.
+		// float ascent = _glyph->metrics.horiBearingY / 64.0f;
+		// float descent = (_glyph->metrics.height / 64.0f) - ascent;
+
+		return GlyphInfo(
+			_codePoint,
+			std::max((float)_glyph->bitmap.width, _glyph->metrics.width / 64.0f),
+			std::max((float)_glyph->bitmap.rows, _glyph->metrics.height / 64.0f),
+			(_glyph->advance.x / 64.0f) - bearingX,
+			bearingX,
+			std::floor(_fontAscent - (_glyph->metrics.horiBearingY / 64.0f) - mOffsetHeight));
+	}
+
+	int ResourceTrueTypeFont::createGlyph(FT_UInt _glyphIndex, const GlyphInfo& _glyphInfo, GlyphHeightMap& _glyphHeightMap)
+	{
+		int width = (int)std::ceil(_glyphInfo.width);
+		int height = (int)std::ceil(_glyphInfo.height);
+
+		mCharMap[_glyphInfo.codePoint] = _glyphIndex;
+		GlyphInfo& info = mGlyphMap.insert(GlyphMap::value_type(_glyphInfo.codePoint, _glyphInfo)).first->second;
+		_glyphHeightMap[height].insert(std::make_pair(_glyphIndex, &info));
+
+		return (width > 0) ? mGlyphSpacing + width : 0;
+	}
+
+	int ResourceTrueTypeFont::createFaceGlyph(FT_UInt _glyphIndex, Char _codePoint, int _fontAscent, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, GlyphHeightMap& _glyphHeightMap)
+	{
+		if (mGlyphMap.find(_codePoint) == mGlyphMap.end())
+		{
+			if (FT_Load_Glyph(_ftFace, _glyphIndex, _ftLoadFlags) == 0)
+				return createGlyph(_glyphIndex, createFaceGlyphInfo(_codePoint, _fontAscent, _ftFace->glyph), _glyphHeightMap);
+			else
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot load glyph " << _glyphIndex << " for character " << _codePoint << " in font '" << getResourceName() << "'.");
+		}
+		else
+		{
+			mCharMap[_codePoint] = _glyphIndex;
+		}
+
+		return 0;
+	}
+
+	void ResourceTrueTypeFont::placeGlyphs(const GlyphHeightMap& _glyphHeightMap, int _texWidth, VectorGlyphPlace& _places) const
+	{
+		int texX = mGlyphSpacing, texY = mGlyphSpacing;
+
+		for (const auto& sameHeightGlyphs : _glyphHeightMap)
+		{
+			int glyphHeight = sameHeightGlyphs.first;
+			for (const auto& glyph : sameHeightGlyphs.second)
+			{
+				int glyphWidth = (int)std::ceil(glyph.second->width);
+
+				autoWrapGlyphPos(glyphWidth, _texWidth, glyphHeight, texX, texY);
+
+				GlyphPlace place = { glyph.first, glyph.second, texX, texY };
+				_places.push_back(place);
+
+				if (glyphWidth > 0)
+					texX += mGlyphSpacing + glyphWidth;
+			}
+		}
+	}
+
+	FT_Face ResourceTrueTypeFont::copyFace(const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize) const
+	{
+		FT_Face result = nullptr;
+
+		if (FT_New_Memory_Face(_ftLibrary, _fontBuffer, (FT_Long)_fontBufferSize, _ftFace->face_index, &result) != 0)
+			return nullptr;
+
+		// Select the same size as loadFace() did for the original face.
+		FT_Error error = (_ftFace->face_flags & FT_FACE_FLAG_SCALABLE) ?
+			FT_Set_Char_Size(result, (FT_F26Dot6)(mSize * (1 << 6)), 0, mResolution, mResolution) :
+			FT_Select_Size(result, 0);
+
+		if (error != 0)
+		{
+			FT_Done_Face(result);
+			return nullptr;
+		}
+
+		return result;
+	}
+
+	template<typename ThreadContext, typename RenderFunction>
+	void ResourceTrueTypeFont::renderInThreads(size_t _count, const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize, RenderFunction _render) const
+	{
+		size_t maxThreadCount = mRenderThreadCount != 0 ? mRenderThreadCount : (size_t)std::thread::hardware_concurrency();
+		size_t threadCount = std::min(std::max(maxThreadCount, (size_t)1), _count / mMinGlyphsPerThread);
+
+		// Threads take glyphs one by one, so expensive glyphs don't leave the other threads idle.
+		std::atomic<size_t> nextIndex(0);
+
+		auto renderGlyphs = [&](const FT_Library& _library, const FT_Face& _face)
+		{
+			ThreadContext context(_library, _face);
+			for (size_t index = nextIndex++; index < _count; index = nextIndex++)
+				_render(context, index);
+		};
+
+		// FreeType objects can't be shared between threads, so every additional thread loads its own copy of the face.
+		std::vector<std::thread> threads;
+		for (size_t index = 1; index < threadCount; ++index)
+		{
+			threads.push_back(std::thread([&]()
+			{
+				FT_Library library;
+				if (FT_Init_FreeType(&library) != 0)
+					return;
+
+				FT_Face face = copyFace(library, _ftFace, _fontBuffer, _fontBufferSize);
+				if (face != nullptr)
+				{
+					renderGlyphs(library, face);
+					FT_Done_Face(face);
+				}
+
+				FT_Done_FreeType(library);
+			}));
+		}
+
+		renderGlyphs(_ftLibrary, _ftFace);
+
+		for (std::vector<std::thread>::iterator iter = threads.begin(); iter != threads.end(); ++iter)
+			iter->join();
+	}
+
+	template<bool LAMode, bool Antialias>
+	void ResourceTrueTypeFont::renderGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, const uint8* _fontBuffer, size_t _fontBufferSize, uint8* _texBuffer, int _texWidth, int _texHeight)
+	{
+		// Calculate all of the glyph positions up front, so that the glyphs can be rendered in any order.
+		VectorGlyphPlace places;
+		placeGlyphs(_glyphHeightMap, _texWidth, places);
+
+		// The special glyphs are cheap to render; only the face glyphs are split between threads.
+		VectorGlyphPlace facePlaces;
+
+		for (const auto& place : places)
+		{
+			GlyphInfo& info = *place.info;
+
+			switch (info.codePoint)
+			{
+			case FontCodeType::Selected:
+			case FontCodeType::SelectedBack:
+				renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, _texBuffer, _texWidth, _texHeight, place.texX, place.texY);
+
+				// Manually adjust the glyph's width to zero. This prevents artifacts from appearing at the seams when
+				// rendering multi-character selections.
+				info.width = 0.0f;
+				info.uvRect.right = info.uvRect.left;
+				break;
+
+			case FontCodeType::Cursor:
+			case FontCodeType::Tab:
+				renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, _texBuffer, _texWidth, _texHeight, place.texX, place.texY);
+				break;
+
+			default:
+				facePlaces.push_back(place);
+				break;
+			}
+		}
+
+		// Glyphs are written into disjoint areas of the texture buffer. Failures are logged afterwards, from this thread.
+		std::vector<uint8> failed(facePlaces.size(), 0);
+
+		renderInThreads<FaceRenderContext>(facePlaces.size(), _ftLibrary, _ftFace, _fontBuffer, _fontBufferSize,
+			[&](const FaceRenderContext& _context, size_t _index)
+			{
+				const GlyphPlace& place = facePlaces[_index];
+				if (!renderFaceGlyph<LAMode, Antialias>(*place.info, place.glyphIndex, _context.library, _context.face, _ftLoadFlags, _texBuffer, _texWidth, _texHeight, place.texX, place.texY))
+					failed[_index] = 1;
+			});
+
+		for (size_t index = 0; index < facePlaces.size(); ++index)
+		{
+			if (failed[index] != 0)
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot render glyph " << facePlaces[index].glyphIndex << " for character " << facePlaces[index].info->codePoint << " in font '" << getResourceName() << "'.");
+		}
+	}
+
+	template<bool LAMode, bool Antialias>
+	bool ResourceTrueTypeFont::renderFaceGlyph(GlyphInfo& _info, FT_UInt _glyphIndex, const FT_Library& _ftLibrary, const FT_Face& _ftFace, FT_Int32 _ftLoadFlags, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY) const
+	{
+		if (FT_Load_Glyph(_ftFace, _glyphIndex, _ftLoadFlags | FT_LOAD_RENDER) != 0)
+			return false;
+
+		if (_ftFace->glyph->bitmap.buffer != nullptr)
+		{
+			FT_Bitmap ftBitmap;
+			FT_Bitmap_New(&ftBitmap);
+
+			uint8* glyphBuffer = nullptr;
+
+			switch (_ftFace->glyph->bitmap.pixel_mode)
+			{
+			case FT_PIXEL_MODE_GRAY:
+				glyphBuffer = _ftFace->glyph->bitmap.buffer;
+				break;
+
+			case FT_PIXEL_MODE_MONO:
+				// Convert the monochrome bitmap to 8-bit before rendering it.
+				if (FT_Bitmap_Convert(_ftLibrary, &_ftFace->glyph->bitmap, &ftBitmap, 1) == 0)
+				{
+					// Go through the bitmap and convert all of the nonzero values to 0xFF (white).
+					for (uint8* p = ftBitmap.buffer, * endP = p + ftBitmap.width * ftBitmap.rows; p != endP; ++p)
+						*p = *p ? 0xFF : 0;
+
+					glyphBuffer = ftBitmap.buffer;
+				}
+				break;
+			}
+
+			if (glyphBuffer != nullptr)
+				renderGlyph<LAMode, true, Antialias>(_info, charMaskWhite, charMaskWhite, charMaskWhite, _texBuffer, _texWidth, _texHeight, _texX, _texY, glyphBuffer);
+
+			FT_Bitmap_Done(_ftLibrary, &ftBitmap);
+		}
+
+		return true;
+	}
 
 	template<bool LAMode, bool UseBuffer, bool Antialias>
-	void ResourceTrueTypeFont::renderGlyph(GlyphInfo& _info, uint8 _luminance0, uint8 _luminance1, uint8 _alpha, int _lineHeight, uint8* _texBuffer, int _texWidth, int _texHeight, int& _texX, int& _texY, uint8* _glyphBuffer)
+	void ResourceTrueTypeFont::renderGlyph(GlyphInfo& _info, uint8 _luminance0, uint8 _luminance1, uint8 _alpha, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY, uint8* _glyphBuffer) const
+	{
+		int width = (int)std::ceil(_info.width);
+		int height = (int)std::ceil(_info.height);
+
+		uint8* dest = _texBuffer + (_texY * _texWidth + _texX) * Pixel<LAMode>::getNumBytes();
+
+		// Calculate how much to advance the destination pointer after each row to get to the start of the next row.
+		ptrdiff_t destNextRow = (_texWidth - width) * Pixel<LAMode>::getNumBytes();
+
+		if (!mMsdfMode || !UseBuffer)
+		{
+			for (int j = height; j > 0; --j)
+			{
+				int i;
+				for (i = width; i > 1; i -= 2)
+				{
+					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance0, _alpha, _glyphBuffer);
+					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance1, _alpha, _glyphBuffer);
+				}
+
+				if (i > 0)
+					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance0, _alpha, _glyphBuffer);
+
+				dest += destNextRow;
+			}
+		}
+		else
+		{
+			for (int y = 0; y < height; ++y)
+			{
+				for (int x = 0; x < width; ++x)
+				{
+					for (int i = 0; i < 3; ++i)
+					{
+						*dest++ = *_glyphBuffer++;
+					}
+					*dest++ = 255;
+				}
+
+				dest += destNextRow;
+			}
+		}
+
+		// Calculate and store the glyph's UV coordinates within the texture.
+		_info.uvRect.left = (float)_texX / _texWidth; // u1
+		_info.uvRect.top = (float)_texY / _texHeight; // v1
+		_info.uvRect.right = (float)(_texX + _info.width) / _texWidth; // u2
+		_info.uvRect.bottom = (float)(_texY + _info.height) / _texHeight; // v2
+	}
+
+	void ResourceTrueTypeFont::initialiseLazy(bool _laMode)
+	{
+		size_t fontBufferSize = 0;
+		uint8* fontBuffer = loadFontBuffer(fontBufferSize);
+
+		if (fontBuffer == nullptr)
+		{
+			MYGUI_LOG(Error, "ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
+			return;
+		}
+
+		FT_Library ftLibrary;
+
+		if (FT_Init_FreeType(&ftLibrary) != 0)
+			MYGUI_EXCEPT("ResourceTrueTypeFont: Could not init the FreeType library!");
+
+		FT_Face ftFace = loadFace(ftLibrary, fontBuffer, fontBufferSize);
+
+		if (ftFace == nullptr)
+		{
+			MYGUI_LOG(Error, "ResourceTrueTypeFont: Could not load the font '" << getResourceName() << "'!");
+			FT_Done_FreeType(ftLibrary);
+			delete [] fontBuffer;
+			return;
+		}
+
+		// Unlike the normal mode, the face stays loaded until the font is destroyed, because glyphs are rendered on demand.
+		mLazyAtlas = new LazyAtlas();
+		mLazyAtlas->library = ftLibrary;
+		mLazyAtlas->face = ftFace;
+		mLazyAtlas->fontBuffer = fontBuffer;
+		mLazyAtlas->fontAscent = calculateFontMetrics(ftFace);
+		mLazyAtlas->loadFlags = getLoadFlags();
+		mLazyAtlas->laMode = _laMode;
+		mLazyAtlas->texWidth = 0;
+		mLazyAtlas->texHeight = 0;
+		mLazyAtlas->useCounter = 0;
+
+		//-------------------------------------------------------------------//
+		// Create the glyphs that are needed up front.
+		//-------------------------------------------------------------------//
+
+		// For historical reasons, MyGUI users are accustomed to omitting the "Space" code point in their font definitions.
+		addCodePoint(FontCodeType::Space);
+
+		// Do some special handling for the "Space" and "Tab" glyphs.
+		LazyGlyph& spaceGlyph = createLazyGlyph(FontCodeType::Space);
+
+		if (spaceGlyph.exist)
+		{
+			// Adjust the width of the "Space" glyph if it has been customized.
+			if (mSpaceWidth != 0.0f)
+			{
+				spaceGlyph.info.width = mSpaceWidth;
+				spaceGlyph.info.advance = mSpaceWidth;
+			}
+
+			// If the width of the "Tab" glyph hasn't been customized, make it eight spaces wide.
+			if (mTabWidth == 0.0f)
+				mTabWidth = mDefaultTabWidth * spaceGlyph.info.advance;
+		}
+
+		float height = (float)mDefaultHeight;
+
+		createLazySpecialGlyph(GlyphInfo(static_cast<Char>(FontCodeType::Tab), 0.0f, 0.0f, mTabWidth, 0.0f, 0.0f));
+		createLazySpecialGlyph(GlyphInfo(static_cast<Char>(FontCodeType::Selected), mSelectedWidth, height, 0.0f, 0.0f, 0.0f));
+		createLazySpecialGlyph(GlyphInfo(static_cast<Char>(FontCodeType::SelectedBack), mSelectedWidth, height, 0.0f, 0.0f, 0.0f));
+		createLazySpecialGlyph(GlyphInfo(static_cast<Char>(FontCodeType::Cursor), mCursorWidth, height, 0.0f, 0.0f, 0.0f));
+
+		// If a substitute code point has been specified, check to make sure that the font supports it. If it doesn't, revert to
+		// the default "Not Defined" code point.
+		if (mSubstituteCodePoint != FontCodeType::NotDefined &&
+			(mCharMap.find(mSubstituteCodePoint) == mCharMap.end() || FT_Get_Char_Index(ftFace, mSubstituteCodePoint) == 0 || !createLazyGlyph(mSubstituteCodePoint).exist))
+			mSubstituteCodePoint = static_cast<Char>(FontCodeType::NotDefined);
+
+		LazyGlyph& substituteGlyph = mSubstituteCodePoint == FontCodeType::NotDefined ?
+			createLazyGlyph(static_cast<Char>(FontCodeType::NotDefined)) :
+			mLazyAtlas->glyphs.find(mSubstituteCodePoint)->second;
+
+		// Cache a pointer to the substitute glyph info for fast lookup. It is used for every unsupported code point, so it must
+		// always stay in the texture.
+		substituteGlyph.exist = true;
+		substituteGlyph.pinned = true;
+		mSubstituteGlyphInfo = &substituteGlyph.info;
+
+		//-------------------------------------------------------------------//
+		// Create the texture and render the pinned glyphs onto it.
+		//-------------------------------------------------------------------//
+
+		// Start with a texture that fits about a hundred glyphs; it grows when more glyphs are requested.
+		int texSize = std::min(Bitwise::firstPO2From(mDefaultHeight * 10), mLazyMaxTextureSize);
+
+		mLazyAtlas->texWidth = texSize;
+		mLazyAtlas->texHeight = texSize;
+		mLazyAtlas->pixels.resize(texSize * texSize * (_laMode ? Pixel<true>::getNumBytes() : Pixel<false>::getNumBytes()));
+
+		if (_laMode)
+			clearPixels<true>(&mLazyAtlas->pixels[0], texSize * texSize);
+		else
+			clearPixels<false>(&mLazyAtlas->pixels[0], texSize * texSize);
+
+		createTexture(texSize, texSize, _laMode ? Pixel<true>::getFormat() : Pixel<false>::getFormat());
+
+		uploadLazyTexture();
+
+		for (LazyGlyphMap::iterator iter = mLazyAtlas->glyphs.begin(); iter != mLazyAtlas->glyphs.end(); ++iter)
+		{
+			if (iter->second.pinned)
+				renderLazyGlyph(iter->second);
+		}
+
+		MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' using lazy texture size " << mLazyAtlas->texWidth << " x " << mLazyAtlas->texHeight << ".");
+		MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' using real height " << mDefaultHeight << " pixels.");
+	}
+
+	void ResourceTrueTypeFont::destroyLazyAtlas()
 	{
-		int width = (int)std::ceil(_info.width);
-		int height = (int)std::ceil(_info.height);
+		if (mLazyAtlas == nullptr)
+			return;
 
-		autoWrapGlyphPos(width, _texWidth, _lineHeight, _texX, _texY);
+		mSubstituteGlyphInfo = nullptr;
 
-		uint8* dest = _texBuffer + (_texY * _texWidth + _texX) * Pixel<LAMode>::getNumBytes();
+		FT_Done_Face(mLazyAtlas->face);
+		FT_Done_FreeType(mLazyAtlas->library);
 
-		// Calculate how much to advance the destination pointer after each row to get to the start of the next row.
-		ptrdiff_t destNextRow = (_texWidth - width) * Pixel<LAMode>::getNumBytes();
+		delete [] mLazyAtlas->fontBuffer;
 
-		if (!mMsdfMode || !UseBuffer)
+		delete mLazyAtlas;
+		mLazyAtlas = nullptr;
+	}
+
+	const GlyphInfo* ResourceTrueTypeFont::getLazyGlyphInfo(Char _id) const
+	{
+		LazyGlyphMap::iterator glyphIter = mLazyAtlas->glyphs.find(_id);
+		LazyGlyph& glyph = (glyphIter != mLazyAtlas->glyphs.end()) ? glyphIter->second : createLazyGlyph(_id);
+
+		if (!glyph.exist)
+			return mSubstituteGlyphInfo;
+
+		glyph.lastUse = ++mLazyAtlas->useCounter;
+
+		if (!glyph.rendered)
 		{
-			for (int j = height; j > 0; --j)
+			MYGUI_PROFILE_COUNTER(GlyphMisses, 1);
+			if (!renderLazyGlyph(glyph))
+				return mSubstituteGlyphInfo;
+		}
+
+		return &glyph.info;
+	}
+
+	ResourceTrueTypeFont::LazyGlyph& ResourceTrueTypeFont::createLazyGlyph(Char _codePoint) const
+	{
+		LazyGlyph& glyph = mLazyAtlas->glyphs[_codePoint];
+		glyph.info = GlyphInfo(_codePoint);
+		glyph.glyphIndex = 0;
+		glyph.exist = false;
+		glyph.rendered = false;
+		glyph.pinned = false;
+		glyph.lastUse = 0;
+
+		// Code points that are not in the font definition use the substitute glyph. Unlike the normal mode, code points that are
+		// in the definition but not in the font face are not removed from mCharMap; they get the face's "Not Defined" glyph, the
+		// same way they would in the normal mode.
+		if (_codePoint != FontCodeType::NotDefined && mCharMap.find(_codePoint) == mCharMap.end())
+			return glyph;
+
+		FT_UInt glyphIndex = (_codePoint != FontCodeType::NotDefined) ? FT_Get_Char_Index(mLazyAtlas->face, _codePoint) : 0;
+
+		if (FT_Load_Glyph(mLazyAtlas->face, glyphIndex, mLazyAtlas->loadFlags) == 0)
+		{
+			glyph.info = createFaceGlyphInfo(_codePoint, mLazyAtlas->fontAscent, mLazyAtlas->face->glyph);
+			glyph.glyphIndex = glyphIndex;
+			glyph.exist = true;
+		}
+		else
+		{
+			MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot load glyph " << glyphIndex << " for character " << _codePoint << " in font '" << getResourceName() << "'.");
+		}
+
+		return glyph;
+	}
+
+	ResourceTrueTypeFont::LazyGlyph& ResourceTrueTypeFont::createLazySpecialGlyph(const GlyphInfo& _glyphInfo)
+	{
+		LazyGlyph& glyph = mLazyAtlas->glyphs[_glyphInfo.codePoint];
+		glyph.info = _glyphInfo;
+		glyph.glyphIndex = 0;
+		glyph.exist = true;
+		glyph.rendered = false;
+		glyph.pinned = true;
+		glyph.lastUse = 0;
+
+		return glyph;
+	}
+
+	bool ResourceTrueTypeFont::renderLazyGlyph(LazyGlyph& _glyph) const
+	{
+		int width = (int)std::ceil(_glyph.info.width);
+		int height = (int)std::ceil(_glyph.info.height);
+
+		bool placed = true;
+		bool textureChanged = false;
+		bool evicted = false;
+
+		// When there is no free space, grow the texture up to the maximum size, then make space by evicting the least recently
+		// used glyphs. Both change texture coordinates of the glyphs that are already rendered.
+		while (!allocateLazyPlace(width, height, _glyph.place))
+		{
+			if (growLazyTexture())
 			{
-				int i;
-				for (i = width; i > 1; i -= 2)
-				{
-					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance0, _alpha, _glyphBuffer);
-					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance1, _alpha, _glyphBuffer);
-				}
+				textureChanged = true;
+			}
+			else if (!evicted)
+			{
+				evictLazyGlyphs();
+				textureChanged = true;
+				evicted = true;
+			}
+			else
+			{
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Glyph for character " << _glyph.info.codePoint << " doesn't fit into the texture of font '" << getResourceName() << "'.");
+				placed = false;
+				break;
+			}
+		}
 
-				if (i > 0)
-					Pixel<LAMode, UseBuffer, Antialias>::set(dest, _luminance0, _alpha, _glyphBuffer);
+		if (placed)
+		{
+			if (mLazyAtlas->laMode)
+			{
+				if (mAntialias)
+					renderLazyGlyphPixels<true, true>(_glyph);
+				else
+					renderLazyGlyphPixels<true, false>(_glyph);
+			}
+			else
+			{
+				if (mAntialias)
+					renderLazyGlyphPixels<false, true>(_glyph);
+				else
+					renderLazyGlyphPixels<false, false>(_glyph);
+			}
 
-				dest += destNextRow;
+			_glyph.rendered = true;
+			updateLazyGlyphUV(_glyph);
+		}
+
+		if (textureChanged)
+		{
+			if (mTexture->getWidth() != mLazyAtlas->texWidth || mTexture->getHeight() != mLazyAtlas->texHeight)
+			{
+				mTexture->destroy();
+				mTexture->createManual(mLazyAtlas->texWidth, mLazyAtlas->texHeight, TextureUsage::Static | TextureUsage::Write, mLazyAtlas->laMode ? Pixel<true>::getFormat() : Pixel<false>::getFormat());
+
+				if (!mShader.empty())
+					mTexture->setShader(mShader);
 			}
+
+			uploadLazyTexture();
+			lazyTextureChanged();
 		}
-		else
+		else if (placed)
 		{
-			for (int y = 0; y < height; ++y)
+			uploadLazyGlyph(_glyph);
+		}
+
+		return placed;
+	}
+
+	template<bool LAMode, bool Antialias>
+	void ResourceTrueTypeFont::renderLazyGlyphPixels(LazyGlyph& _glyph) const
+	{
+		GlyphInfo& info = _glyph.info;
+		uint8* texBuffer = &mLazyAtlas->pixels[0];
+		int texWidth = mLazyAtlas->texWidth;
+		int texHeight = mLazyAtlas->texHeight;
+
+		switch (info.codePoint)
+		{
+		case FontCodeType::Selected:
+		case FontCodeType::SelectedBack:
+			renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, texBuffer, texWidth, texHeight, _glyph.place.left, _glyph.place.top);
+
+			// Manually adjust the glyph's width to zero. This prevents artifacts from appearing at the seams when rendering
+			// multi-character selections. Texture coordinates are updated from the width afterwards.
+			info.width = 0.0f;
+			break;
+
+		case FontCodeType::Cursor:
+		case FontCodeType::Tab:
+			renderGlyph<LAMode, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, texBuffer, texWidth, texHeight, _glyph.place.left, _glyph.place.top);
+			break;
+
+		default:
+			if (!renderFaceGlyph<LAMode, Antialias>(info, _glyph.glyphIndex, mLazyAtlas->library, mLazyAtlas->face, mLazyAtlas->loadFlags, texBuffer, texWidth, texHeight, _glyph.place.left, _glyph.place.top))
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot render glyph " << _glyph.glyphIndex << " for character " << info.codePoint << " in font '" << getResourceName() << "'.");
+			break;
+		}
+	}
+
+	bool ResourceTrueTypeFont::allocateLazyPlace(int _width, int _height, IntCoord& _place) const
+	{
+		// Glyphs without pixels don't need any space.
+		if (_width <= 0 || _height <= 0)
+		{
+			_place.set(mGlyphSpacing, mGlyphSpacing, std::max(_width, 0), std::max(_height, 0));
+			return true;
+		}
+
+		LazyAtlas& atlas = *mLazyAtlas;
+
+		// Find the lowest shelf that still has room for the glyph.
+		VectorLazyShelf::iterator shelf = atlas.shelves.end();
+		for (VectorLazyShelf::iterator iter = atlas.shelves.begin(); iter != atlas.shelves.end(); ++iter)
+		{
+			if (iter->height >= _height && iter->right + mGlyphSpacing + _width <= atlas.texWidth &&
+				(shelf == atlas.shelves.end() || iter->height < shelf->height))
+				shelf = iter;
+		}
+
+		// Start a new shelf if there is no suitable one or if the glyph would waste too much of the shelf's height.
+		if (shelf == atlas.shelves.end() || shelf->height > _height + _height / 2)
+		{
+			int top = atlas.shelves.empty() ? mGlyphSpacing : atlas.shelves.back().top + atlas.shelves.back().height + mGlyphSpacing;
+
+			if (top + _height <= atlas.texHeight && mGlyphSpacing * 2 + _width <= atlas.texWidth)
 			{
-				for (int x = 0; x < width; ++x)
-				{
-					for (int i = 0; i < 3; ++i)
-					{
-						*dest++ = *_glyphBuffer++;
-					}
-					*dest++ = 255;
-				}
+				LazyShelf newShelf = { top, _height, mGlyphSpacing };
+				atlas.shelves.push_back(newShelf);
+				shelf = atlas.shelves.end() - 1;
+			}
+		}
 
-				dest += destNextRow;
+		if (shelf == atlas.shelves.end())
+			return false;
+
+		_place.set(shelf->right, shelf->top, _width, _height);
+		shelf->right += _width + mGlyphSpacing;
+
+		return true;
+	}
+
+	bool ResourceTrueTypeFont::growLazyTexture() const
+	{
+		LazyAtlas& atlas = *mLazyAtlas;
+
+		if (atlas.texWidth >= mLazyMaxTextureSize && atlas.texHeight >= mLazyMaxTextureSize)
+			return false;
+
+		// Keep the texture as square as possible. Making it wider first lets the existing shelves take more glyphs.
+		int texWidth = atlas.texWidth;
+		int texHeight = atlas.texHeight;
+
+		if (texHeight >= mLazyMaxTextureSize || (texWidth <= texHeight && texWidth < mLazyMaxTextureSize))
+			texWidth *= 2;
+		else
+			texHeight *= 2;
+
+		size_t numBytes = atlas.laMode ? Pixel<true>::getNumBytes() : Pixel<false>::getNumBytes();
+		std::vector<uint8> pixels(texWidth * texHeight * numBytes);
+
+		if (atlas.laMode)
+			clearPixels<true>(&pixels[0], texWidth * texHeight);
+		else
+			clearPixels<false>(&pixels[0], texWidth * texHeight);
+
+		// Glyphs keep their positions in pixels.
+		copyPixels(&atlas.pixels[0], atlas.texWidth, 0, 0, &pixels[0], texWidth, 0, 0, atlas.texWidth, atlas.texHeight, numBytes);
+
+		atlas.pixels.swap(pixels);
+		atlas.texWidth = texWidth;
+		atlas.texHeight = texHeight;
+
+		for (LazyGlyphMap::iterator iter = atlas.glyphs.begin(); iter != atlas.glyphs.end(); ++iter)
+		{
+			if (iter->second.rendered)
+				updateLazyGlyphUV(iter->second);
+		}
+
+		MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' texture grown to " << texWidth << " x " << texHeight << ".");
+
+		return true;
+	}
+
+	void ResourceTrueTypeFont::evictLazyGlyphs() const
+	{
+		LazyAtlas& atlas = *mLazyAtlas;
+
+		std::vector<LazyGlyph*> glyphs;
+		for (LazyGlyphMap::iterator iter = atlas.glyphs.begin(); iter != atlas.glyphs.end(); ++iter)
+		{
+			if (iter->second.rendered && !iter->second.pinned)
+				glyphs.push_back(&iter->second);
+		}
+
+		// Evict the least recently used half of the glyphs.
+		std::sort(glyphs.begin(), glyphs.end(), [](const LazyGlyph* _left, const LazyGlyph* _right) { return _left->lastUse < _right->lastUse; });
+
+		size_t evictCount = (glyphs.size() + 1) / 2;
+		for (size_t index = 0; index < evictCount; ++index)
+			glyphs[index]->rendered = false;
+
+		// Pack the remaining glyphs again from scratch, tallest first, so that the freed space becomes one free area.
+		glyphs.clear();
+		for (LazyGlyphMap::iterator iter = atlas.glyphs.begin(); iter != atlas.glyphs.end(); ++iter)
+		{
+			if (iter->second.rendered)
+				glyphs.push_back(&iter->second);
+		}
+
+		std::sort(glyphs.begin(), glyphs.end(), [](const LazyGlyph* _left, const LazyGlyph* _right) { return _left->place.height > _right->place.height; });
+
+		size_t numBytes = atlas.laMode ? Pixel<true>::getNumBytes() : Pixel<false>::getNumBytes();
+		std::vector<uint8> pixels(atlas.pixels.size());
+
+		if (atlas.laMode)
+			clearPixels<true>(&pixels[0], atlas.texWidth * atlas.texHeight);
+		else
+			clearPixels<false>(&pixels[0], atlas.texWidth * atlas.texHeight);
+
+		atlas.shelves.clear();
+
+		for (std::vector<LazyGlyph*>::iterator iter = glyphs.begin(); iter != glyphs.end(); ++iter)
+		{
+			LazyGlyph& glyph = **iter;
+			IntCoord place;
+
+			if (allocateLazyPlace(glyph.place.width, glyph.place.height, place))
+			{
+				copyPixels(&atlas.pixels[0], atlas.texWidth, glyph.place.left, glyph.place.top, &pixels[0], atlas.texWidth, place.left, place.top, place.width, place.height, numBytes);
+				glyph.place = place;
+				updateLazyGlyphUV(glyph);
+			}
+			else
+			{
+				glyph.rendered = false;
 			}
 		}
 
-		// Calculate and store the glyph's UV coordinates within the texture.
-		_info.uvRect.left = (float)_texX / _texWidth; // u1
-		_info.uvRect.top = (float)_texY / _texHeight; // v1
-		_info.uvRect.right = (float)(_texX + _info.width) / _texWidth; // u2
-		_info.uvRect.bottom = (float)(_texY + _info.height) / _texHeight; // v2
+		atlas.pixels.swap(pixels);
+
+		MYGUI_LOG(Info, "ResourceTrueTypeFont: Font '" << getResourceName() << "' evicted " << evictCount << " glyphs from texture.");
+	}
+
+	void ResourceTrueTypeFont::updateLazyGlyphUV(LazyGlyph& _glyph) const
+	{
+		GlyphInfo& info = _glyph.info;
+		float texWidth = (float)mLazyAtlas->texWidth;
+		float texHeight = (float)mLazyAtlas->texHeight;
+
+		info.uvRect.left = _glyph.place.left / texWidth; // u1
+		info.uvRect.top = _glyph.place.top / texHeight; // v1
+		info.uvRect.right = (_glyph.place.left + info.width) / texWidth; // u2
+		info.uvRect.bottom = (_glyph.place.top + info.height) / texHeight; // v2
+	}
+
+	void ResourceTrueTypeFont::uploadLazyTexture() const
+	{
+		uint8* texBuffer = static_cast<uint8*>(mTexture->lock(TextureUsage::Write));
+
+		if (texBuffer != nullptr)
+		{
+			memcpy(texBuffer, &mLazyAtlas->pixels[0], mLazyAtlas->pixels.size());
+			mTexture->unlock();
+		}
+		else
+		{
+			MYGUI_LOG(Error, "ResourceTrueTypeFont: Error locking texture; pointer is nullptr.");
+		}
+	}
+
+	void ResourceTrueTypeFont::uploadLazyGlyph(const LazyGlyph& _glyph) const
+	{
+		if (_glyph.place.width <= 0 || _glyph.place.height <= 0)
+			return;
+
+		size_t numBytes = mLazyAtlas->laMode ? Pixel<true>::getNumBytes() : Pixel<false>::getNumBytes();
+		size_t rowPitch = mLazyAtlas->texWidth * numBytes;
+		const uint8* data = &mLazyAtlas->pixels[_glyph.place.top * rowPitch + _glyph.place.left * numBytes];
 
-		if (width > 0)
-			_texX += mGlyphSpacing + width;
+		// Fall back to uploading the whole texture if the render system can't update part of it.
+		if (!mTexture->updateRect(_glyph.place, data, rowPitch))
+			uploadLazyTexture();
+	}
+
+	void ResourceTrueTypeFont::lazyTextureChanged() const
+	{
+		++mTextureVersion;
+		RenderManager::getInstance()._forceUpdate();
 	}
 
 #ifdef MYGUI_MSDF_FONTS
@@ -1149,93 +2196,100 @@ namespace MyGUI
 		return 0;
 	}
 
-	void ResourceTrueTypeFont::renderMsdfGlyphs(const GlyphHeightMap& _glyphHeightMap, msdfgen::FontHandle* _fontHandle, uint8* _texBuffer, int _texWidth, int _texHeight)
+	void ResourceTrueTypeFont::renderMsdfGlyphs(const GlyphHeightMap& _glyphHeightMap, const FT_Library& _ftLibrary, const FT_Face& _ftFace, const uint8* _fontBuffer, size_t _fontBufferSize, uint8* _texBuffer, int _texWidth, int _texHeight)
 	{
-		int texX = mGlyphSpacing, texY = mGlyphSpacing;
+		// Calculate all of the glyph positions up front, so that the glyphs can be rendered in any order.
+		VectorGlyphPlace places;
+		placeGlyphs(_glyphHeightMap, _texWidth, places);
 
-		for (const auto& sameHeightGlyphs : _glyphHeightMap)
+		// The special glyphs are cheap to render; only the msdf glyphs are split between threads.
+		VectorGlyphPlace facePlaces;
+
+		for (const auto& place : places)
 		{
-			int glyphHeight = sameHeightGlyphs.first;
-			for (const auto& glyph : sameHeightGlyphs.second)
+			GlyphInfo& info = *place.info;
+
+			switch (info.codePoint)
 			{
-				GlyphInfo& info = *glyph.second;
+				case FontCodeType::Selected:
+				case FontCodeType::SelectedBack:
+					renderGlyph<false, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, _texBuffer, _texWidth, _texHeight, place.texX, place.texY);
 
-				switch (info.codePoint)
-				{
-					case FontCodeType::Selected:
-					case FontCodeType::SelectedBack:
-					{
-						renderGlyph<false, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY);
+					// Manually adjust the glyph's width to zero. This prevents artifacts from appearing at the seams when
+					// rendering multi-character selections.
+					info.width = 0.0f;
+					info.uvRect.right = info.uvRect.left;
+					break;
 
-						// Manually adjust the glyph's width to zero. This prevents artifacts from appearing at the seams when
-						// rendering multi-character selections.
-						GlyphMap::iterator glyphIter = mGlyphMap.find(info.codePoint);
-						if (glyphIter != mGlyphMap.end())
-						{
-							glyphIter->second.width = 0.0f;
-							glyphIter->second.uvRect.right = glyphIter->second.uvRect.left;
-						}
-					}
-						break;
+				case FontCodeType::Cursor:
+				case FontCodeType::Tab:
+					renderGlyph<false, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, _texBuffer, _texWidth, _texHeight, place.texX, place.texY);
+					break;
+
+				default:
+					facePlaces.push_back(place);
+					break;
+			}
+		}
 
-					case FontCodeType::Cursor:
-					case FontCodeType::Tab:
-						renderGlyph<false, false, false>(info, charMaskWhite, charMaskBlack, charMask.find(info.codePoint)->second, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY);
-						break;
+		// Glyphs are written into disjoint areas of the texture buffer. Failures are logged afterwards, from this thread.
+		std::vector<uint8> failed(facePlaces.size(), 0);
 
-					default:
-						msdfgen::Shape shape;
-						if (loadGlyph(shape, _fontHandle, info.codePoint))
-						{
-							msdfgen::Shape::Bounds bounds = shape.getBounds();
-							double range = mMsdfRange / 2.0;
-							if (shape.contours.empty())
-							{
-								bounds = {0, 0, 0, 0};
-								range = 0;
-							}
-
-							shape.normalize();
-							edgeColoringSimple(shape, 3.0);
-
-							msdfgen::Bitmap<float, 3> msdf(
-								std::ceil(bounds.r - bounds.l + 2 * range),
-								std::ceil(bounds.t - bounds.b + 2 * range));
-							msdfgen::generateMSDF(msdf, shape, mMsdfRange, 1, msdfgen::Vector2(-bounds.l + range, -bounds.b + range));
-//							double error = msdfgen::estimateSDFError(
-//								msdfgen::BitmapConstRef<float, 3>{(float*)msdf, msdf.width(), msdf.height()},
-//								shape,
-//								1,
-//								msdfgen::Vector2(-bounds.l + range, -bounds.b + range),
-//								33);
-//							if (100000 * error > 1)
-//								MYGUI_LOG(Warning, "Error for '" << char(info.codePoint) << "' is :" << (int) 100000 * error);
-
-							uint8* glyphBuffer = new uint8[msdf.width() * msdf.height() * 3];
-							uint8* glyphBufferPointer = glyphBuffer;
-							for (int y = 0; y < msdf.height(); ++y)
-							{
-								for (int x = 0; x < msdf.width(); ++x)
-								{
-									for (int i = 0; i < 3; ++i)
-									{
-										// upside-down and RGB->BGR
-										*glyphBufferPointer++ = msdfgen::pixelFloatToByte(msdf(x, msdf.height() - y - 1)[2 - i]);
-									}
-								}
-							}
-
-							renderGlyph<false, true, false>(info, charMaskWhite, charMaskWhite, charMaskWhite, glyphHeight, _texBuffer, _texWidth, _texHeight, texX, texY, glyphBuffer);
-							delete[] glyphBuffer;
-						}
-						else
-						{
-							MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot render glyph for character " << info.codePoint << " in font '" << getResourceName() << "'.");
-						}
-						break;
+		renderInThreads<MsdfRenderContext>(facePlaces.size(), _ftLibrary, _ftFace, _fontBuffer, _fontBufferSize,
+			[&](const MsdfRenderContext& _context, size_t _index)
+			{
+				const GlyphPlace& place = facePlaces[_index];
+				if (!renderMsdfGlyph(*place.info, _context.font, _texBuffer, _texWidth, _texHeight, place.texX, place.texY))
+					failed[_index] = 1;
+			});
+
+		for (size_t index = 0; index < facePlaces.size(); ++index)
+		{
+			if (failed[index] != 0)
+				MYGUI_LOG(Warning, "ResourceTrueTypeFont: Cannot render glyph for character " << facePlaces[index].info->codePoint << " in font '" << getResourceName() << "'.");
+		}
+	}
+
+	bool ResourceTrueTypeFont::renderMsdfGlyph(GlyphInfo& _info, msdfgen::FontHandle* _fontHandle, uint8* _texBuffer, int _texWidth, int _texHeight, int _texX, int _texY) const
+	{
+		msdfgen::Shape shape;
+		if (!loadGlyph(shape, _fontHandle, _info.codePoint))
+			return false;
+
+		msdfgen::Shape::Bounds bounds = shape.getBounds();
+		double range = mMsdfRange / 2.0;
+		if (shape.contours.empty())
+		{
+			bounds = {0, 0, 0, 0};
+			range = 0;
+		}
+
+		shape.normalize();
+		edgeColoringSimple(shape, 3.0);
+
+		msdfgen::Bitmap<float, 3> msdf(
+			std::ceil(bounds.r - bounds.l + 2 * range),
+			std::ceil(bounds.t - bounds.b + 2 * range));
+		msdfgen::generateMSDF(msdf, shape, mMsdfRange, 1, msdfgen::Vector2(-bounds.l + range, -bounds.b + range));
+
+		uint8* glyphBuffer = new uint8[msdf.width() * msdf.height() * 3];
+		uint8* glyphBufferPointer = glyphBuffer;
+		for (int y = 0; y < msdf.height(); ++y)
+		{
+			for (int x = 0; x < msdf.width(); ++x)
+			{
+				for (int i = 0; i < 3; ++i)
+				{
+					// upside-down and RGB->BGR
+					*glyphBufferPointer++ = msdfgen::pixelFloatToByte(msdf(x, msdf.height() - y - 1)[2 - i]);
 				}
 			}
 		}
+
+		renderGlyph<false, true, false>(_info, charMaskWhite, charMaskWhite, charMaskWhite, _texBuffer, _texWidth, _texHeight, _texX, _texY, glyphBuffer);
+		delete[] glyphBuffer;
+
+		return true;
 	}
 #endif
 
@@ -1281,6 +2335,7 @@ namespace MyGUI
 	void ResourceTrueTypeFont::setTabWidth(float _value)
 	{
 		mTabWidth = _value;
+		mSpecifiedTabWidth = _value;
 	}
 
 	void ResourceTrueTypeFont::setOffsetHeight(int _value)
@@ -1291,6 +2346,7 @@ namespace MyGUI
 	void ResourceTrueTypeFont::setSubstituteCode(int _value)
 	{
 		mSubstituteCodePoint = _value;
+		mSpecifiedSubstituteCodePoint = _value;
 	}
 
 	void ResourceTrueTypeFont::setDistance(int _value)
@@ -1313,6 +2369,26 @@ namespace MyGUI
 		mMsdfRange = _value;
 	}
 
+	void ResourceTrueTypeFont::setLazyMode(bool _value)
+	{
+		mLazyMode = _value;
+	}
+
+	void ResourceTrueTypeFont::setLazyMaxTextureSize(int _value)
+	{
+		mLazyMaxTextureSize = Bitwise::firstPO2From(std::max(_value, 1));
+	}
+
+	void ResourceTrueTypeFont::setCacheFile(const std::string& _value)
+	{
+		mCacheFile = _value;
+	}
+
+	void ResourceTrueTypeFont::setRenderThreadCount(int _value)
+	{
+		mRenderThreadCount = (size_t)std::max(_value, 0);
+	}
+
 #endif // MYGUI_USE_FREETYPE
 
 } // namespace MyGUI
@@ -31,7 +31,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::setCenter(const IntPoint& _center)
@@ -40,7 +40,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	IntPoint RotatingSkin::getCenter(bool _local) const
@@ -57,7 +57,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::setAlpha(float _alpha)
@@ -66,7 +66,7 @@ namespace MyGUI
 		mCurrentColour = (mCurrentColour & 0x00FFFFFF) | (alpha & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::_correctView()
@@ -74,7 +74,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::_setAlign(const IntSize& _oldsize)
@@ -125,7 +125,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::createDrawItem(ITexture* _texture, ILayerNode* _node)
@@ -177,7 +177,7 @@ namespace MyGUI
 		mCurrentColour = (colour & 0x00FFFFFF) | (mCurrentColour & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void RotatingSkin::setStateData(IStateInfo* _data)
@@ -197,7 +197,7 @@ namespace MyGUI
 		mGeometryOutdated = true;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	inline float len(float x, float y)
@@ -312,8 +312,8 @@ namespace MyGUI
 
 		// now calculate widget base offset and then resulting position in screen coordinates
 		const RenderTargetInfo& info = mRenderItem->getRenderTarget()->getInfo();
-		float vertex_left_base = ((info.pixScaleX * (float)(mCroppedParent->getAbsoluteLeft()) + info.hOffset) * 2) - 1;
-		float vertex_top_base = -(((info.pixScaleY * (float)(mCroppedParent->getAbsoluteTop()) + info.vOffset) * 2) - 1);
+		float vertex_left_base = ((info.pixScaleX * (float)(mCroppedParent->getAbsoluteLeft() - info.leftOffset) + info.hOffset) * 2) - 1;
+		float vertex_top_base = -(((info.pixScaleY * (float)(mCroppedParent->getAbsoluteTop() - info.topOffset) + info.vOffset) * 2) - 1);
 
 		for (size_t i = 0; i < GEOMETRY_VERTICIES_TOTAL_COUNT; ++i)
 		{
@@ -39,6 +39,27 @@ namespace MyGUI
 		if (mTextOutDate)
 			updateRawData();
 
+		updateViewOffset();
+
+		Base::doRender();
+	}
+
+	void SimpleText::_prepareRender()
+	{
+		if (nullptr == mFont || !mVisible || mEmptyView)
+			return;
+
+		if (mTextOutDate)
+			updateRawData();
+
+		// visible lines depend on alignment
+		updateViewOffset();
+
+		Base::_prepareRender();
+	}
+
+	void SimpleText::updateViewOffset()
+	{
 		const IntSize& size = mTextView.getViewSize();
 
 		if (mTextAlign.isRight())
@@ -54,8 +75,6 @@ namespace MyGUI
 			mViewOffset.top = - ((mCoord.height - size.height) / 2);
 		else
 			mViewOffset.top = 0;
-
-		Base::doRender();
 	}
 
 } // namespace MyGUI
@@ -8,7 +8,7 @@
 #include "MyGUI_SkinItem.h"
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_Widget.h"
-#include "MyGUI_RenderManager.h"
+#include "MyGUI_TextureUtility.h"
 #include "MyGUI_SubWidgetManager.h"
 
 namespace MyGUI
@@ -16,6 +16,7 @@ namespace MyGUI
 	SkinItem::SkinItem() :
 		mText(nullptr),
 		mMainSkin(nullptr),
+		mStateInfo(nullptr),
 		mTexture(nullptr),
 		mSubSkinsVisible(true)
 	{
@@ -63,8 +64,11 @@ namespace MyGUI
 
 	bool SkinItem::_setSkinItemState(const std::string& _state)
 	{
-		MapWidgetStateInfo::const_iterator iter = mStateInfo.find(_state);
-		if (iter == mStateInfo.end())
+		if (mStateInfo == nullptr)
+			return false;
+
+		MapWidgetStateInfo::const_iterator iter = mStateInfo->find(_state);
+		if (iter == mStateInfo->end())
 			return false;
 
 		size_t index = 0;
@@ -79,17 +83,20 @@ namespace MyGUI
 
 	void SkinItem::_createSkinItem(ResourceSkin* _info)
 	{
-		mStateInfo = _info->getStateInfo();
+		// states are shared with skin instead of being copied into every widget
+		mStateInfo = &_info->getStateInfo();
 
 		// все что с текстурой можно тоже перенести в скин айтем и setRenderItemTexture
 		mTextureName = _info->getTextureName();
-		mTexture = RenderManager::getInstance().getTexture(mTextureName);
+		// skins only read size from texture header, texture is loaded when first widget uses it
+		mTexture = texture_utility::loadTexture(mTextureName);
 
 		setRenderItemTexture(mTexture);
 
 		std::string categoryName = SubWidgetManager::getInstance().getCategoryName();
 		// загружаем кирпичики виджета
 		FactoryManager& factory = FactoryManager::getInstance();
+		mSubSkinChild.reserve(_info->getBasisInfo().size());
 		for (VectorSubWidgetInfo::const_iterator iter = _info->getBasisInfo().begin(); iter != _info->getBasisInfo().end(); ++iter)
 		{
 			IObject* object = factory.createObject(categoryName, (*iter).type);
@@ -118,7 +125,7 @@ namespace MyGUI
 	{
 		mTexture = nullptr;
 
-		mStateInfo.clear();
+		mStateInfo = nullptr;
 
 		removeAllRenderItems();
 		// удаляем все сабскины
@@ -133,7 +140,7 @@ namespace MyGUI
 	void SkinItem::_setTextureName(const std::string& _texture)
 	{
 		mTextureName = _texture;
-		mTexture = RenderManager::getInstance().getTexture(mTextureName);
+		mTexture = texture_utility::loadTexture(mTextureName);
 
 		setRenderItemTexture(mTexture);
 	}
@@ -35,7 +35,7 @@ namespace MyGUI
 		mVisible = _visible;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::setAlpha(float _alpha)
@@ -44,13 +44,13 @@ namespace MyGUI
 		mCurrentColour = (mCurrentColour & 0x00FFFFFF) | (alpha & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::_correctView()
 	{
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::_setAlign(const IntSize& _oldsize)
@@ -115,7 +115,7 @@ namespace MyGUI
 
 				// обновить перед выходом
 				if (nullptr != mNode)
-					mNode->outOfDate(mRenderItem);
+					mNode->outOfDate(mRenderItem, this);
 				return;
 			}
 		}
@@ -156,7 +156,7 @@ namespace MyGUI
 		mIsMargin = margin;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::createDrawItem(ITexture* _texture, ILayerNode* _node)
@@ -165,7 +165,7 @@ namespace MyGUI
 
 		mNode = _node;
 		mRenderItem = mNode->addToRenderItem(_texture, true, mSeparate);
-		mRenderItem->addDrawItem(this, VertexQuad::VertexCount);
+		mRenderItem->addDrawItem(this, IndexedVertexQuad::VertexCount, true);
 	}
 
 	void SubSkin::destroyDrawItem()
@@ -208,7 +208,7 @@ namespace MyGUI
 		}
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::doRender()
@@ -216,7 +216,7 @@ namespace MyGUI
 		if (!mVisible || mEmptyView)
 			return;
 
-		VertexQuad* quad = reinterpret_cast<VertexQuad*>(mRenderItem->getCurrentVertexBuffer());
+		IndexedVertexQuad* quad = reinterpret_cast<IndexedVertexQuad*>(mRenderItem->getCurrentVertexBuffer());
 
 		const RenderTargetInfo& info = mRenderItem->getRenderTarget()->getInfo();
 
@@ -239,7 +239,7 @@ namespace MyGUI
 			mCurrentTexture.bottom,
 			mCurrentColour);
 
-		mRenderItem->setLastVertexCount(VertexQuad::VertexCount);
+		mRenderItem->setLastVertexCount(IndexedVertexQuad::VertexCount);
 	}
 
 	void SubSkin::_setColour(const Colour& _value)
@@ -248,7 +248,7 @@ namespace MyGUI
 		mCurrentColour = (colour & 0x00FFFFFF) | (mCurrentColour & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void SubSkin::setStateData(IStateInfo* _data)
@@ -0,0 +1,148 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_TextBuffer.h"
+
+namespace MyGUI
+{
+
+	TextBuffer::TextBuffer() :
+		mGapStart(0),
+		mGapSize(0),
+		mTagCharCount(0)
+	{
+	}
+
+	TextBuffer::TextBuffer(const UString::utf32string& _text) :
+		mGapStart(0),
+		mGapSize(0),
+		mTagCharCount(0)
+	{
+		assign(_text);
+	}
+
+	void TextBuffer::insert(size_t _position, const UString::utf32string& _text)
+	{
+		insert(_position, _text.data(), _text.size());
+	}
+
+	void TextBuffer::insert(size_t _position, const value_type* _text, size_t _count)
+	{
+		MYGUI_ASSERT(_position <= size(), "TextBuffer::insert position " << _position << " is out of range " << size());
+		if (_count == 0)
+			return;
+
+		reserveGap(_count);
+		moveGap(_position);
+
+		std::copy(_text, _text + _count, mData.begin() + mGapStart);
+		mGapStart += _count;
+		mGapSize -= _count;
+		mTagCharCount += std::count(_text, _text + _count, (value_type)L'#');
+	}
+
+	void TextBuffer::erase(size_t _position, size_t _count)
+	{
+		MYGUI_ASSERT(_position <= size(), "TextBuffer::erase position " << _position << " is out of range " << size());
+		_count = (std::min)(_count, size() - _position);
+		if (_count == 0)
+			return;
+
+		moveGap(_position);
+
+		std::vector<value_type>::const_iterator start = mData.begin() + mGapStart + mGapSize;
+		mTagCharCount -= std::count(start, start + _count, (value_type)L'#');
+		mGapSize += _count;
+	}
+
+	void TextBuffer::assign(const UString::utf32string& _text)
+	{
+		mData.assign(_text.begin(), _text.end());
+		mGapStart = mData.size();
+		mGapSize = 0;
+		mTagCharCount = std::count(_text.begin(), _text.end(), (value_type)L'#');
+	}
+
+	void TextBuffer::clear()
+	{
+		// memory is kept for the next text, everything becomes the gap
+		mGapStart = 0;
+		mGapSize = mData.size();
+		mTagCharCount = 0;
+	}
+
+	UString::utf32string TextBuffer::substr(size_t _position, size_t _count) const
+	{
+		MYGUI_ASSERT(_position <= size(), "TextBuffer::substr position " << _position << " is out of range " << size());
+		_count = (std::min)(_count, size() - _position);
+
+		UString::utf32string result;
+		result.reserve(_count);
+
+		// part before the gap
+		if (_position < mGapStart)
+		{
+			size_t count = (std::min)(_count, mGapStart - _position);
+			result.append(mData.begin() + _position, mData.begin() + _position + count);
+			_position += count;
+			_count -= count;
+		}
+
+		// part after the gap
+		if (_count != 0)
+		{
+			std::vector<value_type>::const_iterator start = mData.begin() + _position + mGapSize;
+			result.append(start, start + _count);
+		}
+
+		return result;
+	}
+
+	UString::utf32string TextBuffer::str() const
+	{
+		return substr(0);
+	}
+
+	size_t TextBuffer::getTagCharCount() const
+	{
+		return mTagCharCount;
+	}
+
+	void TextBuffer::moveGap(size_t _position)
+	{
+		if (_position < mGapStart)
+		{
+			// text between position and gap goes after the gap
+			std::copy_backward(mData.begin() + _position, mData.begin() + mGapStart, mData.begin() + mGapStart + mGapSize);
+		}
+		else if (_position > mGapStart)
+		{
+			// text between gap and position goes before the gap
+			std::copy(mData.begin() + mGapStart + mGapSize, mData.begin() + _position + mGapSize, mData.begin() + mGapStart);
+		}
+		mGapStart = _position;
+	}
+
+	void TextBuffer::reserveGap(size_t _size)
+	{
+		if (mGapSize >= _size)
+			return;
+
+		// grow proportionally to text, so typing reallocates rarely
+		size_t gapSize = _size + (std::max)(size() / 2, (size_t)64);
+
+		std::vector<value_type> data;
+		data.reserve(size() + gapSize);
+		data.insert(data.end(), mData.begin(), mData.begin() + mGapStart);
+		data.resize(mGapStart + gapSize);
+		data.insert(data.end(), mData.begin() + mGapStart + mGapSize, mData.end());
+
+		mData.swap(data);
+		mGapSize = gapSize;
+	}
+
+} // namespace MyGUI
@@ -11,28 +11,94 @@ namespace MyGUI
 {
 
 	TextIterator::TextIterator() :
+		mText(&mOwnText),
+		mCurrent(0),
+		mSave(ITEM_NONE),
 		mPosition(0),
 		mSize(ITEM_NONE),
 		mFirst(true),
-		mHistory(nullptr)
+		mHistory(nullptr),
+		mChangeStart(ITEM_NONE),
+		mChangeSuffix(0),
+		mOriginalSize(0)
 	{
 	}
 
 	TextIterator::TextIterator(const UString& _text, VectorChangeInfo* _history) :
-		mText(_text.asUTF32()),
-		mCurrent(mText.begin()),
-		mEnd(mText.end()),
-		mSave(mEnd),
+		mOwnText(_text.asUTF32()),
+		mText(&mOwnText),
+		mCurrent(0),
+		mSave(ITEM_NONE),
 		mPosition(0),
 		mSize(ITEM_NONE),
 		mFirst(true),
-		mHistory(_history)
+		mHistory(_history),
+		mChangeStart(ITEM_NONE),
+		mChangeSuffix(0),
+		mOriginalSize(mText->size())
 	{
 	}
 
+	TextIterator::TextIterator(TextBuffer& _text, VectorChangeInfo* _history) :
+		mText(&_text),
+		mCurrent(0),
+		mSave(ITEM_NONE),
+		mPosition(0),
+		mSize(ITEM_NONE),
+		mFirst(true),
+		mHistory(_history),
+		mChangeStart(ITEM_NONE),
+		mChangeSuffix(0),
+		mOriginalSize(mText->size())
+	{
+	}
+
+	TextIterator::TextIterator(const TextIterator& _other) :
+		mText(&mOwnText),
+		mCurrent(0),
+		mSave(ITEM_NONE),
+		mPosition(0),
+		mSize(ITEM_NONE),
+		mFirst(true),
+		mHistory(nullptr),
+		mChangeStart(ITEM_NONE),
+		mChangeSuffix(0),
+		mOriginalSize(0)
+	{
+		assign(_other);
+	}
+
+	TextIterator& TextIterator::operator = (const TextIterator& _other)
+	{
+		if (this != &_other)
+			assign(_other);
+		return *this;
+	}
+
+	void TextIterator::assign(const TextIterator& _other)
+	{
+		// copy of iterator over own text gets its own copy of text, external text is shared
+		bool ownText = _other.mText == &_other.mOwnText;
+		mOwnText = ownText ? _other.mOwnText : TextBuffer();
+		mText = ownText ? &mOwnText : _other.mText;
+
+		mCurrent = _other.mCurrent;
+		mSave = _other.mSave;
+
+		mPosition = _other.mPosition;
+		mSize = _other.mSize;
+		mFirst = _other.mFirst;
+		mHistory = _other.mHistory;
+
+		mChangeStart = _other.mChangeStart;
+		mChangeSuffix = _other.mChangeSuffix;
+		mOriginalSize = _other.mOriginalSize;
+	}
+
 	bool TextIterator::moveNext()
 	{
-		if (mCurrent == mEnd) return false;
+		size_t end = mText->size();
+		if (mCurrent == end) return false;
 		else if (mFirst)
 		{
 			mFirst = false;
@@ -40,35 +106,35 @@ namespace MyGUI
 		}
 
 		// jump to next character, skipping tags (#)
-		for (UString::utf32string::iterator iter = mCurrent; iter != mEnd; ++iter)
+		for (size_t index = mCurrent; index != end; ++index)
 		{
 
-			if ((*iter) == L'#')
+			if ((*mText)[index] == L'#')
 			{
 
 				// следующий символ
-				++ iter;
-				if (iter == mEnd)
+				++ index;
+				if (index == end)
 				{
-					mCurrent = mEnd;
+					mCurrent = end;
 					return false;
 				}
 
 				// две решетки подряд
-				if ((*iter) == L'#')
+				if ((*mText)[index] == L'#')
 				{
 
 					// следующий символ
 					mPosition ++;
-					++iter;
-					if (iter == mEnd)
+					++index;
+					if (index == end)
 					{
-						mCurrent = mEnd;
+						mCurrent = end;
 						return false;
 					}
 
 					// указатель на следующий символ
-					mCurrent = iter;
+					mCurrent = index;
 					return true;
 				}
 
@@ -76,10 +142,10 @@ namespace MyGUI
 				for (size_t pos = 0; pos < 5; pos++)
 				{
 					// следующий символ
-					++ iter;
-					if (iter == mEnd)
+					++ index;
+					if (index == end)
 					{
-						mCurrent = mEnd;
+						mCurrent = end;
 						return false;
 					}
 				}
@@ -90,15 +156,15 @@ namespace MyGUI
 
 				// обыкновенный символ
 				mPosition ++;
-				++iter;
-				if (iter == mEnd)
+				++index;
+				if (index == end)
 				{
-					mCurrent = mEnd;
+					mCurrent = end;
 					return false;
 				}
 
 				// указатель на следующий символ
-				mCurrent = iter;
+				mCurrent = index;
 				return true;
 			}
 		}
@@ -106,16 +172,26 @@ namespace MyGUI
 		return false;
 	}
 
+	bool TextIterator::skipTo(size_t _position)
+	{
+		if (!mFirst || mPosition != 0 || mText->getTagCharCount() != 0)
+			return false;
+
+		// without tags position of character is its index in text
+		mPosition = mCurrent = (std::min)(_position, mText->size());
+		return true;
+	}
+
 	// возвращает цвет
 	bool TextIterator::getTagColour(UString& _colour) const
 	{
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 
-		UString::utf32string::iterator iter = mCurrent;
+		size_t index = mCurrent;
 
 		// нам нужен последний цвет
 		bool ret = false;
-		while (getTagColour(_colour, iter))
+		while (getTagColour(_colour, index))
 		{
 			ret = true;
 		}
@@ -125,9 +201,9 @@ namespace MyGUI
 
 	bool TextIterator::setTagColour(const Colour& _colour)
 	{
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 		clearTagColour();
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 
 		const size_t SIZE = 16;
 		wchar_t buff[SIZE];
@@ -145,9 +221,9 @@ namespace MyGUI
 
 	bool TextIterator::setTagColour(const UString::utf32string& _colour)
 	{
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 		clearTagColour();
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 
 		// check if it looks like a colour tag
 		if ( (_colour.size() != 7) || (_colour.find(L'#', 1) != MyGUI::UString::npos) ) return false;
@@ -166,27 +242,36 @@ namespace MyGUI
 	size_t TextIterator::getSize() const
 	{
 		if (mSize != ITEM_NONE) return mSize;
+
+		// every character is visible in text without tags
+		if (mText->getTagCharCount() == 0)
+		{
+			mSize = mText->size();
+			return mSize;
+		}
+
 		mSize = mPosition;
 
-		for (UString::utf32string::const_iterator iter = mCurrent; iter != mEnd; ++iter)
+		size_t end = mText->size();
+		for (size_t index = mCurrent; index != end; ++index)
 		{
 
-			if ((*iter) == L'#')
+			if ((*mText)[index] == L'#')
 			{
 				// следующий символ
-				++ iter;
-				if (iter == mEnd) break;
+				++ index;
+				if (index == end) break;
 
 				// тэг цвета
-				if ((*iter) != L'#')
+				if ((*mText)[index] != L'#')
 				{
 					// остальные 5 символов цвета
 					for (size_t pos = 0; pos < 5; pos++)
 					{
-						++ iter;
-						if (iter == mEnd)
+						++ index;
+						if (index == end)
 						{
-							--iter;
+							--index;
 							break;
 						}
 					}
@@ -243,26 +328,27 @@ namespace MyGUI
 	}
 
 	// возвращает цвет
-	bool TextIterator::getTagColour(UString& _colour, UString::utf32string::iterator& _iter) const
+	bool TextIterator::getTagColour(UString& _colour, size_t& _index) const
 	{
-		if ( (_iter == mEnd) || ((*_iter) != L'#') ) return false;
+		size_t end = mText->size();
+		if ( (_index == end) || ((*mText)[_index] != L'#') ) return false;
 
 		// следующий символ
-		++_iter;
-		if ( (_iter == mEnd) || ((*_iter) == L'#') ) return false;
+		++_index;
+		if ( (_index == end) || ((*mText)[_index] == L'#') ) return false;
 
 		// берем цвет
 		wchar_t buff[16] = L"#FFFFFF\0";
-		buff[1] = (wchar_t)(*_iter);
+		buff[1] = (wchar_t)(*mText)[_index];
 		for (size_t pos = 2; pos < 7; pos++)
 		{
-			++_iter;
-			if ( _iter == mEnd ) return false;
-			buff[pos] = (wchar_t)(*_iter);
+			++_index;
+			if ( _index == end ) return false;
+			buff[pos] = (wchar_t)(*mText)[_index];
 		}
 
 		// ставим на следующий тег или символ
-		++_iter;
+		++_index;
 
 		// возвращаем цвет
 		_colour = buff;
@@ -285,23 +371,22 @@ namespace MyGUI
 
 	bool TextIterator::saveStartPoint()
 	{
-		if (mCurrent == mEnd) return false;
+		if (mCurrent == mText->size()) return false;
 		mSave = mCurrent;
 		return true;
 	}
 
 	UString TextIterator::getFromStart() const
 	{
-		if (mSave == mEnd) return L"";
-		size_t start = mSave - mText.begin();
-		return UString(mText.substr(start, mCurrent - mText.begin() - start));
+		if (mSave == ITEM_NONE) return L"";
+		return UString(mText->substr(mSave, mCurrent - mSave));
 	}
 
 	bool TextIterator::eraseFromStart()
 	{
-		if (mSave == mEnd) return false;
+		if (mSave == ITEM_NONE) return false;
 		mCurrent = erase(mSave, mCurrent);
-		mSave = mEnd = mText.end();
+		mSave = ITEM_NONE;
 		return true;
 	}
 
@@ -367,80 +452,106 @@ namespace MyGUI
 		return text;
 	}
 
-	void TextIterator::insert(UString::utf32string::iterator& _start, const UString::utf32string& _insert)
+	void TextIterator::insert(size_t _start, const UString::utf32string& _insert)
 	{
 		// сбрасываем размер
 		mSize = ITEM_NONE;
 		// записываем в историю
-		if (mHistory) mHistory->push_back(TextCommandInfo(_insert, _start - mText.begin(), TextCommandInfo::COMMAND_INSERT));
-		// запоминаем позицию итератора
-		size_t pos = _start - mText.begin();
-		size_t pos_save = (mSave == mEnd) ? ITEM_NONE : _start - mText.begin();
+		if (mHistory) mHistory->push_back(TextCommandInfo(_insert, _start, TextCommandInfo::COMMAND_INSERT));
+		notifyChange(_start, _start);
 		// непосредственно вставляем
-		mText.insert(_start, _insert.begin(), _insert.end());
-		// возвращаем итераторы
-		_start = mText.begin() + pos;
-		mEnd = mText.end();
-		(pos_save == ITEM_NONE) ? mSave = mEnd : mSave = mText.begin() + pos_save;
+		mText->insert(_start, _insert);
+		// saved point moves to the place of insertion
+		if (mSave != ITEM_NONE) mSave = _start;
 	}
 
-	UString::utf32string::iterator TextIterator::erase(UString::utf32string::iterator _start, UString::utf32string::iterator _end)
+	size_t TextIterator::erase(size_t _start, size_t _end)
 	{
 		// сбрасываем размер
 		mSize = ITEM_NONE;
 		// сохраняем в историю
-		size_t start = _start - mText.begin();
-		if (mHistory) mHistory->push_back(TextCommandInfo(mText.substr(start, _end - _start), start, TextCommandInfo::COMMAND_ERASE));
-		// возвращаем итератор
-		return mText.erase(_start, _end);
+		if (mHistory) mHistory->push_back(TextCommandInfo(mText->substr(_start, _end - _start), _start, TextCommandInfo::COMMAND_ERASE));
+		notifyChange(_start, _end);
+		mText->erase(_start, _end - _start);
+		return _start;
+	}
+
+	void TextIterator::notifyChange(size_t _start, size_t _end)
+	{
+		size_t suffix = mText->size() - _end;
+		if (mChangeStart == ITEM_NONE)
+		{
+			mChangeStart = _start;
+			mChangeSuffix = suffix;
+		}
+		else
+		{
+			mChangeStart = (std::min)(mChangeStart, _start);
+			mChangeSuffix = (std::min)(mChangeSuffix, suffix);
+		}
+	}
+
+	bool TextIterator::getChangedRange(size_t& _start, size_t& _erased, size_t& _inserted) const
+	{
+		if (mChangeStart == ITEM_NONE)
+			return false;
+
+		_start = mChangeStart;
+		_erased = mOriginalSize - mChangeStart - mChangeSuffix;
+		_inserted = mText->size() - mChangeStart - mChangeSuffix;
+		return true;
 	}
 
 	void TextIterator::clear()
 	{
-		if (mText.empty()) return;
+		if (mText->empty()) return;
 
 		// записываем в историю
-		if (mHistory) mHistory->push_back(TextCommandInfo(mText, 0, TextCommandInfo::COMMAND_ERASE));
+		if (mHistory) mHistory->push_back(TextCommandInfo(mText->str(), 0, TextCommandInfo::COMMAND_ERASE));
+		notifyChange(0, mText->size());
 
 		// все сбрасываем
-		mText.clear();
-		mCurrent = mText.begin();
-		mEnd = mSave = mText.end();
+		mText->clear();
+		mCurrent = 0;
+		mSave = ITEM_NONE;
 		mSize = ITEM_NONE;
 	}
 
 	void TextIterator::cutMaxLength(size_t _max)
 	{
 		if ( (mSize != ITEM_NONE) && (mSize <= _max) ) return;
+		// text without tags can't be longer than text with tags
+		if (mText->size() <= _max) return;
 		if (mPosition > _max)
 		{
 			// придется считать сначала
 			mSize = mPosition = 0;
-			mCurrent = mText.begin();
-			mEnd = mSave = mText.end();
+			mCurrent = 0;
+			mSave = ITEM_NONE;
 		}
 
 		mSize = mPosition;
 
-		for (UString::utf32string::iterator iter = mCurrent; iter != mEnd; ++iter)
+		size_t end = mText->size();
+		for (size_t index = mCurrent; index != end; ++index)
 		{
 
-			if ((*iter) == L'#')
+			if ((*mText)[index] == L'#')
 			{
 				// следующий символ
-				++ iter;
-				if (iter == mEnd) break;
+				++ index;
+				if (index == end) break;
 
 				// тэг цвета
-				if ((*iter) != L'#')
+				if ((*mText)[index] != L'#')
 				{
 					// остальные 5 символов цвета
 					for (size_t pos = 0; pos < 5; pos++)
 					{
-						++ iter;
-						if (iter == mEnd)
+						++ index;
+						if (index == end)
 						{
-							-- iter;
+							-- index;
 							break;
 						}
 					}
@@ -452,8 +563,8 @@ namespace MyGUI
 			if (mSize == _max)
 			{
 				mPosition = mSize; // сохраняем
-				mCurrent = erase(iter, mEnd);
-				mSave = mEnd = mText.end();
+				mCurrent = erase(index, end);
+				mSave = ITEM_NONE;
 				mSize = mPosition; // восстанавливаем
 				return;
 			}
@@ -473,35 +584,36 @@ namespace MyGUI
 		size_t diff = size - _max;
 
 		// последний цвет
-		UString::utf32string::iterator iter_colour = mEnd;
+		size_t index_colour = ITEM_NONE;
 
 		// теперь пройдем от начала и узнаем реальную позицию разницы
-		UString::utf32string::iterator iter = mText.begin();
-		for (; iter != mEnd; ++iter)
+		size_t end = mText->size();
+		size_t index = 0;
+		for (; index != end; ++index)
 		{
-			if ((*iter) == L'#')
+			if ((*mText)[index] == L'#')
 			{
-				UString::utf32string::iterator save = iter;
+				size_t save = index;
 
 				// следующий символ
-				++ iter;
-				if (iter == mEnd) break;
+				++ index;
+				if (index == end) break;
 
 				// тэг цвета
-				if ((*iter) != L'#')
+				if ((*mText)[index] != L'#')
 				{
 					// остальные 5 символов цвета
 					for (size_t pos = 0; pos < 5; pos++)
 					{
-						++ iter;
-						if (iter == mEnd)
+						++ index;
+						if (index == end)
 						{
-							-- iter;
+							-- index;
 							break;
 						}
 					}
 					// сохраняем цвет
-					iter_colour = save;
+					index_colour = save;
 				}
 				continue;
 			}
@@ -512,14 +624,13 @@ namespace MyGUI
 
 		UString::utf32string colour;
 		// если бы цвет, то вставляем назад
-		if (iter_colour != mEnd)
+		if (index_colour != ITEM_NONE)
 		{
-			colour.append(iter_colour, iter_colour + size_t(7));
+			colour = mText->substr(index_colour, 7);
 		}
 
-		mCurrent = erase(mText.begin(), iter);
-		mEnd = mText.end();
-		mSave = mText.end(); //FIXME
+		mCurrent = erase(0, index);
+		mSave = ITEM_NONE; //FIXME
 		mPosition = 0;
 		mSize = _max;
 
@@ -529,16 +640,14 @@ namespace MyGUI
 
 	void TextIterator::clearTagColour()
 	{
-		if (mCurrent == mEnd) return;
+		if (mCurrent == mText->size()) return;
 
-		UString::utf32string::iterator iter = mCurrent;
+		size_t index = mCurrent;
 		UString colour;
 		// нам нужен последний цвет
-		while (getTagColour(colour, iter))
+		while (getTagColour(colour, index))
 		{
-			// обязательно обновляем итераторы
-			iter = mCurrent = erase(mCurrent, iter);
-			mEnd = mText.end();
+			index = mCurrent = erase(mCurrent, index);
 		}
 	}
 
@@ -549,7 +658,7 @@ namespace MyGUI
 
 	UString TextIterator::getText() const
 	{
-		return UString(mText);
+		return UString(mText->str());
 	}
 
 	void TextIterator::clearText()
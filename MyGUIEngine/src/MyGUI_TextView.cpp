@@ -6,6 +6,8 @@
 
 #include "MyGUI_Precompiled.h"
 #include "MyGUI_TextView.h"
+#include "MyGUI_Profiler.h"
+#include <cfloat>
 
 namespace MyGUI
 {
@@ -34,13 +36,14 @@ namespace MyGUI
 	public:
 		RollBackPoint() :
 			position(0),
+			space_point(0),
 			count(0),
 			width(0),
 			rollback(false)
 		{
 		}
 
-		void set(size_t _position, const UString::utf32string::const_iterator& _space_point, size_t _count, float _width)
+		void set(size_t _position, size_t _space_point, size_t _count, float _width)
 		{
 			position = _position;
 			space_point = _space_point;
@@ -77,7 +80,7 @@ namespace MyGUI
 			return position;
 		}
 
-		UString::utf32string::const_iterator getTextIter() const
+		size_t getTextIndex() const
 		{
 			MYGUI_DEBUG_ASSERT(rollback, "rollback point not valid");
 			return space_point;
@@ -85,7 +88,7 @@ namespace MyGUI
 
 	private:
 		size_t position;
-		UString::utf32string::const_iterator space_point;
+		size_t space_point;
 		size_t count;
 		float width;
 		bool rollback;
@@ -93,14 +96,205 @@ namespace MyGUI
 
 	TextView::TextView() :
 		mLength(0),
-		mFontHeight(0)
+		mFontHeight(0),
+		mTextSize(0),
+		mFont(nullptr),
+		mFontTextureVersion(0),
+		mTextChanged(false),
+		mChangeStart(0),
+		mChangeSuffix(0),
+		mChangedTextSize(0)
 	{
 	}
 
-	void TextView::update(const UString::utf32string& _text, IFont* _font, int _height, Align _align, VertexColourType _format, int _maxWidth)
+	void TextView::notifyTextChange(size_t _start, size_t _erased, size_t _inserted)
 	{
+		if (_erased == 0 && _inserted == 0)
+			return;
+
+		size_t size = mTextChanged ? mChangedTextSize : mTextSize;
+		// wrong range, whole text is laid out again
+		if (_start + _erased > size)
+		{
+			_start = 0;
+			_erased = size;
+		}
+
+		size_t suffix = size - _start - _erased;
+		if (!mTextChanged)
+		{
+			mTextChanged = true;
+			mChangeStart = _start;
+			mChangeSuffix = suffix;
+		}
+		else
+		{
+			mChangeStart = (std::min)(mChangeStart, _start);
+			mChangeSuffix = (std::min)(mChangeSuffix, suffix);
+		}
+		mChangedTextSize = size - _erased + _inserted;
+	}
+
+	void TextView::update(const TextBuffer& _text, IFont* _font, int _height, Align _align, VertexColourType _format, int _maxWidth)
+	{
+		MYGUI_PROFILE_SCOPE("TextView::update");
+		MYGUI_PROFILE_COUNTER(LayoutPasses, 1);
+
+		// glyph metrics or texture coordinates could change, nothing to reuse
+		size_t fontTextureVersion = _font->getTextureVersion();
+		if (_font != mFont || _height != mFontHeight || _format != mVertexFormat || fontTextureVersion != mFontTextureVersion)
+		{
+			mLineInfo.clear();
+			mLineLayout.clear();
+		}
+
+		mFont = _font;
 		mFontHeight = _height;
+		mVertexFormat = _format;
+		mFontTextureVersion = fontTextureVersion;
+
+		// changed part of text is [prefix, oldSize - suffix) in old text and [prefix, newSize - suffix) in new one
+		size_t oldSize = mTextSize;
+		size_t newSize = _text.size();
+		size_t prefix = oldSize;
+		size_t suffix = 0;
+		if (mTextChanged)
+		{
+			prefix = mChangeStart;
+			suffix = mChangeSuffix;
+		}
+		// size doesn't match notified changes, nothing to reuse
+		if ((mTextChanged ? mChangedTextSize : oldSize) != newSize)
+		{
+			prefix = 0;
+			suffix = 0;
+		}
+		bool textChanged = prefix != oldSize || oldSize != newSize;
+		size_t changeEnd = oldSize - suffix;
+
+		mTextSize = newSize;
+		mTextChanged = false;
+
+		VectorLineInfo oldLines;
+		VectorLineLayout oldLayouts;
+		oldLines.swap(mLineInfo);
+		oldLayouts.swap(mLineLayout);
+		mLineInfo.reserve(oldLines.size());
+		mLineLayout.reserve(oldLayouts.size());
+
+		size_t position = 0;
+		size_t oldIndex = 0;
+		while (true)
+		{
+			// old lines that lay before changed text keep their position, lines after it are shifted
+			while (oldIndex < oldLayouts.size())
+			{
+				const LineLayout& layout = oldLayouts[oldIndex];
+				bool valid = !textChanged || layout.examined <= prefix || layout.start >= changeEnd;
+				size_t start = (textChanged && layout.start >= changeEnd) ? layout.start + newSize - oldSize : layout.start;
+				if (valid && start >= position)
+					break;
+				++oldIndex;
+			}
+
+			bool reused = false;
+			if (oldIndex < oldLayouts.size() && isLineFit(oldLayouts[oldIndex], _maxWidth))
+			{
+				LineLayout layout = oldLayouts[oldIndex];
+				if (textChanged && layout.start >= changeEnd)
+				{
+					layout.start += newSize - oldSize;
+					layout.next += newSize - oldSize;
+					layout.examined += newSize - oldSize;
+				}
+
+				if (layout.start == position)
+				{
+					mLineInfo.push_back(std::move(oldLines[oldIndex]));
+					mLineLayout.push_back(layout);
+					++oldIndex;
+					reused = true;
+				}
+			}
+
+			if (!reused)
+			{
+				mLineInfo.push_back(LineInfo());
+				mLineLayout.push_back(LineLayout());
+				layoutLine(_text, position, _height, _format, _maxWidth, mLineInfo.back(), mLineLayout.back());
+
+				// colour of next lines starts from it
+				LineLayout& layout = mLineLayout.back();
+				const VectorCharInfo& symbols = mLineInfo.back().symbols;
+				layout.hasColour = false;
+				for (VectorCharInfo::const_reverse_iterator sim = symbols.rbegin(); sim != symbols.rend(); ++sim)
+				{
+					if (sim->isColour())
+					{
+						layout.hasColour = true;
+						layout.colour = sim->getColour();
+						break;
+					}
+				}
+			}
+
+			// last line reached end of text
+			position = mLineLayout.back().next;
+			if (position > newSize)
+				break;
+		}
+
+		IntSize result;
+		mLength = 0;
+		for (VectorLineInfo::const_iterator line = mLineInfo.begin(); line != mLineInfo.end(); ++line)
+		{
+			mLength += line->count + 1;
+			setMax(result.width, line->width);
+		}
+		// no line break after last line
+		mLength --;
+		result.height = _height * (int)mLineInfo.size();
+
+		bool hasColour = false;
+		uint32 colour = 0;
+		position = 0;
+		for (VectorLineLayout::iterator layout = mLineLayout.begin(); layout != mLineLayout.end(); ++layout)
+		{
+			layout->position = position;
+			layout->hasStartColour = hasColour;
+			layout->startColour = colour;
+			if (layout->hasColour)
+			{
+				hasColour = true;
+				colour = layout->colour;
+			}
+			position += mLineInfo[layout - mLineLayout.begin()].count + 1;
+		}
+
+		// теперь выравниванием строки
+		for (VectorLineInfo::iterator line = mLineInfo.begin(); line != mLineInfo.end(); ++line)
+		{
+			if (_align.isRight())
+				line->offset = result.width - line->width;
+			else if (_align.isHCenter())
+				line->offset = (result.width - line->width) / 2;
+			else
+				line->offset = 0;
+		}
 
+		mViewSize = result;
+	}
+
+	bool TextView::isLineFit(const LineLayout& _layout, int _maxWidth) const
+	{
+		// same wrapping as with width line was laid out with
+		if (_maxWidth == -1)
+			return _layout.wrapWidth == FLT_MAX;
+		return _layout.fitWidth <= _maxWidth && _layout.wrapWidth > _maxWidth;
+	}
+
+	void TextView::layoutLine(const TextBuffer& _text, size_t _start, int _height, VertexColourType _format, int _maxWidth, LineInfo& _line, LineLayout& _layout) const
+	{
 		// массив для быстрой конвертации цветов
 		static const char convert_colour[64] =
 		{
@@ -110,28 +304,21 @@ namespace MyGUI
 			0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0
 		};
 
-		mViewSize.clear();
-
 		RollBackPoint roll_back;
-		IntSize result;
 		float width = 0.0f;
 		size_t count = 0;
-		mLength = 0;
-		mLineInfo.clear();
-		LineInfo line_info;
-		int font_height = _font->getDefaultHeight();
+		int font_height = mFont->getDefaultHeight();
 
-		UString::utf32string::const_iterator end = _text.end();
-		UString::utf32string::const_iterator index = _text.begin();
+		_layout.start = _start;
+		_layout.fitWidth = 0.0f;
+		_layout.wrapWidth = FLT_MAX;
 
-		/*if (index == end)
-			return;*/
+		size_t end = _text.size();
+		size_t index = _start;
 
-		result.height += _height;
-
-		for (; index != end; ++index)
+		for (; index < end; ++index)
 		{
-			Char character = *index;
+			Char character = _text[index];
 
 			// new line
 			if (character == FontCodeType::CR
@@ -140,27 +327,17 @@ namespace MyGUI
 			{
 				if (character == FontCodeType::CR)
 				{
-					UString::utf32string::const_iterator peeki = index;
-					++peeki;
-					if ((peeki != end) && (*peeki == FontCodeType::LF))
-						index = peeki; // skip both as one newline
+					if ((index + 1 != end) && (_text[index + 1] == FontCodeType::LF))
+						++index; // skip both as one newline
 				}
 
-				line_info.width = (int)std::ceil(width);
-				line_info.count = count;
-				mLength += line_info.count + 1;
-
-				result.height += _height;
-				setMax(result.width, line_info.width);
-				width = 0;
-				count = 0;
+				_line.width = (int)std::ceil(width);
+				_line.count = count;
 
-				mLineInfo.push_back(line_info);
-				line_info.clear();
-
-				roll_back.clear();
-
-				continue;
+				_layout.next = index + 1;
+				// CR also looks at the next character
+				_layout.examined = character == FontCodeType::CR ? _layout.next + 1 : _layout.next;
+				return;
 			}
 			// tag
 			else if (character == L'#')
@@ -173,7 +350,7 @@ namespace MyGUI
 					continue;
 				}
 
-				character = *index;
+				character = _text[index];
 				// "##" converted to visible '#', change colour otherwise
 				if (character != L'#')
 				{
@@ -190,26 +367,26 @@ namespace MyGUI
 							continue;
 						}
 						colour <<= 4;
-						colour += convert_colour[ ((*index) - 48) & 0x3F ];
+						colour += convert_colour[ (_text[index] - 48) & 0x3F ];
 					}
 
 					// convert to ABGR if we use that colour format
 					texture_utility::convertColour(colour, _format);
 
-					line_info.symbols.push_back( CharInfo(colour) );
+					_line.symbols.push_back( CharInfo(colour) );
 
 					continue;
 				}
 			}
 
-			const GlyphInfo* info = _font->getGlyphInfo(character);
+			const GlyphInfo* info = mFont->getGlyphInfo(character);
 
 			if (info == nullptr)
 				continue;
 
 			if (FontCodeType::Space == character || FontCodeType::Tab == character)
 			{
-				roll_back.set(line_info.symbols.size(), index, count, width);
+				roll_back.set(_line.symbols.size(), index, count, width);
 			}
 
 			float char_width = info->width;
@@ -232,58 +409,42 @@ namespace MyGUI
 			float char_fullAdvance = char_bearingX + char_advance;
 
 			// перенос слов
-			if (_maxWidth != -1
-				&& (width + char_fullAdvance) > _maxWidth
-				&& !roll_back.empty())
+			if (!roll_back.empty())
 			{
-				// откатываем до последнего пробела
-				width = roll_back.getWidth();
-				count = roll_back.getCount();
-				index = roll_back.getTextIter();
-				line_info.symbols.erase(line_info.symbols.begin() + roll_back.getPosition(), line_info.symbols.end());
-
-				// запоминаем место отката, как полную строку
-				line_info.width = (int)std::ceil(width);
-				line_info.count = count;
-				mLength += line_info.count + 1;
+				if (_maxWidth != -1
+					&& (width + char_fullAdvance) > _maxWidth)
+				{
+					_layout.wrapWidth = width + char_fullAdvance;
+					_layout.examined = index + 1;
 
-				result.height += _height;
-				setMax(result.width, line_info.width);
-				width = 0;
-				count = 0;
+					// откатываем до последнего пробела
+					width = roll_back.getWidth();
+					count = roll_back.getCount();
+					index = roll_back.getTextIndex();
+					_line.symbols.erase(_line.symbols.begin() + roll_back.getPosition(), _line.symbols.end());
 
-				mLineInfo.push_back(line_info);
-				line_info.clear();
+					// запоминаем место отката, как полную строку
+					_line.width = (int)std::ceil(width);
+					_line.count = count;
 
-				// отменяем откат
-				roll_back.clear();
+					_layout.next = index + 1;
+					return;
+				}
 
-				continue;
+				setMax(_layout.fitWidth, width + char_fullAdvance);
 			}
 
-			line_info.symbols.push_back(CharInfo(info->uvRect, char_width, char_height, char_advance, char_bearingX, char_bearingY));
+			_line.symbols.push_back(CharInfo(info->uvRect, char_width, char_height, char_advance, char_bearingX, char_bearingY));
 			width += char_fullAdvance;
 			count ++;
 		}
 
-		line_info.width = (int)std::ceil(width);
-		line_info.count = count;
-		mLength += line_info.count;
-
-		mLineInfo.push_back(line_info);
+		_line.width = (int)std::ceil(width);
+		_line.count = count;
 
-		setMax(result.width, line_info.width);
-
-		// теперь выравниванием строки
-		for (VectorLineInfo::iterator line = mLineInfo.begin(); line != mLineInfo.end(); ++line)
-		{
-			if (_align.isRight())
-				line->offset = result.width - line->width;
-			else if (_align.isHCenter())
-				line->offset = (result.width - line->width) / 2;
-		}
-
-		mViewSize = result;
+		// past the end, depends on everything that could be appended
+		_layout.next = _text.size() + 1;
+		_layout.examined = _text.size() + 1;
 	}
 
 	size_t TextView::getCursorPosition(const IntPoint& _value) const
@@ -331,34 +492,33 @@ namespace MyGUI
 
 	IntPoint TextView::getCursorPoint(size_t _position) const
 	{
+		if (mLineInfo.empty())
+			return IntPoint();
+
 		setMin(_position, mLength);
 
-		size_t position = 0;
-		int top = 0;
-		float left = 0.0f;
-		for (VectorLineInfo::const_iterator line = mLineInfo.begin(); line != mLineInfo.end(); ++line)
-		{
-			left = (float)line->offset;
-			if (position + line->count >= _position)
-			{
-				for (VectorCharInfo::const_iterator sim = line->symbols.begin(); sim != line->symbols.end(); ++sim)
-				{
-					if (sim->isColour())
-						continue;
+		// last line that starts before position
+		VectorLineLayout::const_iterator layout = std::upper_bound(mLineLayout.begin(), mLineLayout.end(), _position,
+			[](size_t _value, const LineLayout& _layout) { return _value < _layout.position; });
+		--layout;
+		size_t index = layout - mLineLayout.begin();
+		const LineInfo& line = mLineInfo[index];
 
-					if (position == _position)
-						break;
+		size_t position = layout->position;
+		float left = (float)line.offset;
+		for (VectorCharInfo::const_iterator sim = line.symbols.begin(); sim != line.symbols.end(); ++sim)
+		{
+			if (sim->isColour())
+				continue;
 
-					position ++;
-					left += sim->getBearingX() + sim->getAdvance();
-				}
+			if (position == _position)
 				break;
-			}
-			position += line->count + 1;
-			top += mFontHeight;
+
+			position ++;
+			left += sim->getBearingX() + sim->getAdvance();
 		}
 
-		return IntPoint((int)left, top);
+		return IntPoint((int)left, (int)index * mFontHeight);
 	}
 
 	const IntSize& TextView::getViewSize() const
@@ -376,4 +536,19 @@ namespace MyGUI
 		return mLineInfo;
 	}
 
+	size_t TextView::getLineStart(size_t _line) const
+	{
+		MYGUI_ASSERT_RANGE(_line, mLineLayout.size(), "TextView::getLineStart");
+		return mLineLayout[_line].position;
+	}
+
+	bool TextView::getLineColour(size_t _line, uint32& _colour) const
+	{
+		MYGUI_ASSERT_RANGE(_line, mLineLayout.size(), "TextView::getLineColour");
+		if (!mLineLayout[_line].hasStartColour)
+			return false;
+		_colour = mLineLayout[_line].startColour;
+		return true;
+	}
+
 } // namespace MyGUI
@@ -0,0 +1,330 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_TextureAtlasManager.h"
+#include "MyGUI_ResourceManager.h"
+#include "MyGUI_RenderManager.h"
+#include "MyGUI_TextureUtility.h"
+#include <cstring>
+
+namespace MyGUI
+{
+
+	// every packed texture is surrounded by its own edge pixels, so filtering never reads neighbours
+	const int ATLAS_GUTTER_SIZE = 1;
+	const size_t ATLAS_PIXEL_SIZE = 4;
+
+	MYGUI_SINGLETON_DEFINITION(TextureAtlasManager);
+
+	TextureAtlasManager::TextureAtlasManager() :
+		mTextureCount(0),
+		mEnabled(false),
+		mPageSize(2048),
+		mMaxTextureSize(512),
+		mIsInitialise(false),
+		mXmlAtlasTagName("TextureAtlas"),
+		mXmlPropertyTagName("Property"),
+		mSingletonHolder(this)
+	{
+	}
+
+	void TextureAtlasManager::initialise()
+	{
+		MYGUI_ASSERT(!mIsInitialise, getClassTypeName() << " initialised twice");
+		MYGUI_LOG(Info, "* Initialise: " << getClassTypeName());
+
+		ResourceManager::getInstance().registerLoadXmlDelegate(mXmlAtlasTagName) = newDelegate(this, &TextureAtlasManager::_load);
+
+		MYGUI_LOG(Info, getClassTypeName() << " successfully initialized");
+		mIsInitialise = true;
+	}
+
+	void TextureAtlasManager::shutdown()
+	{
+		MYGUI_ASSERT(mIsInitialise, getClassTypeName() << " is not initialised");
+		MYGUI_LOG(Info, "* Shutdown: " << getClassTypeName());
+
+		ResourceManager::getInstance().unregisterLoadXmlDelegate(mXmlAtlasTagName);
+
+		if (!mPages.empty())
+			MYGUI_LOG(Info, getClassTypeName() << " had " << mTextureCount << " textures packed into " << mPages.size() << " pages");
+
+		destroyAllPages();
+
+		MYGUI_LOG(Info, getClassTypeName() << " successfully shutdown");
+		mIsInitialise = false;
+	}
+
+	void TextureAtlasManager::_load(xml::ElementPtr _node, const std::string& _file, Version _version)
+	{
+		xml::ElementEnumerator node = _node->getElementEnumerator();
+		while (node.next(mXmlPropertyTagName))
+		{
+			const std::string& key = node->findAttribute("key");
+			const std::string& value = node->findAttribute("value");
+			if (key == "Enabled")
+				setEnabled(utility::parseBool(value));
+			else if (key == "PageSize")
+				setPageSize(utility::parseInt(value));
+			else if (key == "MaxTextureSize")
+				setMaxTextureSize(utility::parseInt(value));
+		}
+	}
+
+	void TextureAtlasManager::setEnabled(bool _value)
+	{
+		mEnabled = _value;
+	}
+
+	bool TextureAtlasManager::getEnabled() const
+	{
+		return mEnabled;
+	}
+
+	void TextureAtlasManager::setPageSize(int _value)
+	{
+		mPageSize = _value;
+	}
+
+	int TextureAtlasManager::getPageSize() const
+	{
+		return mPageSize;
+	}
+
+	void TextureAtlasManager::setMaxTextureSize(int _value)
+	{
+		mMaxTextureSize = _value;
+	}
+
+	int TextureAtlasManager::getMaxTextureSize() const
+	{
+		return mMaxTextureSize;
+	}
+
+	size_t TextureAtlasManager::getTextureCount() const
+	{
+		return mTextureCount;
+	}
+
+	size_t TextureAtlasManager::getPageCount() const
+	{
+		return mPages.size();
+	}
+
+	bool TextureAtlasManager::mapTexture(std::string& _texture, IntPoint& _offset)
+	{
+		if (!mEnabled || _texture.empty())
+			return false;
+
+		MapPlacement::iterator item = mPlacements.find(_texture);
+		if (item == mPlacements.end())
+			item = mPlacements.insert(MapPlacement::value_type(_texture, packTexture(_texture))).first;
+
+		const Placement& placement = item->second;
+		if (placement.page == ITEM_NONE)
+			return false;
+
+		_texture = mPages[placement.page].texture->getName();
+		_offset = placement.offset;
+		return true;
+	}
+
+	TextureAtlasManager::Placement TextureAtlasManager::packTexture(const std::string& _texture)
+	{
+		Placement result;
+		result.page = ITEM_NONE;
+
+		RenderManager& render = RenderManager::getInstance();
+
+		// texture created by somebody else can be used directly, so it is left alive
+		ITexture* texture = render.getTexture(_texture);
+		bool ownTexture = texture == nullptr;
+		if (ownTexture)
+		{
+			// textures that are too big are not loaded here, size is known from file header
+			texture_utility::TextureInfo info;
+			if (texture_utility::getTextureInfo(_texture, info) && !fitTexture(info.size.width, info.size.height))
+				return result;
+
+			texture = texture_utility::loadTexture(_texture);
+			if (texture == nullptr)
+				return result;
+		}
+
+		int width = texture->getWidth();
+		int height = texture->getHeight();
+		if (!fitTexture(width, height))
+			return result;
+
+		std::vector<uint8> pixels;
+		if (!readPixels(texture, pixels))
+		{
+			MYGUI_LOG(Warning, "Texture '" << _texture << "' can't be read, it is not packed into atlas");
+			return result;
+		}
+
+		IntPoint point;
+		result.page = findPlace(width + ATLAS_GUTTER_SIZE * 2, height + ATLAS_GUTTER_SIZE * 2, point);
+		result.offset.set(point.left + ATLAS_GUTTER_SIZE, point.top + ATLAS_GUTTER_SIZE);
+
+		Page& page = mPages[result.page];
+		size_t rowPitch = page.size * ATLAS_PIXEL_SIZE;
+		size_t sourcePitch = width * ATLAS_PIXEL_SIZE;
+		for (int y = -ATLAS_GUTTER_SIZE; y < height + ATLAS_GUTTER_SIZE; ++y)
+		{
+			int sourceY = (std::min)((std::max)(y, 0), height - 1);
+			const uint8* source = &pixels[sourceY * sourcePitch];
+			uint8* dest = &page.pixels[(result.offset.top + y) * rowPitch + result.offset.left * ATLAS_PIXEL_SIZE];
+
+			memcpy(dest, source, sourcePitch);
+			for (int x = 1; x <= ATLAS_GUTTER_SIZE; ++x)
+			{
+				memcpy(dest - x * ATLAS_PIXEL_SIZE, source, ATLAS_PIXEL_SIZE);
+				memcpy(dest + sourcePitch + (x - 1) * ATLAS_PIXEL_SIZE, source + sourcePitch - ATLAS_PIXEL_SIZE, ATLAS_PIXEL_SIZE);
+			}
+		}
+
+		uploadPage(page, IntCoord(point.left, point.top, width + ATLAS_GUTTER_SIZE * 2, height + ATLAS_GUTTER_SIZE * 2));
+		mTextureCount ++;
+
+		if (ownTexture)
+			render.destroyTexture(texture);
+
+		return result;
+	}
+
+	bool TextureAtlasManager::fitTexture(int _width, int _height) const
+	{
+		return _width > 0 && _height > 0 && _width <= mMaxTextureSize && _height <= mMaxTextureSize &&
+			_width + ATLAS_GUTTER_SIZE * 2 <= mPageSize && _height + ATLAS_GUTTER_SIZE * 2 <= mPageSize;
+	}
+
+	bool TextureAtlasManager::readPixels(ITexture* _texture, std::vector<uint8>& _pixels) const
+	{
+		// format of texture that is loaded asynchronously is known only after lock
+		const uint8* data = static_cast<const uint8*>(_texture->lock(TextureUsage::Read));
+		if (data == nullptr)
+			return false;
+
+		PixelFormat format = _texture->getFormat();
+		if (format != PixelFormat::R8G8B8A8 && format != PixelFormat::R8G8B8)
+		{
+			_texture->unlock();
+			return false;
+		}
+
+		size_t count = _texture->getWidth() * _texture->getHeight();
+		_pixels.resize(count * ATLAS_PIXEL_SIZE);
+
+		if (format == PixelFormat::R8G8B8A8)
+		{
+			memcpy(&_pixels[0], data, _pixels.size());
+		}
+		else
+		{
+			// components have the same order in both formats, only alpha is added
+			uint8* dest = &_pixels[0];
+			for (size_t index = 0; index < count; ++index, data += 3, dest += ATLAS_PIXEL_SIZE)
+			{
+				dest[0] = data[0];
+				dest[1] = data[1];
+				dest[2] = data[2];
+				dest[3] = 0xFF;
+			}
+		}
+
+		_texture->unlock();
+		return true;
+	}
+
+	size_t TextureAtlasManager::findPlace(int _width, int _height, IntPoint& _point)
+	{
+		for (size_t index = 0; index < mPages.size(); ++index)
+		{
+			Page& page = mPages[index];
+
+			int left = page.shelfLeft;
+			int top = page.shelfTop;
+			int height = page.shelfHeight;
+			if (left + _width > page.size)
+			{
+				left = 0;
+				top += height;
+				height = 0;
+			}
+
+			if (left + _width > page.size || top + _height > page.size)
+				continue;
+
+			page.shelfLeft = left + _width;
+			page.shelfTop = top;
+			page.shelfHeight = (std::max)(height, _height);
+
+			_point.set(left, top);
+			return index;
+		}
+
+		Page page;
+		page.size = mPageSize;
+		page.shelfLeft = _width;
+		page.shelfTop = 0;
+		page.shelfHeight = _height;
+		page.pixels.resize(page.size * page.size * ATLAS_PIXEL_SIZE, 0);
+
+		page.texture = RenderManager::getInstance().createTexture(utility::toString("MyGUI_TextureAtlas_", mPages.size()));
+		page.texture->setInvalidateListener(this);
+		page.texture->createManual(page.size, page.size, TextureUsage::Static | TextureUsage::Write, PixelFormat::R8G8B8A8);
+
+		MYGUI_LOG(Info, "Atlas page '" << page.texture->getName() << "' " << page.size << "x" << page.size << " created");
+
+		mPages.push_back(page);
+
+		_point.set(0, 0);
+		return mPages.size() - 1;
+	}
+
+	void TextureAtlasManager::uploadPage(const Page& _page, const IntCoord& _coord) const
+	{
+		size_t rowPitch = _page.size * ATLAS_PIXEL_SIZE;
+		const uint8* data = &_page.pixels[_coord.top * rowPitch + _coord.left * ATLAS_PIXEL_SIZE];
+
+		// Fall back to uploading the whole page if the render system can't update part of it.
+		if (_page.texture->updateRect(_coord, data, rowPitch))
+			return;
+
+		uint8* buffer = static_cast<uint8*>(_page.texture->lock(TextureUsage::Write));
+		if (buffer != nullptr)
+		{
+			memcpy(buffer, &_page.pixels[0], _page.pixels.size());
+			_page.texture->unlock();
+		}
+		else
+		{
+			MYGUI_LOG(Error, "TextureAtlasManager: Error locking texture; pointer is nullptr.");
+		}
+	}
+
+	void TextureAtlasManager::textureInvalidate(ITexture* _texture)
+	{
+		for (VectorPage::const_iterator page = mPages.begin(); page != mPages.end(); ++page)
+		{
+			if (page->texture == _texture)
+				uploadPage(*page, IntCoord(0, 0, page->size, page->size));
+		}
+	}
+
+	void TextureAtlasManager::destroyAllPages()
+	{
+		for (VectorPage::iterator page = mPages.begin(); page != mPages.end(); ++page)
+			RenderManager::getInstance().destroyTexture(page->texture);
+
+		mPages.clear();
+		mPlacements.clear();
+		mTextureCount = 0;
+	}
+
+} // namespace MyGUI
@@ -9,7 +9,8 @@
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_DataManager.h"
 #include "MyGUI_Bitwise.h"
-#include "MyGUI_Constants.h"
+#include <cstring>
+#include <mutex>
 
 namespace MyGUI
 {
@@ -17,52 +18,293 @@ namespace MyGUI
 	namespace texture_utility
 	{
 
-		const IntSize& getTextureSize(const std::string& _texture, bool _cache)
+		namespace
 		{
-			static std::string prevTexture;
-			static IntSize prevSize;
 
-			if (prevTexture == _texture && _cache)
-				return prevSize;
+			struct TextureInfoEntry
+			{
+				bool found;
+				TextureInfo info;
+			};
+			typedef std::map<std::string, TextureInfoEntry> MapTextureInfo;
 
-			prevTexture.clear();
-			prevSize.clear();
+			// headers read by any thread, entries are only copied out under the lock
+			std::mutex gTextureInfoMutex;
+			MapTextureInfo gTextureInfo;
 
-			if (_texture.empty())
-				return Constants::getZeroIntSize();
+			uint32 readBigEndian16(const uint8* _data)
+			{
+				return (_data[0] << 8) | _data[1];
+			}
 
-			RenderManager& render = RenderManager::getInstance();
+			uint32 readBigEndian32(const uint8* _data)
+			{
+				return ((uint32)_data[0] << 24) | (_data[1] << 16) | (_data[2] << 8) | _data[3];
+			}
 
-			ITexture* texture = render.getTexture(_texture);
-			if (texture == nullptr)
+			uint32 readLittleEndian32(const uint8* _data)
+			{
+				return ((uint32)_data[3] << 24) | (_data[2] << 16) | (_data[1] << 8) | _data[0];
+			}
+
+			bool readPngInfo(IDataStream* _stream, const uint8* _signature, TextureInfo& _info)
 			{
-				if (!DataManager::getInstance().isDataExist(_texture))
+				// signature, IHDR chunk length and type, width, height, bit depth and colour type
+				uint8 header[26];
+				memcpy(header, _signature, 4);
+				if (_stream->read(header + 4, sizeof(header) - 4) != sizeof(header) - 4 ||
+					memcmp(header, "\x89PNG\r\n\x1a\n", 8) != 0 ||
+					memcmp(header + 12, "IHDR", 4) != 0)
+					return false;
+
+				_info.size.set((int)readBigEndian32(header + 16), (int)readBigEndian32(header + 20));
+				_info.mipCount = 1;
+
+				uint8 bitDepth = header[24];
+				uint8 colourType = header[25];
+				if (colourType == 0 && bitDepth == 8)
+					_info.format = PixelFormat::L8;
+				else if (colourType == 4 && bitDepth == 8)
+					_info.format = PixelFormat::L8A8;
+				else if ((colourType == 2 && bitDepth == 8) || colourType == 3)
+					_info.format = PixelFormat::R8G8B8;
+				else if (colourType == 6 && bitDepth == 8)
+					_info.format = PixelFormat::R8G8B8A8;
+
+				return true;
+			}
+
+			bool readDdsInfo(IDataStream* _stream, const uint8* _signature, TextureInfo& _info)
+			{
+				// magic and DDS_HEADER
+				uint8 header[128];
+				memcpy(header, _signature, 4);
+				if (_stream->read(header + 4, sizeof(header) - 4) != sizeof(header) - 4 ||
+					readLittleEndian32(header + 4) != 124)
+					return false;
+
+				const uint32 DDSD_MIPMAPCOUNT = 0x20000;
+				const uint32 DDPF_ALPHAPIXELS = 0x1;
+				const uint32 DDPF_RGB = 0x40;
+				const uint32 DDPF_LUMINANCE = 0x20000;
+
+				uint32 flags = readLittleEndian32(header + 8);
+				_info.size.set((int)readLittleEndian32(header + 16), (int)readLittleEndian32(header + 12));
+				uint32 mipCount = readLittleEndian32(header + 28);
+				_info.mipCount = (flags & DDSD_MIPMAPCOUNT) != 0 && mipCount != 0 ? mipCount : 1;
+
+				// compressed formats are described by fourCC and stay Unknow
+				uint32 formatFlags = readLittleEndian32(header + 80);
+				uint32 bitCount = readLittleEndian32(header + 88);
+				if ((formatFlags & DDPF_RGB) != 0)
 				{
-					MYGUI_LOG(Error, "Texture '" + _texture + "' not found");
-					return Constants::getZeroIntSize();
+					if (bitCount == 32 && (formatFlags & DDPF_ALPHAPIXELS) != 0)
+						_info.format = PixelFormat::R8G8B8A8;
+					else if (bitCount == 24)
+						_info.format = PixelFormat::R8G8B8;
 				}
-				else
+				else if ((formatFlags & DDPF_LUMINANCE) != 0)
 				{
-					texture = render.createTexture(_texture);
-					if (texture == nullptr)
+					if (bitCount == 8)
+						_info.format = PixelFormat::L8;
+					else if (bitCount == 16 && (formatFlags & DDPF_ALPHAPIXELS) != 0)
+						_info.format = PixelFormat::L8A8;
+				}
+
+				return true;
+			}
+
+			bool readJpegInfo(IDataStream* _stream, const uint8* _signature, TextureInfo& _info)
+			{
+				// segments are skipped until first SOFn marker, it have to be before image data
+				size_t position = 2;
+
+				uint8 buffer[512];
+				while (true)
+				{
+					uint8 marker[2];
+					for (size_t index = 0; index < 2; ++index)
 					{
-						MYGUI_LOG(Error, "Texture '" + _texture + "' cannot be created");
-						return Constants::getZeroIntSize();
+						if (position < 4)
+							marker[index] = _signature[position++];
+						else if (_stream->read(&marker[index], 1) != 1)
+							return false;
 					}
-					texture->loadFromFile(_texture);
-#if MYGUI_DEBUG_MODE == 1
-					if (!Bitwise::isPO2(prevSize.width) || !Bitwise::isPO2(prevSize.height))
+
+					if (marker[0] != 0xFF)
+						return false;
+
+					// any count of fill bytes can precede marker
+					uint8 type = marker[1];
+					while (type == 0xFF)
 					{
-						MYGUI_LOG(Warning, "Texture '" + _texture + "' have non power of two size");
+						if (_stream->read(&type, 1) != 1)
+							return false;
 					}
-#endif
+
+					// markers without segment
+					if (type == 0x01 || (type >= 0xD0 && type <= 0xD8))
+						continue;
+					// start of scan or end of image
+					if (type == 0xDA || type == 0xD9)
+						return false;
+
+					uint8 length[2];
+					if (_stream->read(length, 2) != 2)
+						return false;
+					size_t size = readBigEndian16(length);
+					if (size < 2)
+						return false;
+					size -= 2;
+
+					if (type >= 0xC0 && type <= 0xCF && type != 0xC4 && type != 0xC8 && type != 0xCC)
+					{
+						// precision, height, width and count of components
+						uint8 frame[6];
+						if (size < sizeof(frame) || _stream->read(frame, sizeof(frame)) != sizeof(frame))
+							return false;
+
+						_info.size.set((int)readBigEndian16(frame + 3), (int)readBigEndian16(frame + 1));
+						_info.mipCount = 1;
+						if (frame[0] == 8 && frame[5] == 1)
+							_info.format = PixelFormat::L8;
+						else if (frame[0] == 8 && frame[5] == 3)
+							_info.format = PixelFormat::R8G8B8;
+						return true;
+					}
+
+					while (size != 0)
+					{
+						size_t count = (std::min)(size, sizeof(buffer));
+						if (_stream->read(buffer, count) != count)
+							return false;
+						size -= count;
+					}
+				}
+			}
+
+			bool readTextureInfo(const std::string& _texture, TextureInfo& _info)
+			{
+				IDataStream* stream = DataManager::getInstance().getData(_texture);
+				if (stream == nullptr)
+					return false;
+
+				bool result = false;
+				uint8 signature[4];
+				if (stream->read(signature, sizeof(signature)) == sizeof(signature))
+				{
+					if (signature[0] == 0x89 && signature[1] == 'P' && signature[2] == 'N' && signature[3] == 'G')
+						result = readPngInfo(stream, signature, _info);
+					else if (signature[0] == 'D' && signature[1] == 'D' && signature[2] == 'S' && signature[3] == ' ')
+						result = readDdsInfo(stream, signature, _info);
+					else if (signature[0] == 0xFF && signature[1] == 0xD8)
+						result = readJpegInfo(stream, signature, _info);
 				}
+
+				DataManager::getInstance().freeData(stream);
+				return result;
 			}
 
-			prevSize = IntSize(texture->getWidth(), texture->getHeight());
-			prevTexture = _texture;
+			// entry is copied under lock, other thread can erase it right after
+			TextureInfoEntry getTextureInfoEntry(const std::string& _texture)
+			{
+				{
+					std::lock_guard<std::mutex> lock(gTextureInfoMutex);
+					MapTextureInfo::const_iterator item = gTextureInfo.find(_texture);
+					if (item != gTextureInfo.end())
+						return item->second;
+				}
+
+				// file is read without lock, if another thread reads it meanwhile first result is kept
+				TextureInfoEntry entry;
+				entry.found = readTextureInfo(_texture, entry.info);
+
+#if MYGUI_DEBUG_MODE == 1
+				if (entry.found && (!Bitwise::isPO2(entry.info.size.width) || !Bitwise::isPO2(entry.info.size.height)))
+				{
+					MYGUI_LOG(Warning, "Texture '" + _texture + "' have non power of two size");
+				}
+#endif
+
+				std::lock_guard<std::mutex> lock(gTextureInfoMutex);
+				return gTextureInfo.insert(MapTextureInfo::value_type(_texture, entry)).first->second;
+			}
+
+		} // namespace
+
+		IntSize getTextureSize(const std::string& _texture, bool _cache)
+		{
+			if (!_cache)
+			{
+				std::lock_guard<std::mutex> lock(gTextureInfoMutex);
+				if (_texture.empty())
+					gTextureInfo.clear();
+				else
+					gTextureInfo.erase(_texture);
+			}
+
+			if (_texture.empty())
+				return IntSize();
+
+			ITexture* texture = RenderManager::getInstance().getTexture(_texture);
+			if (texture == nullptr)
+			{
+				TextureInfoEntry entry = getTextureInfoEntry(_texture);
+				if (entry.found)
+					return entry.info.size;
+
+				// format is not recognised, the only way to know size is to load texture
+				texture = loadTexture(_texture);
+				if (texture == nullptr)
+					return IntSize();
+			}
+
+			// size of created texture is not cached, texture can be recreated with another size
+			return IntSize(texture->getWidth(), texture->getHeight());
+		}
+
+		bool getTextureInfo(const std::string& _texture, TextureInfo& _info)
+		{
+			if (_texture.empty())
+				return false;
+
+			TextureInfoEntry entry = getTextureInfoEntry(_texture);
+			_info = entry.info;
+			return entry.found;
+		}
+
+		void clearTextureInfo()
+		{
+			std::lock_guard<std::mutex> lock(gTextureInfoMutex);
+			gTextureInfo.clear();
+		}
+
+		ITexture* loadTexture(const std::string& _texture)
+		{
+			if (_texture.empty())
+				return nullptr;
+
+			RenderManager& render = RenderManager::getInstance();
+
+			ITexture* texture = render.getTexture(_texture);
+			if (texture != nullptr)
+				return texture;
+
+			if (!DataManager::getInstance().isDataExist(_texture))
+			{
+				MYGUI_LOG(Error, "Texture '" + _texture + "' not found");
+				return nullptr;
+			}
+
+			texture = render.createTexture(_texture);
+			if (texture == nullptr)
+			{
+				MYGUI_LOG(Error, "Texture '" + _texture + "' cannot be created");
+				return nullptr;
+			}
+			texture->loadFromFile(_texture);
 
-			return prevSize;
+			return texture;
 		}
 
 		uint32 toNativeColour(const Colour& _colour, VertexColourType _format)
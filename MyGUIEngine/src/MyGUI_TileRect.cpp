@@ -17,7 +17,7 @@
 namespace MyGUI
 {
 
-	const size_t TILERECT_COUNT_VERTEX = 16 * VertexQuad::VertexCount;
+	const size_t TILERECT_COUNT_VERTEX = 16 * IndexedVertexQuad::VertexCount;
 
 	TileRect::TileRect() :
 		mEmptyView(false),
@@ -42,7 +42,7 @@ namespace MyGUI
 		mVisible = _visible;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void TileRect::setAlpha(float _alpha)
@@ -51,13 +51,13 @@ namespace MyGUI
 		mCurrentColour = (mCurrentColour & 0x00FFFFFF) | (alpha & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void TileRect::_correctView()
 	{
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void TileRect::_setAlign(const IntSize& _oldsize)
@@ -128,7 +128,7 @@ namespace MyGUI
 				if ((mCoord.height % mTileSize.height) > 0)
 					count_y ++;
 
-				count = count_y * count_x * VertexQuad::VertexCount;
+				count = count_y * count_x * IndexedVertexQuad::VertexCount;
 			}
 
 			// нужно больше вершин
@@ -151,7 +151,7 @@ namespace MyGUI
 
 				// обновить перед выходом
 				if (nullptr != mNode)
-					mNode->outOfDate(mRenderItem);
+					mNode->outOfDate(mRenderItem, this);
 				return;
 			}
 		}
@@ -160,14 +160,14 @@ namespace MyGUI
 		mIsMargin = margin;
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void TileRect::_setUVSet(const FloatRect& _rect)
 	{
 		mCurrentTexture = _rect;
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 	void TileRect::doRender()
@@ -175,7 +175,7 @@ namespace MyGUI
 		if (!mVisible || mEmptyView || mTileSize.empty())
 			return;
 
-		VertexQuad* quad = reinterpret_cast<VertexQuad*>(mRenderItem->getCurrentVertexBuffer());
+		IndexedVertexQuad* quad = reinterpret_cast<IndexedVertexQuad*>(mRenderItem->getCurrentVertexBuffer());
 
 		const RenderTargetInfo& info = mRenderItem->getRenderTarget()->getInfo();
 
@@ -312,7 +312,7 @@ namespace MyGUI
 			}
 		}
 
-		mRenderItem->setLastVertexCount(VertexQuad::VertexCount * count);
+		mRenderItem->setLastVertexCount(IndexedVertexQuad::VertexCount * count);
 	}
 
 	void TileRect::createDrawItem(ITexture* _texture, ILayerNode* _node)
@@ -321,7 +321,7 @@ namespace MyGUI
 
 		mNode = _node;
 		mRenderItem = mNode->addToRenderItem(_texture, true, false);
-		mRenderItem->addDrawItem(this, mCountVertex);
+		mRenderItem->addDrawItem(this, mCountVertex, true);
 	}
 
 	void TileRect::destroyDrawItem()
@@ -349,7 +349,7 @@ namespace MyGUI
 		mCurrentColour = (colour & 0x00FFFFFF) | (mCurrentColour & 0xFF000000);
 
 		if (nullptr != mNode)
-			mNode->outOfDate(mRenderItem);
+			mNode->outOfDate(mRenderItem, this);
 	}
 
 } // namespace MyGUI
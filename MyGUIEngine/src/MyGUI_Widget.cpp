@@ -15,6 +15,7 @@
 #include "MyGUI_WidgetDefines.h"
 #include "MyGUI_LayerItem.h"
 #include "MyGUI_LayerManager.h"
+#include "MyGUI_LayerNode.h"
 #include "MyGUI_RenderItem.h"
 #include "MyGUI_ISubWidget.h"
 #include "MyGUI_ISubWidgetText.h"
@@ -24,12 +25,18 @@
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_ToolTipManager.h"
 #include "MyGUI_LayoutManager.h"
+#include "MyGUI_OverlappedLayer.h"
+#include "MyGUI_PickGrid.h"
 
 namespace MyGUI
 {
 
+	// children count starting from which pick grid is used
+	const size_t PICK_GRID_MIN_CHILDS = 32;
+
 	Widget::Widget() :
 		mWidgetClient(nullptr),
+		mPickGrid(nullptr),
 		mEnabled(true),
 		mInheritedEnabled(true),
 		mInheritedVisible(true),
@@ -45,6 +52,16 @@ namespace MyGUI
 	{
 	}
 
+	void* Widget::operator new(size_t _size)
+	{
+		return WidgetAllocator::allocate(_size);
+	}
+
+	void Widget::operator delete(void* _pointer)
+	{
+		WidgetAllocator::deallocate(_pointer);
+	}
+
 	void Widget::_initialise(WidgetStyle _style, const IntCoord& _coord, const std::string& _skinName, Widget* _parent, ICroppedRectangle* _croppedParent, const std::string& _name)
 	{
 		ResourceSkin* skinInfo = nullptr;
@@ -133,6 +150,9 @@ namespace MyGUI
 
 		_destroyAllChildWidget();
 
+		delete mPickGrid;
+		mPickGrid = nullptr;
+
 		// дочернее окно обыкновенное
 		if (mWidgetStyle == WidgetStyle::Child)
 		{
@@ -277,6 +297,7 @@ namespace MyGUI
 		{
 			// Добавляем себя чтобы удалилось
 			mWidgetChild.push_back(*iter);
+			_pickGridOutOfDate();
 			_destroyChildWidget(*iter);
 		}
 		mWidgetChildSkin.clear();
@@ -393,6 +414,7 @@ namespace MyGUI
 
 			// удаляем из списка
 			mWidgetChild.erase(iter);
+			_pickGridOutOfDate();
 
 			// отписываем от всех
 			WidgetManager::getInstance().unlinkFromUnlinkers(_widget);
@@ -415,6 +437,7 @@ namespace MyGUI
 			// сразу себя отписывем, иначе вложенной удаление убивает все
 			Widget* widget = mWidgetChild.back();
 			mWidgetChild.pop_back();
+			_pickGridOutOfDate();
 
 			// отписываем от всех
 			manager.unlinkFromUnlinkers(widget);
@@ -474,15 +497,39 @@ namespace MyGUI
 			return nullptr;
 
 		// спрашиваем у детишек
-		for (VectorWidgetPtr::const_reverse_iterator widget = mWidgetChild.rbegin(); widget != mWidgetChild.rend(); ++widget)
+		if (mWidgetChild.size() >= PICK_GRID_MIN_CHILDS && _isPickGridEnabled())
+		{
+			// grid is created only for widgets with many children
+			if (mPickGrid == nullptr)
+				mPickGrid = new PickGrid();
+			if (mPickGrid->isOutOfDate())
+				mPickGrid->build(mWidgetChild);
+
+			// only children that may contain point, in the same order
+			const std::vector<size_t>& indexes = mPickGrid->getItemsByPoint(_left - mCoord.left, _top - mCoord.top);
+			for (std::vector<size_t>::const_reverse_iterator index = indexes.rbegin(); index != indexes.rend(); ++index)
+			{
+				Widget* widget = mWidgetChild[*index];
+				if (widget->mWidgetStyle == WidgetStyle::Popup)
+					continue;
+
+				ILayerItem* item = widget->getLayerItemByPoint(_left - mCoord.left, _top - mCoord.top);
+				if (item != nullptr)
+					return item;
+			}
+		}
+		else
 		{
-			// общаемся только с послушными детьми
-			if ((*widget)->mWidgetStyle == WidgetStyle::Popup)
-				continue;
+			for (VectorWidgetPtr::const_reverse_iterator widget = mWidgetChild.rbegin(); widget != mWidgetChild.rend(); ++widget)
+			{
+				// общаемся только с послушными детьми
+				if ((*widget)->mWidgetStyle == WidgetStyle::Popup)
+					continue;
 
-			ILayerItem* item = (*widget)->getLayerItemByPoint(_left - mCoord.left, _top - mCoord.top);
-			if (item != nullptr)
-				return item;
+				ILayerItem* item = (*widget)->getLayerItemByPoint(_left - mCoord.left, _top - mCoord.top);
+				if (item != nullptr)
+					return item;
+			}
 		}
 		// спрашиваем у детишек скина
 		for (VectorWidgetPtr::const_reverse_iterator widget = mWidgetChildSkin.rbegin(); widget != mWidgetChildSkin.rend(); ++widget)
@@ -496,6 +543,43 @@ namespace MyGUI
 		return getInheritsPick() ? nullptr : const_cast<Widget*>(this);
 	}
 
+	bool Widget::_isPickGridEnabled() const
+	{
+		// only root widget is attached to layer
+		const Widget* root = this;
+		while (root->getLayer() == nullptr && root->mParent != nullptr)
+			root = root->mParent;
+
+		ILayer* layer = root->getLayer();
+		if (layer == nullptr)
+			return false;
+
+		OverlappedLayer* overlapped = layer->castType<OverlappedLayer>(false);
+		return overlapped != nullptr && overlapped->getPickGrid();
+	}
+
+	void Widget::_pickGridOutOfDate()
+	{
+		if (mPickGrid == nullptr)
+			return;
+
+		if (mWidgetChild.size() < PICK_GRID_MIN_CHILDS)
+		{
+			delete mPickGrid;
+			mPickGrid = nullptr;
+		}
+		else
+		{
+			mPickGrid->outOfDate();
+		}
+	}
+
+	void Widget::_pickGridUpdateItem(Widget* _widget)
+	{
+		if (mPickGrid != nullptr)
+			mPickGrid->updateItem(_widget);
+	}
+
 	void Widget::_updateAbsolutePoint()
 	{
 		// мы рут, нам не надо
@@ -512,6 +596,35 @@ namespace MyGUI
 		_correctSkinItemView();
 	}
 
+	void Widget::_translateAbsolutePoint()
+	{
+		if (!mCroppedParent)
+			return;
+
+		// overlapped child has its own layer node and its vertices are not relative to moved root
+		if (mWidgetStyle == WidgetStyle::Overlapped)
+		{
+			_updateAbsolutePoint();
+			return;
+		}
+
+		mAbsolutePosition = mCroppedParent->getAbsolutePosition() + mCoord.point();
+
+		for (VectorWidgetPtr::iterator widget = mWidgetChild.begin(); widget != mWidgetChild.end(); ++widget)
+			(*widget)->_translateAbsolutePoint();
+		for (VectorWidgetPtr::iterator widget = mWidgetChildSkin.begin(); widget != mWidgetChildSkin.end(); ++widget)
+			(*widget)->_translateAbsolutePoint();
+	}
+
+	bool Widget::_isPixelSpaceRoot() const
+	{
+		if (mCroppedParent != nullptr || getLayerNode() == nullptr)
+			return false;
+
+		LayerNode* node = getLayerNode()->castType<LayerNode>(false);
+		return node != nullptr && node->getPixelSpace();
+	}
+
 	void Widget::_forcePick(Widget* _widget)
 	{
 		if (mWidgetClient != nullptr)
@@ -634,6 +747,25 @@ namespace MyGUI
 		// обновляем абсолютные координаты
 		mAbsolutePosition += _point - mCoord.point();
 
+		// vertices of pixel space layer node are relative to its root, only origin of node is changed
+		if (_isPixelSpaceRoot())
+		{
+			for (VectorWidgetPtr::iterator widget = mWidgetChild.begin(); widget != mWidgetChild.end(); ++widget)
+				(*widget)->_translateAbsolutePoint();
+			for (VectorWidgetPtr::iterator widget = mWidgetChildSkin.begin(); widget != mWidgetChildSkin.end(); ++widget)
+				(*widget)->_translateAbsolutePoint();
+
+			mCoord = _point;
+
+			getLayerNode()->outOfDate(nullptr);
+
+			if (mParent != nullptr)
+				mParent->_pickGridUpdateItem(this);
+
+			eventChangeCoord(this);
+			return;
+		}
+
 		for (VectorWidgetPtr::iterator widget = mWidgetChild.begin(); widget != mWidgetChild.end(); ++widget)
 			(*widget)->_updateAbsolutePoint();
 		for (VectorWidgetPtr::iterator widget = mWidgetChildSkin.begin(); widget != mWidgetChildSkin.end(); ++widget)
@@ -643,6 +775,9 @@ namespace MyGUI
 
 		_updateView();
 
+		if (mParent != nullptr)
+			mParent->_pickGridUpdateItem(this);
+
 		eventChangeCoord(this);
 	}
 
@@ -680,6 +815,9 @@ namespace MyGUI
 		// запоминаем текущее состояние
 		mIsMargin = margin;
 
+		if (mParent != nullptr)
+			mParent->_pickGridUpdateItem(this);
+
 		eventChangeCoord(this);
 	}
 
@@ -725,6 +863,9 @@ namespace MyGUI
 		// запоминаем текущее состояние
 		mIsMargin = margin;
 
+		if (mParent != nullptr)
+			mParent->_pickGridUpdateItem(this);
+
 		eventChangeCoord(this);
 	}
 
@@ -1049,6 +1190,7 @@ namespace MyGUI
 		VectorWidgetPtr::iterator iter = std::remove(mWidgetChild.begin(), mWidgetChild.end(), _widget);
 		MYGUI_ASSERT(iter != mWidgetChild.end(), "widget not found");
 		mWidgetChild.erase(iter);
+		_pickGridOutOfDate();
 	}
 
 	void Widget::shutdownOverride()
@@ -1373,6 +1515,8 @@ namespace MyGUI
 
 		int depth = _widget->getDepth();
 
+		_pickGridOutOfDate();
+
 		for (size_t index = 0; index < mWidgetChild.size(); ++index)
 		{
 			Widget* widget = mWidgetChild[index];
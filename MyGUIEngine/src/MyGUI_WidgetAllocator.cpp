@@ -0,0 +1,200 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_Precompiled.h"
+#include "MyGUI_WidgetAllocator.h"
+#include <new>
+
+namespace MyGUI
+{
+
+	namespace
+	{
+
+		const size_t BLOCK_ALIGN = 16;
+#ifdef MYGUI_DISABLE_WIDGET_POOL
+		// every object is allocated directly from heap, so memory checkers see each of them
+		const size_t MAX_POOL_BLOCK_SIZE = 0;
+#else
+		// bigger objects are allocated directly from heap
+		const size_t MAX_POOL_BLOCK_SIZE = 4096;
+#endif
+		const size_t POOL_PAGE_SIZE = 16384;
+
+		size_t alignSize(size_t _size)
+		{
+			return (_size + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+		}
+
+		// placed before every object
+		struct BlockHeader
+		{
+			// index of free list, 0 if object is allocated directly from heap
+			size_t pool;
+		};
+
+		// every page starts with pointer to next page of the same pool
+		struct PageHeader
+		{
+			PageHeader* next;
+		};
+
+		const size_t HEADER_SIZE = (sizeof(BlockHeader) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+		const size_t PAGE_HEADER_SIZE = (sizeof(PageHeader) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct Pool
+		{
+			FreeBlock* freeList;
+			PageHeader* pages;
+			size_t pageCount;
+			size_t blocks;
+			size_t freeBlocks;
+		};
+
+		// plain data only, so allocator works even for objects destroyed during static destruction
+		Pool gPools[MAX_POOL_BLOCK_SIZE / BLOCK_ALIGN + 1];
+		size_t gLiveObjects = 0;
+		size_t gAllocations = 0;
+
+		PageHeader* allocatePage(size_t _size, PageHeader* _next)
+		{
+			PageHeader* page = static_cast<PageHeader*>(::operator new(_size));
+			page->next = _next;
+			return page;
+		}
+
+		void releasePages(PageHeader* _page)
+		{
+			while (_page != nullptr)
+			{
+				PageHeader* next = _page->next;
+				::operator delete(_page);
+				_page = next;
+			}
+		}
+
+		char* allocatePool(size_t _index)
+		{
+			Pool& pool = gPools[_index];
+			if (pool.freeList == nullptr)
+			{
+				size_t blockSize = _index * BLOCK_ALIGN;
+				size_t count = (std::max)((POOL_PAGE_SIZE - PAGE_HEADER_SIZE) / blockSize, (size_t)4);
+
+				pool.pages = allocatePage(PAGE_HEADER_SIZE + count * blockSize, pool.pages);
+				pool.pageCount ++;
+				pool.blocks += count;
+				pool.freeBlocks += count;
+
+				// blocks are linked in address order, so objects created one after another are neighbours
+				char* data = reinterpret_cast<char*>(pool.pages) + PAGE_HEADER_SIZE;
+				for (size_t index = count; index > 0; --index)
+				{
+					FreeBlock* block = reinterpret_cast<FreeBlock*>(data + (index - 1) * blockSize);
+					block->next = pool.freeList;
+					pool.freeList = block;
+				}
+			}
+
+			FreeBlock* block = pool.freeList;
+			pool.freeList = block->next;
+			pool.freeBlocks --;
+			return reinterpret_cast<char*>(block);
+		}
+
+	}
+
+	void* WidgetAllocator::allocate(size_t _size)
+	{
+		size_t size = HEADER_SIZE + alignSize(_size);
+
+		char* block = nullptr;
+		BlockHeader header = { 0 };
+		if (size <= MAX_POOL_BLOCK_SIZE)
+		{
+			header.pool = size / BLOCK_ALIGN;
+			block = allocatePool(header.pool);
+		}
+		else
+		{
+			block = static_cast<char*>(::operator new(size));
+		}
+
+		*reinterpret_cast<BlockHeader*>(block) = header;
+		gLiveObjects ++;
+		gAllocations ++;
+
+		return block + HEADER_SIZE;
+	}
+
+	void WidgetAllocator::deallocate(void* _pointer)
+	{
+		if (_pointer == nullptr)
+			return;
+
+		char* block = static_cast<char*>(_pointer) - HEADER_SIZE;
+		const BlockHeader& header = *reinterpret_cast<BlockHeader*>(block);
+		gLiveObjects --;
+
+		if (header.pool != 0)
+		{
+			Pool& pool = gPools[header.pool];
+			FreeBlock* free = reinterpret_cast<FreeBlock*>(block);
+			free->next = pool.freeList;
+			pool.freeList = free;
+			pool.freeBlocks ++;
+		}
+		else
+		{
+			::operator delete(block);
+		}
+	}
+
+	void WidgetAllocator::trim()
+	{
+		for (size_t index = 0; index < sizeof(gPools) / sizeof(gPools[0]); ++index)
+		{
+			Pool& pool = gPools[index];
+			if (pool.pages == nullptr || pool.freeBlocks != pool.blocks)
+				continue;
+
+			releasePages(pool.pages);
+			pool.freeList = nullptr;
+			pool.pages = nullptr;
+			pool.pageCount = 0;
+			pool.blocks = 0;
+			pool.freeBlocks = 0;
+		}
+	}
+
+	WidgetAllocatorStats WidgetAllocator::getStats()
+	{
+		WidgetAllocatorStats result;
+
+		for (size_t index = 0; index < sizeof(gPools) / sizeof(gPools[0]); ++index)
+		{
+			const Pool& pool = gPools[index];
+			if (pool.pages == nullptr)
+				continue;
+
+			result.poolCount ++;
+			result.poolPages += pool.pageCount;
+			result.poolBlocks += pool.blocks;
+			result.poolFreeBlocks += pool.freeBlocks;
+		}
+
+		result.liveObjects = gLiveObjects;
+		result.allocations = gAllocations;
+
+		return result;
+	}
+
+} // namespace MyGUI
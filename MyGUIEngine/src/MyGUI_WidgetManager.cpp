@@ -9,6 +9,7 @@
 #include "MyGUI_Gui.h"
 #include "MyGUI_Widget.h"
 #include "MyGUI_FactoryManager.h"
+#include "MyGUI_Profiler.h"
 
 #include "MyGUI_Button.h"
 #include "MyGUI_Canvas.h"
@@ -92,6 +93,7 @@ namespace MyGUI
 
 		Gui::getInstance().eventFrameStart -= newDelegate(this, &WidgetManager::notifyEventFrameStart);
 		_deleteDelayWidgets();
+		WidgetAllocator::trim();
 
 		mVectorIUnlinkWidget.clear();
 
@@ -161,6 +163,11 @@ namespace MyGUI
 		return false;
 	}
 
+	WidgetAllocatorStats WidgetManager::getAllocatorStats() const
+	{
+		return WidgetAllocator::getStats();
+	}
+
 	void WidgetManager::notifyEventFrameStart(float _time)
 	{
 		_deleteDelayWidgets();
@@ -184,6 +191,8 @@ namespace MyGUI
 	{
 		if (!mDestroyWidgets.empty())
 		{
+			MYGUI_PROFILE_SCOPE("WidgetManager::_deleteDelayWidgets");
+
 			for (VectorWidgetPtr::iterator entry = mDestroyWidgets.begin(); entry != mDestroyWidgets.end(); ++entry)
 				delete (*entry);
 			mDestroyWidgets.clear();
@@ -15,47 +15,104 @@ namespace MyGUI
 
 		namespace utility
 		{
-			static std::string convert_from_xml(const std::string& _string, bool& _ok)
+			// Same as std::find, but memchr is usually much faster on long ranges.
+			static const char* find(const char* _begin, const char* _end, char _char)
 			{
-				std::string ret;
-				_ok = true;
+				const void* result = memchr(_begin, _char, _end - _begin);
+				return result != nullptr ? static_cast<const char*>(result) : _end;
+			}
 
-				size_t pos = _string.find("&");
-				if (pos == std::string::npos) return _string;
+			// Same as find, for short ranges where memchr call costs more than the search.
+			static const char* findShort(const char* _begin, const char* _end, char _char)
+			{
+				while (_begin != _end && *_begin != _char)
+					++_begin;
+				return _begin;
+			}
 
-				ret.reserve(_string.size());
-				size_t old = 0;
-				while (pos != std::string::npos)
+			// Decodes xml entities in [_begin, _end) and stores the result in _result.
+			static bool convert_from_xml(const char* _begin, const char* _end, std::string& _result)
+			{
+				const char* pos = findShort(_begin, _end, '&');
+				if (pos == _end)
 				{
-					ret += _string.substr(old, pos - old);
+					_result.assign(_begin, _end);
+					return true;
+				}
 
-					size_t end = _string.find(";", pos + 1);
-					if (end == std::string::npos)
-					{
-						_ok = false;
-						return ret;
-					}
+				_result.clear();
+				_result.reserve(_end - _begin);
+				const char* old = _begin;
+				while (pos != _end)
+				{
+					_result.append(old, pos);
+
+					const char* end = find(pos + 1, _end, ';');
+					if (end == _end)
+						return false;
+
+					size_t size = end - pos + 1;
+					if (size == 5 && memcmp(pos, "&amp;", 5) == 0) _result += '&';
+					else if (size == 4 && memcmp(pos, "&lt;", 4) == 0) _result += '<';
+					else if (size == 4 && memcmp(pos, "&gt;", 4) == 0) _result += '>';
+					else if (size == 6 && memcmp(pos, "&apos;", 6) == 0) _result += '\'';
+					else if (size == 6 && memcmp(pos, "&quot;", 6) == 0) _result += '\"';
 					else
-					{
-						std::string tag = _string.substr(pos, end - pos + 1);
-						if (tag == "&amp;") ret += '&';
-						else if (tag == "&lt;") ret += '<';
-						else if (tag == "&gt;") ret += '>';
-						else if (tag == "&apos;") ret += '\'';
-						else if (tag == "&quot;") ret += '\"';
-						else
-						{
-							_ok = false;
-							return ret;
-						}
-					}
+						return false;
 
 					old = end + 1;
-					pos = _string.find("&", old);
+					pos = find(old, _end, '&');
 				}
-				ret += _string.substr(old, std::string::npos);
+				_result.append(old, _end);
 
-				return ret;
+				return true;
+			}
+
+			static bool isSpace(char _char)
+			{
+				return _char == ' ' || _char == '\t';
+			}
+
+			// Trims spaces, tabs and carriage returns, same as MyGUI::utility::trim.
+			static void trim(const char*& _begin, const char*& _end)
+			{
+				while (_begin != _end && (isSpace(*_begin) || *_begin == '\r'))
+					++_begin;
+				while (_begin != _end && (isSpace(*(_end - 1)) || *(_end - 1) == '\r'))
+					--_end;
+			}
+
+			// Finds the character, skipping parts in double quotes. Returns _end if not found.
+			// Ranges between tags and inside them are short, so one pass is faster than memchr calls.
+			static const char* findUnquoted(const char* _begin, const char* _end, char _char)
+			{
+				for (const char* pos = _begin; pos != _end; ++pos)
+				{
+					if (*pos == _char)
+						return pos;
+					if (*pos == '"')
+					{
+						pos = findShort(pos + 1, _end, '"');
+						if (pos == _end)
+							return _end;
+					}
+				}
+				return _end;
+			}
+
+			// Converts offset in joined lines to line number (from one) and column.
+			static void findLocation(const std::vector<size_t>& _lines, size_t _offset, size_t& _line, size_t& _col)
+			{
+				_line = std::upper_bound(_lines.begin(), _lines.end(), _offset) - _lines.begin();
+				_col = _line != 0 ? _offset - _lines[_line - 1] : 0;
+			}
+
+			// Finds the first single or double quote. Returns _end if not found.
+			static const char* findQuote(const char* _begin, const char* _end)
+			{
+				while (_begin != _end && *_begin != '"' && *_begin != '\'')
+					++_begin;
+				return _begin;
 			}
 
 			static std::string convert_to_xml(const std::string& _string)
@@ -87,6 +144,163 @@ namespace MyGUI
 
 		}
 
+		namespace binary
+		{
+			// Starts with a zero byte, so it can't be confused with a text document.
+			const char signature[8] = { '\0', 'M', 'y', 'G', 'U', 'I', 'X', 'B' };
+			const uint32 version = 2;
+
+			// Compiled document is signature and header, then records of strings, elements and attributes,
+			// then data of strings, each ends with zero. Numbers are little endian uint32 and records refer
+			// to each other by index only, so the whole document can be used in place.
+			enum HeaderField
+			{
+				HeaderVersion,
+				HeaderStringCount,
+				HeaderElementCount,
+				HeaderAttributeCount,
+				HeaderDeclaration,
+				HeaderRoot,
+				HeaderStringDataSize,
+				HeaderFieldCount
+			};
+
+			enum StringField
+			{
+				StringOffset,
+				StringSize,
+				StringFieldCount
+			};
+
+			// Elements are stored in breadth first order, so children and attributes of element are consecutive.
+			enum ElementField
+			{
+				ElementName,
+				ElementTypeValue,
+				ElementContent,
+				ElementFirstAttribute,
+				ElementAttributeCount,
+				ElementFirstChild,
+				ElementChildCount,
+				ElementFieldCount
+			};
+
+			const size_t maxNumbers = 4;
+
+			enum AttributeField
+			{
+				AttributeName,
+				AttributeValue,
+				AttributeValueType,
+				AttributeNumberCount,
+				AttributeNumbers,
+				AttributeFieldCount = AttributeNumbers + maxNumbers
+			};
+
+			enum ValueType
+			{
+				ValueString,
+				ValueInt,
+				ValueFloat,
+				ValueColour,
+				ValueTypeCount
+			};
+
+			static_assert(StringFieldCount == 2 && ElementFieldCount == 7 && AttributeFieldCount == 8, "record sizes are used by CompiledDocument");
+
+			const size_t headerSize = sizeof(signature) + HeaderFieldCount * 4;
+			const uint32 noIndex = 0xFFFFFFFF;
+
+			// Elements are destroyed and saved recursively, so Element tree can't be nested deeper.
+			const size_t maxDepth = 512;
+
+			inline uint32 readUInt(const char* _data)
+			{
+				const uint8* data = reinterpret_cast<const uint8*>(_data);
+				return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24);
+			}
+
+			void writeUInt(std::ostream& _stream, uint32 _value)
+			{
+				for (size_t index = 0; index < 4; ++index)
+					_stream.put((char)((_value >> (index * 8)) & 0xFF));
+			}
+
+			uint32 floatToUInt(float _value)
+			{
+				uint32 result;
+				memcpy(&result, &_value, sizeof(result));
+				return result;
+			}
+
+			float uintToFloat(uint32 _value)
+			{
+				float result;
+				memcpy(&result, &_value, sizeof(result));
+				return result;
+			}
+
+			// Index of every distinct string in the document.
+			typedef std::map<std::string, uint32> StringTable;
+
+			uint32 addString(const std::string& _value, StringTable& _strings)
+			{
+				return _strings.insert(StringTable::value_type(_value, (uint32)_strings.size())).first->second;
+			}
+
+			template <typename Type>
+			bool parseNumber(const std::string& _value, Type& _result)
+			{
+				std::istringstream stream(_value);
+				stream >> _result;
+				return !stream.fail() && stream.get() == std::char_traits<char>::eof();
+			}
+
+			// Values are parsed the same way as utility::parseValue and Colour::parse do it, so loaders
+			// that use numbers get what they would get from the string.
+			ValueType parseValue(const std::string& _value, uint32& _count, uint32* _numbers)
+			{
+				_count = 0;
+				if (_value.size() == 7 && _value[0] == '#' && _value.find_first_not_of("0123456789abcdefABCDEF", 1) == std::string::npos)
+				{
+					Colour colour = Colour::parse(_value);
+					_numbers[0] = floatToUInt(colour.red);
+					_numbers[1] = floatToUInt(colour.green);
+					_numbers[2] = floatToUInt(colour.blue);
+					_numbers[3] = floatToUInt(colour.alpha);
+					_count = 4;
+					return ValueColour;
+				}
+
+				std::vector<std::string> items = MyGUI::utility::split(_value, " \t");
+				if (items.empty() || items.size() > maxNumbers)
+					return ValueString;
+
+				bool integer = true;
+				for (size_t index = 0; index < items.size() && integer; ++index)
+				{
+					int number;
+					integer = parseNumber(items[index], number);
+					_numbers[index] = (uint32)number;
+				}
+
+				if (!integer)
+				{
+					for (size_t index = 0; index < items.size(); ++index)
+					{
+						float number;
+						if (!parseNumber(items[index], number))
+							return ValueString;
+						_numbers[index] = floatToUInt(number);
+					}
+				}
+
+				_count = (uint32)items.size();
+				return integer ? ValueInt : ValueFloat;
+			}
+
+		}
+
 		//----------------------------------------------------------------------//
 		// class ElementEnumerator
 		//----------------------------------------------------------------------//
@@ -141,7 +355,8 @@ namespace MyGUI
 			mName(_name),
 			mContent(_content),
 			mParent(_parent),
-			mType(_type)
+			mType(_type),
+			mInArena(false)
 		{
 		}
 
@@ -149,11 +364,19 @@ namespace MyGUI
 		{
 			for (VectorElement::iterator iter = mChilds.begin(); iter != mChilds.end(); ++iter)
 			{
-				delete *iter;
+				destroy(*iter);
 			}
 			mChilds.clear();
 		}
 
+		void Element::destroy(ElementPtr _element)
+		{
+			if (_element->mInArena)
+				_element->~Element();
+			else
+				delete _element;
+		}
+
 		void Element::save(std::ostream& _stream, size_t _level)
 		{
 			// сначала табуляции намутим
@@ -230,14 +453,14 @@ namespace MyGUI
 			VectorElement::iterator item = std::find(mChilds.begin(), mChilds.end(), _child);
 			if (item != mChilds.end())
 			{
-				delete (*item);
+				destroy(*item);
 				mChilds.erase(item);
 			}
 		}
 
 		void Element::clear()
 		{
-			for (VectorElement::iterator iter = mChilds.begin(); iter != mChilds.end(); ++iter) delete *iter;
+			for (VectorElement::iterator iter = mChilds.begin(); iter != mChilds.end(); ++iter) destroy(*iter);
 			mChilds.clear();
 			mContent.clear();
 			mAttributes.clear();
@@ -366,7 +589,7 @@ namespace MyGUI
 		}
 		inline void open_stream(std::ifstream& _stream, const std::wstring& _wide)
 		{
-			_stream.open(_wide.c_str());
+			_stream.open(_wide.c_str(), std::ios_base::binary);
 		}
 #else
 		inline void open_stream(std::ofstream& _stream, const std::wstring& _wide)
@@ -375,7 +598,7 @@ namespace MyGUI
 		}
 		inline void open_stream(std::ifstream& _stream, const std::wstring& _wide)
 		{
-			_stream.open(UString(_wide).asUTF8_c_str());
+			_stream.open(UString(_wide).asUTF8_c_str(), std::ios_base::binary);
 		}
 #endif
 
@@ -385,6 +608,8 @@ namespace MyGUI
 		Document::Document():
 			mRoot(nullptr),
 			mDeclaration(nullptr),
+			mElementBlockSize(0),
+			mElementBlockUsed(0),
 			mLastErrorFile(""),
 			mLine(0),
 			mCol(0)
@@ -400,7 +625,7 @@ namespace MyGUI
 		bool Document::open(const std::string& _filename)
 		{
 			std::ifstream stream;
-			stream.open(_filename.c_str());
+			stream.open(_filename.c_str(), std::ios_base::binary);
 
 			if (!stream.is_open())
 			{
@@ -497,37 +722,104 @@ namespace MyGUI
 		{
 			clear();
 
-			// это текущая строка для разбора
-			std::string line;
-			// это строка из файла
-			std::string read;
+			std::string data(_stream->size(), '\0');
+			if (!data.empty())
+				data.resize(_stream->read(&data[0], data.size()));
+
+			if (CompiledDocument::isCompiled(data.data(), data.size()))
+			{
+				CompiledDocument document;
+				if (!document.open(data.data(), data.size()))
+				{
+					mLastError = ErrorType::IncorrectContent;
+					return false;
+				}
+				return open(document);
+			}
+
+			return parseText(data);
+		}
+
+		bool Document::parseText(std::string& _data)
+		{
+			// The format has always been parsed line by line with line breaks dropped, so lines are joined in place first.
+			// Start offset of every joined line is kept for error reporting.
+			std::vector<size_t> lines;
+			lines.reserve(_data.size() / 32 + 1);
+			size_t size = 0;
+			size_t start = 0;
+			while (start < _data.size())
+			{
+				size_t end = _data.find('\n', start);
+				if (end == std::string::npos)
+					end = _data.size();
+				size_t next = end + 1;
+				if (end != start && _data[end - 1] == '\r')
+					--end;
+
+				lines.push_back(size);
+				if (size != start)
+					memmove(&_data[size], &_data[start], end - start);
+				size += end - start;
+				start = next;
+			}
+
+			const char* begin = _data.data();
+			const char* end = begin + size;
+			const char* position = begin;
+
 			// текущий узел для разбора
 			ElementPtr currentNode = nullptr;
 
-			while (!_stream->eof())
+			while (true)
 			{
-				// берем новую строку
-				_stream->readline(read, '\n');
-				if (read.empty())
-					continue;
-				if (read[read.size() - 1] == '\r')
-					read.erase(read.size() - 1, 1);
-				if (read.empty())
-					continue;
+				// сначала ищем по угловым скобкам
+				const char* tagStart = utility::findUnquoted(position, end, '<');
+				if (tagStart == end)
+					break;
+				const char* tagEnd;
 
-				mLine ++;
-				mCol = 0; // потом проверить на многострочных тэгах
+				// пытаемся вырезать многострочный коментарий
+				if ((end - tagStart > 3) && (tagStart[1] == '!') && (tagStart[2] == '-') && (tagStart[3] == '-'))
+				{
+					static const char commentEnd[] = "-->";
+					tagEnd = std::search(tagStart + 4, end, commentEnd, commentEnd + 3);
+					if (tagEnd == end)
+						break;
+					tagEnd += 2;
+				}
+				else
+				{
+					tagEnd = utility::findUnquoted(tagStart + 1, end, '>');
+					if (tagEnd == end)
+						break;
+				}
 
-				// текущая строка для разбора и то что еще прочитали
-				line += read;
+				// проверяем на наличее тела
+				const char* body = position;
+				while (body != tagStart && (utility::isSpace(*body) || *body == '<'))
+					++body;
+				if (body != tagStart && currentNode != nullptr)
+				{
+					if (!utility::convert_from_xml(position, tagStart, currentNode->mContent))
+					{
+						mLastError = ErrorType::IncorrectContent;
+						utility::findLocation(lines, tagStart - begin, mLine, mCol);
+						return false;
+					}
+				}
 
-				if (!parseLine(line, currentNode))
+				// парсим наш тэг
+				if (!parseTag(currentNode, tagStart + 1, tagEnd))
 				{
+					utility::findLocation(lines, tagEnd - begin, mLine, mCol);
 					return false;
 				}
 
-			} // while (!stream.eof())
+				position = tagEnd + 1;
+			}
 
+			mLine = lines.size();
 			if (currentNode)
 			{
 				mLastError = ErrorType::NotClosedElements;
@@ -537,6 +829,143 @@ namespace MyGUI
 			return true;
 		}
 
+		bool Document::open(const CompiledDocument& _document)
+		{
+			clear();
+
+			if (_document.getDepth() > binary::maxDepth)
+			{
+				mLastError = ErrorType::TooDeepNesting;
+				return false;
+			}
+
+			// elements are created in the same breadth first order as they are stored
+			typedef std::pair<CompiledElement, ElementPtr> PairElement;
+			std::vector<PairElement> elements;
+			CompiledElement top[2] = { _document.getDeclaration(), _document.getRoot() };
+			for (size_t index = 0; index < 2; ++index)
+			{
+				if (!top[index].isValid())
+					continue;
+
+				ElementPtr element = createElement(nullptr, top[index].getType());
+				if (index == 0)
+					mDeclaration = element;
+				else
+					mRoot = element;
+				elements.push_back(PairElement(top[index], element));
+			}
+
+			for (size_t index = 0; index < elements.size(); ++index)
+			{
+				CompiledElement source = elements[index].first;
+				ElementPtr element = elements[index].second;
+				element->mName = source.getName();
+				element->mContent = source.getContent();
+
+				element->mAttributes.reserve(source.getAttributeCount());
+				for (size_t attribute = 0; attribute < source.getAttributeCount(); ++attribute)
+				{
+					CompiledAttribute value = source.getAttributeAt(attribute);
+					element->mAttributes.push_back(PairAttribute(value.getName(), value.getValue()));
+				}
+
+				element->mChilds.reserve(source.getChildCount());
+				for (size_t child = 0; child < source.getChildCount(); ++child)
+				{
+					CompiledElement item = source.getChildAt(child);
+					elements.push_back(PairElement(item, createElement(element, item.getType())));
+				}
+			}
+
+			return true;
+		}
+
+		bool Document::saveBinary(std::ostream& _stream)
+		{
+			if (!mDeclaration)
+			{
+				mLastError = ErrorType::NoXMLDeclaration;
+				return false;
+			}
+
+			// breadth first order, children of every element are consecutive
+			std::vector<ElementPtr> elements;
+			elements.push_back(mDeclaration);
+			if (mRoot)
+				elements.push_back(mRoot);
+			for (size_t index = 0; index < elements.size(); ++index)
+				elements.insert(elements.end(), elements[index]->mChilds.begin(), elements[index]->mChilds.end());
+
+			binary::StringTable strings;
+			std::vector<uint32> elementRecords;
+			elementRecords.reserve(elements.size() * binary::ElementFieldCount);
+			std::vector<uint32> attributeRecords;
+			uint32 attributeCount = 0;
+			uint32 childCount = (uint32)(mRoot ? 2 : 1);
+			for (std::vector<ElementPtr>::const_iterator iter = elements.begin(); iter != elements.end(); ++iter)
+			{
+				ElementPtr element = *iter;
+				elementRecords.push_back(binary::addString(element->mName, strings));
+				elementRecords.push_back((uint32)element->mType.getValue());
+				elementRecords.push_back(binary::addString(element->mContent, strings));
+				elementRecords.push_back(attributeCount);
+				elementRecords.push_back((uint32)element->mAttributes.size());
+				elementRecords.push_back(childCount);
+				elementRecords.push_back((uint32)element->mChilds.size());
+				attributeCount += (uint32)element->mAttributes.size();
+				childCount += (uint32)element->mChilds.size();
+
+				for (VectorAttributes::const_iterator attribute = element->mAttributes.begin(); attribute != element->mAttributes.end(); ++attribute)
+				{
+					uint32 numbers[binary::maxNumbers] = { 0, 0, 0, 0 };
+					uint32 count = 0;
+					binary::ValueType type = binary::parseValue(attribute->second, count, numbers);
+
+					attributeRecords.push_back(binary::addString(attribute->first, strings));
+					attributeRecords.push_back(binary::addString(attribute->second, strings));
+					attributeRecords.push_back((uint32)type);
+					attributeRecords.push_back(count);
+					attributeRecords.insert(attributeRecords.end(), numbers, numbers + binary::maxNumbers);
+				}
+			}
+
+			std::vector<const std::string*> table(strings.size());
+			for (binary::StringTable::const_iterator iter = strings.begin(); iter != strings.end(); ++iter)
+				table[iter->second] = &iter->first;
+
+			uint32 stringDataSize = 0;
+			for (std::vector<const std::string*>::const_iterator iter = table.begin(); iter != table.end(); ++iter)
+				stringDataSize += (uint32)(*iter)->size() + 1;
+
+			_stream.write(binary::signature, sizeof(binary::signature));
+			binary::writeUInt(_stream, binary::version);
+			binary::writeUInt(_stream, (uint32)table.size());
+			binary::writeUInt(_stream, (uint32)elements.size());
+			binary::writeUInt(_stream, attributeCount);
+			binary::writeUInt(_stream, 0);
+			binary::writeUInt(_stream, mRoot ? 1 : binary::noIndex);
+			binary::writeUInt(_stream, stringDataSize);
+
+			uint32 offset = 0;
+			for (std::vector<const std::string*>::const_iterator iter = table.begin(); iter != table.end(); ++iter)
+			{
+				binary::writeUInt(_stream, offset);
+				binary::writeUInt(_stream, (uint32)(*iter)->size());
+				offset += (uint32)(*iter)->size() + 1;
+			}
+
+			for (std::vector<uint32>::const_iterator iter = elementRecords.begin(); iter != elementRecords.end(); ++iter)
+				binary::writeUInt(_stream, *iter);
+			for (std::vector<uint32>::const_iterator iter = attributeRecords.begin(); iter != attributeRecords.end(); ++iter)
+				binary::writeUInt(_stream, *iter);
+
+			for (std::vector<const std::string*>::const_iterator iter = table.begin(); iter != table.end(); ++iter)
+				_stream.write((*iter)->c_str(), (*iter)->size() + 1);
+
+			return _stream.good();
+		}
+
 		bool Document::save(std::ostream& _stream)
 		{
 			if (!mDeclaration)
@@ -561,25 +990,55 @@ namespace MyGUI
 		{
 			clearDeclaration();
 			clearRoot();
+			clearElements();
 			mLine = 0;
 			mCol = 0;
 		}
 
-		bool Document::parseTag(ElementPtr& _currentNode, std::string _content)
+		ElementPtr Document::createElement(ElementPtr _parent, ElementType _type)
+		{
+			if (mElementBlockUsed == mElementBlockSize)
+			{
+				// small documents are common, so blocks grow
+				mElementBlockSize = mElementBlocks.empty() ? 32 : (std::min)(mElementBlockSize * 2, (size_t)1024);
+				mElementBlocks.push_back(static_cast<Element*>(::operator new(mElementBlockSize * sizeof(Element))));
+				mElementBlockUsed = 0;
+			}
+
+			ElementPtr element = new (mElementBlocks.back() + mElementBlockUsed) Element("", _parent, _type);
+			element->mInArena = true;
+			++mElementBlockUsed;
+
+			if (_parent != nullptr)
+				_parent->mChilds.push_back(element);
+			return element;
+		}
+
+		void Document::clearElements()
+		{
+			// elements are destroyed already with their parents
+			for (std::vector<Element*>::iterator block = mElementBlocks.begin(); block != mElementBlocks.end(); ++block)
+				::operator delete(*block);
+			mElementBlocks.clear();
+			mElementBlockSize = 0;
+			mElementBlockUsed = 0;
+		}
+
+		bool Document::parseTag(ElementPtr& _currentNode, const char* _begin, const char* _end)
 		{
 			// убераем лишнее
-			MyGUI::utility::trim(_content);
+			utility::trim(_begin, _end);
 
-			if (_content.empty())
+			if (_begin == _end)
 			{
 				// создаем пустой тег
 				if (_currentNode)
 				{
-					_currentNode = _currentNode->createChild("");
+					_currentNode = createElement(_currentNode, ElementType::Normal);
 				}
 				else
 				{
-					_currentNode = new Element("", nullptr);
+					_currentNode = createElement(nullptr, ElementType::Normal);
 					// если это первый то запоминаем
 					if (!mRoot)
 						mRoot = _currentNode;
@@ -587,27 +1046,21 @@ namespace MyGUI
 				return true;
 			}
 
-			char symbol = _content[0];
+			char symbol = *_begin;
 			bool tagDeclaration = false;
 
 			// проверяем на коментарии
 			if (symbol == '!')
 			{
-				if (_currentNode != nullptr)
-				{
-					//_currentNode->createChild("", _content, ElementType::Comment);
-				}
 				return true;
 			}
 			// проверяем на информационный тег
 			else if (symbol == '?')
 			{
 				tagDeclaration = true;
-				_content.erase(0, 1); // удаляем первый символ
+				++_begin;
 			}
 
-			size_t start = 0;
-			size_t end = 0;
 			// проверяем на закрытие тега
 			if (symbol == '/')
 			{
@@ -617,221 +1070,159 @@ namespace MyGUI
 					return false;
 				}
 				// обрезаем имя тэга
-				start = _content.find_first_not_of(" \t", 1);
-				if (start == _content.npos)
-				{
-					// тег пустой
-					_content.clear();
-				}
-				else
-				{
-					end = _content.find_last_not_of(" \t");
-					_content = _content.substr(start, end - start + 1);
-				}
+				const char* name = _begin + 1;
+				while (name != _end && utility::isSpace(*name))
+					++name;
 				// проверяем соответствие открывающего и закрывающего тегов
-				if (_currentNode->getName() != _content)
+				const std::string& currentName = _currentNode->getName();
+				if (currentName.size() != (size_t)(_end - name) || currentName.compare(0, currentName.size(), name, _end - name) != 0)
 				{
 					mLastError = ErrorType::InconsistentOpenCloseElements;
 					return false;
 				}
 				// а теперь снижаем текущий узел вниз
 				_currentNode = _currentNode->getParent();
+				return true;
 			}
-			else
-			{
-				// выделяем имя до первого пробела или закрывающего тега
-				std::string cut = _content;
-				start = _content.find_first_of(" \t/?", 1); // << превед
-				if (start != _content.npos)
-				{
-					cut = _content.substr(0, start);
-					_content = _content.substr(start);
-				}
-				else
-				{
-					_content.clear();
-				}
 
-				if (_currentNode)
-				{
-					_currentNode = _currentNode->createChild(cut);
-				}
-				else
-				{
-					if (tagDeclaration)
-					{
-						// информационный тег
-						if (mDeclaration)
-						{
-							mLastError = ErrorType::MoreThanOneXMLDeclaration;
-							return false;
-						}
-						_currentNode = new Element(cut, nullptr, ElementType::Declaration);
-						mDeclaration = _currentNode;
-					}
-					else
-					{
-						// рутовый тег
-						if (mRoot)
-						{
-							mLastError = ErrorType::MoreThanOneRootElement;
-							return false;
-						}
-						_currentNode = new Element(cut, nullptr, ElementType::Normal);
-						mRoot = _currentNode;
-					}
-				}
-
-				// проверим на пустоту
-				start = _content.find_last_not_of(" \t");
-				if (start == _content.npos)
-					return true;
+			// выделяем имя до первого пробела или закрывающего тега
+			const char* nameEnd = _begin;
+			if (nameEnd != _end)
+			{
+				++nameEnd;
+				while (nameEnd != _end && !utility::isSpace(*nameEnd) && *nameEnd != '/' && *nameEnd != '?')
+					++nameEnd;
+			}
 
-				// сразу отделим закрывающийся тэг
-				bool close = false;
-				if ((_content[start] == '/') || (_content[start] == '?'))
+			if (_currentNode)
+			{
+				_currentNode = createElement(_currentNode, ElementType::Normal);
+			}
+			else
+			{
+				if (tagDeclaration)
 				{
-					close = true;
-					// не будем резать строку, просто поставим пробел
-					_content[start] = ' ';
-					// проверим на пустоту
-					start = _content.find_last_not_of(" \t");
-					if (start == _content.npos)
+					// информационный тег
+					if (mDeclaration)
 					{
-						// возвращаем все назад и уходим
-						_currentNode = _currentNode->getParent();
-						return true;
+						mLastError = ErrorType::MoreThanOneXMLDeclaration;
+						return false;
 					}
+					_currentNode = createElement(nullptr, ElementType::Declaration);
+					mDeclaration = _currentNode;
 				}
-
-				// а вот здесь уже в цикле разбиваем на атрибуты
-				while (true)
+				else
 				{
-					// ищем равно
-					start = _content.find('=');
-					if (start == _content.npos)
-					{
-						mLastError = ErrorType::IncorrectAttribute;
-						return false;
-					}
-					// ищем вторые ковычки
-					end = _content.find_first_of("\"\'", start + 1);
-					if (end == _content.npos)
-					{
-						mLastError = ErrorType::IncorrectAttribute;
-						return false;
-					}
-					end = _content.find_first_of("\"\'", end + 1);
-					if (end == _content.npos)
-					{
-						mLastError = ErrorType::IncorrectAttribute;
-						return false;
-					}
-
-					std::string key = _content.substr(0, start);
-					std::string value = _content.substr(start + 1, end - start);
-
-					// проверка на валидность
-					if (! checkPair(key, value))
+					// рутовый тег
+					if (mRoot)
 					{
-						mLastError = ErrorType::IncorrectAttribute;
+						mLastError = ErrorType::MoreThanOneRootElement;
 						return false;
 					}
-
-					// добавляем пару в узел
-					_currentNode->addAttribute(key, value);
-
-					// следующий кусок
-					_content = _content.substr(end + 1);
-
-					// в строке не осталось символов
-					start = _content.find_first_not_of(" \t");
-					if (start == _content.npos)
-						break;
-
-					mCol += start;
+					_currentNode = createElement(nullptr, ElementType::Normal);
+					mRoot = _currentNode;
 				}
+			}
+			_currentNode->mName.assign(_begin, nameEnd);
+
+			// проверим на пустоту
+			const char* end = _end;
+			while (end != nameEnd && utility::isSpace(*(end - 1)))
+				--end;
+			if (end == nameEnd)
+				return true;
 
-				// был закрывающий тег для текущего тега
-				if (close)
+			// сразу отделим закрывающийся тэг
+			bool close = false;
+			if ((*(end - 1) == '/') || (*(end - 1) == '?'))
+			{
+				close = true;
+				--end;
+				// проверим на пустоту
+				while (end != nameEnd && utility::isSpace(*(end - 1)))
+					--end;
+				if (end == nameEnd)
 				{
-					// не проверяем имена, потому что это наш тэг
+					// возвращаем все назад и уходим
 					_currentNode = _currentNode->getParent();
+					return true;
 				}
-
 			}
-			return true;
-		}
 
-		bool Document::checkPair(std::string& _key, std::string& _value)
-		{
-			// в ключе не должно быть ковычек и пробелов
-			MyGUI::utility::trim(_key);
-			if (_key.empty())
-				return false;
-			size_t start = _key.find_first_of(" \t\"\'&");
-			if (start != _key.npos)
+			if (!parseAttributes(_currentNode, nameEnd, end))
+			{
+				mLastError = ErrorType::IncorrectAttribute;
 				return false;
+			}
 
-			// в значении, ковычки по бокам
-			MyGUI::utility::trim(_value);
-			if (_value.size() < 2)
-				return false;
-			if (((_value[0] != '"') || (_value[_value.length() - 1] != '"')) &&
-				((_value[0] != '\'') || (_value[_value.length() - 1] != '\'')))
-				return false;
-			bool ok = true;
-			_value = utility::convert_from_xml(_value.substr(1, _value.length() - 2), ok);
-			return ok;
+			// был закрывающий тег для текущего тега
+			if (close)
+			{
+				// не проверяем имена, потому что это наш тэг
+				_currentNode = _currentNode->getParent();
+			}
+
+			return true;
 		}
 
-		// ищет символ без учета ковычек
-		size_t Document::find(const std::string& _text, char _char, size_t _start)
+		bool Document::parseAttributes(ElementPtr _element, const char* _begin, const char* _end)
 		{
-			// ковычки
-			bool kov = false;
-
-			// буфер для поиска
-			char buff[16] = "\"_\0";
-			buff[1] = _char;
-
-			size_t pos = _start;
+			// every attribute has at least one '=', so this is enough to append without reallocations
+			_element->mAttributes.reserve(_element->mAttributes.size() + std::count(_begin, _end, '='));
 
+			// а вот здесь уже в цикле разбиваем на атрибуты
 			while (true)
 			{
-				pos = _text.find_first_of(buff, pos);
+				// ищем равно
+				const char* equal = utility::findShort(_begin, _end, '=');
+				if (equal == _end)
+					return false;
 
-				// если уже конец, то досвидания
-				if (pos == _text.npos)
-				{
-					break;
-				}
-				// нашли ковычку
-				else if (_text[pos] == '"')
-				{
-					kov = !kov;
-					pos ++;
-				}
-				// если мы в ковычках, то идем дальше
-				else if (kov)
+				// в ключе не должно быть ковычек и пробелов
+				const char* keyBegin = _begin;
+				const char* keyEnd = equal;
+				utility::trim(keyBegin, keyEnd);
+				if (keyBegin == keyEnd)
+					return false;
+				for (const char* key = keyBegin; key != keyEnd; ++key)
 				{
-					pos ++;
+					if (utility::isSpace(*key) || *key == '"' || *key == '\'' || *key == '&')
+						return false;
 				}
-				// мы не в ковычках
-				else
-				{
+
+				// в значении, ковычки по бокам, внутри значения ковычек нет
+				const char* valueBegin = equal + 1;
+				while (valueBegin != _end && (utility::isSpace(*valueBegin) || *valueBegin == '\r'))
+					++valueBegin;
+				if (valueBegin == _end || (*valueBegin != '"' && *valueBegin != '\''))
+					return false;
+				const char* quote = utility::findQuote(valueBegin + 1, _end);
+				if (quote == _end || *quote != *valueBegin)
+					return false;
+
+				// добавляем пару в узел
+				_element->mAttributes.push_back(PairAttribute(std::string(keyBegin, keyEnd), std::string()));
+				if (!utility::convert_from_xml(valueBegin + 1, quote, _element->mAttributes.back().second))
+					return false;
+
+				// следующий кусок
+				_begin = quote + 1;
+				while (_begin != _end && utility::isSpace(*_begin))
+					++_begin;
+
+				// в строке не осталось символов
+				if (_begin == _end)
 					break;
-				}
 			}
 
-			return pos;
+			return true;
 		}
 
 		void Document::clearDeclaration()
 		{
 			if (mDeclaration)
 			{
-				delete mDeclaration;
+				Element::destroy(mDeclaration);
 				mDeclaration = nullptr;
 			}
 		}
@@ -840,7 +1231,7 @@ namespace MyGUI
 		{
 			if (mRoot)
 			{
-				delete mRoot;
+				Element::destroy(mRoot);
 				mRoot = nullptr;
 			}
 		}
@@ -861,61 +1252,6 @@ namespace MyGUI
 			return mRoot;
 		}
 
-		bool Document::parseLine(std::string& _line, ElementPtr& _element)
-		{
-			// крутимся пока в строке есть теги
-			while (true)
-			{
-				// сначала ищем по угловым скобкам
-				size_t start = find(_line, '<');
-				if (start == _line.npos)
-					break;
-				size_t end;
-
-				// пытаемся вырезать многострочный коментарий
-				if ((start + 3 < _line.size()) && (_line[start + 1] == '!') && (_line[start + 2] == '-') && (_line[start + 3] == '-'))
-				{
-					end = _line.find("-->", start + 4);
-					if (end == _line.npos)
-						break;
-					end += 2;
-				}
-				else
-				{
-					end = find(_line, '>', start + 1);
-					if (end == _line.npos)
-						break;
-				}
-				// проверяем на наличее тела
-				size_t body = _line.find_first_not_of(" \t<");
-				if (body < start)
-				{
-					std::string body_str = _line.substr(0, start);
-					// текущий символ
-					mCol = 0;
-
-					if (_element != nullptr)
-					{
-						bool ok = true;
-						_element->setContent(utility::convert_from_xml(body_str, ok));
-						if (!ok)
-						{
-							mLastError = ErrorType::IncorrectContent;
-							return false;
-						}
-					}
-				}
-				// вырезаем наш тэг и парсим
-				if (!parseTag(_element, _line.substr(start + 1, end - start - 1)))
-				{
-					return false;
-				}
-				// и обрезаем текущую строку разбора
-				_line = _line.substr(end + 1);
-			}
-			return true;
-		}
-
 		std::string Document::getLastError() const
 		{
 			const std::string& error = mLastError.print();
@@ -954,6 +1290,383 @@ namespace MyGUI
 			mLastErrorFile = UString(_filename).asUTF8();
 		}
 
+		//----------------------------------------------------------------------//
+		// class CompiledAttribute
+		//----------------------------------------------------------------------//
+		CompiledAttribute::CompiledAttribute() :
+			mDocument(nullptr),
+			mIndex(0)
+		{
+		}
+
+		CompiledAttribute::CompiledAttribute(const CompiledDocument* _document, uint32 _index) :
+			mDocument(_document),
+			mIndex(_index)
+		{
+		}
+
+		bool CompiledAttribute::isValid() const
+		{
+			return mDocument != nullptr;
+		}
+
+		const char* CompiledAttribute::getName() const
+		{
+			return mDocument != nullptr ? mDocument->getString(mDocument->getAttributeField(mIndex, binary::AttributeName)) : "";
+		}
+
+		const char* CompiledAttribute::getValue() const
+		{
+			return mDocument != nullptr ? mDocument->getString(mDocument->getAttributeField(mIndex, binary::AttributeValue)) : "";
+		}
+
+		uint32 CompiledAttribute::getNumber(size_t _index) const
+		{
+			return mDocument->getAttributeField(mIndex, binary::AttributeNumbers + _index);
+		}
+
+		bool CompiledAttribute::getInts(int* _values, size_t _count) const
+		{
+			if (mDocument == nullptr ||
+				mDocument->getAttributeField(mIndex, binary::AttributeValueType) != binary::ValueInt ||
+				mDocument->getAttributeField(mIndex, binary::AttributeNumberCount) != _count)
+				return false;
+
+			for (size_t index = 0; index < _count; ++index)
+				_values[index] = (int)getNumber(index);
+			return true;
+		}
+
+		bool CompiledAttribute::getFloats(float* _values, size_t _count) const
+		{
+			if (mDocument == nullptr || mDocument->getAttributeField(mIndex, binary::AttributeNumberCount) != _count)
+				return false;
+
+			uint32 type = mDocument->getAttributeField(mIndex, binary::AttributeValueType);
+			if (type != binary::ValueInt && type != binary::ValueFloat)
+				return false;
+
+			for (size_t index = 0; index < _count; ++index)
+				_values[index] = type == binary::ValueInt ? (float)(int)getNumber(index) : binary::uintToFloat(getNumber(index));
+			return true;
+		}
+
+		bool CompiledAttribute::getValue(int& _value) const
+		{
+			return getInts(&_value, 1);
+		}
+
+		bool CompiledAttribute::getValue(float& _value) const
+		{
+			return getFloats(&_value, 1);
+		}
+
+		bool CompiledAttribute::getValue(IntPoint& _value) const
+		{
+			int values[2];
+			if (!getInts(values, 2))
+				return false;
+			_value.set(values[0], values[1]);
+			return true;
+		}
+
+		bool CompiledAttribute::getValue(IntSize& _value) const
+		{
+			int values[2];
+			if (!getInts(values, 2))
+				return false;
+			_value.set(values[0], values[1]);
+			return true;
+		}
+
+		bool CompiledAttribute::getValue(IntCoord& _value) const
+		{
+			int values[4];
+			if (!getInts(values, 4))
+				return false;
+			_value.set(values[0], values[1], values[2], values[3]);
+			return true;
+		}
+
+		bool CompiledAttribute::getValue(FloatCoord& _value) const
+		{
+			float values[4];
+			if (!getFloats(values, 4))
+				return false;
+			_value.set(values[0], values[1], values[2], values[3]);
+			return true;
+		}
+
+		bool CompiledAttribute::getValue(Colour& _value) const
+		{
+			if (mDocument == nullptr)
+				return false;
+
+			float values[4] = { 0, 0, 0, ALPHA_MAX };
+			if (mDocument->getAttributeField(mIndex, binary::AttributeValueType) == binary::ValueColour)
+			{
+				for (size_t index = 0; index < 4; ++index)
+					values[index] = binary::uintToFloat(getNumber(index));
+			}
+			else if (!getFloats(values, 3) && !getFloats(values, 4))
+			{
+				return false;
+			}
+
+			_value.set(values[0], values[1], values[2], values[3]);
+			return true;
+		}
+
+		//----------------------------------------------------------------------//
+		// class CompiledElement
+		//----------------------------------------------------------------------//
+		CompiledElement::CompiledElement() :
+			mDocument(nullptr),
+			mIndex(0)
+		{
+		}
+
+		CompiledElement::CompiledElement(const CompiledDocument* _document, uint32 _index) :
+			mDocument(_document),
+			mIndex(_index)
+		{
+		}
+
+		uint32 CompiledElement::getField(size_t _field) const
+		{
+			return mDocument->getElementField(mIndex, _field);
+		}
+
+		bool CompiledElement::isValid() const
+		{
+			return mDocument != nullptr;
+		}
+
+		const char* CompiledElement::getName() const
+		{
+			return mDocument != nullptr ? mDocument->getString(getField(binary::ElementName)) : "";
+		}
+
+		bool CompiledElement::isName(const char* _name) const
+		{
+			if (mDocument == nullptr)
+				return false;
+
+			uint32 name = getField(binary::ElementName);
+			size_t size = strlen(_name);
+			return mDocument->getStringSize(name) == size && memcmp(mDocument->getString(name), _name, size) == 0;
+		}
+
+		const char* CompiledElement::getContent() const
+		{
+			return mDocument != nullptr ? mDocument->getString(getField(binary::ElementContent)) : "";
+		}
+
+		ElementType CompiledElement::getType() const
+		{
+			return mDocument != nullptr ? ElementType((ElementType::Enum)getField(binary::ElementTypeValue)) : ElementType();
+		}
+
+		size_t CompiledElement::getAttributeCount() const
+		{
+			return mDocument != nullptr ? getField(binary::ElementAttributeCount) : 0;
+		}
+
+		CompiledAttribute CompiledElement::getAttributeAt(size_t _index) const
+		{
+			MYGUI_ASSERT_RANGE(_index, getAttributeCount(), "CompiledElement::getAttributeAt");
+			return CompiledAttribute(mDocument, getField(binary::ElementFirstAttribute) + (uint32)_index);
+		}
+
+		CompiledAttribute CompiledElement::findAttribute(const char* _name) const
+		{
+			size_t size = strlen(_name);
+			uint32 first = mDocument != nullptr ? getField(binary::ElementFirstAttribute) : 0;
+			for (uint32 index = first; index < first + getAttributeCount(); ++index)
+			{
+				uint32 name = mDocument->getAttributeField(index, binary::AttributeName);
+				if (mDocument->getStringSize(name) == size && memcmp(mDocument->getString(name), _name, size) == 0)
+					return CompiledAttribute(mDocument, index);
+			}
+			return CompiledAttribute();
+		}
+
+		size_t CompiledElement::getChildCount() const
+		{
+			return mDocument != nullptr ? getField(binary::ElementChildCount) : 0;
+		}
+
+		CompiledElement CompiledElement::getChildAt(size_t _index) const
+		{
+			MYGUI_ASSERT_RANGE(_index, getChildCount(), "CompiledElement::getChildAt");
+			return CompiledElement(mDocument, getField(binary::ElementFirstChild) + (uint32)_index);
+		}
+
+		//----------------------------------------------------------------------//
+		// class CompiledDocument
+		//----------------------------------------------------------------------//
+		CompiledDocument::CompiledDocument() :
+			mStrings(nullptr),
+			mElements(nullptr),
+			mAttributes(nullptr),
+			mStringData(nullptr),
+			mStringCount(0),
+			mElementCount(0),
+			mAttributeCount(0),
+			mDeclaration(binary::noIndex),
+			mRoot(binary::noIndex),
+			mDepth(0)
+		{
+		}
+
+		bool CompiledDocument::isCompiled(const void* _data, size_t _size)
+		{
+			return _size >= sizeof(binary::signature) && memcmp(_data, binary::signature, sizeof(binary::signature)) == 0;
+		}
+
+		bool CompiledDocument::open(const void* _data, size_t _size)
+		{
+			close();
+
+			if (!isCompiled(_data, _size) || _size < binary::headerSize)
+				return fail();
+
+			const char* data = static_cast<const char*>(_data);
+			uint32 header[binary::HeaderFieldCount];
+			for (size_t index = 0; index < binary::HeaderFieldCount; ++index)
+				header[index] = binary::readUInt(data + sizeof(binary::signature) + index * 4);
+
+			if (header[binary::HeaderVersion] != binary::version)
+				return fail();
+
+			mStringCount = header[binary::HeaderStringCount];
+			mElementCount = header[binary::HeaderElementCount];
+			mAttributeCount = header[binary::HeaderAttributeCount];
+			mDeclaration = header[binary::HeaderDeclaration];
+			mRoot = header[binary::HeaderRoot];
+			uint32 stringDataSize = header[binary::HeaderStringDataSize];
+
+			uint64_t size = binary::headerSize +
+				(uint64_t)mStringCount * binary::StringFieldCount * 4 +
+				(uint64_t)mElementCount * binary::ElementFieldCount * 4 +
+				(uint64_t)mAttributeCount * binary::AttributeFieldCount * 4 +
+				stringDataSize;
+			if (size != _size)
+				return fail();
+
+			mStrings = data + binary::headerSize;
+			mElements = mStrings + (size_t)mStringCount * binary::StringFieldCount * 4;
+			mAttributes = mElements + (size_t)mElementCount * binary::ElementFieldCount * 4;
+			mStringData = mAttributes + (size_t)mAttributeCount * binary::AttributeFieldCount * 4;
+
+			for (uint32 index = 0; index < mStringCount; ++index)
+			{
+				uint64_t end = (uint64_t)getStringField(index, binary::StringOffset) + getStringField(index, binary::StringSize);
+				if (end >= stringDataSize || mStringData[end] != '\0')
+					return fail();
+			}
+
+			for (uint32 index = 0; index < mAttributeCount; ++index)
+			{
+				uint32 type = getAttributeField(index, binary::AttributeValueType);
+				uint32 count = getAttributeField(index, binary::AttributeNumberCount);
+				if (getAttributeField(index, binary::AttributeName) >= mStringCount ||
+					getAttributeField(index, binary::AttributeValue) >= mStringCount ||
+					type >= binary::ValueTypeCount ||
+					count > binary::maxNumbers ||
+					(type == binary::ValueString) != (count == 0) ||
+					(type == binary::ValueColour && count != 4))
+					return fail();
+			}
+
+			// declaration and root are the first elements, both are optional
+			uint32 topCount = 0;
+			if (mDeclaration != binary::noIndex && mDeclaration != topCount++)
+				return fail();
+			if (mRoot != binary::noIndex && mRoot != topCount++)
+				return fail();
+			if (mElementCount < topCount)
+				return fail();
+
+			// every element is a child of one of previous elements, so they make trees and levels are consecutive
+			uint32 nextChild = topCount;
+			uint32 nextAttribute = 0;
+			uint32 levelEnd = topCount;
+			mDepth = topCount != 0 ? 1 : 0;
+			for (uint32 index = 0; index < mElementCount; ++index)
+			{
+				if (index >= nextChild)
+					return fail();
+
+				if (index == levelEnd)
+				{
+					levelEnd = nextChild;
+					++mDepth;
+				}
+
+				uint32 attributeCount = getElementField(index, binary::ElementAttributeCount);
+				uint32 childCount = getElementField(index, binary::ElementChildCount);
+				if (getElementField(index, binary::ElementName) >= mStringCount ||
+					getElementField(index, binary::ElementContent) >= mStringCount ||
+					getElementField(index, binary::ElementTypeValue) >= ElementType::MAX ||
+					getElementField(index, binary::ElementFirstAttribute) != nextAttribute ||
+					attributeCount > mAttributeCount - nextAttribute ||
+					getElementField(index, binary::ElementFirstChild) != nextChild ||
+					childCount > mElementCount - nextChild)
+					return fail();
+
+				nextAttribute += attributeCount;
+				nextChild += childCount;
+			}
+
+			if (nextAttribute != mAttributeCount)
+				return fail();
+
+			return true;
+		}
+
+		void CompiledDocument::close()
+		{
+			mStrings = nullptr;
+			mElements = nullptr;
+			mAttributes = nullptr;
+			mStringData = nullptr;
+			mStringCount = 0;
+			mElementCount = 0;
+			mAttributeCount = 0;
+			mDeclaration = binary::noIndex;
+			mRoot = binary::noIndex;
+			mDepth = 0;
+			mLastError = ErrorType::MAX;
+		}
+
+		bool CompiledDocument::fail()
+		{
+			close();
+			mLastError = ErrorType::IncorrectContent;
+			return false;
+		}
+
+		CompiledElement CompiledDocument::getDeclaration() const
+		{
+			return mDeclaration != binary::noIndex ? CompiledElement(this, mDeclaration) : CompiledElement();
+		}
+
+		CompiledElement CompiledDocument::getRoot() const
+		{
+			return mRoot != binary::noIndex ? CompiledElement(this, mRoot) : CompiledElement();
+		}
+
+		size_t CompiledDocument::getDepth() const
+		{
+			return mDepth;
+		}
+
+		std::string CompiledDocument::getLastError() const
+		{
+			return mLastError.print();
+		}
+
 	} // namespace xml
 
 } // namespace MyGUI
@@ -45,6 +45,18 @@ namespace MyGUI
 
 		/** @see DataManager::getDataPath(const std::string& _name) */
 		const std::string& getDataPath(const std::string& _name) const override;
+
+	/*internal:*/
+		void addResourceLocation(const std::string& _name, bool _recursive);
+
+	private:
+		struct ArhivInfo
+		{
+			std::wstring name;
+			bool recursive;
+		};
+		typedef std::vector<ArhivInfo> VectorArhivInfo;
+		VectorArhivInfo mPaths;
 	};
 
 } // namespace MyGUI
@@ -45,6 +45,26 @@ namespace MyGUI
 			return VertexColourType::ColourARGB;
 		}
 
+		/** @see RenderManager::getVertexLayout */
+		VertexLayout getVertexLayout() const override
+		{
+			return mVertexLayout;
+		}
+		/** Set layout of vertices in buffers of RenderItem, must be called before Gui is initialised */
+		void setVertexLayout(VertexLayout _value);
+
+		/** Allow vertex buffers to keep indexed quads, when disabled they keep triangle list
+			like on render systems without index buffers. Must be called before Gui is initialised.
+		*/
+		void setIndexedQuadsSupported(bool _value);
+		bool getIndexedQuadsSupported() const;
+
+		/** Allow vertex buffers to keep position transform, when disabled RenderItem maps vertices itself
+			like on render systems without it. Must be called before Gui is initialised.
+		*/
+		void setPositionTransformSupported(bool _value);
+		bool getPositionTransformSupported() const;
+
 		/** @see RenderManager::createVertexBuffer */
 		IVertexBuffer* createVertexBuffer() override;
 		/** @see RenderManager::destroyVertexBuffer */
@@ -84,12 +104,44 @@ namespace MyGUI
 		{
 		}
 
+		/** Number of doRender calls since last resetStatistic */
+		size_t getBatchCount() const;
+		/** Number of vertices passed to doRender since last resetStatistic */
+		size_t getVertexCount() const;
+		/** Number of vertices that would be processed by GPU since last resetStatistic, indices for indexed quads */
+		size_t getIndexCount() const;
+		/** Number of vertex buffer locks since last resetStatistic */
+		size_t getLockCount() const;
+		/** Number of vertices written to locked vertex buffers since last resetStatistic */
+		size_t getLockedVertexCount() const;
+		/** Size in bytes of vertices written to locked vertex buffers since last resetStatistic */
+		size_t getLockedVertexSize() const;
+		void resetStatistic();
+
 		/*internal:*/
 		void drawOneFrame();
+		void _notifyVertexBufferLock(size_t _count, VertexLayout _layout);
+
+	private:
+		void destroyAllResources();
 
 	private:
 		IntSize mViewSize;
 		RenderTargetInfo mInfo;
+
+		typedef std::map<std::string, ITexture*> MapTexture;
+		MapTexture mTextures;
+
+		size_t mBatchCount;
+		size_t mVertexCount;
+		size_t mIndexCount;
+		size_t mLockCount;
+		size_t mLockedVertexCount;
+		size_t mLockedVertexSize;
+
+		VertexLayout mVertexLayout;
+		bool mIndexedQuadsSupported;
+		bool mPositionTransformSupported;
 	};
 
 } // namespace MyGUI
@@ -0,0 +1,62 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_DUMMY_TEXTURE_H_
+#define MYGUI_DUMMY_TEXTURE_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_ITexture.h"
+#include "MyGUI_RenderFormat.h"
+
+namespace MyGUI
+{
+
+	/** Texture in system memory.
+		Images are not decoded, only size of png files is read, so skins get their real texture coordinates.
+	*/
+	class DummyTexture :
+		public ITexture
+	{
+	public:
+		DummyTexture(const std::string& _name);
+
+		const std::string& getName() const override;
+
+		void createManual(int _width, int _height, TextureUsage _usage, PixelFormat _format) override;
+		void loadFromFile(const std::string& _filename) override;
+		void saveToFile(const std::string& _filename) override;
+		void setShader(const std::string& _shaderName) override;
+
+		void destroy() override;
+
+		void* lock(TextureUsage _access) override;
+		void unlock() override;
+		bool isLocked() const override;
+
+		int getWidth() const override;
+		int getHeight() const override;
+
+		PixelFormat getFormat() const override;
+		TextureUsage getUsage() const override;
+		size_t getNumElemBytes() const override;
+
+	private:
+		void setSize(int _width, int _height, TextureUsage _usage, PixelFormat _format);
+
+	private:
+		std::string mName;
+		int mWidth;
+		int mHeight;
+		TextureUsage mUsage;
+		PixelFormat mFormat;
+		size_t mNumElemBytes;
+		std::vector<uint8> mBuffer;
+		bool mLock;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_DUMMY_TEXTURE_H_
@@ -0,0 +1,59 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_DUMMY_VERTEX_BUFFER_H_
+#define MYGUI_DUMMY_VERTEX_BUFFER_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_IVertexBuffer.h"
+
+namespace MyGUI
+{
+
+	class DummyRenderManager;
+
+	/** Vertex buffer in system memory, counts every lock in DummyRenderManager statistic */
+	class DummyVertexBuffer :
+		public IVertexBuffer
+	{
+	public:
+		DummyVertexBuffer(DummyRenderManager* _manager);
+
+		void setVertexCount(size_t _count) override;
+		size_t getVertexCount() const override;
+
+		Vertex* lock() override;
+		void unlock() override;
+
+		Vertex* lockRange(size_t _start, size_t _count) override;
+
+		void setIndexedQuads(bool _value) override;
+		bool getIndexedQuads() const override;
+
+		void setVertexLayout(VertexLayout _value) override;
+		VertexLayout getVertexLayout() const override;
+
+		bool setPositionTransform(const FloatPoint& _scale, const FloatPoint& _offset) override;
+		FloatPoint getPositionScale() const override;
+		FloatPoint getPositionOffset() const override;
+
+	private:
+		size_t getAllocatedVertexCount() const;
+
+	private:
+		DummyRenderManager* mManager;
+		// storage for vertices of any layout
+		std::vector<Vertex> mVertices;
+		size_t mNeedVertexCount;
+		bool mIndexedQuads;
+		VertexLayout mVertexLayout;
+		FloatPoint mPositionScale;
+		FloatPoint mPositionOffset;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_DUMMY_VERTEX_BUFFER_H_
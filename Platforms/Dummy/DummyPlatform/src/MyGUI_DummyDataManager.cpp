@@ -7,6 +7,8 @@
 #include "MyGUI_DummyDataManager.h"
 #include "MyGUI_DummyDiagnostic.h"
 #include "MyGUI_DataFileStream.h"
+#include "FileSystemInfo/FileSystemInfo.h"
+#include <fstream>
 
 namespace MyGUI
 {
@@ -31,7 +33,22 @@ namespace MyGUI
 
 	IDataStream* DummyDataManager::getData(const std::string& _name) const
 	{
-		return nullptr;
+		std::string filepath = getDataPath(_name);
+		if (filepath.empty())
+			return nullptr;
+
+		std::ifstream* stream = new std::ifstream();
+		stream->open(filepath.c_str(), std::ios_base::binary);
+
+		if (!stream->is_open())
+		{
+			delete stream;
+			return nullptr;
+		}
+
+		DataFileStream* data = new DataFileStream(stream);
+
+		return data;
 	}
 
 	void DummyDataManager::freeData(IDataStream* _data)
@@ -41,19 +58,67 @@ namespace MyGUI
 
 	bool DummyDataManager::isDataExist(const std::string& _name) const
 	{
-		return false;
+		const VectorString& files = getDataListNames(_name);
+		return !files.empty();
 	}
 
 	const VectorString& DummyDataManager::getDataListNames(const std::string& _pattern) const
 	{
 		static VectorString result;
+		common::VectorWString wresult;
+		result.clear();
+
+		for (VectorArhivInfo::const_iterator item = mPaths.begin(); item != mPaths.end(); ++item)
+		{
+			common::scanFolder(wresult, (*item).name, (*item).recursive, MyGUI::UString(_pattern).asWStr(), false);
+		}
+
+		for (common::VectorWString::const_iterator item = wresult.begin(); item != wresult.end(); ++item)
+		{
+			result.push_back(MyGUI::UString(*item).asUTF8());
+		}
+
 		return result;
 	}
 
 	const std::string& DummyDataManager::getDataPath(const std::string& _name) const
 	{
-		static std::string result;
-		return result;
+		static std::string path;
+		VectorString result;
+		common::VectorWString wresult;
+		path.clear();
+
+		for (VectorArhivInfo::const_iterator item = mPaths.begin(); item != mPaths.end(); ++item)
+		{
+			common::scanFolder(wresult, (*item).name, (*item).recursive, MyGUI::UString(_name).asWStr(), true);
+		}
+
+		for (common::VectorWString::const_iterator item = wresult.begin(); item != wresult.end(); ++item)
+		{
+			result.push_back(MyGUI::UString(*item).asUTF8());
+		}
+
+		if (!result.empty())
+		{
+			path = result[0];
+			if (result.size() > 1)
+			{
+				MYGUI_PLATFORM_LOG(Warning, "There are several files with name '" << _name << "'. '" << path << "' was used.");
+				MYGUI_PLATFORM_LOG(Warning, "Other candidates are:");
+				for (size_t index = 1; index < result.size(); index++)
+					MYGUI_PLATFORM_LOG(Warning, " - '" << result[index] << "'");
+			}
+		}
+
+		return path;
+	}
+
+	void DummyDataManager::addResourceLocation(const std::string& _name, bool _recursive)
+	{
+		ArhivInfo info;
+		info.name = MyGUI::UString(_name).asWStr();
+		info.recursive = _recursive;
+		mPaths.push_back(info);
 	}
 
 } // namespace MyGUI
@@ -6,13 +6,24 @@
 
 #include "MyGUI_DummyRenderManager.h"
 #include "MyGUI_DummyDiagnostic.h"
+#include "MyGUI_DummyTexture.h"
+#include "MyGUI_DummyVertexBuffer.h"
 #include "MyGUI_Gui.h"
 #include "MyGUI_Timer.h"
 
 namespace MyGUI
 {
 
-	DummyRenderManager::DummyRenderManager()
+	DummyRenderManager::DummyRenderManager() :
+		mBatchCount(0),
+		mVertexCount(0),
+		mIndexCount(0),
+		mLockCount(0),
+		mLockedVertexCount(0),
+		mLockedVertexSize(0),
+		mVertexLayout(VertexLayout::Float),
+		mIndexedQuadsSupported(true),
+		mPositionTransformSupported(true)
 	{
 	}
 
@@ -27,20 +38,54 @@ namespace MyGUI
 	{
 		MYGUI_PLATFORM_LOG(Info, "* Shutdown: " << getClassTypeName());
 
+		destroyAllResources();
+
 		MYGUI_PLATFORM_LOG(Info, getClassTypeName() << " successfully shutdown");
 	}
 
+	void DummyRenderManager::setVertexLayout(VertexLayout _value)
+	{
+		mVertexLayout = _value;
+	}
+
+	void DummyRenderManager::setIndexedQuadsSupported(bool _value)
+	{
+		mIndexedQuadsSupported = _value;
+	}
+
+	bool DummyRenderManager::getIndexedQuadsSupported() const
+	{
+		return mIndexedQuadsSupported;
+	}
+
+	void DummyRenderManager::setPositionTransformSupported(bool _value)
+	{
+		mPositionTransformSupported = _value;
+	}
+
+	bool DummyRenderManager::getPositionTransformSupported() const
+	{
+		return mPositionTransformSupported;
+	}
+
 	IVertexBuffer* DummyRenderManager::createVertexBuffer()
 	{
-		return nullptr;
+		return new DummyVertexBuffer(this);
 	}
 
 	void DummyRenderManager::destroyVertexBuffer(IVertexBuffer* _buffer)
 	{
+		delete _buffer;
 	}
 
 	void DummyRenderManager::doRender(IVertexBuffer* _buffer, ITexture* _texture, size_t _count)
 	{
+		mBatchCount ++;
+		mVertexCount += _count;
+		if (_buffer->getIndexedQuads())
+			mIndexCount += _count / IndexedVertexQuad::VertexCount * IndexedVertexQuad::IndexCount;
+		else
+			mIndexCount += _count;
 	}
 
 	void DummyRenderManager::drawOneFrame()
@@ -73,27 +118,113 @@ namespace MyGUI
 
 	ITexture* DummyRenderManager::createTexture(const std::string& _name)
 	{
-		return nullptr;
+		MapTexture::const_iterator item = mTextures.find(_name);
+		MYGUI_PLATFORM_ASSERT(item == mTextures.end(), "Texture '" << _name << "' already exist");
+
+		DummyTexture* texture = new DummyTexture(_name);
+		mTextures[_name] = texture;
+		return texture;
 	}
 
 	void DummyRenderManager::destroyTexture(ITexture* _texture)
 	{
+		if (_texture == nullptr)
+			return;
+
+		MapTexture::iterator item = mTextures.find(_texture->getName());
+		MYGUI_PLATFORM_ASSERT(item != mTextures.end(), "Texture '" << _texture->getName() << "' not found");
+
+		mTextures.erase(item);
+		delete _texture;
 	}
 
 	ITexture* DummyRenderManager::getTexture(const std::string& _name)
 	{
-		return nullptr;
+		MapTexture::const_iterator item = mTextures.find(_name);
+		if (item == mTextures.end())
+			return nullptr;
+		return item->second;
 	}
 
 	bool DummyRenderManager::isFormatSupported(PixelFormat _format, TextureUsage _usage)
 	{
-		return false;
+		// textures are kept in system memory, so every format is fine
+		return _format != PixelFormat::Unknow;
 	}
 
 	void DummyRenderManager::setViewSize(int _width, int _height)
 	{
+		if (_height == 0)
+			_height = 1;
+		if (_width == 0)
+			_width = 1;
+
 		mViewSize.set(_width, _height);
+
+		mInfo.maximumDepth = 1;
+		mInfo.hOffset = 0;
+		mInfo.vOffset = 0;
+		mInfo.aspectCoef = float(mViewSize.height) / float(mViewSize.width);
+		mInfo.pixScaleX = 1.0f / float(mViewSize.width);
+		mInfo.pixScaleY = 1.0f / float(mViewSize.height);
+
 		onResizeView(mViewSize);
 	}
 
+	size_t DummyRenderManager::getBatchCount() const
+	{
+		return mBatchCount;
+	}
+
+	size_t DummyRenderManager::getVertexCount() const
+	{
+		return mVertexCount;
+	}
+
+	size_t DummyRenderManager::getIndexCount() const
+	{
+		return mIndexCount;
+	}
+
+	size_t DummyRenderManager::getLockCount() const
+	{
+		return mLockCount;
+	}
+
+	size_t DummyRenderManager::getLockedVertexCount() const
+	{
+		return mLockedVertexCount;
+	}
+
+	size_t DummyRenderManager::getLockedVertexSize() const
+	{
+		return mLockedVertexSize;
+	}
+
+	void DummyRenderManager::resetStatistic()
+	{
+		mBatchCount = 0;
+		mVertexCount = 0;
+		mIndexCount = 0;
+		mLockCount = 0;
+		mLockedVertexCount = 0;
+		mLockedVertexSize = 0;
+	}
+
+	void DummyRenderManager::_notifyVertexBufferLock(size_t _count, VertexLayout _layout)
+	{
+		mLockCount ++;
+		mLockedVertexCount += _count;
+		mLockedVertexSize += _count * _layout.getVertexSize();
+	}
+
+	void DummyRenderManager::destroyAllResources()
+	{
+		for (MapTexture::const_iterator item = mTextures.begin(); item != mTextures.end(); ++item)
+		{
+			delete item->second;
+		}
+		mTextures.clear();
+	}
+
 } // namespace MyGUI
@@ -0,0 +1,151 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_DummyTexture.h"
+#include "MyGUI_DummyDiagnostic.h"
+#include "MyGUI_DataManager.h"
+#include "MyGUI_DataStreamHolder.h"
+#include <cstring>
+
+namespace MyGUI
+{
+
+	namespace
+	{
+		// png signature followed by length and type of IHDR chunk
+		const uint8 PNG_HEADER[16] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 13, 'I', 'H', 'D', 'R' };
+
+		int readBigEndian(const uint8* _data)
+		{
+			return (int)(((uint32)_data[0] << 24) | ((uint32)_data[1] << 16) | ((uint32)_data[2] << 8) | (uint32)_data[3]);
+		}
+	}
+
+	DummyTexture::DummyTexture(const std::string& _name) :
+		mName(_name),
+		mWidth(0),
+		mHeight(0),
+		mUsage(TextureUsage::Default),
+		mFormat(PixelFormat::Unknow),
+		mNumElemBytes(0),
+		mLock(false)
+	{
+	}
+
+	const std::string& DummyTexture::getName() const
+	{
+		return mName;
+	}
+
+	void DummyTexture::createManual(int _width, int _height, TextureUsage _usage, PixelFormat _format)
+	{
+		setSize(_width, _height, _usage, _format);
+		mBuffer.assign((size_t)mWidth * mHeight * mNumElemBytes, 0);
+	}
+
+	void DummyTexture::loadFromFile(const std::string& _filename)
+	{
+		destroy();
+
+		DataStreamHolder data = DataManager::getInstance().getData(_filename);
+		if (data.getData() == nullptr)
+		{
+			MYGUI_PLATFORM_LOG(Error, "Texture '" + _filename + "' not found");
+			return;
+		}
+
+		uint8 header[24];
+		if (data.getData()->read(header, sizeof(header)) != sizeof(header) || memcmp(header, PNG_HEADER, sizeof(PNG_HEADER)) != 0)
+		{
+			MYGUI_PLATFORM_LOG(Warning, "Texture '" + _filename + "' is not a png image, size is unknown");
+			return;
+		}
+
+		// pixels are not needed until someone locks the texture
+		setSize(readBigEndian(header + 16), readBigEndian(header + 20), TextureUsage::Static | TextureUsage::Write, PixelFormat::R8G8B8A8);
+	}
+
+	void DummyTexture::saveToFile(const std::string& _filename)
+	{
+	}
+
+	void DummyTexture::setShader(const std::string& _shaderName)
+	{
+	}
+
+	void DummyTexture::destroy()
+	{
+		MYGUI_PLATFORM_ASSERT(!mLock, "Texture '" << mName << "' is locked");
+
+		mWidth = 0;
+		mHeight = 0;
+		mUsage = TextureUsage::Default;
+		mFormat = PixelFormat::Unknow;
+		mNumElemBytes = 0;
+		std::vector<uint8>().swap(mBuffer);
+	}
+
+	void* DummyTexture::lock(TextureUsage _access)
+	{
+		MYGUI_PLATFORM_ASSERT(!mLock, "Texture '" << mName << "' is already locked");
+
+		size_t size = (size_t)mWidth * mHeight * mNumElemBytes;
+		if (mBuffer.size() != size)
+			mBuffer.resize(size);
+		if (mBuffer.empty())
+			return nullptr;
+
+		mLock = true;
+		return &mBuffer[0];
+	}
+
+	void DummyTexture::unlock()
+	{
+		mLock = false;
+	}
+
+	bool DummyTexture::isLocked() const
+	{
+		return mLock;
+	}
+
+	int DummyTexture::getWidth() const
+	{
+		return mWidth;
+	}
+
+	int DummyTexture::getHeight() const
+	{
+		return mHeight;
+	}
+
+	PixelFormat DummyTexture::getFormat() const
+	{
+		return mFormat;
+	}
+
+	TextureUsage DummyTexture::getUsage() const
+	{
+		return mUsage;
+	}
+
+	size_t DummyTexture::getNumElemBytes() const
+	{
+		return mNumElemBytes;
+	}
+
+	void DummyTexture::setSize(int _width, int _height, TextureUsage _usage, PixelFormat _format)
+	{
+		destroy();
+
+		mWidth = _width;
+		mHeight = _height;
+		mUsage = _usage;
+		mFormat = _format;
+		mNumElemBytes = mFormat.getBytesPerPixel();
+	}
+
+} // namespace MyGUI
@@ -0,0 +1,100 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_DummyVertexBuffer.h"
+#include "MyGUI_DummyRenderManager.h"
+
+namespace MyGUI
+{
+
+	DummyVertexBuffer::DummyVertexBuffer(DummyRenderManager* _manager) :
+		mManager(_manager),
+		mNeedVertexCount(0),
+		mIndexedQuads(false),
+		mVertexLayout(VertexLayout::Float),
+		mPositionScale(1, 1)
+	{
+	}
+
+	void DummyVertexBuffer::setVertexCount(size_t _count)
+	{
+		mNeedVertexCount = _count;
+	}
+
+	size_t DummyVertexBuffer::getVertexCount() const
+	{
+		return mNeedVertexCount;
+	}
+
+	Vertex* DummyVertexBuffer::lock()
+	{
+		if (getAllocatedVertexCount() < mNeedVertexCount || mVertices.empty())
+			mVertices.resize((std::max)((mNeedVertexCount * mVertexLayout.getVertexSize() + sizeof(Vertex) - 1) / sizeof(Vertex), (size_t)1));
+
+		mManager->_notifyVertexBufferLock(mNeedVertexCount, mVertexLayout);
+		return &mVertices[0];
+	}
+
+	void DummyVertexBuffer::unlock()
+	{
+	}
+
+	Vertex* DummyVertexBuffer::lockRange(size_t _start, size_t _count)
+	{
+		// buffer was never filled with that many vertices, caller falls back to full lock
+		if (_start + _count > getAllocatedVertexCount())
+			return nullptr;
+
+		mManager->_notifyVertexBufferLock(_count, mVertexLayout);
+		return reinterpret_cast<Vertex*>(reinterpret_cast<uint8*>(mVertices.data()) + _start * mVertexLayout.getVertexSize());
+	}
+
+	void DummyVertexBuffer::setIndexedQuads(bool _value)
+	{
+		mIndexedQuads = _value && mManager->getIndexedQuadsSupported();
+	}
+
+	bool DummyVertexBuffer::getIndexedQuads() const
+	{
+		return mIndexedQuads;
+	}
+
+	void DummyVertexBuffer::setVertexLayout(VertexLayout _value)
+	{
+		mVertexLayout = _value;
+	}
+
+	VertexLayout DummyVertexBuffer::getVertexLayout() const
+	{
+		return mVertexLayout;
+	}
+
+	bool DummyVertexBuffer::setPositionTransform(const FloatPoint& _scale, const FloatPoint& _offset)
+	{
+		if (!mManager->getPositionTransformSupported())
+			return false;
+
+		mPositionScale = _scale;
+		mPositionOffset = _offset;
+		return true;
+	}
+
+	FloatPoint DummyVertexBuffer::getPositionScale() const
+	{
+		return mPositionScale;
+	}
+
+	FloatPoint DummyVertexBuffer::getPositionOffset() const
+	{
+		return mPositionOffset;
+	}
+
+	size_t DummyVertexBuffer::getAllocatedVertexCount() const
+	{
+		return mVertices.size() * sizeof(Vertex) / mVertexLayout.getVertexSize();
+	}
+
+} // namespace MyGUI
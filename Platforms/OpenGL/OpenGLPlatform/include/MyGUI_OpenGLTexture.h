@@ -39,6 +39,8 @@ namespace MyGUI
 		void unlock() override;
 		bool isLocked() const override;
 
+		bool updateRect(const IntCoord& _coord, const void* _data, size_t _rowPitch) override;
+
 		PixelFormat getFormat() const override;
 		TextureUsage getUsage() const override;
 		size_t getNumElemBytes() const override;
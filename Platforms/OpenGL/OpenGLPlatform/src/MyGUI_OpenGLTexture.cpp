@@ -332,6 +332,28 @@ namespace MyGUI
 		mLock = false;
 	}
 
+	bool OpenGLTexture::updateRect(const IntCoord& _coord, const void* _data, size_t _rowPitch)
+	{
+		MYGUI_PLATFORM_ASSERT(mTextureId, "Texture is not created");
+		MYGUI_PLATFORM_ASSERT(!mLock, "Texture is locked");
+
+		int alignment = 0;
+		int rowLength = 0;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(_rowPitch / mNumElemBytes));
+
+		glBindTexture(GL_TEXTURE_2D, mTextureId);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, _coord.left, _coord.top, _coord.width, _coord.height, mPixelFormat, GL_UNSIGNED_BYTE, _data);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		return true;
+	}
+
 	void OpenGLTexture::loadFromFile(const std::string& _filename)
 	{
 		destroy();
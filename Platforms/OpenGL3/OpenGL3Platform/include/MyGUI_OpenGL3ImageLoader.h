@@ -20,6 +20,15 @@ namespace MyGUI
 		virtual ~OpenGL3ImageLoader() { }
 
 		virtual void* loadImage(int& _width, int& _height, PixelFormat& _format, const std::string& _filename) = 0;
+
+		/** Read size of image without decoding it, needed for asynchronous loading.
+			loadImage is called from worker threads when this is implemented and asynchronous loading is enabled.
+			@return false if not supported, image is loaded synchronously in this case.
+		*/
+		virtual bool getImageSize(int& /*_width*/, int& /*_height*/, const std::string& /*_filename*/)
+		{
+			return false;
+		}
 		virtual void saveImage(
 			int _width,
 			int _height,
@@ -16,6 +16,9 @@
 namespace MyGUI
 {
 
+	class OpenGL3TextureLoader;
+	class OpenGL3VertexBuffer;
+
 	class OpenGL3RenderManager :
 		public RenderManager,
 		public IRenderTarget
@@ -35,6 +38,15 @@ namespace MyGUI
 		/** @see RenderManager::getVertexFormat */
 		VertexColourType getVertexFormat() const override;
 
+		/** @see RenderManager::getVertexLayout */
+		VertexLayout getVertexLayout() const override;
+		/** Set layout of vertices in buffers of RenderItem, must be called before Gui is initialised.
+			VertexLayout::Compact halves size of uploaded vertices and video memory used by them, but vertex program must read
+			VertexTransform and VertexDepth attributes like MyGUI_OpenGL3_VP.glsl does, compact position is scaled by it.
+			Position transform of vertex buffers (pixel space layer nodes) is passed by VertexTransform too.
+		*/
+		void setVertexLayout(VertexLayout _value);
+
 		/** @see RenderManager::isFormatSupported */
 		bool isFormatSupported(PixelFormat _format, TextureUsage _usage) override;
 
@@ -71,20 +83,66 @@ namespace MyGUI
 		/* for use with RTT, flips Y coordinate when rendering */
 		void doRenderRtt(IVertexBuffer* _buffer, ITexture* _texture, size_t _count);
 
+		/** Submit batches collected by doRender since last flush.
+			Every vertex buffer keeps its vertices in own range of one shared vertex buffer, doRender uploads
+			only changed part of it and batches are drawn at the end of render target,
+			call flush before issuing own OpenGL commands between doRender calls.
+		*/
+		void flush();
+
+		/** Decode images loaded from files on _threadCount worker threads, 0 to load them synchronously.
+			Needs OpenGL3ImageLoader::getImageSize and thread safe OpenGL3ImageLoader::loadImage.
+			Texture that is still loading is not drawn, its invalidate listener is called when pixels are uploaded.
+		*/
+		void setAsyncTextureLoading(size_t _threadCount);
+		size_t getAsyncTextureLoading() const;
+
+		/** Set maximum size in bytes of asynchronously loaded pixels uploaded during one frame.
+			At least one texture is uploaded every frame.
+		*/
+		void setTextureUploadBudget(size_t _bytes);
+		size_t getTextureUploadBudget() const;
+
 	/*internal:*/
 		void drawOneFrame();
+		OpenGL3TextureLoader* _getTextureLoader() const;
 		bool isPixelBufferObjectSupported() const;
 		unsigned int getShaderProgramId(const std::string& _shaderName) const;
+		// bytes [_start, _end) of vertex buffer range for writing, range is allocated when it is smaller than buffer
+		uint8* mapVertices(OpenGL3VertexBuffer* _buffer, size_t _start, size_t _end);
+		void unmapVertices();
 
 	private:
 		std::string loadFileContent(const std::string& _file);
 		unsigned int createShaderProgram(const std::string& _vertexProgramFile, const std::string& _fragmentProgramFile);
 		void destroyAllResources();
+		void addBatch(IVertexBuffer* _buffer, ITexture* _texture, size_t _count, bool _flipY);
+		void updateQuadIndexBuffer(size_t _quadCount);
+		void setupVertexArray(VertexLayout _layout);
+		bool allocateRange(OpenGL3VertexBuffer* _buffer);
+		void releaseRange(OpenGL3VertexBuffer* _buffer);
+		void addFreeRange(size_t _offset, size_t _size);
+		void resizeVertexBuffer(size_t _size);
 
 	private:
+		struct Batch
+		{
+			size_t start;
+			size_t count;
+			unsigned int textureId;
+			unsigned int programId;
+			bool flipY;
+			bool indexedQuads;
+			// start and count are in CompactVertex
+			bool compact;
+			// IVertexBuffer::setPositionTransform
+			FloatPoint positionScale;
+			FloatPoint positionOffset;
+		};
 		IntSize mViewSize;
 		bool mUpdate;
 		VertexColourType mVertexFormat;
+		VertexLayout mVertexLayout;
 		RenderTargetInfo mInfo;
 		unsigned int mDefaultProgramId;
 		std::map<std::string, unsigned int> mRegisteredShaders;
@@ -96,6 +154,30 @@ namespace MyGUI
 		OpenGL3ImageLoader* mImageLoader;
 		bool mPboIsSupported;
 
+		// batches since last flush, drawn from ranges of one buffer with offsets
+		std::vector<Batch> mBatches;
+		size_t mFlushIndex;
+		std::vector<OpenGL3VertexBuffer*> mVertexBuffers;
+		// free parts of shared vertex buffer, offset to size in bytes
+		typedef std::map<size_t, size_t> MapFreeRange;
+		MapFreeRange mFreeRanges;
+		// arguments of multi draw calls
+		std::vector<int> mDrawFirsts;
+		std::vector<const void*> mDrawOffsets;
+		std::vector<int> mDrawCounts;
+		unsigned int mVertexArrayId;
+		// the same buffers with attributes of CompactVertex
+		unsigned int mCompactVertexArrayId;
+		unsigned int mVertexBufferId;
+		size_t mVertexBufferSize;
+		bool mVerticesMapped;
+		// indices of quads for whole vertex buffer, shared by all indexed batches
+		unsigned int mQuadIndexBufferId;
+		size_t mQuadIndexBufferCount;
+
+		OpenGL3TextureLoader* mTextureLoader;
+		size_t mTextureUploadBudget;
+
 		bool mIsInitialise;
 	};
 
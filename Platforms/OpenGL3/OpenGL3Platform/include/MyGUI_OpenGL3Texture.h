@@ -30,6 +30,8 @@ namespace MyGUI
 		void saveToFile(const std::string& _filename) override;
 		void setShader(const std::string& _shaderName) override;
 
+		void setInvalidateListener(ITextureInvalidateListener* _listener) override;
+
 		void destroy() override;
 
 		int getWidth() const override;
@@ -39,6 +41,8 @@ namespace MyGUI
 		void unlock() override;
 		bool isLocked() const override;
 
+		bool updateRect(const IntCoord& _coord, const void* _data, size_t _rowPitch) override;
+
 		PixelFormat getFormat() const override;
 		TextureUsage getUsage() const override;
 		size_t getNumElemBytes() const override;
@@ -51,8 +55,13 @@ namespace MyGUI
 		void setUsage(TextureUsage _usage);
 		void createManual(int _width, int _height, TextureUsage _usage, PixelFormat _format, void* _data);
 
+		/** Texture that is loaded asynchronously already has size, but it is not drawn until pixels are uploaded. */
+		bool isLoading() const;
+		void _loadFromImage(int _width, int _height, PixelFormat _format, void* _data);
+
 	private:
 		void _create();
+		void waitLoading();
 
 	private:
 		std::string mName;
@@ -73,6 +82,8 @@ namespace MyGUI
 		TextureUsage mOriginalUsage;
 		OpenGL3ImageLoader* mImageLoader;
 		OpenGL3RTTexture* mRenderTarget;
+		ITextureInvalidateListener* mInvalidateListener;
+		bool mLoading;
 	};
 
 } // namespace MyGUI
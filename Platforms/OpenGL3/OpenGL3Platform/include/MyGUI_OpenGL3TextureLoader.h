@@ -0,0 +1,96 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef MYGUI_OPENGL3_TEXTURE_LOADER_H_
+#define MYGUI_OPENGL3_TEXTURE_LOADER_H_
+
+#include "MyGUI_Prerequest.h"
+#include "MyGUI_RenderFormat.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MyGUI
+{
+
+	class OpenGL3Texture;
+	class OpenGL3ImageLoader;
+
+	/** Decodes images with OpenGL3ImageLoader on worker threads.
+		Decoded pixels are uploaded on the main thread by uploadTextures, limited by byte budget per call.
+	*/
+	class OpenGL3TextureLoader
+	{
+	public:
+		OpenGL3TextureLoader(OpenGL3ImageLoader* _loader, size_t _threadCount);
+		~OpenGL3TextureLoader();
+
+		size_t getThreadCount() const;
+
+		void setUploadBudget(size_t _bytes);
+		size_t getUploadBudget() const;
+
+		void requestLoad(OpenGL3Texture* _texture, const std::string& _filename);
+		void cancelLoad(OpenGL3Texture* _texture);
+
+		/** Decode texture on this thread or wait until worker finishes it, then upload it. */
+		void finishLoad(OpenGL3Texture* _texture);
+		void finishAll();
+
+		/** Upload decoded textures, at least one if there are any. */
+		void uploadTextures();
+
+	private:
+		struct Request
+		{
+			enum State
+			{
+				Queued,
+				Decoding,
+				Decoded
+			};
+
+			OpenGL3Texture* texture;
+			std::string filename;
+			State state;
+			bool cancelled;
+			void* data;
+			int width;
+			int height;
+			PixelFormat format;
+		};
+		typedef std::deque<Request*> DequeRequest;
+		typedef std::map<OpenGL3Texture*, Request*> MapRequest;
+
+		void workerThread();
+		void decode(Request* _request);
+		void upload(Request* _request);
+		void removeRequest(DequeRequest& _queue, Request* _request);
+
+	private:
+		OpenGL3ImageLoader* mImageLoader;
+		size_t mUploadBudget;
+
+		std::mutex mMutex;
+		std::condition_variable mQueueCondition;
+		std::condition_variable mDecodedCondition;
+		// all requests that are not uploaded yet
+		MapRequest mRequests;
+		DequeRequest mQueued;
+		DequeRequest mDecoded;
+		bool mStop;
+
+		std::vector<std::thread> mThreads;
+	};
+
+} // namespace MyGUI
+
+#endif // MYGUI_OPENGL3_TEXTURE_LOADER_H_
@@ -13,6 +13,9 @@
 namespace MyGUI
 {
 
+	/** Owns a range of shared vertex buffer of OpenGL3RenderManager, lock and lockRange map that range,
+		so vertices are written right into it without a copy in system memory.
+	*/
 	class OpenGL3VertexBuffer : public IVertexBuffer
 	{
 	public:
@@ -25,23 +28,63 @@ namespace MyGUI
 		Vertex* lock() override;
 		void unlock() override;
 
+		Vertex* lockRange(size_t _start, size_t _count) override;
+
+		void setIndexedQuads(bool _value) override;
+		bool getIndexedQuads() const override;
+
+		void setVertexLayout(VertexLayout _value) override;
+		VertexLayout getVertexLayout() const override;
+
+		bool setPositionTransform(const FloatPoint& _scale, const FloatPoint& _offset) override;
+		FloatPoint getPositionScale() const override;
+		FloatPoint getPositionOffset() const override;
+
 	/*internal:*/
-		unsigned int getBufferID() const
+		size_t getAllocatedVertexCount() const
 		{
-			return mVAOID;
+			return mAllocatedSize / mVertexLayout.getVertexSize();
 		}
 
-	private:
-		void destroy();
-		void create();
-		void resize();
+		size_t getAllocatedSize() const
+		{
+			return mAllocatedSize;
+		}
+
+		// range of shared vertex buffer in bytes, size is 0 when buffer has no range
+		void setRange(size_t _offset, size_t _size);
+		size_t getRangeOffset() const
+		{
+			return mRangeOffset;
+		}
+		size_t getRangeSize() const
+		{
+			return mRangeSize;
+		}
+
+		// number of flush that draws batch of this buffer
+		void setFlushIndex(size_t _value)
+		{
+			mFlushIndex = _value;
+		}
+		size_t getFlushIndex() const
+		{
+			return mFlushIndex;
+		}
 
 	private:
-		unsigned int mVAOID;
-		unsigned int mBufferID;
-		size_t mVertexCount;
 		size_t mNeedVertexCount;
-		size_t mSizeInBytes;
+		// bytes needed for range, range itself is aligned
+		size_t mAllocatedSize;
+		bool mIndexedQuads;
+		VertexLayout mVertexLayout;
+		FloatPoint mPositionScale;
+		FloatPoint mPositionOffset;
+		size_t mRangeOffset;
+		size_t mRangeSize;
+		// range keeps vertices of current layout written by lock, so they can be changed by lockRange
+		bool mVerticesValid;
+		size_t mFlushIndex;
 	};
 
 } // namespace MyGUI
@@ -73,13 +73,15 @@ namespace MyGUI
 
 	void OpenGL3RTTexture::begin()
 	{
+		// submits batches of current render target before framebuffer is switched
+		OpenGL3RenderManager::getInstance().begin();
+
 		glGetIntegerv(GL_VIEWPORT, mSavedViewport); // save current viewport
 
 		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, mFBOID);
 
 		glViewport(0, 0, mWidth, mHeight);
 
-		OpenGL3RenderManager::getInstance().begin();
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
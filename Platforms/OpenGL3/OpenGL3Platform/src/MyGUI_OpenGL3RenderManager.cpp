@@ -6,6 +6,7 @@
 
 #include "MyGUI_OpenGL3RenderManager.h"
 #include "MyGUI_OpenGL3Texture.h"
+#include "MyGUI_OpenGL3TextureLoader.h"
 #include "MyGUI_OpenGL3VertexBuffer.h"
 #include "MyGUI_OpenGL3Diagnostic.h"
 #include "MyGUI_VertexData.h"
@@ -18,6 +19,12 @@
 namespace MyGUI
 {
 
+	const size_t VERTEX_BUFFER_INITIAL_SIZE = 4096 * sizeof(Vertex);
+	// ranges start from first vertex of some quad for any vertex layout, so quad indices can be shared
+	const size_t VERTEX_RANGE_ALIGNMENT = IndexedVertexQuad::VertexCount * sizeof(Vertex);
+	// about one 1024x1024 RGBA image per frame
+	const size_t TEXTURE_UPLOAD_DEFAULT_BUDGET = 4 * 1024 * 1024;
+
 	OpenGL3RenderManager& OpenGL3RenderManager::getInstance()
 	{
 		return *getInstancePtr();
@@ -30,8 +37,19 @@ namespace MyGUI
 
 	OpenGL3RenderManager::OpenGL3RenderManager() :
 		mUpdate(false),
+		mVertexLayout(VertexLayout::Float),
 		mImageLoader(nullptr),
 		mPboIsSupported(false),
+		mFlushIndex(0),
+		mVertexArrayId(0),
+		mCompactVertexArrayId(0),
+		mVertexBufferId(0),
+		mVertexBufferSize(0),
+		mVerticesMapped(false),
+		mQuadIndexBufferId(0),
+		mQuadIndexBufferCount(0),
+		mTextureLoader(nullptr),
+		mTextureUploadBudget(TEXTURE_UPLOAD_DEFAULT_BUDGET),
 		mIsInitialise(false)
 	{
 	}
@@ -89,6 +107,8 @@ namespace MyGUI
 		glBindAttribLocation(progID, 0, "VertexPosition");
 		glBindAttribLocation(progID, 1, "VertexColor");
 		glBindAttribLocation(progID, 2, "VertexTexCoord");
+		glBindAttribLocation(progID, 3, "VertexTransform");
+		glBindAttribLocation(progID, 4, "VertexDepth");
 
 		glLinkProgram(progID);
 
@@ -152,10 +172,55 @@ namespace MyGUI
 
 		registerShader("Default", "MyGUI_OpenGL3_VP.glsl", "MyGUI_OpenGL3_FP.glsl");
 
+		// one vertex buffer for all render items, every vertex buffer keeps its vertices in own range of it
+		glGenBuffers(1, &mVertexBufferId);
+		glGenBuffers(1, &mQuadIndexBufferId);
+		glGenVertexArrays(1, &mVertexArrayId);
+		glGenVertexArrays(1, &mCompactVertexArrayId);
+
+		resizeVertexBuffer(VERTEX_BUFFER_INITIAL_SIZE);
+		glBindBuffer(GL_ARRAY_BUFFER, mVertexBufferId);
+
+		glBindVertexArray(mCompactVertexArrayId);
+		setupVertexArray(VertexLayout::Compact);
+
+		glBindVertexArray(mVertexArrayId);
+		setupVertexArray(VertexLayout::Float);
+		updateQuadIndexBuffer(mVertexBufferSize / sizeof(Vertex) / IndexedVertexQuad::VertexCount);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
 		MYGUI_PLATFORM_LOG(Info, getClassTypeName() << " successfully initialized");
 		mIsInitialise = true;
 	}
 
+	void OpenGL3RenderManager::setupVertexArray(VertexLayout _layout)
+	{
+		// element buffer binding is part of vertex array state
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mQuadIndexBufferId);
+
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+		// VertexTransform and VertexDepth are the same for whole batch, they are set with glVertexAttrib
+		glDisableVertexAttribArray(3);
+		glDisableVertexAttribArray(4);
+
+		if (_layout == VertexLayout::Compact)
+		{
+			glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(CompactVertex), (GLubyte*)offsetof(struct CompactVertex, x));
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CompactVertex), (GLubyte*)offsetof(struct CompactVertex, colour));
+			glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex), (GLubyte*)offsetof(struct CompactVertex, u));
+		}
+		else
+		{
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLubyte*)nullptr);
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLubyte*)offsetof(struct Vertex, colour));
+			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLubyte*)offsetof(struct Vertex, u));
+		}
+	}
+
 	void OpenGL3RenderManager::shutdown()
 	{
 		MYGUI_PLATFORM_ASSERT(mIsInitialise, getClassTypeName() << " is not initialised");
@@ -163,60 +228,347 @@ namespace MyGUI
 
 		destroyAllResources();
 
+		// textures are destroyed already, so nothing is waiting for upload
+		delete mTextureLoader;
+		mTextureLoader = nullptr;
+
 		MYGUI_PLATFORM_LOG(Info, getClassTypeName() << " successfully shutdown");
 		mIsInitialise = false;
 	}
 
 	IVertexBuffer* OpenGL3RenderManager::createVertexBuffer()
 	{
-		return new OpenGL3VertexBuffer();
+		OpenGL3VertexBuffer* buffer = new OpenGL3VertexBuffer();
+		mVertexBuffers.push_back(buffer);
+		return buffer;
 	}
 
 	void OpenGL3RenderManager::destroyVertexBuffer(IVertexBuffer* _buffer)
 	{
+		OpenGL3VertexBuffer* buffer = static_cast<OpenGL3VertexBuffer*>(_buffer);
+		std::vector<OpenGL3VertexBuffer*>::iterator item = std::find(mVertexBuffers.begin(), mVertexBuffers.end(), buffer);
+		if (item != mVertexBuffers.end())
+		{
+			// vertices could be drawn yet
+			flush();
+			releaseRange(buffer);
+			mVertexBuffers.erase(item);
+		}
 		delete _buffer;
 	}
 
+	uint8* OpenGL3RenderManager::mapVertices(OpenGL3VertexBuffer* _buffer, size_t _start, size_t _end)
+	{
+		MYGUI_PLATFORM_ASSERT(!mVerticesMapped, "Other vertex buffer is locked");
+
+		// batch of this buffer is not drawn yet, it must be drawn with old vertices
+		if (_buffer->getFlushIndex() == mFlushIndex)
+			flush();
+
+		if (_buffer->getRangeSize() < _buffer->getAllocatedSize())
+		{
+			releaseRange(_buffer);
+			if (!allocateRange(_buffer))
+			{
+				resizeVertexBuffer(mVertexBufferSize + (std::max)(mVertexBufferSize, _buffer->getAllocatedSize() + VERTEX_RANGE_ALIGNMENT));
+				bool allocated = allocateRange(_buffer);
+				MYGUI_PLATFORM_ASSERT(allocated, "Vertex range is not allocated");
+			}
+		}
+
+		// previous vertices of range are discarded, so driver doesn't wait for draws that use them
+		glBindBuffer(GL_ARRAY_BUFFER, mVertexBufferId);
+		void* data = glMapBufferRange(GL_ARRAY_BUFFER, _buffer->getRangeOffset() + _start, _end - _start, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		mVerticesMapped = data != nullptr;
+		return static_cast<uint8*>(data);
+	}
+
+	void OpenGL3RenderManager::unmapVertices()
+	{
+		if (!mVerticesMapped)
+			return;
+		mVerticesMapped = false;
+
+		glBindBuffer(GL_ARRAY_BUFFER, mVertexBufferId);
+		if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+			MYGUI_PLATFORM_LOG(Warning, "Vertices are lost while vertex buffer was locked");
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	bool OpenGL3RenderManager::allocateRange(OpenGL3VertexBuffer* _buffer)
+	{
+		size_t size = (_buffer->getAllocatedSize() + VERTEX_RANGE_ALIGNMENT - 1) / VERTEX_RANGE_ALIGNMENT * VERTEX_RANGE_ALIGNMENT;
+
+		// first fit
+		for (MapFreeRange::iterator item = mFreeRanges.begin(); item != mFreeRanges.end(); ++item)
+		{
+			if (item->second < size)
+				continue;
+
+			size_t offset = item->first;
+			size_t rest = item->second - size;
+			mFreeRanges.erase(item);
+			if (rest != 0)
+				mFreeRanges[offset + size] = rest;
+
+			_buffer->setRange(offset, size);
+			return true;
+		}
+
+		return false;
+	}
+
+	void OpenGL3RenderManager::releaseRange(OpenGL3VertexBuffer* _buffer)
+	{
+		size_t offset = _buffer->getRangeOffset();
+		size_t size = _buffer->getRangeSize();
+		if (size == 0)
+			return;
+		_buffer->setRange(0, 0);
+
+		addFreeRange(offset, size);
+	}
+
+	void OpenGL3RenderManager::addFreeRange(size_t _offset, size_t _size)
+	{
+		// join with free neighbours
+		MapFreeRange::iterator next = mFreeRanges.lower_bound(_offset);
+		if (next != mFreeRanges.end() && _offset + _size == next->first)
+		{
+			_size += next->second;
+			next = mFreeRanges.erase(next);
+		}
+		if (next != mFreeRanges.begin())
+		{
+			MapFreeRange::iterator prev = next;
+			--prev;
+			if (prev->first + prev->second == _offset)
+			{
+				prev->second += _size;
+				return;
+			}
+		}
+		mFreeRanges[_offset] = _size;
+	}
+
+	void OpenGL3RenderManager::resizeVertexBuffer(size_t _size)
+	{
+		// buffer only grows and its size is at least doubled, so vertices of all ranges are read back rarely
+		std::vector<uint8> vertices(mVertexBufferSize);
+
+		glBindBuffer(GL_ARRAY_BUFFER, mVertexBufferId);
+		if (!vertices.empty())
+			glGetBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size(), vertices.data());
+		glBufferData(GL_ARRAY_BUFFER, _size, nullptr, GL_DYNAMIC_DRAW);
+		if (!vertices.empty())
+			glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size(), vertices.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// ranges keep their offsets, added part is free
+		addFreeRange(mVertexBufferSize, _size - mVertexBufferSize);
+		mVertexBufferSize = _size;
+	}
+
 	void OpenGL3RenderManager::doRenderRtt(IVertexBuffer* _buffer, ITexture* _texture, size_t _count)
 	{
-		glUniform1f(mYScaleUniformLocation, -1.0f);
-		doRender(_buffer, _texture, _count);
-		glUniform1f(mYScaleUniformLocation, 1.0f);
+		addBatch(_buffer, _texture, _count, true);
 	}
 
 	void OpenGL3RenderManager::doRender(IVertexBuffer* _buffer, ITexture* _texture, size_t _count)
 	{
+		addBatch(_buffer, _texture, _count, false);
+	}
+
+	void OpenGL3RenderManager::addBatch(IVertexBuffer* _buffer, ITexture* _texture, size_t _count, bool _flipY)
+	{
+		if (_count == 0)
+			return;
+
 		OpenGL3VertexBuffer* buffer = static_cast<OpenGL3VertexBuffer*>(_buffer);
-		unsigned int buffer_id = buffer->getBufferID();
-		MYGUI_PLATFORM_ASSERT(buffer_id, "Vertex buffer is not created");
+		MYGUI_PLATFORM_ASSERT(_count <= buffer->getAllocatedVertexCount(), "Vertex buffer is not created");
 
-		unsigned int texture_id = 0;
+		unsigned int textureId = 0;
+		unsigned int programId = mDefaultProgramId;
 		if (_texture)
 		{
 			OpenGL3Texture* texture = static_cast<OpenGL3Texture*>(_texture);
-			texture_id = texture->getTextureId();
-			//MYGUI_PLATFORM_ASSERT(texture_id, "Texture is not created");
+			// pixels are not uploaded yet, nothing is drawn instead
+			if (texture->isLoading())
+				return;
+			textureId = texture->getTextureId();
+			//MYGUI_PLATFORM_ASSERT(textureId, "Texture is not created");
 			if (texture->getShaderId())
+				programId = texture->getShaderId();
+		}
+
+		bool indexedQuads = buffer->getIndexedQuads();
+		bool compact = buffer->getVertexLayout() == VertexLayout::Compact;
+		FloatPoint positionScale = buffer->getPositionScale();
+		FloatPoint positionOffset = buffer->getPositionOffset();
+
+		// vertices are lost with range, they are written again after next lock
+		if (buffer->getRangeSize() == 0)
+			return;
+		buffer->setFlushIndex(mFlushIndex);
+		size_t start = buffer->getRangeOffset() / buffer->getVertexLayout().getVertexSize();
+
+		// neighbour items with same state are drawn with one call
+		if (!mBatches.empty())
+		{
+			Batch& last = mBatches.back();
+			if (last.textureId == textureId && last.programId == programId && last.flipY == _flipY && last.indexedQuads == indexedQuads && last.compact == compact &&
+				last.positionScale == positionScale && last.positionOffset == positionOffset && last.start + last.count == start)
 			{
-				glUseProgram(texture->getShaderId());
+				last.count += _count;
+				return;
 			}
 		}
 
-		glBindTexture(GL_TEXTURE_2D, texture_id);
+		Batch batch;
+		batch.start = start;
+		batch.count = _count;
+		batch.textureId = textureId;
+		batch.programId = programId;
+		batch.flipY = _flipY;
+		batch.indexedQuads = indexedQuads;
+		batch.compact = compact;
+		batch.positionScale = positionScale;
+		batch.positionOffset = positionOffset;
+		mBatches.push_back(batch);
+	}
 
-		glBindVertexArray(buffer_id);
-		glDrawArrays(GL_TRIANGLES, 0, _count);
-		glBindVertexArray(0);
+	void OpenGL3RenderManager::updateQuadIndexBuffer(size_t _quadCount)
+	{
+		if (_quadCount <= mQuadIndexBufferCount)
+			return;
 
-		glBindTexture(GL_TEXTURE_2D, 0);
-		if (_texture && static_cast<OpenGL3Texture*>(_texture)->getShaderId())
+		mQuadIndexBufferCount = (std::max)(_quadCount, mQuadIndexBufferCount * 2);
+
+		std::vector<GLuint> indices(mQuadIndexBufferCount * IndexedVertexQuad::IndexCount);
+		IndexedVertexQuad::fillIndices(indices.data(), 0, mQuadIndexBufferCount);
+
+		// expects vertex array to be bound
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+	}
+
+	void OpenGL3RenderManager::flush()
+	{
+		if (mBatches.empty())
+			return;
+
+		size_t quadCount = 0;
+		for (std::vector<Batch>::const_iterator batch = mBatches.begin(); batch != mBatches.end(); ++batch)
 		{
-			glUseProgram(mDefaultProgramId);
+			if (batch->indexedQuads)
+				quadCount = (std::max)(quadCount, (batch->start + batch->count) / IndexedVertexQuad::VertexCount);
 		}
+
+		glBindVertexArray(mVertexArrayId);
+		updateQuadIndexBuffer(quadCount);
+		glVertexAttrib4f(3, 1.0f, 1.0f, 0.0f, 0.0f);
+		glVertexAttrib1f(4, 0.0f);
+
+		unsigned int programId = mDefaultProgramId;
+		unsigned int textureId = 0;
+		bool flipY = false;
+		bool compact = false;
+		FloatPoint positionScale(1, 1);
+		FloatPoint positionOffset;
+		glBindTexture(GL_TEXTURE_2D, textureId);
+
+		std::vector<Batch>::const_iterator batch = mBatches.begin();
+		while (batch != mBatches.end())
+		{
+			if (batch->compact != compact || batch->positionScale != positionScale || batch->positionOffset != positionOffset)
+			{
+				if (batch->compact != compact)
+				{
+					compact = batch->compact;
+					glBindVertexArray(compact ? mCompactVertexArrayId : mVertexArrayId);
+					// compact vertices have no depth
+					glVertexAttrib1f(4, compact ? mInfo.maximumDepth : 0.0f);
+				}
+
+				positionScale = batch->positionScale;
+				positionOffset = batch->positionOffset;
+				// compact vertices have fixed point position
+				float scale = compact ? 1.0f / CompactVertex::PositionScale : 1.0f;
+				glVertexAttrib4f(3, positionScale.left * scale, positionScale.top * scale, positionOffset.left, positionOffset.top);
+			}
+
+			// YScale belongs to default program
+			if (batch->flipY != flipY)
+			{
+				if (programId != mDefaultProgramId)
+				{
+					programId = mDefaultProgramId;
+					glUseProgram(programId);
+				}
+				flipY = batch->flipY;
+				glUniform1f(mYScaleUniformLocation, flipY ? -1.0f : 1.0f);
+			}
+
+			if (batch->programId != programId)
+			{
+				programId = batch->programId;
+				glUseProgram(programId);
+			}
+
+			if (batch->textureId != textureId)
+			{
+				textureId = batch->textureId;
+				glBindTexture(GL_TEXTURE_2D, textureId);
+			}
+
+			// ranges of neighbour batches with same state are drawn with one call
+			mDrawFirsts.clear();
+			mDrawOffsets.clear();
+			mDrawCounts.clear();
+			const Batch& first = *batch;
+			for (; batch != mBatches.end(); ++batch)
+			{
+				if (batch->textureId != first.textureId || batch->programId != first.programId || batch->flipY != first.flipY || batch->indexedQuads != first.indexedQuads || batch->compact != first.compact ||
+					batch->positionScale != first.positionScale || batch->positionOffset != first.positionOffset)
+					break;
+
+				if (batch->indexedQuads)
+				{
+					size_t firstIndex = batch->start / IndexedVertexQuad::VertexCount * IndexedVertexQuad::IndexCount;
+					mDrawOffsets.push_back((const void*)(firstIndex * sizeof(GLuint)));
+					mDrawCounts.push_back((int)(batch->count / IndexedVertexQuad::VertexCount * IndexedVertexQuad::IndexCount));
+				}
+				else
+				{
+					mDrawFirsts.push_back((int)batch->start);
+					mDrawCounts.push_back((int)batch->count);
+				}
+			}
+
+			if (first.indexedQuads)
+				glMultiDrawElements(GL_TRIANGLES, mDrawCounts.data(), GL_UNSIGNED_INT, mDrawOffsets.data(), (GLsizei)mDrawCounts.size());
+			else
+				glMultiDrawArrays(GL_TRIANGLES, mDrawFirsts.data(), mDrawCounts.data(), (GLsizei)mDrawCounts.size());
+		}
+
+		glBindVertexArray(0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if (programId != mDefaultProgramId)
+			glUseProgram(mDefaultProgramId);
+		if (flipY)
+			glUniform1f(mYScaleUniformLocation, 1.0f);
+
+		mBatches.clear();
+		++mFlushIndex;
 	}
 
 	void OpenGL3RenderManager::begin()
 	{
+		// batches of outer render target
+		flush();
+
 		++mReferenceCount;
 
 		glUseProgram(mDefaultProgramId);
@@ -228,6 +580,8 @@ namespace MyGUI
 
 	void OpenGL3RenderManager::end()
 	{
+		flush();
+
 		if (--mReferenceCount == 0)
 		{
 			glDisable(GL_BLEND);
@@ -250,6 +604,16 @@ namespace MyGUI
 		return mVertexFormat;
 	}
 
+	VertexLayout OpenGL3RenderManager::getVertexLayout() const
+	{
+		return mVertexLayout;
+	}
+
+	void OpenGL3RenderManager::setVertexLayout(VertexLayout _value)
+	{
+		mVertexLayout = _value;
+	}
+
 	bool OpenGL3RenderManager::isFormatSupported(PixelFormat _format, TextureUsage _usage)
 	{
 		if (_format == PixelFormat::R8G8B8 ||
@@ -272,6 +636,9 @@ namespace MyGUI
 
 		onFrameEvent(time / 1000.0f);
 
+		if (mTextureLoader != nullptr)
+			mTextureLoader->uploadTextures();
+
 		last_time = now_time;
 
 		begin();
@@ -316,6 +683,53 @@ namespace MyGUI
 			mDefaultProgramId = mRegisteredShaders[_shaderName];
 	}
 
+	void OpenGL3RenderManager::setAsyncTextureLoading(size_t _threadCount)
+	{
+		if (mTextureLoader != nullptr)
+		{
+			if (mTextureLoader->getThreadCount() == _threadCount)
+				return;
+
+			// pending textures are finished synchronously
+			delete mTextureLoader;
+			mTextureLoader = nullptr;
+		}
+
+		if (_threadCount == 0)
+			return;
+
+		if (mImageLoader == nullptr)
+		{
+			MYGUI_PLATFORM_LOG(Warning, "Asynchronous texture loading needs image loader");
+			return;
+		}
+
+		mTextureLoader = new OpenGL3TextureLoader(mImageLoader, _threadCount);
+		mTextureLoader->setUploadBudget(mTextureUploadBudget);
+	}
+
+	size_t OpenGL3RenderManager::getAsyncTextureLoading() const
+	{
+		return mTextureLoader != nullptr ? mTextureLoader->getThreadCount() : 0;
+	}
+
+	void OpenGL3RenderManager::setTextureUploadBudget(size_t _bytes)
+	{
+		mTextureUploadBudget = _bytes;
+		if (mTextureLoader != nullptr)
+			mTextureLoader->setUploadBudget(_bytes);
+	}
+
+	size_t OpenGL3RenderManager::getTextureUploadBudget() const
+	{
+		return mTextureUploadBudget;
+	}
+
+	OpenGL3TextureLoader* OpenGL3RenderManager::_getTextureLoader() const
+	{
+		return mTextureLoader;
+	}
+
 	bool OpenGL3RenderManager::isPixelBufferObjectSupported() const
 	{
 		return mPboIsSupported;
@@ -374,6 +788,33 @@ namespace MyGUI
 		}
 		mRegisteredShaders.clear();
 		mDefaultProgramId = 0;
+
+		if (mVertexBufferId != 0)
+		{
+			glDeleteBuffers(1, &mVertexBufferId);
+			mVertexBufferId = 0;
+			mVertexBufferSize = 0;
+		}
+		if (mQuadIndexBufferId != 0)
+		{
+			glDeleteBuffers(1, &mQuadIndexBufferId);
+			mQuadIndexBufferId = 0;
+			mQuadIndexBufferCount = 0;
+		}
+		if (mVertexArrayId != 0)
+		{
+			glDeleteVertexArrays(1, &mVertexArrayId);
+			mVertexArrayId = 0;
+		}
+		if (mCompactVertexArrayId != 0)
+		{
+			glDeleteVertexArrays(1, &mCompactVertexArrayId);
+			mCompactVertexArrayId = 0;
+		}
+		mBatches.clear();
+		mFreeRanges.clear();
+		for (std::vector<OpenGL3VertexBuffer*>::const_iterator item = mVertexBuffers.begin(); item != mVertexBuffers.end(); ++item)
+			(*item)->setRange(0, 0);
 	}
 
 } // namespace MyGUI
@@ -9,6 +9,7 @@
 #include "MyGUI_OpenGL3Diagnostic.h"
 #include "MyGUI_OpenGL3Platform.h"
 #include "MyGUI_OpenGL3RTTexture.h"
+#include "MyGUI_OpenGL3TextureLoader.h"
 
 #include <GL/glew.h>
 
@@ -31,7 +32,9 @@ namespace MyGUI
 		mLock(false),
 		mBuffer(nullptr),
 		mImageLoader(_loader),
-		mRenderTarget(nullptr)
+		mRenderTarget(nullptr),
+		mInvalidateListener(nullptr),
+		mLoading(false)
 	{
 	}
 
@@ -204,6 +207,12 @@ namespace MyGUI
 
 	void OpenGL3Texture::destroy()
 	{
+		if (mLoading)
+		{
+			OpenGL3RenderManager::getInstance()._getTextureLoader()->cancelLoad(this);
+			mLoading = false;
+		}
+
 		if (mRenderTarget != nullptr)
 		{
 			delete mRenderTarget;
@@ -237,6 +246,8 @@ namespace MyGUI
 
 	void* OpenGL3Texture::lock(TextureUsage _access)
 	{
+		waitLoading();
+
 		MYGUI_PLATFORM_ASSERT(mTextureId, "Texture is not created");
 
 		if (_access == TextureUsage::Read)
@@ -326,6 +337,30 @@ namespace MyGUI
 		mLock = false;
 	}
 
+	bool OpenGL3Texture::updateRect(const IntCoord& _coord, const void* _data, size_t _rowPitch)
+	{
+		waitLoading();
+
+		MYGUI_PLATFORM_ASSERT(mTextureId, "Texture is not created");
+		MYGUI_PLATFORM_ASSERT(!mLock, "Texture is locked");
+
+		int alignment = 0;
+		int rowLength = 0;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(_rowPitch / mNumElemBytes));
+
+		glBindTexture(GL_TEXTURE_2D, mTextureId);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, _coord.left, _coord.top, _coord.width, _coord.height, mPixelFormat, GL_UNSIGNED_BYTE, _data);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		return true;
+	}
+
 	void OpenGL3Texture::loadFromFile(const std::string& _filename)
 	{
 		destroy();
@@ -336,6 +371,17 @@ namespace MyGUI
 			int height = 0;
 			PixelFormat format = PixelFormat::Unknow;
 
+			// with known size texture can be used right away, pixels are decoded by worker threads
+			OpenGL3TextureLoader* textureLoader = OpenGL3RenderManager::getInstance()._getTextureLoader();
+			if (textureLoader != nullptr && mImageLoader->getImageSize(width, height, _filename))
+			{
+				mWidth = width;
+				mHeight = height;
+				mLoading = true;
+				textureLoader->requestLoad(this, _filename);
+				return;
+			}
+
 			void* data = mImageLoader->loadImage(width, height, format, _filename);
 			if (data)
 			{
@@ -347,6 +393,8 @@ namespace MyGUI
 
 	void OpenGL3Texture::saveToFile(const std::string& _filename)
 	{
+		waitLoading();
+
 		if (mImageLoader)
 		{
 			void* data = lock(TextureUsage::Read);
@@ -360,8 +408,39 @@ namespace MyGUI
 		mProgramId = OpenGL3RenderManager::getInstance().getShaderProgramId(_shaderName);
 	}
 
+	void OpenGL3Texture::setInvalidateListener(ITextureInvalidateListener* _listener)
+	{
+		mInvalidateListener = _listener;
+	}
+
+	bool OpenGL3Texture::isLoading() const
+	{
+		return mLoading;
+	}
+
+	void OpenGL3Texture::_loadFromImage(int _width, int _height, PixelFormat _format, void* _data)
+	{
+		mLoading = false;
+		mWidth = 0;
+		mHeight = 0;
+
+		if (_data != nullptr)
+			createManual(_width, _height, TextureUsage::Static | TextureUsage::Write, _format, _data);
+
+		if (mInvalidateListener != nullptr)
+			mInvalidateListener->textureInvalidate(this);
+	}
+
+	void OpenGL3Texture::waitLoading()
+	{
+		if (mLoading)
+			OpenGL3RenderManager::getInstance()._getTextureLoader()->finishLoad(this);
+	}
+
 	IRenderTarget* OpenGL3Texture::getRenderTarget()
 	{
+		waitLoading();
+
 		if (mRenderTarget == nullptr)
 			mRenderTarget = new OpenGL3RTTexture(mTextureId);
 
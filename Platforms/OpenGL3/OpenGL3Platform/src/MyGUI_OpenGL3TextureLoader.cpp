@@ -0,0 +1,237 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_OpenGL3TextureLoader.h"
+#include "MyGUI_OpenGL3Texture.h"
+#include "MyGUI_OpenGL3ImageLoader.h"
+#include "MyGUI_OpenGL3Diagnostic.h"
+
+#include <algorithm>
+
+namespace MyGUI
+{
+
+	OpenGL3TextureLoader::OpenGL3TextureLoader(OpenGL3ImageLoader* _loader, size_t _threadCount) :
+		mImageLoader(_loader),
+		mUploadBudget(0),
+		mStop(false)
+	{
+		for (size_t index = 0; index < _threadCount; ++index)
+			mThreads.push_back(std::thread(&OpenGL3TextureLoader::workerThread, this));
+	}
+
+	OpenGL3TextureLoader::~OpenGL3TextureLoader()
+	{
+		finishAll();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStop = true;
+		}
+		mQueueCondition.notify_all();
+
+		for (std::vector<std::thread>::iterator thread = mThreads.begin(); thread != mThreads.end(); ++thread)
+			thread->join();
+	}
+
+	size_t OpenGL3TextureLoader::getThreadCount() const
+	{
+		return mThreads.size();
+	}
+
+	void OpenGL3TextureLoader::setUploadBudget(size_t _bytes)
+	{
+		mUploadBudget = _bytes;
+	}
+
+	size_t OpenGL3TextureLoader::getUploadBudget() const
+	{
+		return mUploadBudget;
+	}
+
+	void OpenGL3TextureLoader::requestLoad(OpenGL3Texture* _texture, const std::string& _filename)
+	{
+		Request* request = new Request();
+		request->texture = _texture;
+		request->filename = _filename;
+		request->state = Request::Queued;
+		request->cancelled = false;
+		request->data = nullptr;
+		request->width = 0;
+		request->height = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			MYGUI_PLATFORM_ASSERT(mRequests.find(_texture) == mRequests.end(), "Texture '" << _texture->getName() << "' is already loading");
+			mRequests[_texture] = request;
+			mQueued.push_back(request);
+		}
+		mQueueCondition.notify_one();
+	}
+
+	void OpenGL3TextureLoader::cancelLoad(OpenGL3Texture* _texture)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		MapRequest::iterator item = mRequests.find(_texture);
+		if (item == mRequests.end())
+			return;
+
+		Request* request = item->second;
+		mRequests.erase(item);
+
+		if (request->state == Request::Decoding)
+		{
+			// worker thread deletes it when decoding is finished
+			request->cancelled = true;
+			return;
+		}
+
+		removeRequest(mQueued, request);
+		removeRequest(mDecoded, request);
+		delete[] (unsigned char*)request->data;
+		delete request;
+	}
+
+	void OpenGL3TextureLoader::finishLoad(OpenGL3Texture* _texture)
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		MapRequest::iterator item = mRequests.find(_texture);
+		if (item == mRequests.end())
+			return;
+
+		Request* request = item->second;
+		if (request->state == Request::Queued)
+		{
+			removeRequest(mQueued, request);
+			request->state = Request::Decoding;
+
+			lock.unlock();
+			decode(request);
+			lock.lock();
+
+			request->state = Request::Decoded;
+		}
+		else if (request->state == Request::Decoding)
+		{
+			mDecodedCondition.wait(lock, [request] { return request->state == Request::Decoded; });
+			removeRequest(mDecoded, request);
+		}
+		else
+		{
+			removeRequest(mDecoded, request);
+		}
+
+		mRequests.erase(_texture);
+		lock.unlock();
+
+		upload(request);
+	}
+
+	void OpenGL3TextureLoader::finishAll()
+	{
+		while (true)
+		{
+			OpenGL3Texture* texture = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				if (mRequests.empty())
+					break;
+				texture = mRequests.begin()->first;
+			}
+			finishLoad(texture);
+		}
+	}
+
+	void OpenGL3TextureLoader::uploadTextures()
+	{
+		std::vector<Request*> requests;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			size_t bytes = 0;
+			while (!mDecoded.empty())
+			{
+				Request* request = mDecoded.front();
+				size_t size = (size_t)request->width * request->height * request->format.getBytesPerPixel();
+				if (!requests.empty() && bytes + size > mUploadBudget)
+					break;
+
+				bytes += size;
+				mDecoded.pop_front();
+				mRequests.erase(request->texture);
+				requests.push_back(request);
+			}
+		}
+
+		for (std::vector<Request*>::iterator request = requests.begin(); request != requests.end(); ++request)
+			upload(*request);
+	}
+
+	void OpenGL3TextureLoader::workerThread()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true)
+		{
+			mQueueCondition.wait(lock, [this] { return mStop || !mQueued.empty(); });
+			if (mStop)
+				return;
+
+			Request* request = mQueued.front();
+			mQueued.pop_front();
+			request->state = Request::Decoding;
+
+			lock.unlock();
+			decode(request);
+			lock.lock();
+
+			if (request->cancelled)
+			{
+				delete[] (unsigned char*)request->data;
+				delete request;
+				continue;
+			}
+
+			request->state = Request::Decoded;
+			mDecoded.push_back(request);
+			mDecodedCondition.notify_all();
+		}
+	}
+
+	void OpenGL3TextureLoader::decode(Request* _request)
+	{
+		// image loader can throw, error is reported on main thread when texture is uploaded
+		try
+		{
+			_request->data = mImageLoader->loadImage(_request->width, _request->height, _request->format, _request->filename);
+		}
+		catch (...)
+		{
+			_request->data = nullptr;
+		}
+	}
+
+	void OpenGL3TextureLoader::upload(Request* _request)
+	{
+		if (_request->data == nullptr)
+			MYGUI_PLATFORM_LOG(Error, "Texture '" << _request->texture->getName() << "' can't be loaded from '" << _request->filename << "'");
+
+		_request->texture->_loadFromImage(_request->width, _request->height, _request->format, _request->data);
+
+		delete[] (unsigned char*)_request->data;
+		delete _request;
+	}
+
+	void OpenGL3TextureLoader::removeRequest(DequeRequest& _queue, Request* _request)
+	{
+		DequeRequest::iterator item = std::find(_queue.begin(), _queue.end(), _request);
+		if (item != _queue.end())
+			_queue.erase(item);
+	}
+
+} // namespace MyGUI
@@ -5,27 +5,29 @@
 */
 
 #include "MyGUI_OpenGL3VertexBuffer.h"
+#include "MyGUI_OpenGL3RenderManager.h"
 #include "MyGUI_OpenGL3Diagnostic.h"
 
-#include <GL/glew.h>
-
 namespace MyGUI
 {
 
 	const size_t VERTEX_BUFFER_REALLOCK_STEP = 5 * VertexQuad::VertexCount;
 
 	OpenGL3VertexBuffer::OpenGL3VertexBuffer() :
-		mVAOID(0),
-		mBufferID(0),
-		mVertexCount(0),
 		mNeedVertexCount(0),
-		mSizeInBytes(0)
+		mAllocatedSize(0),
+		mIndexedQuads(false),
+		mVertexLayout(VertexLayout::Float),
+		mPositionScale(1, 1),
+		mRangeOffset(0),
+		mRangeSize(0),
+		mVerticesValid(false),
+		mFlushIndex(ITEM_NONE)
 	{
 	}
 
 	OpenGL3VertexBuffer::~OpenGL3VertexBuffer()
 	{
-		destroy();
 	}
 
 	void OpenGL3VertexBuffer::setVertexCount(size_t _count)
@@ -40,91 +42,77 @@ namespace MyGUI
 
 	Vertex* OpenGL3VertexBuffer::lock()
 	{
-		if (mNeedVertexCount > mVertexCount || mVertexCount == 0)
-			resize();
-
-		MYGUI_PLATFORM_ASSERT(mBufferID, "Vertex buffer in not created");
-
-		// Use glMapBuffer
-		glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
+		// all vertices are written again, so range is reallocated when they don't fit
+		if (mNeedVertexCount > getAllocatedVertexCount())
+			mAllocatedSize = (mNeedVertexCount + VERTEX_BUFFER_REALLOCK_STEP) * mVertexLayout.getVertexSize();
 
-		// Discard the buffer
-		glBufferData(GL_ARRAY_BUFFER, mSizeInBytes, nullptr, GL_STREAM_DRAW);
-
-		Vertex* pBuffer = reinterpret_cast<Vertex*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
+		uint8* data = OpenGL3RenderManager::getInstance().mapVertices(this, 0, mAllocatedSize);
+		mVerticesValid = data != nullptr;
+		return reinterpret_cast<Vertex*>(data);
+	}
 
-		MYGUI_PLATFORM_ASSERT(pBuffer, "Error lock vertex buffer");
+	Vertex* OpenGL3VertexBuffer::lockRange(size_t _start, size_t _count)
+	{
+		// range is reallocated or has vertices of other layout, so all of them have to be written
+		if (!mVerticesValid || mNeedVertexCount > getAllocatedVertexCount() || _count == 0)
+			return nullptr;
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		MYGUI_PLATFORM_ASSERT(_start + _count <= getAllocatedVertexCount(), "Vertex range is out of buffer");
 
-		return pBuffer;
+		size_t vertexSize = mVertexLayout.getVertexSize();
+		return reinterpret_cast<Vertex*>(OpenGL3RenderManager::getInstance().mapVertices(this, _start * vertexSize, (_start + _count) * vertexSize));
 	}
 
 	void OpenGL3VertexBuffer::unlock()
 	{
-		MYGUI_PLATFORM_ASSERT(mBufferID, "Vertex buffer in not created");
-
-		glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
-		GLboolean result = glUnmapBuffer(GL_ARRAY_BUFFER);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-		MYGUI_PLATFORM_ASSERT(result, "Error unlock vertex buffer");
+		OpenGL3RenderManager::getInstance().unmapVertices();
 	}
-
-	void OpenGL3VertexBuffer::create()
+	void OpenGL3VertexBuffer::setIndexedQuads(bool _value)
 	{
-		MYGUI_PLATFORM_ASSERT(!mBufferID, "Vertex buffer already exist");
-
-		mSizeInBytes = mVertexCount * sizeof(Vertex);
-		void* data = nullptr;
-
-		glGenBuffers(1, &mBufferID);
-		glGenVertexArrays(1, &mVAOID);
+		mIndexedQuads = _value;
+	}
 
-		glBindVertexArray(mVAOID);
-		glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
-		glBufferData(GL_ARRAY_BUFFER, mSizeInBytes, data, GL_STREAM_DRAW);
+	bool OpenGL3VertexBuffer::getIndexedQuads() const
+	{
+		return mIndexedQuads;
+	}
 
-		// check data size in VBO is same as input array, if not return 0 and delete VBO
-		int bufferSize = 0;
-		glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bufferSize);
-		if (mSizeInBytes != (size_t)bufferSize)
-		{
-			destroy();
-			MYGUI_PLATFORM_EXCEPT("Data size is mismatch with input array");
-		}
+	bool OpenGL3VertexBuffer::setPositionTransform(const FloatPoint& _scale, const FloatPoint& _offset)
+	{
+		// applied by VertexTransform attribute of batch
+		mPositionScale = _scale;
+		mPositionOffset = _offset;
+		return true;
+	}
 
-		glEnableVertexAttribArray(0);
-		glEnableVertexAttribArray(1);
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLubyte*)nullptr);
-		glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLubyte*)offsetof(struct Vertex, colour));
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLubyte*)offsetof(struct Vertex, u));
+	FloatPoint OpenGL3VertexBuffer::getPositionScale() const
+	{
+		return mPositionScale;
+	}
 
-		glBindVertexArray(0);
+	FloatPoint OpenGL3VertexBuffer::getPositionOffset() const
+	{
+		return mPositionOffset;
+	}
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	void OpenGL3VertexBuffer::setVertexLayout(VertexLayout _value)
+	{
+		if (mVertexLayout != _value)
+			mVerticesValid = false;
+		mVertexLayout = _value;
 	}
 
-	void OpenGL3VertexBuffer::destroy()
+	VertexLayout OpenGL3VertexBuffer::getVertexLayout() const
 	{
-		if (mBufferID != 0)
-		{
-			glDeleteBuffers(1, &mBufferID);
-			mBufferID = 0;
-		}
-		if (mVAOID != 0)
-		{
-			glDeleteVertexArrays(1, &mVAOID);
-			mVAOID = 0;
-		}
+		return mVertexLayout;
 	}
 
-	void OpenGL3VertexBuffer::resize()
+	void OpenGL3VertexBuffer::setRange(size_t _offset, size_t _size)
 	{
-		mVertexCount = mNeedVertexCount + VERTEX_BUFFER_REALLOCK_STEP;
-		destroy();
-		create();
+		mRangeOffset = _offset;
+		mRangeSize = _size;
+		// content of new range is undefined
+		mVerticesValid = false;
 	}
 
 } // namespace MyGUI
@@ -18,6 +18,8 @@ namespace MyGUI
 		Vertex* lock() override;
 		void unlock() override;
 
+		Vertex* lockRange(size_t _start, size_t _count) override;
+
 	/*internal:*/
 		unsigned int getBufferID() const
 		{
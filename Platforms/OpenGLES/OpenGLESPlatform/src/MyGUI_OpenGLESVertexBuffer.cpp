@@ -59,6 +59,27 @@ namespace MyGUI
 		return pBuffer;
 	}
 
+	Vertex* OpenGLESVertexBuffer::lockRange(size_t _start, size_t _count)
+	{
+		// buffer will be recreated, so previous content is lost anyway
+		if (mNeedVertexCount > mVertexCount || mBufferID == 0)
+			return nullptr;
+
+		glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
+
+		Vertex* pBuffer = reinterpret_cast<Vertex*>(glMapBufferRange(
+			GL_ARRAY_BUFFER,
+			_start * sizeof(Vertex),
+			_count * sizeof(Vertex),
+			GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_WRITE_BIT));
+
+		MYGUI_PLATFORM_ASSERT(pBuffer, "Error lock vertex buffer");
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		return pBuffer;
+	}
+
 	void OpenGLESVertexBuffer::unlock()
 	{
 		MYGUI_PLATFORM_ASSERT(mBufferID, "Vertex buffer in not created");
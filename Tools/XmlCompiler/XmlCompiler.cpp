@@ -0,0 +1,59 @@
+/*
+ * This source file is part of MyGUI. For the latest info, see http://mygui.info/
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MyGUI_XmlDocument.h"
+
+#include <iostream>
+#include <cstring>
+
+namespace
+{
+
+	void printUsage()
+	{
+		std::cout << "Converts MyGUI xml files (layouts, skins, resources) to compiled binary format and back." << std::endl;
+		std::cout << "Usage: XmlCompiler [-d] <source> <destination>" << std::endl;
+		std::cout << "  -d  convert compiled file back to xml" << std::endl;
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	bool decompile = argc == 4 && strcmp(argv[1], "-d") == 0;
+	if (argc != 3 && !decompile)
+	{
+		printUsage();
+		return 1;
+	}
+
+	const char* source = argv[argc - 2];
+	const char* destination = argv[argc - 1];
+
+	// both formats are detected automatically
+	MyGUI::xml::Document document;
+	if (!document.open(std::string(source)))
+	{
+		std::cerr << source << ": " << document.getLastError() << std::endl;
+		return 1;
+	}
+
+	std::ofstream stream(destination, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!stream.is_open())
+	{
+		std::cerr << destination << ": failed to create file" << std::endl;
+		return 1;
+	}
+
+	bool result = decompile ? document.save(stream) : document.saveBinary(stream);
+	if (!result)
+	{
+		std::cerr << destination << ": " << document.getLastError() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
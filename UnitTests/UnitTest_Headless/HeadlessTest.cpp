@@ -0,0 +1,231 @@
+/*!
+	@file
+	@brief Tests running without window on top of the dummy render system
+*/
+#include "HeadlessTest.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+
+	std::atomic<size_t> allocationCount(0);
+	std::string mediaPath;
+
+}
+
+void* operator new(size_t _size)
+{
+	++allocationCount;
+	void* result = std::malloc(_size != 0 ? _size : 1);
+	if (result == nullptr)
+		throw std::bad_alloc();
+	return result;
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	std::free(_pointer);
+}
+
+namespace test
+{
+
+	TestCase::TestCase(const std::string& _name) :
+		mName(_name)
+	{
+		getTests().push_back(this);
+	}
+
+	const std::string& TestCase::getName() const
+	{
+		return mName;
+	}
+
+	std::vector<TestCase*>& TestCase::getTests()
+	{
+		static std::vector<TestCase*> tests;
+		return tests;
+	}
+
+	void check(bool _value, const char* _expression, const char* _file, int _line)
+	{
+		if (!_value)
+			throw MyGUI::Exception(std::string("check failed: ") + _expression, "HeadlessTest", _file, _line);
+	}
+
+	size_t getAllocationCount()
+	{
+		return allocationCount;
+	}
+
+	const std::string& getMediaPath()
+	{
+		return mediaPath;
+	}
+
+	VertexCapture::VertexCapture() :
+		mBatchCount(0)
+	{
+	}
+
+	void VertexCapture::doRender(MyGUI::IVertexBuffer* _buffer, MyGUI::ITexture* _texture, size_t _count)
+	{
+		mBatchCount++;
+
+		std::vector<size_t> indices;
+		if (_buffer->getIndexedQuads())
+		{
+			indices.resize(_count / MyGUI::IndexedVertexQuad::VertexCount * MyGUI::IndexedVertexQuad::IndexCount);
+			MyGUI::IndexedVertexQuad::fillIndices(indices.data(), 0, _count / MyGUI::IndexedVertexQuad::VertexCount);
+		}
+		else
+		{
+			for (size_t index = 0; index < _count; ++index)
+				indices.push_back(index);
+		}
+
+		// render target maps positions of buffer that keeps transform
+		MyGUI::FloatPoint scale = _buffer->getPositionScale();
+		MyGUI::FloatPoint offset = _buffer->getPositionOffset();
+
+		MyGUI::Vertex* vertices = _buffer->lock();
+		bool compact = _buffer->getVertexLayout() == MyGUI::VertexLayout::Compact;
+		for (std::vector<size_t>::const_iterator index = indices.begin(); index != indices.end(); ++index)
+		{
+			CapturedVertex vertex;
+			if (compact)
+			{
+				const MyGUI::CompactVertex& source = reinterpret_cast<const MyGUI::CompactVertex*>(vertices)[*index];
+				vertex.x = (float)source.x / MyGUI::CompactVertex::PositionScale;
+				vertex.y = (float)source.y / MyGUI::CompactVertex::PositionScale;
+				vertex.colour = source.colour;
+				vertex.u = (float)source.u / MyGUI::CompactVertex::TexCoordScale;
+				vertex.v = (float)source.v / MyGUI::CompactVertex::TexCoordScale;
+			}
+			else
+			{
+				const MyGUI::Vertex& source = vertices[*index];
+				vertex.x = source.x;
+				vertex.y = source.y;
+				vertex.colour = source.colour;
+				vertex.u = source.u;
+				vertex.v = source.v;
+			}
+			vertex.x = vertex.x * scale.left + offset.left;
+			vertex.y = vertex.y * scale.top + offset.top;
+			mVertices.push_back(vertex);
+		}
+		_buffer->unlock();
+	}
+
+	const MyGUI::RenderTargetInfo& VertexCapture::getInfo() const
+	{
+		return MyGUI::DummyRenderManager::getInstance().getInfo();
+	}
+
+	const VectorCapturedVertex& VertexCapture::capture(bool _update)
+	{
+		mVertices.clear();
+		mBatchCount = 0;
+		MyGUI::LayerManager::getInstance().renderToTarget(this, _update);
+		return mVertices;
+	}
+
+	size_t VertexCapture::getBatchCount() const
+	{
+		return mBatchCount;
+	}
+
+	MyGUI::EditText* getEditText(MyGUI::EditBox* _edit)
+	{
+		MyGUI::ISubWidgetText* text = _edit->getSubWidgetText();
+		if (_edit->getClientWidget() != nullptr && _edit->getClientWidget()->getSubWidgetText() != nullptr)
+			text = _edit->getClientWidget()->getSubWidgetText();
+		return text != nullptr ? text->castType<MyGUI::EditText>(false) : nullptr;
+	}
+
+	bool equalVertices(const VectorCapturedVertex& _left, const VectorCapturedVertex& _right, float _tolerance)
+	{
+		if (_left.size() != _right.size())
+			return false;
+
+		for (size_t index = 0; index < _left.size(); ++index)
+		{
+			const CapturedVertex& left = _left[index];
+			const CapturedVertex& right = _right[index];
+			if (std::fabs(left.x - right.x) > _tolerance ||
+				std::fabs(left.y - right.y) > _tolerance ||
+				std::fabs(left.u - right.u) > _tolerance ||
+				std::fabs(left.v - right.v) > _tolerance ||
+				left.colour != right.colour)
+				return false;
+		}
+
+		return true;
+	}
+
+} // namespace test
+
+int main(int argc, char* argv[])
+{
+	mediaPath = argc > 1 ? argv[1] : MYGUI_MEDIA_DIR;
+	std::string name = argc > 2 ? argv[2] : "";
+
+	MyGUI::DummyPlatform* platform = new MyGUI::DummyPlatform();
+	MyGUI::LogManager::getInstance().setSTDOutputEnabled(false);
+	platform->initialise("UnitTest_Headless.log");
+
+	platform->getDataManagerPtr()->addResourceLocation(mediaPath + "/MyGUI_Media", false);
+	platform->getRenderManagerPtr()->setViewSize(1024, 768);
+
+	if (!platform->getDataManagerPtr()->isDataExist("MyGUI_Core.xml"))
+	{
+		std::cerr << "MyGUI media not found in '" << mediaPath << "'" << std::endl;
+		platform->shutdown();
+		delete platform;
+		return 1;
+	}
+
+	MyGUI::Gui* gui = new MyGUI::Gui();
+	gui->initialise();
+
+	int failed = 0;
+	size_t count = 0;
+	const std::vector<test::TestCase*>& tests = test::TestCase::getTests();
+	for (std::vector<test::TestCase*>::const_iterator item = tests.begin(); item != tests.end(); ++item)
+	{
+		if (!name.empty() && (*item)->getName() != name)
+			continue;
+
+		count ++;
+		try
+		{
+			(*item)->run();
+			std::cout << "passed: " << (*item)->getName() << std::endl;
+		}
+		catch (const MyGUI::Exception& _exception)
+		{
+			std::cout << "failed: " << (*item)->getName() << ": " << _exception.getFullDescription() << std::endl;
+			failed ++;
+		}
+	}
+
+	gui->shutdown();
+	delete gui;
+
+	platform->shutdown();
+	delete platform;
+
+	if (count == 0)
+	{
+		std::cerr << "test '" << name << "' not found" << std::endl;
+		return 1;
+	}
+
+	return failed != 0 ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+/*!
+	@file
+	@brief Tests running without window on top of the dummy render system
+*/
+#ifndef HEADLESS_TEST_H_
+#define HEADLESS_TEST_H_
+
+#include "MyGUI.h"
+#include "MyGUI_DummyPlatform.h"
+#include "MyGUI_EditText.h"
+
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+	class TestCase
+	{
+	public:
+		TestCase(const std::string& _name);
+		virtual ~TestCase() { }
+
+		const std::string& getName() const;
+
+		/** Run test, failed check throws */
+		virtual void run() = 0;
+
+		static std::vector<TestCase*>& getTests();
+
+	private:
+		std::string mName;
+	};
+
+	void check(bool _value, const char* _expression, const char* _file, int _line);
+
+	/** Number of memory allocations made with operator new since start */
+	size_t getAllocationCount();
+
+	/** Media folder passed to test runner */
+	const std::string& getMediaPath();
+
+	struct CapturedVertex
+	{
+		float x;
+		float y;
+		MyGUI::uint32 colour;
+		float u;
+		float v;
+	};
+	typedef std::vector<CapturedVertex> VectorCapturedVertex;
+
+	/** Render target collecting drawn vertices as triangle list in clip space,
+		indexed quads and compact vertices are expanded, position transform of buffer is applied.
+	*/
+	class VertexCapture :
+		public MyGUI::IRenderTarget
+	{
+	public:
+		VertexCapture();
+
+		void begin() override { }
+		void end() override { }
+
+		void doRender(MyGUI::IVertexBuffer* _buffer, MyGUI::ITexture* _texture, size_t _count) override;
+
+		const MyGUI::RenderTargetInfo& getInfo() const override;
+
+		/** Render all layers and return drawn vertices */
+		const VectorCapturedVertex& capture(bool _update = false);
+
+		/** Number of doRender calls in last capture */
+		size_t getBatchCount() const;
+
+	private:
+		VectorCapturedVertex mVertices;
+		size_t mBatchCount;
+	};
+
+	/** Text sub widget that EditBox edits */
+	MyGUI::EditText* getEditText(MyGUI::EditBox* _edit);
+
+	/** Compare vertices with tolerance for positions and texture coordinates */
+	bool equalVertices(const VectorCapturedVertex& _left, const VectorCapturedVertex& _right, float _tolerance);
+
+} // namespace test
+
+#define TEST_CHECK(_expression) test::check((_expression), #_expression, __FILE__, __LINE__)
+
+#define HEADLESS_TEST(_name) \
+	class _name##Test : \
+		public test::TestCase \
+	{ \
+	public: \
+		_name##Test() : test::TestCase(#_name) { } \
+		void run() override; \
+	}; \
+	static _name##Test _name##Instance; \
+	void _name##Test::run()
+
+#endif // HEADLESS_TEST_H_
@@ -0,0 +1,183 @@
+/*!
+	@file
+	@brief Controller manager tests
+*/
+#include "HeadlessTest.h"
+
+namespace
+{
+
+	// same controllers with other type names, manager updates them one by one with addTime
+	class GenericFadeAlpha :
+		public MyGUI::ControllerFadeAlpha
+	{
+		MYGUI_RTTI_DERIVED( GenericFadeAlpha )
+	};
+
+	class GenericPosition :
+		public MyGUI::ControllerPosition
+	{
+		MYGUI_RTTI_DERIVED( GenericPosition )
+	};
+
+	class ActionCounter
+	{
+	public:
+		ActionCounter() :
+			mUpdates(0),
+			mPosts(0)
+		{
+		}
+
+		void subscribe(MyGUI::ControllerItem* _item)
+		{
+			_item->eventUpdateAction += MyGUI::newDelegate(this, &ActionCounter::notifyUpdate);
+			_item->eventPostAction += MyGUI::newDelegate(this, &ActionCounter::notifyPost);
+		}
+
+		void notifyUpdate(MyGUI::Widget* /*_sender*/, MyGUI::ControllerItem* /*_item*/)
+		{
+			mUpdates ++;
+		}
+
+		void notifyPost(MyGUI::Widget* /*_sender*/, MyGUI::ControllerItem* /*_item*/)
+		{
+			mPosts ++;
+		}
+
+		size_t mUpdates;
+		size_t mPosts;
+	};
+
+	MyGUI::Widget* createWidget(const MyGUI::IntCoord& _coord, float _alpha)
+	{
+		MyGUI::Widget* widget = MyGUI::Gui::getInstance().createWidget<MyGUI::Widget>("PanelEmpty", _coord, MyGUI::Align::Default, "Main");
+		widget->setAlpha(_alpha);
+		return widget;
+	}
+
+	// frames of different length, as with real frame rate
+	float getFrameTime(size_t _frame)
+	{
+		return 0.005f + 0.003f * (float)(_frame % 7);
+	}
+
+	void customMoveFunction(const MyGUI::IntCoord& _startRect, const MyGUI::IntCoord& _destRect, MyGUI::IntCoord& _result, float _k)
+	{
+		MyGUI::action::linearMoveFunction(_startRect, _destRect, _result, _k * _k);
+	}
+
+	// frames are run until both controllers are finished, widgets have to be the same after every frame
+	bool runSame(MyGUI::Widget* _track, const ActionCounter& _trackCounter, MyGUI::Widget* _generic, const ActionCounter& _genericCounter)
+	{
+		for (size_t frame = 0; frame < 1000; ++frame)
+		{
+			MyGUI::Gui::getInstance().frameEvent(getFrameTime(frame));
+
+			if (_track->getAlpha() != _generic->getAlpha() ||
+				_track->getCoord() != _generic->getCoord() ||
+				_trackCounter.mUpdates != _genericCounter.mUpdates ||
+				_trackCounter.mPosts != _genericCounter.mPosts)
+				return false;
+
+			if (_trackCounter.mPosts != 0)
+				return _trackCounter.mPosts == 1;
+		}
+		return false;
+	}
+
+	bool compareFadeAlpha(float _start, float _alpha, float _coef)
+	{
+		MyGUI::Widget* track = createWidget(MyGUI::IntCoord(0, 0, 10, 10), _start);
+		MyGUI::Widget* generic = createWidget(MyGUI::IntCoord(0, 0, 10, 10), _start);
+
+		MyGUI::ControllerManager& manager = MyGUI::ControllerManager::getInstance();
+		MyGUI::ControllerFadeAlpha* trackItem = manager.createItem(MyGUI::ControllerFadeAlpha::getClassTypeName())->castType<MyGUI::ControllerFadeAlpha>();
+		GenericFadeAlpha* genericItem = new GenericFadeAlpha();
+
+		ActionCounter trackCounter;
+		ActionCounter genericCounter;
+		MyGUI::ControllerFadeAlpha* items[] = { trackItem, genericItem };
+		for (size_t index = 0; index < 2; ++index)
+		{
+			items[index]->setAlpha(_alpha);
+			items[index]->setCoef(_coef);
+		}
+		trackCounter.subscribe(trackItem);
+		genericCounter.subscribe(genericItem);
+		manager.addItem(track, trackItem);
+		manager.addItem(generic, genericItem);
+
+		bool result = runSame(track, trackCounter, generic, genericCounter) && track->getAlpha() == _alpha;
+
+		MyGUI::WidgetManager::getInstance().destroyWidget(track);
+		MyGUI::WidgetManager::getInstance().destroyWidget(generic);
+		return result;
+	}
+
+	bool comparePosition(const std::string& _function, bool _custom, bool _position, bool _size)
+	{
+		MyGUI::IntCoord start(17, 31, 120, 45);
+		MyGUI::IntCoord dest(403, -12, 77, 260);
+		MyGUI::Widget* track = createWidget(start, 1.0f);
+		MyGUI::Widget* generic = createWidget(start, 1.0f);
+
+		MyGUI::ControllerManager& manager = MyGUI::ControllerManager::getInstance();
+		MyGUI::ControllerPosition* trackItem = manager.createItem(MyGUI::ControllerPosition::getClassTypeName())->castType<MyGUI::ControllerPosition>();
+		GenericPosition* genericItem = new GenericPosition();
+
+		ActionCounter trackCounter;
+		ActionCounter genericCounter;
+		MyGUI::ControllerPosition* items[] = { trackItem, genericItem };
+		for (size_t index = 0; index < 2; ++index)
+		{
+			items[index]->setTime(0.37f);
+			if (_custom)
+				items[index]->setAction(MyGUI::newDelegate(customMoveFunction));
+			else
+				items[index]->setFunction(_function);
+
+			if (_position && _size)
+				items[index]->setCoord(dest);
+			else if (_position)
+				items[index]->setPosition(dest.point());
+			else
+				items[index]->setSize(dest.size());
+		}
+		trackCounter.subscribe(trackItem);
+		genericCounter.subscribe(genericItem);
+		manager.addItem(track, trackItem);
+		manager.addItem(generic, genericItem);
+
+		bool result = runSame(track, trackCounter, generic, genericCounter) && trackCounter.mUpdates > 10;
+		if (_position)
+			result = result && track->getPosition() == dest.point();
+		if (_size)
+			result = result && track->getSize() == dest.size();
+
+		MyGUI::WidgetManager::getInstance().destroyWidget(track);
+		MyGUI::WidgetManager::getInstance().destroyWidget(generic);
+		return result;
+	}
+
+}
+
+HEADLESS_TEST(controller_tracks)
+{
+	// fade up and down, ends exactly at target alpha
+	TEST_CHECK(compareFadeAlpha(0.0f, 1.0f, 1.3f));
+	TEST_CHECK(compareFadeAlpha(1.0f, 0.0f, 2.7f));
+	TEST_CHECK(compareFadeAlpha(0.2f, 0.65f, 0.9f));
+	TEST_CHECK(compareFadeAlpha(0.8f, 0.35f, 5.0f));
+	TEST_CHECK(compareFadeAlpha(0.5f, 0.5f, 1.0f));
+
+	// every move function with coordinate, position and size
+	const char* functions[] = { "Linear", "Inertional", "Accelerated", "Slowed", "Jump" };
+	for (size_t index = 0; index < sizeof(functions) / sizeof(functions[0]); ++index)
+	{
+		TEST_CHECK(comparePosition(functions[index], false, true, true));
+		TEST_CHECK(comparePosition(functions[index], false, true, false));
+		TEST_CHECK(comparePosition(functions[index], false, false, true));
+	}
+	TEST_CHECK(comparePosition(std::string(), true, true, true));
+}
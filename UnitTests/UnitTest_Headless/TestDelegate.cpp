@@ -0,0 +1,150 @@
+/*!
+	@file
+	@brief Delegate and multi delegate tests
+*/
+#include "HeadlessTest.h"
+
+namespace
+{
+
+	class Counter
+	{
+	public:
+		Counter() :
+			mCount(0)
+		{
+		}
+
+		void notify(int _value)
+		{
+			mCount += _value;
+		}
+
+		int mCount;
+	};
+
+	int staticCount = 0;
+
+	void notifyStatic(int _value)
+	{
+		staticCount += _value;
+	}
+
+	// Handler that unsubscribes itself and subscribes another one while being invoked.
+	class Resubscriber
+	{
+	public:
+		Resubscriber(MyGUI::delegates::MultiDelegate<int>& _event, Counter& _other) :
+			mEvent(_event),
+			mOther(_other),
+			mCount(0)
+		{
+		}
+
+		void notify(int _value)
+		{
+			mCount += _value;
+			mEvent -= MyGUI::newDelegate(MyGUI::delegates::byValue, this, &Resubscriber::notify);
+			for (int index = 0; index < 10; ++index)
+				mEvent += MyGUI::newDelegate(MyGUI::delegates::byValue, MyGUI::delegates::DelegateFunction<int>::Function(notifyStatic), index);
+			mEvent += MyGUI::newDelegate(MyGUI::delegates::byValue, &mOther, &Counter::notify);
+		}
+
+		MyGUI::delegates::MultiDelegate<int>& mEvent;
+		Counter& mOther;
+		int mCount;
+	};
+
+}
+
+HEADLESS_TEST(delegate_compare)
+{
+	Counter first;
+	Counter second;
+
+	MyGUI::delegates::MultiDelegate<int> event;
+	event += MyGUI::newDelegate(&first, &Counter::notify);
+	event += MyGUI::newDelegate(&second, &Counter::notify);
+	event += MyGUI::newDelegate(notifyStatic);
+	event(1);
+	TEST_CHECK(first.mCount == 1 && second.mCount == 1 && staticCount == 1);
+
+	// only delegate with the same object and method is removed
+	event -= MyGUI::newDelegate(&first, &Counter::notify);
+	event(1);
+	TEST_CHECK(first.mCount == 1 && second.mCount == 2 && staticCount == 2);
+
+	event -= MyGUI::newDelegate(notifyStatic);
+	event(1);
+	TEST_CHECK(second.mCount == 3 && staticCount == 2);
+
+	event -= MyGUI::newDelegate(&second, &Counter::notify);
+	TEST_CHECK(event.empty());
+
+	// delegates with the same target are equal
+	typedef MyGUI::delegates::DelegateFunction<int> IDelegate;
+	IDelegate* delegate = MyGUI::newDelegate(&first, &Counter::notify);
+	IDelegate* same = MyGUI::newDelegate(&first, &Counter::notify);
+	IDelegate* other = MyGUI::newDelegate(&second, &Counter::notify);
+	IDelegate* function = MyGUI::newDelegate(notifyStatic);
+	TEST_CHECK(delegate->compare(same));
+	TEST_CHECK(!delegate->compare(other));
+	TEST_CHECK(!delegate->compare(function));
+	TEST_CHECK(!function->compare(delegate));
+	TEST_CHECK(delegate->compare(MyGUI::newDelegate(MyGUI::delegates::byValue, &first, &Counter::notify)));
+	delete delegate;
+	delete same;
+	delete other;
+	delete function;
+}
+
+HEADLESS_TEST(delegate_allocations)
+{
+	Counter first;
+	Counter second;
+	staticCount = 0;
+
+	MyGUI::delegates::MultiDelegate<int> event;
+	event += MyGUI::newDelegate(MyGUI::delegates::byValue, &first, &Counter::notify);
+	event += MyGUI::newDelegate(MyGUI::delegates::byValue, &second, &Counter::notify);
+	event += MyGUI::newDelegate(MyGUI::delegates::byValue, notifyStatic);
+	event -= MyGUI::newDelegate(MyGUI::delegates::byValue, notifyStatic);
+
+	// delegates passed by value are kept in the vector without allocation of their own
+	size_t allocations = test::getAllocationCount();
+	for (int index = 0; index < 100; ++index)
+	{
+		event += MyGUI::newDelegate(MyGUI::delegates::byValue, notifyStatic);
+		event(1);
+		event -= MyGUI::newDelegate(MyGUI::delegates::byValue, notifyStatic);
+	}
+	TEST_CHECK(test::getAllocationCount() == allocations);
+	TEST_CHECK(first.mCount == 100 && second.mCount == 100 && staticCount == 100);
+
+	// delegates created with new are allocated once for every subscription and unsubscription
+	allocations = test::getAllocationCount();
+	for (int index = 0; index < 100; ++index)
+	{
+		event += MyGUI::newDelegate(notifyStatic);
+		event -= MyGUI::newDelegate(notifyStatic);
+	}
+	TEST_CHECK(test::getAllocationCount() == allocations + 200);
+
+	// handler changes subscriptions while it is invoked, vector is reallocated under it
+	Counter third;
+	Resubscriber resubscriber(event, third);
+	event += MyGUI::newDelegate(MyGUI::delegates::byValue, &resubscriber, &Resubscriber::notify);
+	staticCount = 0;
+	event(1);
+	TEST_CHECK(resubscriber.mCount == 1 && third.mCount == 1 && staticCount == 10);
+	event(1);
+	TEST_CHECK(resubscriber.mCount == 1 && third.mCount == 2 && staticCount == 20);
+
+	// std::function delegates are removed by id
+	event -= MyGUI::newDelegate(MyGUI::delegates::byValue, MyGUI::delegates::DelegateFunction<int>::Function(notifyStatic), 3);
+	event(1);
+	TEST_CHECK(staticCount == 29);
+
+	event.clear();
+	TEST_CHECK(event.empty());
+}
@@ -0,0 +1,66 @@
+/*!
+	@file
+	@brief EditBox rendering tests
+*/
+#include "HeadlessTest.h"
+
+namespace
+{
+
+	// Vertices of frame with only visible lines tessellated must be the same as with all lines.
+	void checkVisibleLines(test::VertexCapture& _capture, MyGUI::EditText* _text)
+	{
+		_text->setVisibleLinesOnly(true);
+		test::VectorCapturedVertex visible = _capture.capture();
+		_text->setVisibleLinesOnly(false);
+		test::VectorCapturedVertex full = _capture.capture();
+		_text->setVisibleLinesOnly(true);
+
+		TEST_CHECK(!visible.empty());
+		TEST_CHECK(test::equalVertices(visible, full, 0.0f));
+	}
+
+}
+
+HEADLESS_TEST(edit_visible_lines)
+{
+	MyGUI::EditBox* edit = MyGUI::Gui::getInstance().createWidget<MyGUI::EditBox>("EditBoxStretch", 10, 20, 400, 300, MyGUI::Align::Default, "Main");
+	edit->setEditMultiLine(true);
+	edit->setTextShadow(true);
+
+	// colour tags before visible lines change colour of visible ones
+	std::string text;
+	for (size_t index = 0; index < 500; ++index)
+	{
+		text += index % 7 == 0 ? "#FF0000" : "";
+		text += "line " + MyGUI::utility::toString(index) + " of scrolled text, long enough to stick out of view on the right side";
+		text += index % 11 == 0 ? " #00FF00green" : "";
+		text += "\n";
+	}
+	edit->setCaption(text);
+
+	MyGUI::EditText* editText = test::getEditText(edit);
+	TEST_CHECK(editText != nullptr);
+
+	test::VertexCapture capture;
+	checkVisibleLines(capture, editText);
+
+	// scrolled to the middle, position is not multiple of line height
+	edit->setVScrollPosition(edit->getVScrollRange() / 2 + 5);
+	edit->setTextSelection(edit->getTextLength() / 2 - 300, edit->getTextLength() / 2 + 300);
+	checkVisibleLines(capture, editText);
+
+	edit->setHScrollPosition(37);
+	checkVisibleLines(capture, editText);
+
+	// end of text
+	edit->setVScrollPosition(edit->getVScrollRange());
+	checkVisibleLines(capture, editText);
+
+	// word wrap makes more lines than paragraphs
+	edit->setEditWordWrap(true);
+	edit->setVScrollPosition(edit->getVScrollRange() / 3 + 3);
+	checkVisibleLines(capture, editText);
+
+	MyGUI::WidgetManager::getInstance().destroyWidget(edit);
+}
@@ -0,0 +1,292 @@
+/*!
+	@file
+	@brief True type font rendering tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_ResourceTrueTypeFont.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+
+	struct RenderedFont
+	{
+		std::vector<MyGUI::uint8> texture;
+		MyGUI::VectorGlyphInfo glyphs;
+		int width;
+		int height;
+	};
+
+	// Enough glyphs for several rendering threads.
+	const MyGUI::Char codePointRanges[][2] = { { 32, 126 }, { 160, 591 }, { 1024, 1279 } };
+
+	MyGUI::ResourceTrueTypeFont* createFont(float _size)
+	{
+		MyGUI::ResourceTrueTypeFont* font = MyGUI::FactoryManager::getInstance().createObject<MyGUI::ResourceTrueTypeFont>(MyGUI::ResourceManager::getInstance().getCategoryName());
+		font->setSource("DejaVuSans.ttf");
+		font->setSize(_size);
+		for (size_t index = 0; index < sizeof(codePointRanges) / sizeof(codePointRanges[0]); ++index)
+			font->addCodePointRange(codePointRanges[index][0], codePointRanges[index][1]);
+		return font;
+	}
+
+	RenderedFont getRenderedFont(MyGUI::ResourceTrueTypeFont* _font)
+	{
+		// lazy font renders glyphs on request, so texture is read after all of them
+		for (size_t index = 0; index < sizeof(codePointRanges) / sizeof(codePointRanges[0]); ++index)
+		{
+			for (MyGUI::Char code = codePointRanges[index][0]; code <= codePointRanges[index][1]; ++code)
+				_font->getGlyphInfo(code);
+		}
+
+		RenderedFont result;
+		MyGUI::ITexture* texture = _font->getTextureFont();
+		TEST_CHECK(texture != nullptr);
+		result.width = texture->getWidth();
+		result.height = texture->getHeight();
+		const MyGUI::uint8* data = static_cast<const MyGUI::uint8*>(texture->lock(MyGUI::TextureUsage::Read));
+		TEST_CHECK(data != nullptr);
+		result.texture.assign(data, data + (size_t)result.width * result.height * texture->getNumElemBytes());
+		texture->unlock();
+
+		for (size_t index = 0; index < sizeof(codePointRanges) / sizeof(codePointRanges[0]); ++index)
+		{
+			for (MyGUI::Char code = codePointRanges[index][0]; code <= codePointRanges[index][1]; ++code)
+				result.glyphs.push_back(*_font->getGlyphInfo(code));
+		}
+
+		return result;
+	}
+
+	RenderedFont renderFont(int _threadCount, bool _antialias, bool _msdfMode)
+	{
+		MyGUI::ResourceTrueTypeFont* font = createFont(_msdfMode ? 24.0f : 14.0f);
+		font->setAntialias(_antialias);
+		font->setMsdfMode(_msdfMode);
+		font->setRenderThreadCount(_threadCount);
+		font->initialise();
+
+		RenderedFont result = getRenderedFont(font);
+		delete font;
+		return result;
+	}
+
+	bool equalGlyphs(const MyGUI::VectorGlyphInfo& _left, const MyGUI::VectorGlyphInfo& _right)
+	{
+		if (_left.size() != _right.size())
+			return false;
+
+		for (size_t index = 0; index < _left.size(); ++index)
+		{
+			const MyGUI::GlyphInfo& left = _left[index];
+			const MyGUI::GlyphInfo& right = _right[index];
+			if (left.codePoint != right.codePoint || left.width != right.width || left.height != right.height ||
+				left.advance != right.advance || left.bearingX != right.bearingX || left.bearingY != right.bearingY ||
+				left.uvRect != right.uvRect)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Pixels of glyph in texture, found from its texture coordinates.
+	std::vector<MyGUI::uint8> getGlyphPixels(const RenderedFont& _font, const MyGUI::GlyphInfo& _glyph)
+	{
+		size_t numBytes = _font.texture.size() / ((size_t)_font.width * _font.height);
+		int left = (int)(_glyph.uvRect.left * _font.width + 0.5f);
+		int top = (int)(_glyph.uvRect.top * _font.height + 0.5f);
+		int width = (int)std::ceil(_glyph.width);
+		int height = (int)std::ceil(_glyph.height);
+
+		std::vector<MyGUI::uint8> result;
+		for (int y = top; y < top + height; ++y)
+		{
+			const MyGUI::uint8* row = &_font.texture[((size_t)y * _font.width + left) * numBytes];
+			result.insert(result.end(), row, row + width * numBytes);
+		}
+		return result;
+	}
+
+	// Rendered glyphs don't overlap and are inside of texture.
+	bool checkGlyphPlaces(const MyGUI::VectorGlyphInfo& _glyphs, int _width, int _height)
+	{
+		std::vector<MyGUI::IntCoord> places;
+		for (size_t index = 0; index < _glyphs.size(); ++index)
+		{
+			const MyGUI::GlyphInfo& glyph = _glyphs[index];
+			MyGUI::IntCoord place((int)(glyph.uvRect.left * _width + 0.5f), (int)(glyph.uvRect.top * _height + 0.5f), (int)std::ceil(glyph.width), (int)std::ceil(glyph.height));
+			if (place.left < 0 || place.top < 0 || place.right() > _width || place.bottom() > _height)
+				return false;
+			if (place.width == 0 || place.height == 0)
+				continue;
+
+			for (size_t other = 0; other < places.size(); ++other)
+			{
+				if (places[other].left < place.right() && place.left < places[other].right() &&
+					places[other].top < place.bottom() && place.top < places[other].bottom())
+					return false;
+			}
+			places.push_back(place);
+		}
+		return true;
+	}
+
+	// Glyphs rendered on several threads must be the same as rendered on the calling thread only.
+	void checkThreads(bool _antialias, bool _msdfMode)
+	{
+		RenderedFont single = renderFont(1, _antialias, _msdfMode);
+		TEST_CHECK(!single.texture.empty());
+
+		const int threadCounts[] = { 2, 5 };
+		for (size_t index = 0; index < sizeof(threadCounts) / sizeof(threadCounts[0]); ++index)
+		{
+			RenderedFont threaded = renderFont(threadCounts[index], _antialias, _msdfMode);
+			TEST_CHECK(threaded.width == single.width && threaded.height == single.height);
+			TEST_CHECK(threaded.texture == single.texture);
+			TEST_CHECK(equalGlyphs(threaded.glyphs, single.glyphs));
+		}
+	}
+
+}
+
+HEADLESS_TEST(font_render_threads)
+{
+	checkThreads(false, false);
+	checkThreads(true, false);
+#ifdef MYGUI_MSDF_FONTS
+	checkThreads(false, true);
+#endif
+}
+
+HEADLESS_TEST(font_cache_key)
+{
+	// Empty file in a known location, so the cache is not written next to the font.
+	const char* cacheFile = "UnitTest_Headless_font.cache";
+	{
+		std::ofstream stream(cacheFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	}
+	MyGUI::DummyDataManager::getInstance().addResourceLocation(".", false);
+
+	MyGUI::ResourceTrueTypeFont* font = createFont(14.0f);
+	font->setCacheFile(cacheFile);
+	font->initialise();
+	RenderedFont small = getRenderedFont(font);
+	delete font;
+
+	// Mark the texture in the cache, so it is visible whether the cache was used.
+	{
+		std::fstream stream(cacheFile, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+		stream.seekp(-1, std::ios_base::end);
+		stream.put((char)(small.texture.back() ^ 0xFF));
+	}
+	small.texture.back() ^= 0xFF;
+
+	font = createFont(14.0f);
+	font->setCacheFile(cacheFile);
+	font->initialise();
+	TEST_CHECK(getRenderedFont(font).texture == small.texture);
+
+	// Changed size must not reuse the cache of the old one, neither on another initialisation of the same font.
+	MyGUI::ResourceTrueTypeFont* reference = createFont(20.0f);
+	reference->initialise();
+	RenderedFont large = getRenderedFont(reference);
+	delete reference;
+
+	font->setSize(20.0f);
+	font->initialise();
+	RenderedFont cached = getRenderedFont(font);
+	TEST_CHECK(cached.width == large.width && cached.height == large.height);
+	TEST_CHECK(cached.texture == large.texture);
+	TEST_CHECK(equalGlyphs(cached.glyphs, large.glyphs));
+	delete font;
+
+	// Cache was rewritten for the new size, another font of that size gets it.
+	font = createFont(20.0f);
+	font->setCacheFile(cacheFile);
+	font->initialise();
+	TEST_CHECK(getRenderedFont(font).texture == large.texture);
+
+	// Removed code points are not restored from the cache either.
+	font->removeCodePointRange(1024, 1279);
+	font->initialise();
+	TEST_CHECK(font->getGlyphInfo(1025) == font->getGlyphInfo(MyGUI::FontCodeType::NotDefined));
+	TEST_CHECK(font->getGlyphInfo(65) != font->getGlyphInfo(MyGUI::FontCodeType::NotDefined));
+	delete font;
+
+	std::remove(cacheFile);
+}
+
+HEADLESS_TEST(font_lazy_atlas)
+{
+	MyGUI::ResourceTrueTypeFont* reference = createFont(14.0f);
+	reference->initialise();
+	RenderedFont full = getRenderedFont(reference);
+	delete reference;
+
+	MyGUI::ResourceTrueTypeFont* font = createFont(14.0f);
+	font->setLazyMode(true);
+	font->initialise();
+
+	// only special glyphs are rendered at start, texture is small
+	MyGUI::ITexture* texture = font->getTextureFont();
+	int startWidth = texture->getWidth();
+	int startHeight = texture->getHeight();
+	TEST_CHECK(startWidth * startHeight < full.width * full.height);
+
+	// glyph is rendered on first request, the same one is returned after
+	size_t version = font->getTextureVersion();
+	const MyGUI::GlyphInfo* glyph = font->getGlyphInfo('A');
+	TEST_CHECK(glyph != font->getGlyphInfo(MyGUI::FontCodeType::NotDefined));
+	TEST_CHECK(font->getGlyphInfo('A') == glyph);
+	TEST_CHECK(font->getTextureVersion() == version);
+
+	// all glyphs make texture grow, coordinates of rendered ones change with it
+	RenderedFont lazy = getRenderedFont(font);
+	TEST_CHECK(lazy.width * lazy.height > startWidth * startHeight);
+	TEST_CHECK(font->getTextureVersion() != version);
+	TEST_CHECK(checkGlyphPlaces(lazy.glyphs, lazy.width, lazy.height));
+
+	// metrics and pixels are the same as of glyphs rendered at once
+	TEST_CHECK(lazy.glyphs.size() == full.glyphs.size());
+	for (size_t index = 0; index < lazy.glyphs.size(); ++index)
+	{
+		const MyGUI::GlyphInfo& left = lazy.glyphs[index];
+		const MyGUI::GlyphInfo& right = full.glyphs[index];
+		TEST_CHECK(left.codePoint == right.codePoint && left.width == right.width && left.height == right.height &&
+			left.advance == right.advance && left.bearingX == right.bearingX && left.bearingY == right.bearingY);
+		TEST_CHECK(getGlyphPixels(lazy, left) == getGlyphPixels(full, right));
+	}
+
+	// code point out of font definition gets substitute glyph without rendering
+	version = font->getTextureVersion();
+	TEST_CHECK(font->getGlyphInfo(0x4E00) == font->getGlyphInfo(MyGUI::FontCodeType::NotDefined));
+	TEST_CHECK(font->getTextureVersion() == version);
+	delete font;
+
+	// texture doesn't grow over its limit, least recently used glyphs are evicted for new ones
+	font = createFont(14.0f);
+	font->setLazyMode(true);
+	font->setLazyMaxTextureSize(128);
+	font->initialise();
+	version = font->getTextureVersion();
+	lazy = getRenderedFont(font);
+	TEST_CHECK(lazy.width <= 128 && lazy.height <= 128);
+	TEST_CHECK(font->getTextureVersion() != version);
+
+	// last glyph is still rendered, special glyphs are kept
+	version = font->getTextureVersion();
+	MyGUI::GlyphInfo last = *font->getGlyphInfo(codePointRanges[2][1]);
+	TEST_CHECK(font->getTextureVersion() == version);
+	TEST_CHECK(last.uvRect == lazy.glyphs.back().uvRect);
+	const MyGUI::GlyphInfo* cursor = font->getGlyphInfo(MyGUI::FontCodeType::Cursor);
+	TEST_CHECK(cursor->width > 0.0f && font->getTextureVersion() == version);
+
+	// evicted glyph is rendered again into the same texture
+	const MyGUI::GlyphInfo* first = font->getGlyphInfo(codePointRanges[0][0] + 1);
+	TEST_CHECK(first->uvRect.right <= 1.0f && first->uvRect.bottom <= 1.0f);
+	TEST_CHECK(font->getTextureFont()->getWidth() <= 128 && font->getTextureFont()->getHeight() <= 128);
+	delete font;
+}
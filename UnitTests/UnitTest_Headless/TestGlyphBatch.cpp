@@ -0,0 +1,80 @@
+/*!
+	@file
+	@brief Glyph batch SIMD against scalar tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_GlyphBatch.h"
+
+#include <cstring>
+
+namespace
+{
+
+	void checkWrite(const MyGUI::GlyphBatch& _batch, const MyGUI::FloatRect& _clip, float _left, float _top, const MyGUI::RenderTargetInfo& _info)
+	{
+		std::vector<MyGUI::Vertex> simd(_batch.size() * MyGUI::IndexedVertexQuad::VertexCount);
+		std::vector<MyGUI::Vertex> scalar(simd.size());
+
+		size_t count = _batch.write(simd.data(), _clip, _left, _top, 0.5f, _info);
+		TEST_CHECK(count == _batch.writeScalar(scalar.data(), _clip, _left, _top, 0.5f, _info));
+		TEST_CHECK(count % MyGUI::IndexedVertexQuad::VertexCount == 0);
+		// the same operations in the same order, results are bit exact
+		TEST_CHECK(count == 0 || memcmp(simd.data(), scalar.data(), count * sizeof(MyGUI::Vertex)) == 0);
+	}
+
+}
+
+HEADLESS_TEST(glyph_batch_simd)
+{
+	MyGUI::RenderTargetInfo info;
+	info.setOffset(0, 0);
+	info.pixScaleX = 1.0f / 1024.0f;
+	info.pixScaleY = 1.0f / 768.0f;
+	info.hOffset = 0.0f;
+	info.vOffset = 0.0f;
+
+	const MyGUI::FloatRect clip(100.0f, 50.0f, 300.0f, 150.0f);
+	const MyGUI::FloatRect texture(0.25f, 0.5f, 0.2578125f, 0.5234375f);
+
+	MyGUI::GlyphBatch batch;
+	// inside
+	batch.add(MyGUI::FloatRect(150.0f, 80.0f, 158.0f, 92.0f), texture, 0xFF000001);
+	// partially clipped from every side and at corners
+	batch.add(MyGUI::FloatRect(96.5f, 80.0f, 104.5f, 92.0f), texture, 0xFF000002);
+	batch.add(MyGUI::FloatRect(295.5f, 80.0f, 303.5f, 92.0f), texture, 0xFF000003);
+	batch.add(MyGUI::FloatRect(150.0f, 45.0f, 158.0f, 57.0f), texture, 0xFF000004);
+	batch.add(MyGUI::FloatRect(150.0f, 144.0f, 158.0f, 156.0f), texture, 0xFF000005);
+	batch.add(MyGUI::FloatRect(97.0f, 46.0f, 105.0f, 58.0f), texture, 0xFF000006);
+	batch.add(MyGUI::FloatRect(296.0f, 145.0f, 304.0f, 157.0f), texture, 0xFF000007);
+	// clipped completely from every side, touching edges too
+	batch.add(MyGUI::FloatRect(80.0f, 80.0f, 88.0f, 92.0f), texture, 0xFF000008);
+	batch.add(MyGUI::FloatRect(92.0f, 80.0f, 100.0f, 92.0f), texture, 0xFF000009);
+	batch.add(MyGUI::FloatRect(300.0f, 80.0f, 308.0f, 92.0f), texture, 0xFF00000A);
+	batch.add(MyGUI::FloatRect(150.0f, 30.0f, 158.0f, 42.0f), texture, 0xFF00000B);
+	batch.add(MyGUI::FloatRect(150.0f, 38.0f, 158.0f, 50.0f), texture, 0xFF00000C);
+	batch.add(MyGUI::FloatRect(150.0f, 150.0f, 158.0f, 162.0f), texture, 0xFF00000D);
+	// bigger than clip
+	batch.add(MyGUI::FloatRect(90.0f, 40.0f, 310.0f, 160.0f), texture, 0xFF00000E);
+	// count is not multiple of four, the rest goes through scalar code in both
+	batch.add(MyGUI::FloatRect(200.0f, 100.0f, 208.0f, 112.0f), texture, 0xFF00000F);
+
+	checkWrite(batch, clip, 0.0f, 0.0f, info);
+	checkWrite(batch, clip, 12.5f, -7.25f, info);
+
+	// random quads around clip, all combinations in groups of four
+	unsigned int seed = 1;
+	MyGUI::GlyphBatch random;
+	for (size_t index = 0; index < 1001; ++index)
+	{
+		seed = seed * 1103515245 + 12345;
+		float left = 60.0f + (float)((seed >> 16) % 2800) / 10.0f;
+		seed = seed * 1103515245 + 12345;
+		float top = 20.0f + (float)((seed >> 16) % 1600) / 10.0f;
+		random.add(MyGUI::FloatRect(left, top, left + 9.0f, top + 14.0f), texture, 0xFF000000 | (MyGUI::uint32)index);
+	}
+
+	checkWrite(random, clip, 0.0f, 0.0f, info);
+	info.hOffset = 0.5f / 1024.0f;
+	info.vOffset = 0.5f / 768.0f;
+	checkWrite(random, clip, 3.0f, 5.0f, info);
+}
@@ -0,0 +1,327 @@
+/*!
+	@file
+	@brief ListBox and MultiListBox tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_IListBoxDataSource.h"
+#include "MyGUI_BiIndexBase.h"
+
+namespace
+{
+
+	class RowSource :
+		public MyGUI::IListBoxDataSource
+	{
+	public:
+		RowSource(size_t _count) :
+			mCount(_count),
+			mSortColumn(MyGUI::ITEM_NONE),
+			mSortAscending(true),
+			mSortCount(0),
+			mNameCount(0)
+		{
+		}
+
+		size_t getItemCount() const override
+		{
+			return mCount;
+		}
+
+		MyGUI::UString getItemNameAt(size_t _index, size_t _column) const override
+		{
+			mNameCount++;
+			return getName(_index, _column);
+		}
+
+		void sortItems(size_t _column, bool _ascending) override
+		{
+			mSortColumn = _column;
+			mSortAscending = _ascending;
+			mSortCount++;
+		}
+
+		std::string getName(size_t _index, size_t _column) const
+		{
+			size_t row = mSortAscending ? _index : mCount - _index - 1;
+			return MyGUI::utility::toString("row ", row, " column ", _column);
+		}
+
+		size_t mCount;
+		size_t mSortColumn;
+		bool mSortAscending;
+		size_t mSortCount;
+		mutable size_t mNameCount;
+	};
+
+	template <typename Type>
+	void findChildren(MyGUI::Widget* _widget, std::vector<Type*>& _result)
+	{
+		for (size_t index = 0; index < _widget->getChildCount(); ++index)
+		{
+			MyGUI::Widget* child = _widget->getChildAt(index);
+			if (child->isType<Type>())
+				_result.push_back(child->castType<Type>());
+			findChildren(child, _result);
+		}
+	}
+
+	// Clicks header of column with mouse, header is between top of list and top of column.
+	bool clickHeader(MyGUI::MultiListBox* _list, MyGUI::ListBox* _column, const MyGUI::UString& _caption)
+	{
+		int left = _column->getAbsoluteLeft() + _column->getWidth() / 2;
+		int top = (_list->getAbsoluteTop() + _column->getAbsoluteTop()) / 2;
+
+		MyGUI::Widget* widget = MyGUI::LayerManager::getInstance().getWidgetFromPoint(left, top);
+		while (widget != nullptr && !widget->isType<MyGUI::Button>())
+			widget = widget->getParent();
+		if (widget == nullptr || widget->castType<MyGUI::Button>()->getCaption() != _caption)
+			return false;
+
+		MyGUI::InputManager& input = MyGUI::InputManager::getInstance();
+		input.injectMouseMove(left, top, 0);
+		input.injectMousePress(left, top, MyGUI::MouseButton::Left);
+		input.injectMouseRelease(left, top, MyGUI::MouseButton::Left);
+		return true;
+	}
+
+	// Lines of list in view show rows of source.
+	void checkVisibleLines(MyGUI::ListBox* _list, const RowSource& _source, size_t _column)
+	{
+		size_t count = 0;
+		for (size_t index = 0; index < _list->getItemCount(); ++index)
+		{
+			MyGUI::Widget* line = _list->getWidgetByIndex(index);
+			if (line == nullptr || !line->getVisible())
+			{
+				if (count != 0)
+					break;
+				continue;
+			}
+
+			TEST_CHECK(line->castType<MyGUI::Button>()->getCaption() == _source.getName(index, _column));
+			count++;
+		}
+		TEST_CHECK(count != 0);
+	}
+
+	bool throwsException(void (*_function)(MyGUI::ListBox*), MyGUI::ListBox* _list)
+	{
+		try
+		{
+			_function(_list);
+		}
+		catch (const MyGUI::Exception& _exception)
+		{
+			return _exception.getDescription().find("virtual mode") != std::string::npos;
+		}
+		return false;
+	}
+
+	void removeItem(MyGUI::ListBox* _list)
+	{
+		_list->removeItemAt(1);
+	}
+
+	void setItemName(MyGUI::ListBox* _list)
+	{
+		_list->setItemNameAt(1, "name");
+	}
+
+	void getItemName(MyGUI::ListBox* _list)
+	{
+		_list->getItemNameAt(1);
+	}
+
+	void swapItems(MyGUI::ListBox* _list)
+	{
+		_list->swapItemsAt(1, 2);
+	}
+
+	class BiIndex :
+		public MyGUI::BiIndexBase
+	{
+	public:
+		using MyGUI::BiIndexBase::insertItemAt;
+		using MyGUI::BiIndexBase::convertToBack;
+		using MyGUI::BiIndexBase::convertToFace;
+		using MyGUI::BiIndexBase::permuteItemsBack;
+	};
+
+	// row inserted at index N has key of column 0 and N as name of column 1 and as data
+	const char* sortKeys[] = { "b", "a", "c", "b", "a", "b", "c", "a" };
+	const size_t sortRowCount = sizeof(sortKeys) / sizeof(sortKeys[0]);
+
+	// rows are found by the same indexes as before sorting
+	bool checkRows(MyGUI::MultiListBox* _list)
+	{
+		for (size_t index = 0; index < sortRowCount; ++index)
+		{
+			if (_list->getSubItemNameAt(0, index) != sortKeys[index] ||
+				_list->getSubItemNameAt(1, index) != MyGUI::utility::toString(index) ||
+				*_list->getItemDataAt<size_t>(index) != index)
+				return false;
+		}
+		return true;
+	}
+
+	// rows in view as "key:index"
+	std::string getLines(const std::vector<MyGUI::ListBox*>& _columns)
+	{
+		std::string result;
+		for (size_t index = 0; index < _columns[0]->getItemCount(); ++index)
+		{
+			if (!result.empty())
+				result += " ";
+			result += _columns[0]->getItemNameAt(index) + ":" + _columns[1]->getItemNameAt(index);
+		}
+		return result;
+	}
+
+	void compareIndexBackward(MyGUI::MultiListBox* /*_sender*/, size_t /*_column*/, size_t _left, size_t _right, bool& _less)
+	{
+		_less = _right < _left;
+	}
+
+}
+
+HEADLESS_TEST(list_virtual_mode)
+{
+	const size_t rowCount = 1000000;
+	RowSource source(rowCount);
+
+	MyGUI::ListBox* list = MyGUI::Gui::getInstance().createWidget<MyGUI::ListBox>("ListBox", 10, 10, 200, 300, MyGUI::Align::Default, "Main");
+	list->addItem("removed by data source");
+	list->setDataSource(&source);
+	TEST_CHECK(list->getItemCount() == rowCount);
+	checkVisibleLines(list, source, 0);
+
+	// only visible lines are requested
+	TEST_CHECK(source.mNameCount < 100);
+
+	list->beginToItemAt(rowCount / 2);
+	checkVisibleLines(list, source, 0);
+	list->beginToItemAt(rowCount - 1);
+	checkVisibleLines(list, source, 0);
+
+	// items have no names in virtual mode, editing methods report it instead of range error
+	TEST_CHECK(list->findItemIndexWith(source.getName(1, 0)) == MyGUI::ITEM_NONE);
+	TEST_CHECK(throwsException(removeItem, list));
+	TEST_CHECK(throwsException(setItemName, list));
+	TEST_CHECK(throwsException(getItemName, list));
+	TEST_CHECK(throwsException(swapItems, list));
+
+	// selection is kept while row exists
+	list->setIndexSelected(5);
+	source.mCount = 8;
+	list->updateDataSource();
+	TEST_CHECK(list->getItemCount() == 8);
+	TEST_CHECK(list->getIndexSelected() == 5);
+	checkVisibleLines(list, source, 0);
+
+	source.mCount = 3;
+	list->updateDataSource();
+	TEST_CHECK(list->getIndexSelected() == MyGUI::ITEM_NONE);
+
+	list->setDataSource(nullptr);
+	TEST_CHECK(list->getItemCount() == 0);
+	MyGUI::WidgetManager::getInstance().destroyWidget(list);
+
+	// columns of MultiListBox show their cells, sorting is done by source
+	source.mCount = rowCount;
+	MyGUI::MultiListBox* multiList = MyGUI::Gui::getInstance().createWidget<MyGUI::MultiListBox>("MultiListBox", 10, 10, 400, 300, MyGUI::Align::Default, "Main");
+	multiList->addColumn("first", 150);
+	multiList->addColumn("second", 150);
+	multiList->setDataSource(&source);
+	TEST_CHECK(multiList->getItemCount() == rowCount);
+
+	std::vector<MyGUI::ListBox*> columns;
+	findChildren(multiList, columns);
+	TEST_CHECK(columns.size() == 2);
+	checkVisibleLines(columns[0], source, 0);
+	checkVisibleLines(columns[1], source, 1);
+
+	TEST_CHECK(clickHeader(multiList, columns[1], "second"));
+	TEST_CHECK(source.mSortCount == 1 && source.mSortColumn == 1 && source.mSortAscending);
+
+	// second click on the same header reverses order
+	TEST_CHECK(clickHeader(multiList, columns[1], "second"));
+	TEST_CHECK(source.mSortCount == 2 && source.mSortColumn == 1 && !source.mSortAscending);
+	checkVisibleLines(columns[0], source, 0);
+	checkVisibleLines(columns[1], source, 1);
+
+	multiList->setIndexSelected(rowCount - 1);
+	source.mCount = 10;
+	multiList->updateDataSource();
+	TEST_CHECK(multiList->getItemCount() == 10);
+	TEST_CHECK(multiList->getIndexSelected() == MyGUI::ITEM_NONE);
+
+	MyGUI::WidgetManager::getInstance().destroyWidget(multiList);
+}
+
+HEADLESS_TEST(list_sort)
+{
+	// permutation of data side indexes and its inverse give back the same mapping
+	const size_t count = 10;
+	BiIndex biIndex;
+	for (size_t index = 0; index < count; ++index)
+		biIndex.insertItemAt(index);
+
+	std::vector<size_t> order(count);
+	std::vector<size_t> inverse(count);
+	for (size_t index = 0; index < count; ++index)
+	{
+		order[index] = (index * 7 + 3) % count;
+		inverse[order[index]] = index;
+	}
+
+	biIndex.permuteItemsBack(order);
+	for (size_t index = 0; index < count; ++index)
+	{
+		TEST_CHECK(biIndex.convertToFace(index) == order[index]);
+		TEST_CHECK(biIndex.convertToBack(order[index]) == index);
+	}
+
+	biIndex.permuteItemsBack(inverse);
+	for (size_t index = 0; index < count; ++index)
+		TEST_CHECK(biIndex.convertToFace(index) == index && biIndex.convertToBack(index) == index);
+
+	MyGUI::MultiListBox* list = MyGUI::Gui::getInstance().createWidget<MyGUI::MultiListBox>("MultiListBox", 10, 10, 400, 300, MyGUI::Align::Default, "Main");
+	list->addColumn("key", 150);
+	list->addColumn("index", 150);
+	for (size_t index = 0; index < sortRowCount; ++index)
+	{
+		list->addItem(sortKeys[index], index);
+		list->setSubItemNameAt(1, index, MyGUI::utility::toString(index));
+	}
+	list->setIndexSelected(3);
+
+	std::vector<MyGUI::ListBox*> columns;
+	findChildren(list, columns);
+	TEST_CHECK(columns.size() == 2);
+
+	// rows with equal keys keep their order
+	list->sortByColumn(0);
+	TEST_CHECK(getLines(columns) == "a:1 a:4 a:7 b:0 b:3 b:5 c:2 c:6");
+	TEST_CHECK(checkRows(list));
+	TEST_CHECK(list->getIndexSelected() == 3);
+
+	// second sort by the same column reverses rows
+	list->sortByColumn(0, true);
+	TEST_CHECK(getLines(columns) == "c:6 c:2 b:5 b:3 b:0 a:7 a:4 a:1");
+	TEST_CHECK(checkRows(list));
+	TEST_CHECK(list->getIndexSelected() == 3);
+
+	// names are compared as strings, sorting by unique column restores order of insertion
+	list->sortByColumn(1);
+	TEST_CHECK(getLines(columns) == "b:0 a:1 c:2 b:3 a:4 b:5 c:6 a:7");
+	TEST_CHECK(checkRows(list));
+
+	// comparison delegate gets indexes of rows as they were inserted
+	list->requestOperatorLess = MyGUI::newDelegate(compareIndexBackward);
+	list->sortByColumn(0);
+	TEST_CHECK(getLines(columns) == "a:7 c:6 b:5 a:4 b:3 c:2 a:1 b:0");
+	TEST_CHECK(checkRows(list));
+	TEST_CHECK(list->getIndexSelected() == 3);
+
+	MyGUI::WidgetManager::getInstance().destroyWidget(list);
+}
@@ -0,0 +1,77 @@
+/*!
+	@file
+	@brief Overlapped layer pick grid tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_OverlappedLayer.h"
+
+namespace
+{
+
+	MyGUI::OverlappedLayer* getOverlappedLayer()
+	{
+		return dynamic_cast<MyGUI::OverlappedLayer*>(MyGUI::LayerManager::getInstance().getByName("Overlapped"));
+	}
+
+	// Widgets picked over the view with pick grid enabled and disabled must be the same.
+	void checkPick()
+	{
+		MyGUI::OverlappedLayer* layer = getOverlappedLayer();
+		MyGUI::LayerManager& manager = MyGUI::LayerManager::getInstance();
+
+		std::vector<MyGUI::Widget*> picked;
+		layer->setPickGrid(false);
+		for (int top = 0; top < 768; top += 7)
+		{
+			for (int left = 0; left < 1024; left += 5)
+				picked.push_back(manager.getWidgetFromPoint(left, top));
+		}
+
+		layer->setPickGrid(true);
+		size_t index = 0;
+		for (int top = 0; top < 768; top += 7)
+		{
+			for (int left = 0; left < 1024; left += 5)
+				TEST_CHECK(manager.getWidgetFromPoint(left, top) == picked[index++]);
+		}
+	}
+
+}
+
+HEADLESS_TEST(pick_grid)
+{
+	MyGUI::Widget* panel = MyGUI::Gui::getInstance().createWidget<MyGUI::Widget>("PanelEmpty", 0, 0, 1024, 768, MyGUI::Align::Default, "Overlapped");
+
+	// overlapping children of different sizes, some of them hidden or disabled
+	unsigned int seed = 1;
+	std::vector<MyGUI::Widget*> children;
+	for (size_t index = 0; index < 300; ++index)
+	{
+		seed = seed * 1103515245 + 12345;
+		int left = (int)((seed >> 16) % 1000);
+		seed = seed * 1103515245 + 12345;
+		int top = (int)((seed >> 16) % 750);
+		int size = 8 + (int)(index % 5) * 30;
+		MyGUI::Widget* child = panel->createWidget<MyGUI::Button>("Button", left, top, size, size / 2, MyGUI::Align::Default);
+		child->setVisible(index % 13 != 0);
+		child->setEnabled(index % 17 != 0);
+		children.push_back(child);
+	}
+	checkPick();
+
+	// moved children must be found at new place
+	for (size_t index = 0; index < children.size(); index += 3)
+		children[index]->setPosition(children[index]->getLeft() + 40, children[index]->getTop() - 20);
+	checkPick();
+
+	// below threshold grid is dropped, picking still works
+	while (children.size() > 10)
+	{
+		MyGUI::WidgetManager::getInstance().destroyWidget(children.back());
+		children.pop_back();
+	}
+	checkPick();
+
+	getOverlappedLayer()->setPickGrid(false);
+	MyGUI::WidgetManager::getInstance().destroyWidget(panel);
+}
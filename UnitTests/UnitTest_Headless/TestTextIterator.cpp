@@ -0,0 +1,197 @@
+/*!
+	@file
+	@brief Text buffer, text iterator and in place editing tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_TextIterator.h"
+
+namespace
+{
+
+	bool equalText(const MyGUI::TextBuffer& _buffer, const MyGUI::UString::utf32string& _text)
+	{
+		if (_buffer.size() != _text.size() || _buffer.str() != _text)
+			return false;
+
+		for (size_t index = 0; index < _text.size(); ++index)
+		{
+			if (_buffer[index] != _text[index])
+				return false;
+		}
+
+		size_t tags = 0;
+		for (size_t index = 0; index < _text.size(); ++index)
+			tags += _text[index] == '#' ? 1 : 0;
+		return _buffer.getTagCharCount() == tags;
+	}
+
+	void pressKey(MyGUI::KeyCode _key, MyGUI::Char _char, bool _control = false)
+	{
+		MyGUI::InputManager& input = MyGUI::InputManager::getInstance();
+		if (_control)
+			input.injectKeyPress(MyGUI::KeyCode::LeftControl);
+		input.injectKeyPress(_key, _char);
+		input.injectKeyRelease(_key);
+		if (_control)
+			input.injectKeyRelease(MyGUI::KeyCode::LeftControl);
+	}
+
+}
+
+HEADLESS_TEST(text_buffer_gap)
+{
+	MyGUI::UString::utf32string text = MyGUI::UString("start #FF0000text").asUTF32();
+	MyGUI::TextBuffer buffer(text);
+	TEST_CHECK(equalText(buffer, text));
+
+	// edits at random places, gap moves both ways and grows
+	unsigned int seed = 1;
+	for (size_t step = 0; step < 2000; ++step)
+	{
+		seed = seed * 1103515245 + 12345;
+		size_t position = (seed >> 16) % (text.size() + 1);
+		seed = seed * 1103515245 + 12345;
+		size_t count = (seed >> 16) % (step % 50 == 0 ? 300 : 5);
+
+		if (step % 3 == 2)
+		{
+			buffer.erase(position, count);
+			text.erase(position, (std::min)(count, text.size() - position));
+		}
+		else
+		{
+			MyGUI::UString::utf32string insert;
+			for (size_t index = 0; index < count; ++index)
+				insert.push_back(index % 7 == 0 ? '#' : (MyGUI::UString::unicode_char)('a' + (step + index) % 26));
+			buffer.insert(position, insert);
+			text.insert(position, insert);
+		}
+
+		if (step % 100 == 0)
+			TEST_CHECK(equalText(buffer, text));
+	}
+	TEST_CHECK(equalText(buffer, text));
+
+	// parts on both sides of gap
+	buffer.erase(text.size() / 2, 0);
+	buffer.insert(text.size() / 2, MyGUI::UString::utf32string());
+	TEST_CHECK(buffer.substr(text.size() / 3, text.size() / 3) == text.substr(text.size() / 3, text.size() / 3));
+	TEST_CHECK(buffer.substr(text.size() / 2) == text.substr(text.size() / 2));
+
+	buffer.clear();
+	TEST_CHECK(buffer.empty() && buffer.getTagCharCount() == 0);
+	buffer.insert(0, text);
+	TEST_CHECK(equalText(buffer, text));
+
+	buffer.assign(MyGUI::UString::utf32string());
+	TEST_CHECK(equalText(buffer, MyGUI::UString::utf32string()));
+}
+
+HEADLESS_TEST(text_iterator_copy)
+{
+	MyGUI::UString text("first #FF0000red#000000 line\nsecond line");
+	MyGUI::TextIterator iterator(text);
+	for (size_t index = 0; index < 7; ++index)
+		iterator.moveNext();
+
+	// copy owns its own text
+	MyGUI::TextIterator copy(iterator);
+	TEST_CHECK(copy.getPosition() == iterator.getPosition());
+	TEST_CHECK(copy.getText() == iterator.getText());
+
+	copy.insertText("new ", true);
+	TEST_CHECK(copy.getText() != iterator.getText());
+	TEST_CHECK(iterator.getText() == text);
+
+	// assigned iterator continues from the same position
+	MyGUI::TextIterator assigned(MyGUI::UString("other"));
+	assigned = iterator;
+	TEST_CHECK(assigned.getPosition() == iterator.getPosition());
+	assigned.moveNext();
+	iterator.moveNext();
+	TEST_CHECK(assigned.getPosition() == iterator.getPosition());
+
+	assigned.clearText();
+	TEST_CHECK(assigned.getText().empty());
+	TEST_CHECK(iterator.getText() == text);
+
+	// iterator over external text edits it in place, copy shares it
+	MyGUI::TextBuffer external(text.asUTF32());
+	MyGUI::TextIterator inPlace(external);
+	MyGUI::TextIterator inPlaceCopy(inPlace);
+	inPlaceCopy.insertText("a", true);
+	TEST_CHECK(external.size() == text.asUTF32().size() + 1);
+
+	// skip is the same as moving over text without tags, text with tags must be walked
+	MyGUI::TextIterator skipped(MyGUI::UString("plain text"));
+	TEST_CHECK(skipped.skipTo(6));
+	TEST_CHECK(skipped.moveNext() && skipped.getPosition() == 6);
+	TEST_CHECK(!skipped.skipTo(8));
+	TEST_CHECK(skipped.getSize() == 10);
+
+	MyGUI::TextIterator end(MyGUI::UString("plain"));
+	TEST_CHECK(end.skipTo(20));
+	TEST_CHECK(!end.moveNext() && end.getPosition() == 5);
+
+	MyGUI::TextIterator tagged(text);
+	TEST_CHECK(!tagged.skipTo(6));
+	TEST_CHECK(tagged.getPosition() == 0);
+}
+
+HEADLESS_TEST(edit_in_place)
+{
+	MyGUI::EditBox* edit = MyGUI::Gui::getInstance().createWidget<MyGUI::EditBox>("EditBoxStretch", 10, 20, 400, 300, MyGUI::Align::Default, "Main");
+	edit->setEditMultiLine(true);
+	MyGUI::InputManager::getInstance().setKeyFocusWidget(edit);
+
+	// shorter than default maximum length
+	std::string text;
+	for (size_t index = 0; index < 80; ++index)
+		text += "line " + MyGUI::utility::toString(index) + " of edited text\n";
+	edit->setCaption(text);
+
+	// typing in the middle and at the end of text without tags
+	MyGUI::UString expected(text);
+	edit->insertText("typed", 100);
+	expected.insert(100, "typed");
+	edit->insertText("end", edit->getTextLength());
+	expected.append("end");
+	edit->eraseText(10, 3);
+	expected.erase(10, 3);
+	TEST_CHECK(edit->getCaption() == expected);
+	TEST_CHECK(edit->getTextLength() == expected.size());
+	TEST_CHECK(edit->getOnlyText() == expected);
+
+	// typed text is saved in history, undo and redo apply it to the same text
+	MyGUI::UString typed(expected);
+	edit->setTextCursor(50);
+	pressKey(MyGUI::KeyCode::A, 'a');
+	pressKey(MyGUI::KeyCode::B, 'b');
+	pressKey(MyGUI::KeyCode::Backspace, 0);
+	pressKey(MyGUI::KeyCode::Delete, 0);
+	typed.insert(50, "a");
+	typed.erase(51, 1);
+	TEST_CHECK(edit->getCaption() == typed);
+
+	for (size_t index = 0; index < 10; ++index)
+		pressKey(MyGUI::KeyCode::Z, 0, true);
+	TEST_CHECK(edit->getCaption() == expected);
+	for (size_t index = 0; index < 10; ++index)
+		pressKey(MyGUI::KeyCode::Y, 0, true);
+	TEST_CHECK(edit->getCaption() == typed);
+
+	// positions skip colour tags once text has them
+	edit->setCaption(expected);
+	edit->setTextIntervalColour(0, 4, MyGUI::Colour::Red);
+	TEST_CHECK(edit->getTextLength() == expected.size());
+	edit->insertText("x", 2);
+	expected.insert(2, "x");
+	TEST_CHECK(edit->getOnlyText() == expected);
+	edit->eraseText(20, 5);
+	expected.erase(20, 5);
+	TEST_CHECK(edit->getOnlyText() == expected);
+	TEST_CHECK(edit->getTextInterval(0, 5) == MyGUI::UString("#FF0000") + expected.substr(0, 5));
+
+	MyGUI::InputManager::getInstance().resetKeyFocusWidget();
+	MyGUI::WidgetManager::getInstance().destroyWidget(edit);
+}
@@ -0,0 +1,160 @@
+/*!
+	@file
+	@brief Incremental text layout tests
+*/
+#include "HeadlessTest.h"
+
+namespace
+{
+
+	unsigned int random(unsigned int& _seed, unsigned int _range)
+	{
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) % _range;
+	}
+
+	bool equalLines(const MyGUI::VectorLineInfo& _left, const MyGUI::VectorLineInfo& _right)
+	{
+		if (_left.size() != _right.size())
+			return false;
+
+		for (size_t line = 0; line < _left.size(); ++line)
+		{
+			const MyGUI::LineInfo& left = _left[line];
+			const MyGUI::LineInfo& right = _right[line];
+			if (left.width != right.width || left.offset != right.offset || left.count != right.count || left.symbols.size() != right.symbols.size())
+				return false;
+
+			for (size_t index = 0; index < left.symbols.size(); ++index)
+			{
+				const MyGUI::CharInfo& leftChar = left.symbols[index];
+				const MyGUI::CharInfo& rightChar = right.symbols[index];
+				if (leftChar.isColour() != rightChar.isColour())
+					return false;
+				if (leftChar.isColour())
+				{
+					if (leftChar.getColour() != rightChar.getColour())
+						return false;
+				}
+				else if (leftChar.getAdvance() != rightChar.getAdvance() || leftChar.getUVRect() != rightChar.getUVRect())
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Layout built from changed range must be the same as layout of the whole text.
+	void checkLayout(MyGUI::EditText* _text, unsigned int& _seed)
+	{
+		MyGUI::IntSize size = _text->getTextSize();
+		MyGUI::VectorLineInfo incremental = _text->getLineInfo();
+		std::vector<size_t> positions;
+		std::vector<MyGUI::IntCoord> cursors;
+		for (size_t index = 0; index < 8; ++index)
+		{
+			positions.push_back(random(_seed, (unsigned int)_text->getLineInfo().size() * 10 + 1));
+			cursors.push_back(_text->getCursorCoord(positions.back()));
+		}
+
+		// whole text is changed, layout is built from scratch
+		_text->setCaption(_text->getCaption());
+		TEST_CHECK(size == _text->getTextSize());
+		TEST_CHECK(equalLines(incremental, _text->getLineInfo()));
+
+		for (size_t index = 0; index < positions.size(); ++index)
+			TEST_CHECK(cursors[index] == _text->getCursorCoord(positions[index]));
+	}
+
+	void pressKey(MyGUI::KeyCode _key, bool _control, MyGUI::Char _text = 0)
+	{
+		MyGUI::InputManager& input = MyGUI::InputManager::getInstance();
+		if (_control)
+			input.injectKeyPress(MyGUI::KeyCode::LeftControl);
+		input.injectKeyPress(_key, _text);
+		input.injectKeyRelease(_key);
+		if (_control)
+			input.injectKeyRelease(MyGUI::KeyCode::LeftControl);
+	}
+
+}
+
+HEADLESS_TEST(text_layout_incremental)
+{
+	MyGUI::EditBox* edit = MyGUI::Gui::getInstance().createWidget<MyGUI::EditBox>("EditBoxStretch", 10, 20, 300, 200, MyGUI::Align::Default, "Main");
+	edit->setEditMultiLine(true);
+	edit->setCaption("first line\nsecond #FF0000red#FFFFFF line\n\nlast line");
+	MyGUI::InputManager::getInstance().setKeyFocusWidget(edit);
+
+	MyGUI::EditText* editText = test::getEditText(edit);
+	TEST_CHECK(editText != nullptr);
+
+	const char* pieces[] = { "a", " ", "\n", "word", "#FF0000", "##", "long line of several words to be wrapped", "\n\n", "#00FF00green " };
+	const size_t piecesCount = sizeof(pieces) / sizeof(pieces[0]);
+	const MyGUI::Align aligns[] = { MyGUI::Align::Default, MyGUI::Align::Center, MyGUI::Align::Right | MyGUI::Align::Bottom };
+
+	unsigned int seed = 7;
+	for (size_t step = 0; step < 600; ++step)
+	{
+		size_t length = edit->getTextLength();
+		unsigned int operation = random(seed, 100);
+		if (operation < 30)
+		{
+			edit->insertText(pieces[random(seed, piecesCount)], random(seed, (unsigned int)length + 1));
+		}
+		else if (operation < 40)
+		{
+			// typed text goes to undo history
+			edit->setTextCursor(random(seed, (unsigned int)length + 1));
+			unsigned int key = random(seed, 4);
+			if (key == 0)
+				pressKey(MyGUI::KeyCode::Return, false);
+			else if (key == 1)
+				pressKey(MyGUI::KeyCode::Space, false, ' ');
+			else
+				pressKey(MyGUI::KeyCode::A, false, 'a');
+		}
+		else if (operation < 60)
+		{
+			size_t start = random(seed, (unsigned int)length + 1);
+			edit->eraseText(start, (std::min)((size_t)random(seed, 20) + 1, length - start));
+		}
+		else if (operation < 70)
+		{
+			size_t start = random(seed, (unsigned int)length + 1);
+			edit->setTextSelection(start, start + random(seed, 30));
+			edit->setTextSelectionColour(MyGUI::Colour((float)random(seed, 2), 0.5f, 1.0f));
+		}
+		else if (operation < 80)
+		{
+			pressKey(random(seed, 2) == 0 ? MyGUI::KeyCode::Z : MyGUI::KeyCode::Y, true);
+		}
+		else if (operation < 85)
+		{
+			edit->setSize(150 + random(seed, 300), 200);
+		}
+		else if (operation < 90)
+		{
+			edit->setEditWordWrap(random(seed, 2) == 0);
+			edit->setTextAlign(aligns[random(seed, 3)]);
+		}
+		else if (operation < 93)
+		{
+			edit->setCaption(random(seed, 2) == 0 ? "" : "new #0000FFcaption\n");
+		}
+		else
+		{
+			edit->setTextCursor(random(seed, (unsigned int)length + 1));
+			pressKey(random(seed, 2) == 0 ? MyGUI::KeyCode::Backspace : MyGUI::KeyCode::Delete, false);
+		}
+
+		// several changes are merged into one range sometimes
+		if (random(seed, 3) != 0)
+			checkLayout(editText, seed);
+	}
+
+	MyGUI::InputManager::getInstance().resetKeyFocusWidget();
+	MyGUI::WidgetManager::getInstance().destroyWidget(edit);
+}
@@ -0,0 +1,214 @@
+/*!
+	@file
+	@brief Texture atlas packing tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_CommonStateInfo.h"
+
+#include <sstream>
+
+namespace
+{
+
+	const int pageSize = 32;
+
+	struct Packed
+	{
+		std::string name;
+		MyGUI::IntSize size;
+		std::string page;
+		MyGUI::IntPoint offset;
+	};
+
+	// every pixel of every texture is different, alpha is added to textures without it
+	MyGUI::uint8 getComponent(size_t _id, int _x, int _y, size_t _component, bool _alpha)
+	{
+		if (_component == 3 && !_alpha)
+			return 0xFF;
+		return (MyGUI::uint8)(_id * 50 + _x * 7 + _y * 13 + _component);
+	}
+
+	MyGUI::ITexture* createTexture(const std::string& _name, size_t _id, int _width, int _height, MyGUI::PixelFormat _format)
+	{
+		MyGUI::ITexture* texture = MyGUI::RenderManager::getInstance().createTexture(_name);
+		texture->createManual(_width, _height, MyGUI::TextureUsage::Static | MyGUI::TextureUsage::Write, _format);
+
+		size_t pixelSize = texture->getNumElemBytes();
+		MyGUI::uint8* data = static_cast<MyGUI::uint8*>(texture->lock(MyGUI::TextureUsage::Write));
+		for (int y = 0; y < _height; ++y)
+		{
+			for (int x = 0; x < _width; ++x)
+			{
+				for (size_t component = 0; component < pixelSize; ++component)
+					*data++ = getComponent(_id, x, y, component, true);
+			}
+		}
+		texture->unlock();
+
+		return texture;
+	}
+
+	bool mapTexture(const std::string& _name, Packed& _packed)
+	{
+		MyGUI::ITexture* texture = MyGUI::RenderManager::getInstance().getTexture(_name);
+		_packed.name = _name;
+		_packed.size = MyGUI::IntSize(texture->getWidth(), texture->getHeight());
+		_packed.page = _name;
+		_packed.offset = MyGUI::IntPoint(-1, -1);
+		return MyGUI::TextureAtlasManager::getInstance().mapTexture(_packed.page, _packed.offset);
+	}
+
+	// texture and one pixel around it are copied, pixels around are the nearest edge pixels
+	bool checkPixels(const Packed& _packed, size_t _id, bool _alpha)
+	{
+		MyGUI::ITexture* page = MyGUI::RenderManager::getInstance().getTexture(_packed.page);
+		if (page == nullptr || page->getFormat() != MyGUI::PixelFormat::R8G8B8A8)
+			return false;
+
+		const MyGUI::uint8* data = static_cast<const MyGUI::uint8*>(page->lock(MyGUI::TextureUsage::Read));
+		bool result = true;
+		for (int y = -1; y <= _packed.size.height; ++y)
+		{
+			for (int x = -1; x <= _packed.size.width; ++x)
+			{
+				int sourceX = (std::min)((std::max)(x, 0), _packed.size.width - 1);
+				int sourceY = (std::min)((std::max)(y, 0), _packed.size.height - 1);
+				const MyGUI::uint8* pixel = data + ((_packed.offset.top + y) * page->getWidth() + _packed.offset.left + x) * 4;
+				for (size_t component = 0; component < 4; ++component)
+				{
+					if (pixel[component] != getComponent(_id, sourceX, sourceY, component, _alpha))
+						result = false;
+				}
+			}
+		}
+		page->unlock();
+
+		return result;
+	}
+
+	// rectangles with gutter are inside of their pages and don't overlap
+	bool checkPlaces(const std::vector<Packed>& _packed)
+	{
+		for (size_t index = 0; index < _packed.size(); ++index)
+		{
+			MyGUI::IntCoord coord(_packed[index].offset.left - 1, _packed[index].offset.top - 1, _packed[index].size.width + 2, _packed[index].size.height + 2);
+			if (coord.left < 0 || coord.top < 0 || coord.right() > pageSize || coord.bottom() > pageSize)
+				return false;
+
+			for (size_t other = index + 1; other < _packed.size(); ++other)
+			{
+				if (_packed[index].page != _packed[other].page)
+					continue;
+				MyGUI::IntCoord otherCoord(_packed[other].offset.left - 1, _packed[other].offset.top - 1, _packed[other].size.width + 2, _packed[other].size.height + 2);
+				if (coord.left < otherCoord.right() && otherCoord.left < coord.right() &&
+					coord.top < otherCoord.bottom() && otherCoord.top < coord.bottom())
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void loadResources(const std::string& _data)
+	{
+		MyGUI::xml::Document document;
+		std::istringstream stream(_data);
+		if (document.open(stream))
+			MyGUI::ResourceManager::getInstance().loadFromXmlNode(document.getRoot(), "", MyGUI::Version(1, 1));
+	}
+
+	const MyGUI::FloatRect& getStateRect(const std::string& _skin)
+	{
+		MyGUI::ResourceSkin* skin = MyGUI::ResourceManager::getInstance().getByName(_skin)->castType<MyGUI::ResourceSkin>();
+		return skin->getStateInfo().find("normal")->second[0]->castType<MyGUI::SubSkinStateInfo>()->getRect();
+	}
+
+}
+
+HEADLESS_TEST(texture_atlas)
+{
+	MyGUI::TextureAtlasManager& manager = MyGUI::TextureAtlasManager::getInstance();
+	MyGUI::RenderManager& render = MyGUI::RenderManager::getInstance();
+
+	const char* names[] = { "UnitTest_Headless_A", "UnitTest_Headless_B", "UnitTest_Headless_RGB", "UnitTest_Headless_D", "UnitTest_Headless_L8", "UnitTest_Headless_Big" };
+	std::vector<MyGUI::ITexture*> textures;
+	textures.push_back(createTexture(names[0], 0, 5, 3, MyGUI::PixelFormat::R8G8B8A8));
+	textures.push_back(createTexture(names[1], 1, 20, 7, MyGUI::PixelFormat::R8G8B8A8));
+	textures.push_back(createTexture(names[2], 2, 6, 4, MyGUI::PixelFormat::R8G8B8));
+	textures.push_back(createTexture(names[3], 3, 30, 20, MyGUI::PixelFormat::R8G8B8A8));
+	textures.push_back(createTexture(names[4], 4, 4, 4, MyGUI::PixelFormat::L8));
+	textures.push_back(createTexture(names[5], 5, 31, 8, MyGUI::PixelFormat::R8G8B8A8));
+
+	// nothing is packed while atlas is disabled
+	Packed packed;
+	TEST_CHECK(!mapTexture(names[0], packed));
+	TEST_CHECK(packed.page == names[0] && packed.offset == MyGUI::IntPoint(-1, -1));
+
+	manager.setPageSize(pageSize);
+	manager.setMaxTextureSize(30);
+	manager.setEnabled(true);
+
+	// two shelves of the first page, last texture doesn't fit there and takes second page
+	std::vector<Packed> pages;
+	for (size_t index = 0; index < 4; ++index)
+	{
+		TEST_CHECK(mapTexture(names[index], packed));
+		pages.push_back(packed);
+		TEST_CHECK(checkPixels(packed, index, index != 2));
+	}
+	TEST_CHECK(checkPlaces(pages));
+	TEST_CHECK(pages[0].page == pages[1].page && pages[0].page == pages[2].page && pages[0].page != pages[3].page);
+	TEST_CHECK(pages[0].offset.top == pages[1].offset.top && pages[2].offset.top > pages[0].offset.top);
+	TEST_CHECK(manager.getTextureCount() == 4 && manager.getPageCount() == 2);
+
+	// placement is remembered, pixels of packed textures are not changed by later ones
+	TEST_CHECK(mapTexture(names[0], packed));
+	TEST_CHECK(packed.page == pages[0].page && packed.offset == pages[0].offset);
+	TEST_CHECK(checkPixels(pages[0], 0, true));
+	TEST_CHECK(checkPixels(pages[1], 1, true));
+	TEST_CHECK(manager.getTextureCount() == 4);
+
+	// format without colour and size bigger than maximum are used as is
+	TEST_CHECK(!mapTexture(names[4], packed));
+	TEST_CHECK(packed.page == names[4]);
+	TEST_CHECK(!mapTexture(names[5], packed));
+	TEST_CHECK(packed.page == names[5]);
+	TEST_CHECK(manager.getTextureCount() == 4 && manager.getPageCount() == 2);
+
+	// skin and image set coordinates point to the same pixels inside of page
+	loadResources(
+		"<MyGUI type=\"Resource\" version=\"1.1\">"
+		"<Resource type=\"ResourceSkin\" name=\"UnitTest_Headless_AtlasSkin\" size=\"3 2\" texture=\"UnitTest_Headless_B\">"
+		"<BasisSkin type=\"SubSkin\" offset=\"0 0 3 2\" align=\"Stretch\"><State name=\"normal\" offset=\"4 5 3 2\"/></BasisSkin>"
+		"</Resource>"
+		"<Resource type=\"ResourceSkin\" name=\"UnitTest_Headless_BigSkin\" size=\"3 2\" texture=\"UnitTest_Headless_Big\">"
+		"<BasisSkin type=\"SubSkin\" offset=\"0 0 3 2\" align=\"Stretch\"><State name=\"normal\" offset=\"4 5 3 2\"/></BasisSkin>"
+		"</Resource>"
+		"<Resource type=\"ResourceImageSet\" name=\"UnitTest_Headless_AtlasImages\">"
+		"<Group name=\"Group\" texture=\"UnitTest_Headless_RGB\" size=\"2 2\"><Index name=\"Index\"><Frame point=\"1 2\"/><Frame point=\"3 0\"/></Index></Group>"
+		"</Resource>"
+		"</MyGUI>");
+
+	MyGUI::ResourceSkin* skin = MyGUI::ResourceManager::getInstance().getByName("UnitTest_Headless_AtlasSkin")->castType<MyGUI::ResourceSkin>();
+	TEST_CHECK(skin->getTextureName() == pages[1].page);
+	MyGUI::IntCoord coord(4 + pages[1].offset.left, 5 + pages[1].offset.top, 3, 2);
+	TEST_CHECK(getStateRect("UnitTest_Headless_AtlasSkin") == MyGUI::CoordConverter::convertTextureCoord(coord, MyGUI::IntSize(pageSize, pageSize)));
+
+	skin = MyGUI::ResourceManager::getInstance().getByName("UnitTest_Headless_BigSkin")->castType<MyGUI::ResourceSkin>();
+	TEST_CHECK(skin->getTextureName() == names[5]);
+	TEST_CHECK(getStateRect("UnitTest_Headless_BigSkin") == MyGUI::CoordConverter::convertTextureCoord(MyGUI::IntCoord(4, 5, 3, 2), MyGUI::IntSize(31, 8)));
+
+	MyGUI::ResourceImageSet* images = MyGUI::ResourceManager::getInstance().getByName("UnitTest_Headless_AtlasImages")->castType<MyGUI::ResourceImageSet>();
+	MyGUI::ImageIndexInfo info = images->getIndexInfo("Group", "Index");
+	TEST_CHECK(info.texture == pages[2].page);
+	TEST_CHECK(info.frames.size() == 2);
+	TEST_CHECK(info.frames[0] == MyGUI::IntPoint(1, 2) + pages[2].offset);
+	TEST_CHECK(info.frames[1] == MyGUI::IntPoint(3, 0) + pages[2].offset);
+
+	MyGUI::ResourceManager::getInstance().removeByName("UnitTest_Headless_AtlasSkin");
+	MyGUI::ResourceManager::getInstance().removeByName("UnitTest_Headless_BigSkin");
+	MyGUI::ResourceManager::getInstance().removeByName("UnitTest_Headless_AtlasImages");
+
+	manager.setEnabled(false);
+	for (size_t index = 0; index < textures.size(); ++index)
+		render.destroyTexture(textures[index]);
+}
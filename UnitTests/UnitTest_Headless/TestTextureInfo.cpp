@@ -0,0 +1,200 @@
+/*!
+	@file
+	@brief Texture file header parser tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_TextureUtility.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+
+	typedef std::vector<MyGUI::uint8> VectorByte;
+
+	const char* textureFile = "UnitTest_Headless_texture.img";
+
+	void writeBigEndian16(VectorByte& _data, MyGUI::uint32 _value)
+	{
+		_data.push_back((MyGUI::uint8)(_value >> 8));
+		_data.push_back((MyGUI::uint8)_value);
+	}
+
+	void writeBigEndian32(VectorByte& _data, MyGUI::uint32 _value)
+	{
+		writeBigEndian16(_data, _value >> 16);
+		writeBigEndian16(_data, _value);
+	}
+
+	void setLittleEndian32(VectorByte& _data, size_t _offset, MyGUI::uint32 _value)
+	{
+		for (size_t index = 0; index < 4; ++index)
+			_data[_offset + index] = (MyGUI::uint8)(_value >> (index * 8));
+	}
+
+	void writeString(VectorByte& _data, const char* _value, size_t _size)
+	{
+		_data.insert(_data.end(), _value, _value + _size);
+	}
+
+	// signature and IHDR chunk with zero CRC
+	VectorByte createPng(int _width, int _height, MyGUI::uint8 _bitDepth, MyGUI::uint8 _colourType)
+	{
+		VectorByte result;
+		writeString(result, "\x89PNG\r\n\x1a\n", 8);
+		writeBigEndian32(result, 13);
+		writeString(result, "IHDR", 4);
+		writeBigEndian32(result, _width);
+		writeBigEndian32(result, _height);
+		result.push_back(_bitDepth);
+		result.push_back(_colourType);
+		result.resize(result.size() + 3 + 4, 0);
+		return result;
+	}
+
+	// magic and DDS_HEADER
+	VectorByte createDds(int _width, int _height, MyGUI::uint32 _mipCount, MyGUI::uint32 _formatFlags, MyGUI::uint32 _bitCount)
+	{
+		VectorByte result(128, 0);
+		memcpy(&result[0], "DDS ", 4);
+		setLittleEndian32(result, 4, 124);
+		setLittleEndian32(result, 8, 0x1007 | (_mipCount != 0 ? 0x20000 : 0));
+		setLittleEndian32(result, 12, _height);
+		setLittleEndian32(result, 16, _width);
+		setLittleEndian32(result, 28, _mipCount);
+		setLittleEndian32(result, 76, 32);
+		setLittleEndian32(result, 80, _formatFlags);
+		setLittleEndian32(result, 88, _bitCount);
+		return result;
+	}
+
+	// SOI, APP0 segment, fill byte and SOF0 segment
+	VectorByte createJpeg(int _width, int _height, MyGUI::uint8 _components)
+	{
+		VectorByte result;
+		writeString(result, "\xFF\xD8\xFF\xE0", 4);
+		writeBigEndian16(result, 16);
+		writeString(result, "JFIF\0\x01\x01\0\0\x01\0\x01\0\0", 14);
+		writeString(result, "\xFF\xFF\xC0", 3);
+		writeBigEndian16(result, 8 + 3 * _components);
+		result.push_back(8);
+		writeBigEndian16(result, _height);
+		writeBigEndian16(result, _width);
+		result.push_back(_components);
+		for (MyGUI::uint8 index = 0; index < _components; ++index)
+		{
+			result.push_back(index + 1);
+			result.push_back(0x11);
+			result.push_back(0);
+		}
+		writeString(result, "\xFF\xD9", 2);
+		return result;
+	}
+
+	// first _size bytes of data are written to file and read without cache
+	bool readInfo(const VectorByte& _data, size_t _size, MyGUI::texture_utility::TextureInfo& _info)
+	{
+		{
+			std::ofstream stream(textureFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+			if (_size != 0)
+				stream.write((const char*)&_data[0], _size);
+		}
+
+		_info = MyGUI::texture_utility::TextureInfo();
+		MyGUI::texture_utility::clearTextureInfo();
+		return MyGUI::texture_utility::getTextureInfo(textureFile, _info);
+	}
+
+	bool readInfo(const VectorByte& _data, MyGUI::texture_utility::TextureInfo& _info)
+	{
+		return readInfo(_data, _data.size(), _info);
+	}
+
+	bool equalInfo(const MyGUI::texture_utility::TextureInfo& _info, int _width, int _height, MyGUI::PixelFormat _format, size_t _mipCount)
+	{
+		return _info.size == MyGUI::IntSize(_width, _height) && _info.format == _format && _info.mipCount == _mipCount;
+	}
+
+	// any header cut before the last byte parser needs is rejected
+	bool rejectsTruncated(const VectorByte& _data, size_t _needed)
+	{
+		MyGUI::texture_utility::TextureInfo info;
+		for (size_t size = 0; size < _needed; ++size)
+		{
+			if (readInfo(_data, size, info))
+				return false;
+		}
+		return readInfo(_data, _needed, info);
+	}
+
+}
+
+HEADLESS_TEST(texture_info)
+{
+	MyGUI::DummyDataManager::getInstance().addResourceLocation(".", false);
+	MyGUI::texture_utility::TextureInfo info;
+
+	// PNG, colour type and bit depth from IHDR
+	TEST_CHECK(readInfo(createPng(300, 200, 8, 6), info));
+	TEST_CHECK(equalInfo(info, 300, 200, MyGUI::PixelFormat::R8G8B8A8, 1));
+	TEST_CHECK(readInfo(createPng(16, 8, 8, 0), info));
+	TEST_CHECK(equalInfo(info, 16, 8, MyGUI::PixelFormat::L8, 1));
+	TEST_CHECK(readInfo(createPng(16, 8, 8, 4), info));
+	TEST_CHECK(equalInfo(info, 16, 8, MyGUI::PixelFormat::L8A8, 1));
+	TEST_CHECK(readInfo(createPng(16, 8, 4, 3), info));
+	TEST_CHECK(equalInfo(info, 16, 8, MyGUI::PixelFormat::R8G8B8, 1));
+	TEST_CHECK(readInfo(createPng(16, 8, 16, 6), info));
+	TEST_CHECK(equalInfo(info, 16, 8, MyGUI::PixelFormat::Unknow, 1));
+	TEST_CHECK(rejectsTruncated(createPng(300, 200, 8, 6), 26));
+
+	VectorByte png = createPng(300, 200, 8, 6);
+	memcpy(&png[12], "IDAT", 4);
+	TEST_CHECK(!readInfo(png, info));
+
+	// DDS, mip count only with its flag, compressed formats stay unknown
+	const MyGUI::uint32 DDPF_ALPHAPIXELS = 0x1;
+	const MyGUI::uint32 DDPF_FOURCC = 0x4;
+	const MyGUI::uint32 DDPF_RGB = 0x40;
+	const MyGUI::uint32 DDPF_LUMINANCE = 0x20000;
+	TEST_CHECK(readInfo(createDds(256, 128, 9, DDPF_RGB | DDPF_ALPHAPIXELS, 32), info));
+	TEST_CHECK(equalInfo(info, 256, 128, MyGUI::PixelFormat::R8G8B8A8, 9));
+	TEST_CHECK(readInfo(createDds(64, 32, 0, DDPF_RGB, 24), info));
+	TEST_CHECK(equalInfo(info, 64, 32, MyGUI::PixelFormat::R8G8B8, 1));
+	TEST_CHECK(readInfo(createDds(64, 32, 7, DDPF_LUMINANCE, 8), info));
+	TEST_CHECK(equalInfo(info, 64, 32, MyGUI::PixelFormat::L8, 7));
+	TEST_CHECK(readInfo(createDds(64, 32, 1, DDPF_LUMINANCE | DDPF_ALPHAPIXELS, 16), info));
+	TEST_CHECK(equalInfo(info, 64, 32, MyGUI::PixelFormat::L8A8, 1));
+	TEST_CHECK(readInfo(createDds(512, 512, 10, DDPF_FOURCC, 0), info));
+	TEST_CHECK(equalInfo(info, 512, 512, MyGUI::PixelFormat::Unknow, 10));
+	TEST_CHECK(rejectsTruncated(createDds(256, 128, 9, DDPF_RGB | DDPF_ALPHAPIXELS, 32), 128));
+
+	VectorByte dds = createDds(256, 128, 9, DDPF_RGB | DDPF_ALPHAPIXELS, 32);
+	setLittleEndian32(dds, 4, 100);
+	TEST_CHECK(!readInfo(dds, info));
+
+	// JPEG, segments before SOF0 are skipped
+	VectorByte jpeg = createJpeg(640, 480, 3);
+	TEST_CHECK(readInfo(jpeg, info));
+	TEST_CHECK(equalInfo(info, 640, 480, MyGUI::PixelFormat::R8G8B8, 1));
+	TEST_CHECK(readInfo(createJpeg(33, 17, 1), info));
+	TEST_CHECK(equalInfo(info, 33, 17, MyGUI::PixelFormat::L8, 1));
+	// SOI, APP0, fill byte, SOF0 marker, length, precision, height, width and components
+	TEST_CHECK(rejectsTruncated(jpeg, 2 + 18 + 1 + 2 + 2 + 6));
+
+	// scan before any frame header
+	VectorByte scan;
+	writeString(scan, "\xFF\xD8\xFF\xDA", 4);
+	writeBigEndian16(scan, 8);
+	scan.resize(scan.size() + 6, 0);
+	TEST_CHECK(!readInfo(scan, info));
+
+	// unknown signature
+	VectorByte gif;
+	writeString(gif, "GIF89a", 6);
+	gif.resize(64, 0);
+	TEST_CHECK(!readInfo(gif, info));
+
+	MyGUI::texture_utility::clearTextureInfo();
+	std::remove(textureFile);
+}
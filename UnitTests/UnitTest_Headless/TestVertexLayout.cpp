@@ -0,0 +1,155 @@
+/*!
+	@file
+	@brief Vertex buffer layout tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_OverlappedLayer.h"
+
+namespace
+{
+
+	MyGUI::Window* createScene()
+	{
+		MyGUI::Gui& gui = MyGUI::Gui::getInstance();
+
+		MyGUI::Window* window = gui.createWidget<MyGUI::Window>("WindowCS", 40, 30, 500, 400, MyGUI::Align::Default, "Overlapped");
+		window->setCaption("Window");
+		for (int index = 0; index < 12; ++index)
+		{
+			MyGUI::Button* button = window->createWidget<MyGUI::Button>("Button", 10 + (index % 4) * 110, 10 + (index / 4) * 30, 100, 26, MyGUI::Align::Default);
+			button->setCaption("Button " + MyGUI::utility::toString(index));
+		}
+		window->createWidget<MyGUI::ScrollBar>("ScrollBarV", 460, 10, 16, 300, MyGUI::Align::Default);
+
+		MyGUI::EditBox* edit = gui.createWidget<MyGUI::EditBox>("EditBoxStretch", 560, 40, 300, 200, MyGUI::Align::Default, "Main");
+		edit->setEditMultiLine(true);
+		edit->setTextShadow(true);
+		std::string text;
+		for (size_t index = 0; index < 40; ++index)
+			text += "#FF8000line " + MyGUI::utility::toString(index) + "#FFFFFF with selection and clipping on the right side\n";
+		edit->setCaption(text);
+		edit->setTextSelection(10, 200);
+		edit->setVScrollPosition(25);
+
+		MyGUI::ImageBox* image = gui.createWidget<MyGUI::ImageBox>("ImageBox", 600, 300, 32, 32, MyGUI::Align::Default, "Main");
+		image->setItemResource("ArrowPointerImage");
+
+		MyGUI::ComboBox* combo = gui.createWidget<MyGUI::ComboBox>("ComboBox", 600, 400, 200, 26, MyGUI::Align::Default, "Main");
+		combo->addItem("Item");
+		combo->setIndexSelected(0);
+
+		// far out of view, its positions don't fit compact vertex
+		MyGUI::Button* far = gui.createWidget<MyGUI::Button>("Button", 9000, -7000, 100, 26, MyGUI::Align::Default, "Popup");
+		far->setCaption("Far");
+
+		return window;
+	}
+
+	// difference of positions in render target space for _steps of compact fixed point
+	float getCompactTolerance(float _steps)
+	{
+		const MyGUI::IntSize& size = MyGUI::DummyRenderManager::getInstance().getViewSize();
+		return 1.01f * _steps * 2 / ((float)(std::min)(size.width, size.height) * MyGUI::CompactVertex::PositionScale);
+	}
+
+	// Gui is initialised again to create render items with new vertex buffers.
+	test::VectorCapturedVertex captureScene(bool _indexedQuads, MyGUI::VertexLayout _layout)
+	{
+		MyGUI::DummyRenderManager& render = MyGUI::DummyRenderManager::getInstance();
+		MyGUI::Gui& gui = MyGUI::Gui::getInstance();
+
+		gui.shutdown();
+		render.setIndexedQuadsSupported(_indexedQuads);
+		render.setVertexLayout(_layout);
+		gui.initialise();
+
+		createScene();
+		test::VertexCapture capture;
+		capture.capture();
+		test::VectorCapturedVertex result = capture.capture();
+
+		gui.shutdown();
+		render.setIndexedQuadsSupported(true);
+		render.setVertexLayout(MyGUI::VertexLayout::Float);
+		gui.initialise();
+
+		return result;
+	}
+
+	// Window of pixel space layer must be drawn where it is drawn by normal layer, also after it is moved.
+	void checkPixelSpace(bool _positionTransform, MyGUI::VertexLayout _layout, float _tolerance)
+	{
+		MyGUI::DummyRenderManager& render = MyGUI::DummyRenderManager::getInstance();
+		MyGUI::Gui& gui = MyGUI::Gui::getInstance();
+
+		gui.shutdown();
+		render.setPositionTransformSupported(_positionTransform);
+		render.setVertexLayout(_layout);
+		gui.initialise();
+
+		MyGUI::OverlappedLayer* layer = dynamic_cast<MyGUI::OverlappedLayer*>(MyGUI::LayerManager::getInstance().getByName("Overlapped"));
+		TEST_CHECK(layer != nullptr);
+		MyGUI::Window* window = createScene();
+
+		test::VertexCapture capture;
+		const int positions[][2] = { { 40, 30 }, { 137, 251 }, { -60, 500 }, { 700, -20 } };
+		for (size_t index = 0; index < sizeof(positions) / sizeof(positions[0]); ++index)
+		{
+			window->setPosition(positions[index][0], positions[index][1]);
+			layer->setPixelSpace(false);
+			test::VectorCapturedVertex normal = capture.capture();
+
+			layer->setPixelSpace(true);
+			capture.capture();
+			window->setPosition(positions[index][0] + 5, positions[index][1] + 7);
+			capture.capture();
+			window->setPosition(positions[index][0], positions[index][1]);
+
+			// moved node is drawn with new transform of vertex buffer, only capture itself locks buffers
+			render.resetStatistic();
+			test::VectorCapturedVertex pixelSpace = capture.capture();
+			if (_positionTransform)
+				TEST_CHECK(render.getLockCount() == capture.getBatchCount());
+			else
+				TEST_CHECK(render.getLockCount() > capture.getBatchCount());
+
+			TEST_CHECK(!normal.empty());
+			TEST_CHECK(test::equalVertices(normal, pixelSpace, _tolerance));
+		}
+
+		layer->setPixelSpace(false);
+		gui.shutdown();
+		render.setPositionTransformSupported(true);
+		render.setVertexLayout(MyGUI::VertexLayout::Float);
+		gui.initialise();
+	}
+
+}
+
+HEADLESS_TEST(indexed_quads)
+{
+	// triangle list in buffers without index support is old VertexQuad layout,
+	// indexed quads drawn with shared index buffer make the same triangles
+	test::VectorCapturedVertex triangles = captureScene(false, MyGUI::VertexLayout::Float);
+	test::VectorCapturedVertex indexed = captureScene(true, MyGUI::VertexLayout::Float);
+	TEST_CHECK(!triangles.empty());
+	TEST_CHECK(triangles.size() % MyGUI::VertexQuad::VertexCount == 0);
+	TEST_CHECK(test::equalVertices(triangles, indexed, 0.0f));
+
+	test::VectorCapturedVertex compactTriangles = captureScene(false, MyGUI::VertexLayout::Compact);
+	test::VectorCapturedVertex compactIndexed = captureScene(true, MyGUI::VertexLayout::Compact);
+	TEST_CHECK(test::equalVertices(compactTriangles, compactIndexed, 0.0f));
+
+	// compact positions are rounded to half of step, far item falls back to float instead of clamping
+	TEST_CHECK(test::equalVertices(indexed, compactIndexed, (std::max)(getCompactTolerance(0.5f), 0.51f / MyGUI::CompactVertex::TexCoordScale)));
+}
+
+HEADLESS_TEST(pixel_space)
+{
+	checkPixelSpace(true, MyGUI::VertexLayout::Float, 1e-5f);
+	checkPixelSpace(false, MyGUI::VertexLayout::Float, 1e-5f);
+	// positions differ by rounding to fixed point, one step at most
+	checkPixelSpace(true, MyGUI::VertexLayout::Compact, getCompactTolerance(1.0f));
+	// compact layout needs position transform, buffers keep float vertices without it
+	checkPixelSpace(false, MyGUI::VertexLayout::Compact, 1e-5f);
+}
@@ -0,0 +1,64 @@
+/*!
+	@file
+	@brief Widget allocator tests
+*/
+#include "HeadlessTest.h"
+
+namespace
+{
+
+	MyGUI::WidgetAllocatorStats getStats()
+	{
+		return MyGUI::WidgetManager::getInstance().getAllocatorStats();
+	}
+
+	// Widgets with text and image sub widgets, all of them destroyed at the end.
+	void createAndDestroy()
+	{
+		MyGUI::Widget* panel = MyGUI::Gui::getInstance().createWidget<MyGUI::Widget>("PanelEmpty", 0, 0, 1024, 768, MyGUI::Align::Default, "Main");
+		for (size_t index = 0; index < 200; ++index)
+		{
+			MyGUI::Button* button = panel->createWidget<MyGUI::Button>("Button", (int)(index % 20) * 50, (int)(index / 20) * 30, 48, 28, MyGUI::Align::Default);
+			button->setCaption(MyGUI::utility::toString("button ", index));
+			panel->createWidget<MyGUI::EditBox>("EditBox", 0, 0, 100, 20, MyGUI::Align::Default);
+		}
+
+		MyGUI::WidgetManager::getInstance().destroyWidget(panel);
+		MyGUI::WidgetManager::getInstance()._deleteDelayWidgets();
+	}
+
+}
+
+HEADLESS_TEST(widget_allocator)
+{
+	// mouse pointer widget is alive all the time
+	MyGUI::WidgetAllocatorStats before = getStats();
+
+	createAndDestroy();
+	MyGUI::WidgetAllocatorStats first = getStats();
+	TEST_CHECK(first.liveObjects == before.liveObjects);
+	TEST_CHECK(first.allocations > before.allocations + 400);
+
+	// same widgets again take memory of destroyed ones
+	createAndDestroy();
+	MyGUI::WidgetAllocatorStats second = getStats();
+	TEST_CHECK(second.liveObjects == before.liveObjects);
+	TEST_CHECK(second.allocations - first.allocations == first.allocations - before.allocations);
+#ifndef MYGUI_DISABLE_WIDGET_POOL
+	TEST_CHECK(first.poolCount != 0);
+	TEST_CHECK(second.poolCount == first.poolCount);
+	TEST_CHECK(second.poolPages == first.poolPages);
+	TEST_CHECK(second.poolBlocks - second.poolFreeBlocks == before.liveObjects);
+#else
+	TEST_CHECK(second.poolCount == 0 && second.poolPages == 0);
+#endif
+
+	// only pools with live objects are kept
+	MyGUI::WidgetAllocator::trim();
+	MyGUI::WidgetAllocatorStats trimmed = getStats();
+	TEST_CHECK(trimmed.liveObjects == before.liveObjects);
+	TEST_CHECK(trimmed.poolCount <= trimmed.liveObjects);
+#ifndef MYGUI_DISABLE_WIDGET_POOL
+	TEST_CHECK(trimmed.poolPages < second.poolPages);
+#endif
+}
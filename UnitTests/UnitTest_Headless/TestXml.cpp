@@ -0,0 +1,334 @@
+/*!
+	@file
+	@brief Xml document tests
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_XmlDocument.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+	std::string saveNested(size_t _depth)
+	{
+		MyGUI::xml::Document document;
+		document.createDeclaration();
+		MyGUI::xml::ElementPtr element = document.createRoot("MyGUI");
+		for (size_t index = 1; index < _depth; ++index)
+		{
+			element = element->createChild("Widget");
+			element->addAttribute("name", MyGUI::utility::toString(index));
+		}
+		element->setContent("leaf");
+
+		std::ostringstream stream;
+		document.saveBinary(stream);
+		return stream.str();
+	}
+
+	size_t getDepth(MyGUI::xml::ElementPtr _element)
+	{
+		size_t depth = 1;
+		MyGUI::xml::ElementEnumerator child = _element->getElementEnumerator();
+		while (child.next())
+		{
+			_element = child.current();
+			child = _element->getElementEnumerator();
+			++depth;
+		}
+		return depth;
+	}
+
+	std::string compile(MyGUI::xml::Document& _document)
+	{
+		std::ostringstream stream;
+		TEST_CHECK(_document.saveBinary(stream));
+		return stream.str();
+	}
+
+	// Numbers parsed when compiling are the same as parsed from string by loaders.
+	void checkNumbers(const MyGUI::xml::CompiledAttribute& _attribute)
+	{
+		const std::string value = _attribute.getValue();
+
+		int number;
+		if (_attribute.getValue(number))
+			TEST_CHECK(number == MyGUI::utility::parseInt(value));
+		float real;
+		if (_attribute.getValue(real))
+			TEST_CHECK(real == MyGUI::utility::parseFloat(value));
+		MyGUI::IntPoint point;
+		if (_attribute.getValue(point))
+			TEST_CHECK(point == MyGUI::IntPoint::parse(value));
+		MyGUI::IntSize size;
+		if (_attribute.getValue(size))
+			TEST_CHECK(size == MyGUI::IntSize::parse(value));
+		MyGUI::IntCoord coord;
+		if (_attribute.getValue(coord))
+			TEST_CHECK(coord == MyGUI::IntCoord::parse(value));
+		MyGUI::FloatCoord floatCoord;
+		if (_attribute.getValue(floatCoord))
+			TEST_CHECK(floatCoord == MyGUI::FloatCoord::parse(value));
+		MyGUI::Colour colour;
+		if (_attribute.getValue(colour))
+			TEST_CHECK(colour == MyGUI::Colour::parse(value));
+	}
+
+	// Compiled element has the same name, content, attributes and children as the source one.
+	void checkElement(const MyGUI::xml::CompiledElement& _compiled, MyGUI::xml::ElementPtr _element)
+	{
+		TEST_CHECK(_compiled.isValid());
+		TEST_CHECK(_element->getName() == _compiled.getName());
+		TEST_CHECK(_compiled.isName(_element->getName().c_str()));
+		TEST_CHECK(_element->getContent() == _compiled.getContent());
+		TEST_CHECK(_element->getType() == _compiled.getType());
+
+		const MyGUI::xml::VectorAttributes& attributes = _element->getAttributes();
+		TEST_CHECK(attributes.size() == _compiled.getAttributeCount());
+		for (size_t index = 0; index < attributes.size(); ++index)
+		{
+			MyGUI::xml::CompiledAttribute attribute = _compiled.getAttributeAt(index);
+			TEST_CHECK(attributes[index].first == attribute.getName());
+			TEST_CHECK(attributes[index].second == attribute.getValue());
+			TEST_CHECK(_element->findAttribute(attributes[index].first) == _compiled.findAttribute(attributes[index].first.c_str()).getValue());
+			checkNumbers(attribute);
+		}
+
+		size_t count = 0;
+		MyGUI::xml::ElementEnumerator child = _element->getElementEnumerator();
+		while (child.next())
+		{
+			TEST_CHECK(count < _compiled.getChildCount());
+			checkElement(_compiled.getChildAt(count++), child.current());
+		}
+		TEST_CHECK(count == _compiled.getChildCount());
+	}
+
+	void checkDocument(const MyGUI::xml::CompiledDocument& _compiled, MyGUI::xml::Document& _document)
+	{
+		checkElement(_compiled.getRoot(), _document.getRoot());
+	}
+
+	// Touches all data of element, returns number of visited elements.
+	size_t walk(const MyGUI::xml::CompiledElement& _element, size_t& _size)
+	{
+		_size += strlen(_element.getName()) + strlen(_element.getContent());
+		for (size_t index = 0; index < _element.getAttributeCount(); ++index)
+		{
+			MyGUI::xml::CompiledAttribute attribute = _element.getAttributeAt(index);
+			_size += strlen(attribute.getName()) + strlen(attribute.getValue());
+			MyGUI::IntCoord coord;
+			if (attribute.getValue(coord))
+				_size += coord.width;
+		}
+
+		size_t result = 1;
+		for (size_t index = 0; index < _element.getChildCount(); ++index)
+			result += walk(_element.getChildAt(index), _size);
+		return result;
+	}
+
+	void writeFile(const std::string& _name, const std::string& _data)
+	{
+		std::ofstream stream(_name.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		stream.write(_data.data(), _data.size());
+	}
+
+	size_t compiledLoads = 0;
+	size_t xmlLoads = 0;
+
+	void loadCompiled(const MyGUI::xml::CompiledElement& _node, const std::string& _file, MyGUI::Version _version)
+	{
+		TEST_CHECK(_node.isName("MyGUI") && _version == MyGUI::Version(1, 2));
+		compiledLoads++;
+	}
+
+	void loadXml(MyGUI::xml::ElementPtr _node, const std::string& _file, MyGUI::Version _version)
+	{
+		TEST_CHECK(_node->getName() == "MyGUI" && _version == MyGUI::Version(1, 2));
+		xmlLoads++;
+	}
+
+}
+
+HEADLESS_TEST(xml_binary_depth)
+{
+	{
+		std::istringstream stream(saveNested(300));
+		MyGUI::xml::Document document;
+		TEST_CHECK(document.open(stream));
+		TEST_CHECK(getDepth(document.getRoot()) == 300);
+	}
+
+	// nesting that could overflow stack is rejected
+	{
+		std::istringstream stream(saveNested(600));
+		MyGUI::xml::Document document;
+		TEST_CHECK(!document.open(stream));
+		TEST_CHECK(document.getLastError().find(MyGUI::xml::ErrorType(MyGUI::xml::ErrorType::TooDeepNesting).print()) != std::string::npos);
+		TEST_CHECK(document.getRoot() == nullptr);
+	}
+
+	// truncated file
+	{
+		std::string data = saveNested(10);
+		std::istringstream stream(data.substr(0, data.size() - 3));
+		MyGUI::xml::Document document;
+		TEST_CHECK(!document.open(stream));
+		TEST_CHECK(document.getRoot() == nullptr);
+	}
+}
+
+HEADLESS_TEST(xml_compiled_view)
+{
+	// every media file, compiled view and Element tree created from it are the same as the source
+	MyGUI::VectorString names = MyGUI::DataManager::getInstance().getDataListNames("*.xml");
+	size_t count = 0;
+	for (MyGUI::VectorString::const_iterator name = names.begin(); name != names.end(); ++name)
+	{
+		MyGUI::xml::Document document;
+		if (!document.open(MyGUI::DataManager::getInstance().getDataPath(*name)))
+			continue;
+		count++;
+
+		std::string data = compile(document);
+		MyGUI::xml::CompiledDocument compiled;
+		TEST_CHECK(compiled.open(data.data(), data.size()));
+		TEST_CHECK(compiled.getDeclaration().getType() == MyGUI::xml::ElementType::Declaration);
+		checkDocument(compiled, document);
+
+		MyGUI::xml::Document copy;
+		TEST_CHECK(copy.open(compiled));
+		checkDocument(compiled, copy);
+
+		// walking compiled data allocates nothing
+		size_t size = 0;
+		size_t allocations = test::getAllocationCount();
+		TEST_CHECK(walk(compiled.getRoot(), size) != 0 && size != 0);
+		TEST_CHECK(test::getAllocationCount() == allocations);
+	}
+	TEST_CHECK(count > 10);
+
+	// parsed values
+	MyGUI::xml::Document document;
+	document.createDeclaration();
+	MyGUI::xml::ElementPtr root = document.createRoot("MyGUI");
+	root->addAttribute("coord", "10 20 30 40");
+	root->addAttribute("float", " 0.5 1.5\t2 3 ");
+	root->addAttribute("hex", "#FF8000");
+	root->addAttribute("colour", "1 0 0 0.5");
+	root->addAttribute("number", "12");
+	root->addAttribute("text", "text");
+	root->addAttribute("long", "1 2 3 4 5");
+	root->addAttribute("mixed", "1 x");
+	root->addAttribute("empty", "");
+	root->createChild("Child", "content")->addAttribute("size", "-1 2");
+
+	std::string data = compile(document);
+	MyGUI::xml::CompiledDocument compiled;
+	TEST_CHECK(compiled.open(data.data(), data.size()));
+	checkDocument(compiled, document);
+	TEST_CHECK(compiled.getDepth() == 2);
+
+	MyGUI::xml::CompiledElement element = compiled.getRoot();
+	MyGUI::IntCoord coord;
+	MyGUI::IntSize size;
+	MyGUI::FloatCoord floatCoord;
+	MyGUI::Colour colour;
+	float real;
+	int number;
+	TEST_CHECK(element.findAttribute("coord").getValue(coord) && coord == MyGUI::IntCoord(10, 20, 30, 40));
+	TEST_CHECK(!element.findAttribute("coord").getValue(size));
+	TEST_CHECK(element.findAttribute("coord").getValue(floatCoord) && floatCoord == MyGUI::FloatCoord(10, 20, 30, 40));
+	TEST_CHECK(!element.findAttribute("float").getValue(coord));
+	TEST_CHECK(element.findAttribute("float").getValue(floatCoord) && floatCoord == MyGUI::FloatCoord(0.5f, 1.5f, 2, 3));
+	TEST_CHECK(element.findAttribute("hex").getValue(colour) && colour == MyGUI::Colour::parse("#FF8000"));
+	TEST_CHECK(!element.findAttribute("hex").getValue(floatCoord));
+	TEST_CHECK(element.findAttribute("colour").getValue(colour) && colour == MyGUI::Colour(1, 0, 0, 0.5f));
+	TEST_CHECK(element.findAttribute("number").getValue(number) && number == 12);
+	TEST_CHECK(element.findAttribute("number").getValue(real) && real == 12);
+	TEST_CHECK(element.getChildAt(0).findAttribute("size").getValue(size) && size == MyGUI::IntSize(-1, 2));
+
+	const char* strings[] = { "text", "long", "mixed", "empty" };
+	for (size_t index = 0; index < sizeof(strings) / sizeof(strings[0]); ++index)
+	{
+		MyGUI::xml::CompiledAttribute attribute = element.findAttribute(strings[index]);
+		TEST_CHECK(attribute.isValid() && attribute.getValue() == document.getRoot()->findAttribute(strings[index]));
+		TEST_CHECK(!attribute.getValue(real) && !attribute.getValue(colour) && !attribute.getValue(floatCoord));
+	}
+
+	MyGUI::xml::CompiledAttribute missing = element.findAttribute("missing");
+	TEST_CHECK(!missing.isValid() && strcmp(missing.getValue(), "") == 0 && !missing.getValue(number));
+
+	// truncated data is rejected, damaged data is either rejected or still safe to walk
+	for (size_t length = 0; length < data.size(); ++length)
+		TEST_CHECK(!compiled.open(data.data(), length));
+	for (size_t index = 0; index < data.size(); ++index)
+	{
+		std::string damaged = data;
+		damaged[index] ^= 0x5A;
+		if (compiled.open(damaged.data(), damaged.size()))
+		{
+			size_t total = 0;
+			walk(compiled.getRoot(), total);
+			MyGUI::xml::Document copy;
+			copy.open(compiled);
+		}
+	}
+}
+
+HEADLESS_TEST(xml_compiled_load)
+{
+	MyGUI::DummyDataManager::getInstance().addResourceLocation(".", false);
+
+	MyGUI::ResourceManager& manager = MyGUI::ResourceManager::getInstance();
+	manager.registerLoadCompiledDelegate("UnitTest") = MyGUI::newDelegate(loadCompiled);
+	manager.registerLoadXmlDelegate("UnitTest") = MyGUI::newDelegate(loadXml);
+
+	MyGUI::xml::Document document;
+	document.createDeclaration();
+	MyGUI::xml::ElementPtr root = document.createRoot("MyGUI");
+	root->addAttribute("type", "UnitTest");
+	root->addAttribute("version", "1.2");
+
+	// compiled file is walked in place by delegate that accepts it
+	const std::string textFile = "UnitTest_Headless_text.xml";
+	const std::string compiledFile = "UnitTest_Headless_compiled.xml";
+	document.save(textFile);
+	writeFile(compiledFile, compile(document));
+	TEST_CHECK(manager.load(compiledFile));
+	TEST_CHECK(compiledLoads == 1 && xmlLoads == 0);
+	TEST_CHECK(manager.load(textFile));
+	TEST_CHECK(compiledLoads == 1 && xmlLoads == 1);
+
+	// compiled list of compiled resources, resources are loaded from Element tree
+	const std::string resourceFile = "UnitTest_Headless_resource.xml";
+	root->setAttribute("type", "Resource");
+	MyGUI::xml::ElementPtr resource = root->createChild("Resource");
+	resource->addAttribute("type", "ResourceImageSet");
+	resource->addAttribute("name", "UnitTest_Headless_Compiled");
+	writeFile(resourceFile, compile(document));
+
+	root->setAttribute("type", "List");
+	root->removeChild(resource);
+	root->createChild("List")->addAttribute("file", resourceFile);
+	writeFile(compiledFile, compile(document));
+	TEST_CHECK(manager.load(compiledFile));
+	TEST_CHECK(manager.isExist("UnitTest_Headless_Compiled"));
+
+	// damaged compiled file is not loaded
+	std::string data = compile(document);
+	writeFile(compiledFile, data.substr(0, data.size() - 1));
+	TEST_CHECK(!manager.load(compiledFile));
+
+	manager.removeByName("UnitTest_Headless_Compiled");
+	manager.unregisterLoadCompiledDelegate("UnitTest");
+	manager.unregisterLoadXmlDelegate("UnitTest");
+	std::remove(textFile.c_str());
+	std::remove(compiledFile.c_str());
+	std::remove(resourceFile.c_str());
+}
@@ -0,0 +1,416 @@
+/*!
+	@file
+	@brief Text xml parser compared with line by line parser it replaced
+*/
+#include "HeadlessTest.h"
+#include "MyGUI_XmlDocument.h"
+#include "FileSystemInfo/FileSystemInfo.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+namespace
+{
+
+	struct Node
+	{
+		std::string name;
+		bool declaration;
+		Node* parent;
+		MyGUI::xml::VectorAttributes attributes;
+		std::string content;
+		std::vector<Node*> children;
+	};
+
+	// Text parser of xml::Document as it was before parsing in place, kept to check that output didn't change.
+	class ReferenceParser
+	{
+	public:
+		ReferenceParser() :
+			mRoot(nullptr),
+			mDeclaration(nullptr)
+		{
+		}
+
+		Node* getRoot() const
+		{
+			return mRoot;
+		}
+
+		bool parse(const std::string& _data)
+		{
+			std::string line;
+			std::string read;
+			Node* currentNode = nullptr;
+
+			size_t start = 0;
+			while (start < _data.size())
+			{
+				size_t end = _data.find('\n', start);
+				if (end == std::string::npos)
+					end = _data.size();
+				read.assign(_data, start, end - start);
+				start = end + 1;
+
+				if (read.empty())
+					continue;
+				if (read[read.size() - 1] == '\r')
+					read.erase(read.size() - 1, 1);
+				if (read.empty())
+					continue;
+
+				line += read;
+
+				if (!parseLine(line, currentNode))
+					return false;
+			}
+
+			return currentNode == nullptr;
+		}
+
+	private:
+		Node* createNode(const std::string& _name, Node* _parent, bool _declaration = false)
+		{
+			mNodes.push_back(std::unique_ptr<Node>(new Node()));
+			Node* node = mNodes.back().get();
+			node->name = _name;
+			node->declaration = _declaration;
+			node->parent = _parent;
+			if (_parent != nullptr)
+				_parent->children.push_back(node);
+			return node;
+		}
+
+		static std::string convertFromXml(const std::string& _string, bool& _ok)
+		{
+			std::string ret;
+			_ok = true;
+
+			size_t pos = _string.find("&");
+			if (pos == std::string::npos)
+				return _string;
+
+			size_t old = 0;
+			while (pos != std::string::npos)
+			{
+				ret += _string.substr(old, pos - old);
+
+				size_t end = _string.find(";", pos + 1);
+				if (end == std::string::npos)
+				{
+					_ok = false;
+					return ret;
+				}
+
+				std::string tag = _string.substr(pos, end - pos + 1);
+				if (tag == "&amp;") ret += '&';
+				else if (tag == "&lt;") ret += '<';
+				else if (tag == "&gt;") ret += '>';
+				else if (tag == "&apos;") ret += '\'';
+				else if (tag == "&quot;") ret += '\"';
+				else
+				{
+					_ok = false;
+					return ret;
+				}
+
+				old = end + 1;
+				pos = _string.find("&", old);
+			}
+			ret += _string.substr(old, std::string::npos);
+
+			return ret;
+		}
+
+		// character out of double quotes
+		static size_t find(const std::string& _text, char _char, size_t _start = 0)
+		{
+			bool quote = false;
+			char buff[16] = "\"_\0";
+			buff[1] = _char;
+
+			size_t pos = _start;
+			while (true)
+			{
+				pos = _text.find_first_of(buff, pos);
+				if (pos == _text.npos)
+					break;
+				else if (_text[pos] == '"')
+				{
+					quote = !quote;
+					pos ++;
+				}
+				else if (quote)
+					pos ++;
+				else
+					break;
+			}
+
+			return pos;
+		}
+
+		static bool checkPair(std::string& _key, std::string& _value)
+		{
+			MyGUI::utility::trim(_key);
+			if (_key.empty())
+				return false;
+			if (_key.find_first_of(" \t\"\'&") != _key.npos)
+				return false;
+
+			MyGUI::utility::trim(_value);
+			if (_value.size() < 2)
+				return false;
+			if (((_value[0] != '"') || (_value[_value.length() - 1] != '"')) &&
+				((_value[0] != '\'') || (_value[_value.length() - 1] != '\'')))
+				return false;
+			bool ok = true;
+			_value = convertFromXml(_value.substr(1, _value.length() - 2), ok);
+			return ok;
+		}
+
+		bool parseLine(std::string& _line, Node*& _node)
+		{
+			while (true)
+			{
+				size_t start = find(_line, '<');
+				if (start == _line.npos)
+					break;
+				size_t end;
+
+				// comment can take several lines
+				if ((start + 3 < _line.size()) && (_line[start + 1] == '!') && (_line[start + 2] == '-') && (_line[start + 3] == '-'))
+				{
+					end = _line.find("-->", start + 4);
+					if (end == _line.npos)
+						break;
+					end += 2;
+				}
+				else
+				{
+					end = find(_line, '>', start + 1);
+					if (end == _line.npos)
+						break;
+				}
+
+				size_t body = _line.find_first_not_of(" \t<");
+				if (body < start && _node != nullptr)
+				{
+					bool ok = true;
+					_node->content = convertFromXml(_line.substr(0, start), ok);
+					if (!ok)
+						return false;
+				}
+
+				if (!parseTag(_node, _line.substr(start + 1, end - start - 1)))
+					return false;
+				_line = _line.substr(end + 1);
+			}
+			return true;
+		}
+
+		bool parseTag(Node*& _node, std::string _content)
+		{
+			MyGUI::utility::trim(_content);
+
+			if (_content.empty())
+			{
+				_node = createNode("", _node);
+				if (mRoot == nullptr)
+					mRoot = _node;
+				return true;
+			}
+
+			char symbol = _content[0];
+			bool tagDeclaration = false;
+
+			if (symbol == '!')
+				return true;
+			else if (symbol == '?')
+			{
+				tagDeclaration = true;
+				_content.erase(0, 1);
+			}
+
+			size_t start = 0;
+			size_t end = 0;
+			if (symbol == '/')
+			{
+				if (_node == nullptr)
+					return false;
+
+				start = _content.find_first_not_of(" \t", 1);
+				if (start == _content.npos)
+				{
+					_content.clear();
+				}
+				else
+				{
+					end = _content.find_last_not_of(" \t");
+					_content = _content.substr(start, end - start + 1);
+				}
+				if (_node->name != _content)
+					return false;
+				_node = _node->parent;
+				return true;
+			}
+
+			std::string cut = _content;
+			start = _content.find_first_of(" \t/?", 1);
+			if (start != _content.npos)
+			{
+				cut = _content.substr(0, start);
+				_content = _content.substr(start);
+			}
+			else
+			{
+				_content.clear();
+			}
+
+			if (_node != nullptr)
+			{
+				_node = createNode(cut, _node);
+			}
+			else if (tagDeclaration)
+			{
+				if (mDeclaration != nullptr)
+					return false;
+				_node = createNode(cut, nullptr, true);
+				mDeclaration = _node;
+			}
+			else
+			{
+				if (mRoot != nullptr)
+					return false;
+				_node = createNode(cut, nullptr);
+				mRoot = _node;
+			}
+
+			start = _content.find_last_not_of(" \t");
+			if (start == _content.npos)
+				return true;
+
+			bool close = false;
+			if ((_content[start] == '/') || (_content[start] == '?'))
+			{
+				close = true;
+				_content[start] = ' ';
+				start = _content.find_last_not_of(" \t");
+				if (start == _content.npos)
+				{
+					_node = _node->parent;
+					return true;
+				}
+			}
+
+			while (true)
+			{
+				start = _content.find('=');
+				if (start == _content.npos)
+					return false;
+				end = _content.find_first_of("\"\'", start + 1);
+				if (end == _content.npos)
+					return false;
+				end = _content.find_first_of("\"\'", end + 1);
+				if (end == _content.npos)
+					return false;
+
+				std::string key = _content.substr(0, start);
+				std::string value = _content.substr(start + 1, end - start);
+				if (!checkPair(key, value))
+					return false;
+				_node->attributes.push_back(MyGUI::xml::PairAttribute(key, value));
+
+				_content = _content.substr(end + 1);
+				if (_content.find_first_not_of(" \t") == _content.npos)
+					break;
+			}
+
+			if (close)
+				_node = _node->parent;
+
+			return true;
+		}
+
+	private:
+		std::vector<std::unique_ptr<Node>> mNodes;
+		Node* mRoot;
+		Node* mDeclaration;
+	};
+
+	bool equalTree(const Node* _node, MyGUI::xml::ElementPtr _element)
+	{
+		if (_node == nullptr || _element == nullptr)
+			return _node == nullptr && _element == nullptr;
+
+		if (_node->name != _element->getName() ||
+			_node->declaration != (_element->getType() == MyGUI::xml::ElementType::Declaration) ||
+			_node->attributes != _element->getAttributes() ||
+			_node->content != _element->getContent())
+			return false;
+
+		size_t index = 0;
+		MyGUI::xml::ElementEnumerator child = _element->getElementEnumerator();
+		while (child.next())
+		{
+			if (index == _node->children.size() || !equalTree(_node->children[index], child.current()))
+				return false;
+			++index;
+		}
+		return index == _node->children.size();
+	}
+
+	// both parsers accept text and build the same tree, or both reject it
+	bool parseSame(const std::string& _data)
+	{
+		ReferenceParser reference;
+		bool referenceResult = reference.parse(_data);
+
+		MyGUI::xml::Document document;
+		std::istringstream stream(_data);
+		bool result = document.open(stream);
+
+		if (result != referenceResult)
+			return false;
+		return !result || equalTree(reference.getRoot(), document.getRoot());
+	}
+
+	std::string readFile(const std::wstring& _fileName)
+	{
+		std::ifstream stream(MyGUI::UString(_fileName).asUTF8_c_str(), std::ios_base::in | std::ios_base::binary);
+		std::ostringstream result;
+		result << stream.rdbuf();
+		return result.str();
+	}
+
+}
+
+HEADLESS_TEST(xml_parser_reference)
+{
+	// every xml and layout file of media
+	common::VectorWString files;
+	common::scanFolder(files, MyGUI::UString(test::getMediaPath()).asWStr(), true, L"*.xml", true);
+	common::scanFolder(files, MyGUI::UString(test::getMediaPath()).asWStr(), true, L"*.layout", true);
+	TEST_CHECK(files.size() > 100);
+
+	for (size_t index = 0; index < files.size(); ++index)
+	{
+		if (!parseSame(readFile(files[index])))
+			test::check(false, ("parsed differently: " + MyGUI::UString(files[index]).asUTF8()).c_str(), __FILE__, __LINE__);
+	}
+
+	// tags split between lines, entities, comments and empty elements
+	TEST_CHECK(parseSame("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<MyGUI type=\"Layout\">\n\t<Widget\n\t\tname=\"a\" skin='b'>text &amp; &lt;more&gt;</Widget>\n</MyGUI>\n"));
+	TEST_CHECK(parseSame("<Root><!-- comment\n with <tags> inside -->\r\n<Child key = \" spaced \" /><Child/>\n<Other a=\"&quot;&apos;\"></Other></Root>"));
+	TEST_CHECK(parseSame("<Root>first<Child/>second</Root>"));
+	TEST_CHECK(parseSame("<Root a=\"1 > 0\" b=\"<\"></Root>"));
+
+	// errors are found by both
+	TEST_CHECK(parseSame("<Root><Child></Root>"));
+	TEST_CHECK(parseSame("<Root></Root><Second/>"));
+	TEST_CHECK(parseSame("<Root a=1></Root>"));
+	TEST_CHECK(parseSame("<Root a=\"&unknown;\"></Root>"));
+	TEST_CHECK(parseSame("<Root>"));
+	TEST_CHECK(parseSame("</Root>"));
+	TEST_CHECK(parseSame("<?xml version=\"1.0\"?><?xml version=\"1.0\"?><Root/>"));
+}
@@ -227,6 +227,12 @@ namespace MyGUI
 		mOutOfDateRtt = true;
 	}
 
+	void RTTLayerNode::outOfDate(RenderItem* _item, ISubWidget* _subItem)
+	{
+		_item->outOfDate(_subItem);
+		mOutOfDateRtt = true;
+	}
+
 	void RTTLayerNode::setCacheUsing(bool _value)
 	{
 		mChacheUsing = _value;
@@ -27,6 +27,7 @@ namespace MyGUI
 
 		// необходимо обновление нода
 		void outOfDate(RenderItem* _item) override;
+		void outOfDate(RenderItem* _item, ISubWidget* _subItem) override;
 
 		// добавляем айтем к ноду
 		void attachLayerItem(ILayerItem* _item) override;